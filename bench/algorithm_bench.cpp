@@ -0,0 +1,302 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./feature_bench.hpp"
+#include "../src/simd.hpp"
+#include "../src/vector.hpp"
+#include "../src/vector_expression.hpp"
+#include "../src/vector_format.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <string>
+
+
+namespace
+{
+/*------------------------------------*/
+/* SIMD kernels */
+
+template<typename ItemType>
+void
+addSimdBenchmarks(pel::bench::suite& suite_, const std::string& typeName_)
+{
+    constexpr std::size_t length = 1'000'000;
+    const std::string     suffix = '/' + typeName_ + '/' + std::to_string(length) + '/';
+
+    /* The value searched for is in the last element */
+    const auto lhs = std::make_shared<pel::vector<ItemType>>(length, ItemType{1});
+    const auto rhs = std::make_shared<pel::vector<ItemType>>(length, ItemType{2});
+    (*lhs)[length - 1] = ItemType{3};
+
+    /* Standard algorithms through vector_iterator */
+    suite_.add("fill" + suffix + "std",
+               [rhs]
+               {
+                   std::fill(rhs->begin(), rhs->end(), ItemType{2});
+                   pel::bench::clobber_memory();
+               });
+    suite_.add("find" + suffix + "std",
+               [lhs]
+               {
+                   pel::bench::do_not_optimize(*std::find(lhs->begin(), lhs->end(), ItemType{3}));
+               });
+    suite_.add("count" + suffix + "std",
+               [lhs]
+               {
+                   pel::bench::do_not_optimize(std::count(lhs->begin(), lhs->end(), ItemType{3}));
+               });
+    suite_.add("minimum" + suffix + "std",
+               [lhs]
+               {
+                   pel::bench::do_not_optimize(*std::min_element(lhs->begin(), lhs->end()));
+               });
+    suite_.add("maximum" + suffix + "std",
+               [lhs]
+               {
+                   pel::bench::do_not_optimize(*std::max_element(lhs->begin(), lhs->end()));
+               });
+    suite_.add("sum" + suffix + "std",
+               [lhs]
+               {
+                   pel::bench::do_not_optimize(
+                     std::accumulate(lhs->begin(), lhs->end(), ItemType{}));
+               });
+    suite_.add("dot" + suffix + "std",
+               [lhs, rhs]
+               {
+                   pel::bench::do_not_optimize(
+                     std::inner_product(lhs->begin(), lhs->end(), rhs->begin(), ItemType{}));
+               });
+
+    /* Every instruction set supported by the processor. The kernels select the active one, so
+     * each benchmark selects its own before running. */
+    for(pel::simd::isa isa = pel::simd::isa::scalar; isa <= pel::simd::detect_isa();
+        isa                = static_cast<pel::simd::isa>(static_cast<int>(isa) + 1))
+    {
+        const std::string container = std::string{"pel::simd("} + pel::simd::to_string(isa) + ')';
+
+        suite_.add("fill" + suffix + container,
+                   [=]
+                   {
+                       pel::simd::set_active_isa(isa);
+                       pel::simd::fill(*rhs, ItemType{2});
+                       pel::bench::clobber_memory();
+                   });
+        suite_.add("find" + suffix + container,
+                   [=]
+                   {
+                       pel::simd::set_active_isa(isa);
+                       pel::bench::do_not_optimize(*pel::simd::find(*lhs, ItemType{3}));
+                   });
+        suite_.add("count" + suffix + container,
+                   [=]
+                   {
+                       pel::simd::set_active_isa(isa);
+                       pel::bench::do_not_optimize(pel::simd::count(*lhs, ItemType{3}));
+                   });
+        suite_.add("minimum" + suffix + container,
+                   [=]
+                   {
+                       pel::simd::set_active_isa(isa);
+                       pel::bench::do_not_optimize(pel::simd::minimum(*lhs));
+                   });
+        suite_.add("maximum" + suffix + container,
+                   [=]
+                   {
+                       pel::simd::set_active_isa(isa);
+                       pel::bench::do_not_optimize(pel::simd::maximum(*lhs));
+                   });
+        suite_.add("sum" + suffix + container,
+                   [=]
+                   {
+                       pel::simd::set_active_isa(isa);
+                       pel::bench::do_not_optimize(pel::simd::sum(*lhs));
+                   });
+        suite_.add("dot" + suffix + container,
+                   [=]
+                   {
+                       pel::simd::set_active_isa(isa);
+                       pel::bench::do_not_optimize(pel::simd::dot(*lhs, *rhs));
+                   });
+    }
+}
+
+
+/*------------------------------------*/
+/* Expression templates */
+
+/**
+ * \brief   Computes `a_ + b_ * c_ - d_` one operator at a time, materializing every intermediate.
+ */
+pel::vector<float>
+evaluateEagerly(const pel::vector<float>& a_,
+                const pel::vector<float>& b_,
+                const pel::vector<float>& c_,
+                const pel::vector<float>& d_)
+{
+    const pel::vector<float> product(b_.length(),
+                                     [&](std::size_t index_) { return b_[index_] * c_[index_]; });
+    const pel::vector<float> addition(a_.length(),
+                                      [&](std::size_t index_)
+                                      { return a_[index_] + product[index_]; });
+    return pel::vector<float>(d_.length(),
+                              [&](std::size_t index_) { return addition[index_] - d_[index_]; });
+}
+
+void
+addExpressionBenchmarks(pel::bench::suite& suite_)
+{
+    constexpr std::size_t length = 1'000'000;
+    const std::string     suffix = "/float/" + std::to_string(length) + '/';
+
+    struct Operands
+    {
+        pel::vector<float> a{length, 1.0f};
+        pel::vector<float> b{length, 2.0f};
+        pel::vector<float> c{length, 3.0f};
+        pel::vector<float> d{length, 4.0f};
+        pel::vector<float> result{length, 0.0f};
+    };
+    const auto operands = std::make_shared<Operands>();
+
+    suite_.add("a+b*c-d" + suffix + "eager",
+               [operands]
+               {
+                   const Operands& o = *operands;
+                   pel::bench::do_not_optimize(evaluateEagerly(o.a, o.b, o.c, o.d).data());
+               });
+    suite_.add("a+b*c-d" + suffix + "fused",
+               [operands]
+               {
+                   Operands& o = *operands;
+                   o.result    = o.a + o.b * o.c - o.d;
+                   pel::bench::do_not_optimize(o.result.data());
+               });
+
+    suite_.add("sum(b*c)" + suffix + "eager",
+               [operands]
+               {
+                   const Operands&          o = *operands;
+                   const pel::vector<float> product(length,
+                                                    [&](std::size_t index_)
+                                                    { return o.b[index_] * o.c[index_]; });
+                   pel::bench::do_not_optimize(pel::simd::sum(product));
+               });
+    suite_.add("sum(b*c)" + suffix + "fused",
+               [operands] { pel::bench::do_not_optimize(pel::sum(operands->b * operands->c)); });
+}
+
+
+/*------------------------------------*/
+/* Formatting */
+
+/**
+ * \brief   Output iterator that only counts the characters written to it.
+ */
+struct CharacterCounter
+{
+    using iterator_category = std::output_iterator_tag;
+    using value_type        = void;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = void;
+    using reference         = void;
+
+    CharacterCounter&
+    operator*() noexcept
+    {
+        return *this;
+    }
+
+    CharacterCounter&
+    operator=(char /*character_*/) noexcept
+    {
+        (*count)++;
+        return *this;
+    }
+
+    CharacterCounter&
+    operator++() noexcept
+    {
+        return *this;
+    }
+
+    CharacterCounter
+    operator++(int) noexcept
+    {
+        return *this;
+    }
+
+    std::size_t* count;
+};
+
+template<typename ItemType>
+void
+addFormattingBenchmarks(pel::bench::suite& suite_, const std::string& typeName_)
+{
+    constexpr std::size_t length = 100'000;
+    const std::string     suffix = '/' + typeName_ + '/' + std::to_string(length) + '/';
+
+    const auto vec = std::make_shared<pel::vector<ItemType>>(length, ItemType{});
+    for(std::size_t i = 0; i < length; i++)
+    {
+        (*vec)[i] = static_cast<ItemType>(i) / static_cast<ItemType>(3);
+    }
+
+    suite_.add("format" + suffix + "ostringstream",
+               [vec] { pel::bench::do_not_optimize(vec->to_string()); });
+    suite_.add("format" + suffix + "to_string",
+               [vec] { pel::bench::do_not_optimize(pel::to_string(*vec)); });
+    suite_.add("format" + suffix + "format_to",
+               [vec]
+               {
+                   std::size_t characters = 0;
+                   pel::format_to(CharacterCounter{&characters}, *vec);
+                   pel::bench::do_not_optimize(characters);
+               });
+}
+
+}        // namespace
+
+
+void
+addAlgorithmBenchmarks(pel::bench::suite& suite_)
+{
+    addSimdBenchmarks<std::int32_t>(suite_, "int32");
+    addSimdBenchmarks<float>(suite_, "float");
+    addSimdBenchmarks<double>(suite_, "double");
+    addExpressionBenchmarks(suite_);
+    addFormattingBenchmarks<int>(suite_, "int");
+    addFormattingBenchmarks<double>(suite_, "double");
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
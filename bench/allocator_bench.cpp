@@ -0,0 +1,307 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./feature_bench.hpp"
+#include "../src/arena.hpp"
+#include "../src/caching_allocator.hpp"
+#include "../src/hugepage_allocator.hpp"
+#include "../src/simd.hpp"
+#include "../src/vector.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <string>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+
+namespace
+{
+/*------------------------------------*/
+/* Aligned storage */
+
+void
+addAlignmentBenchmarks(pel::bench::suite& suite_)
+{
+    constexpr std::size_t length = 64 * 1024;
+    const std::string     suffix = "/float/" + std::to_string(length) + '/';
+
+    /* One spare register, so that the misaligned range stays within the vector */
+    const auto vec = std::make_shared<const pel::vector<float>>(length + 16, 1.0f);
+
+    suite_.add("sum" + suffix + "aligned",
+               [vec]
+               {
+                   const float* first = vec->data();
+                   pel::bench::do_not_optimize(pel::simd::sum(first, first + length));
+               });
+    suite_.add("sum" + suffix + "misaligned",
+               [vec]
+               {
+                   const float* first = vec->data() + 1;
+                   pel::bench::do_not_optimize(pel::simd::sum(first, first + length));
+               });
+}
+
+
+/*------------------------------------*/
+/* Huge pages */
+
+/**
+ * \brief   Baseline allocator whose blocks are never backed by huge pages.
+ *          On Linux, blocks are mapped and marked with `madvise(MADV_NOHUGEPAGE)`, so that they
+ *          keep 4 KiB pages even when transparent huge pages are always enabled.
+ */
+template<typename ItemType>
+struct small_page_allocator
+{
+    using value_type = ItemType;
+
+    small_page_allocator() noexcept = default;
+
+    template<typename OtherType>
+    small_page_allocator(const small_page_allocator<OtherType>& /*other_*/) noexcept
+    {
+    }
+
+    [[nodiscard]] ItemType*
+    allocate(std::size_t count_)
+    {
+#if defined(__linux__)
+        void* ptr = ::mmap(nullptr,
+                           count_ * sizeof(ItemType),
+                           PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS,
+                           -1,
+                           0);
+        if(ptr == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+        ::madvise(ptr, count_ * sizeof(ItemType), MADV_NOHUGEPAGE);
+        return static_cast<ItemType*>(ptr);
+#else
+        return std::allocator<ItemType>{}.allocate(count_);
+#endif
+    }
+
+    void
+    deallocate(ItemType* ptr_, std::size_t count_) noexcept
+    {
+#if defined(__linux__)
+        ::munmap(ptr_, count_ * sizeof(ItemType));
+#else
+        std::allocator<ItemType>{}.deallocate(ptr_, count_);
+#endif
+    }
+
+    friend bool
+    operator==(const small_page_allocator& /*lhs_*/, const small_page_allocator& /*rhs_*/) noexcept
+    {
+        return true;
+    }
+};
+
+/**
+ * \brief   Transparent huge page mode of the system, as selected in
+ *          /sys/kernel/mm/transparent_hugepage/enabled (always, madvise or never).
+ */
+std::string
+transparentHugePageMode()
+{
+    std::ifstream enabled{"/sys/kernel/mm/transparent_hugepage/enabled"};
+    std::string   mode;
+    while(enabled >> mode)
+    {
+        if(mode.size() > 2 && mode.front() == '[' && mode.back() == ']')
+        {
+            return mode.substr(1, mode.size() - 2);
+        }
+    }
+    return "unknown";
+}
+
+/**
+ * \brief   Fills a vector, then measures a sequential scan and random reads over it.
+ */
+template<typename Allocator>
+void
+addPageBenchmarks(pel::bench::suite& suite_, const std::string& allocator_)
+{
+    using VectorType = pel::vector<float, Allocator>;
+
+    constexpr std::size_t length      = 16 * 1024 * 1024;
+    constexpr std::size_t randomReads = 100'000;
+    const std::string     suffix      = "/float/" + std::to_string(length) + '/' + allocator_;
+
+    auto fill = [](float* data_, std::size_t count_)
+    {
+        std::fill_n(data_, count_, 1.0f);
+        return count_;
+    };
+
+    suite_.add("fill" + suffix,
+               [fill]
+               {
+                   VectorType vec;
+                   vec.resize_for_overwrite(length, fill);
+                   pel::bench::do_not_optimize(vec.data());
+               });
+
+    const auto vec = std::make_shared<VectorType>();
+    vec->resize_for_overwrite(length, fill);
+
+    suite_.add("scan" + suffix, [vec] { pel::bench::do_not_optimize(pel::simd::sum(*vec)); });
+
+    suite_.add("random_reads" + suffix,
+               [vec]
+               {
+                   std::uint64_t state = 0x9E3779B97F4A7C15;
+                   float         total = 0;
+                   for(std::size_t i = 0; i < randomReads; i++)
+                   {
+                       state = state * 6364136223846793005 + 1442695040888963407;
+                       total += (*vec)[(state >> 17) % length];
+                   }
+                   pel::bench::do_not_optimize(total);
+               });
+}
+
+
+/*------------------------------------*/
+/* Arenas */
+
+/**
+ * \brief   Simulates a request handler building a few temporary vectors from one allocator.
+ */
+template<typename Allocator>
+std::size_t
+handleRequest(const Allocator& alloc_, std::size_t elements_)
+{
+    pel::vector<int, Allocator> ids(0, alloc_);
+    pel::vector<int, Allocator> scores(0, alloc_);
+    pel::vector<int, Allocator> results(0, alloc_);
+
+    for(std::size_t i = 0; i < elements_; i++)
+    {
+        ids.push_back(static_cast<int>(i));
+        scores.push_back(static_cast<int>(i * 7 % 13));
+    }
+    for(std::size_t i = 0; i < elements_; i++)
+    {
+        if(scores[i] > 6)
+        {
+            results.push_back(ids[i]);
+        }
+    }
+    return results.length();
+}
+
+void
+addArenaBenchmarks(pel::bench::suite& suite_)
+{
+    constexpr std::size_t elements = 256;
+    const std::string     suffix   = "/int/" + std::to_string(elements) + '/';
+
+    using BufferType  = std::array<std::byte, 16 * 1024>;
+    const auto buffer = std::make_shared<BufferType>();
+
+    suite_.add("request" + suffix + "std::allocator",
+               [] { pel::bench::do_not_optimize(handleRequest(std::allocator<int>{}, elements)); });
+
+    suite_.add("request" + suffix + "pmr::monotonic_buffer_resource",
+               [buffer]
+               {
+                   std::pmr::monotonic_buffer_resource resource{buffer->data(), buffer->size()};
+                   pel::bench::do_not_optimize(
+                     handleRequest(std::pmr::polymorphic_allocator<int>{&resource}, elements));
+               });
+
+    suite_.add("request" + suffix + "pel::arena",
+               [buffer]
+               {
+                   pel::arena arena{buffer->data(), buffer->size()};
+                   pel::bench::do_not_optimize(
+                     handleRequest(pel::arena_allocator<int>{arena}, elements));
+               });
+}
+
+
+/*------------------------------------*/
+/* Buffer cache */
+
+/**
+ * \brief   Grows a vector through a series of capacities, the way a short-lived buffer would.
+ */
+template<typename Allocator>
+void
+addChurnBenchmark(pel::bench::suite& suite_, const std::string& allocator_)
+{
+    constexpr std::size_t length = 16384;
+
+    suite_.add("churn/int/" + std::to_string(length) + '/' + allocator_,
+               []
+               {
+                   pel::vector<int, Allocator> vec;
+                   for(std::size_t capacity = 16; capacity <= length; capacity *= 4)
+                   {
+                       vec.reserve(capacity);
+                       vec.push_back(static_cast<int>(capacity));
+                   }
+                   pel::bench::do_not_optimize(vec.data());
+               });
+}
+
+}        // namespace
+
+
+void
+addAllocatorBenchmarks(pel::bench::suite& suite_)
+{
+    addAlignmentBenchmarks(suite_);
+
+    /* The system setting decides what the huge page allocator actually gets, so it is part of
+     * the name of the benchmarks */
+    const std::string thpMode = "/thp=" + transparentHugePageMode();
+    addPageBenchmarks<small_page_allocator<float>>(suite_, "4KiB_pages" + thpMode);
+    addPageBenchmarks<pel::hugepage_allocator<float>>(suite_, "huge_pages" + thpMode);
+    addArenaBenchmarks(suite_);
+    addChurnBenchmark<std::allocator<int>>(suite_, "std::allocator");
+    addChurnBenchmark<pel::caching_allocator<int>>(suite_, "pel::caching_allocator");
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,212 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+
+namespace pel::bench
+{
+/**
+ **************************************************************************************************
+ * \brief       Prevent the compiler from optimizing away the computation of a value.
+ *              The value is considered read, and all memory is considered clobbered.
+ *************************************************************************************************/
+template<typename ValueType>
+inline void
+do_not_optimize(const ValueType& value_) noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    const volatile void* volatile sink = &value_;
+    static_cast<void>(sink);
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "r"(&value_) : "memory");
+#endif
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Force every pending write to memory to be considered observed.
+ *************************************************************************************************/
+inline void
+clobber_memory() noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : : "memory");
+#endif
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Settings of a benchmark run.
+ *************************************************************************************************/
+struct options
+{
+    /** Batches run and discarded before measuring, to warm up caches, branch predictors and the
+     *  allocator. */
+    std::uint32_t m_warmupBatches = 3;
+
+    /** Measured batches. Statistics are computed over the time per iteration of every batch. */
+    std::uint32_t m_repetitions = 15;
+
+    /** Minimum duration of a batch. Iterations are added to a batch until it lasts that long,
+     *  so that fast operations are not dominated by the resolution of the clock. */
+    std::chrono::nanoseconds m_minBatchTime = std::chrono::milliseconds{2};
+
+    /** Only benchmarks whose name contains this string are run. */
+    std::string m_filter;
+};
+
+/**
+ **************************************************************************************************
+ * \brief       Statistics of the time per iteration of a benchmark, in nanoseconds.
+ *************************************************************************************************/
+struct statistics
+{
+    double m_min    = 0.0;
+    double m_median = 0.0;
+    double m_p90    = 0.0;
+    double m_p99    = 0.0;
+    double m_max    = 0.0;
+    double m_mean   = 0.0;
+    double m_stddev = 0.0;
+
+    [[nodiscard]] static statistics compute(std::vector<double> samples_);
+};
+
+/**
+ **************************************************************************************************
+ * \brief       Value reported next to the timings of a benchmark, such as a number of
+ *              reallocations.
+ *************************************************************************************************/
+struct counter
+{
+    std::string m_name;
+    double      m_value = 0.0;
+};
+
+/**
+ **************************************************************************************************
+ * \brief       Measurements of a single benchmark.
+ *************************************************************************************************/
+struct result
+{
+    std::string          m_name;
+    std::uint64_t        m_iterations  = 0;
+    std::uint32_t        m_repetitions = 0;
+    statistics           m_statistics;
+    std::vector<counter> m_counters;
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Collection of micro-benchmarks.
+ *
+ *              A benchmark is a function running an operation a given number of times. It is
+ *              first run in growing batches until a batch lasts \ref options::m_minBatchTime,
+ *              then for \ref options::m_warmupBatches discarded batches, and finally for
+ *              \ref options::m_repetitions measured batches of that size.
+ *
+ *              Benchmarks must feed their results to \ref do_not_optimize(), so that the measured
+ *              work cannot be removed by the optimizer.
+ *************************************************************************************************/
+class suite
+{
+public:
+    using BatchFunction   = std::function<void(std::uint64_t iterations_)>;
+    using CounterFunction = std::function<double(void)>;
+
+    /*********************************************************************************************/
+    /* Registration ---------------------------------------------------------------------------- */
+    void add_batch(std::string name_, BatchFunction batch_);
+
+    template<typename OperationType>
+    void add(std::string name_, OperationType operation_);
+
+    void add_counter(std::string name_, CounterFunction compute_);
+
+
+    /*********************************************************************************************/
+    /* Running --------------------------------------------------------------------------------- */
+    const std::vector<result>& run(const options& options_, std::ostream& progress_);
+
+    [[nodiscard]] const std::vector<result>& results() const noexcept;
+
+    void write_table(std::ostream& os_) const;
+    void write_csv(std::ostream& os_) const;
+    void write_json(std::ostream& os_) const;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    struct counter_source
+    {
+        std::string     m_name;
+        CounterFunction m_compute;
+    };
+
+    struct benchmark
+    {
+        std::string                 m_name;
+        BatchFunction               m_batch;
+        std::vector<counter_source> m_counters;
+    };
+
+    [[nodiscard]] static result measure(const benchmark& benchmark_, const options& options_);
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    std::vector<benchmark> m_benchmarks;
+    std::vector<result>    m_results;
+};
+
+}        // namespace pel::bench
+
+
+#include "./benchmark.inl"
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
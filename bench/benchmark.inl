@@ -0,0 +1,329 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include <stdexcept>
+
+
+namespace pel::bench
+{
+/*************************************************************************************************/
+/* STATISTICS ---------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Compute the statistics of a set of samples.
+ *              Percentiles are interpolated linearly between the two closest samples.
+ *
+ * \param       samples_: Time per iteration of every measured batch, in nanoseconds.
+ *************************************************************************************************/
+inline statistics
+statistics::compute(std::vector<double> samples_)
+{
+    statistics stats;
+    if(samples_.empty())
+    {
+        return stats;
+    }
+
+    std::sort(samples_.begin(), samples_.end());
+
+    auto percentile = [&](double fraction_)
+    {
+        const double      rank  = fraction_ * static_cast<double>(samples_.size() - 1);
+        const std::size_t lower = static_cast<std::size_t>(rank);
+        const std::size_t upper = std::min(lower + 1, samples_.size() - 1);
+        const double      ratio = rank - static_cast<double>(lower);
+        return samples_[lower] + (samples_[upper] - samples_[lower]) * ratio;
+    };
+
+    const double count = static_cast<double>(samples_.size());
+
+    stats.m_min    = samples_.front();
+    stats.m_median = percentile(0.50);
+    stats.m_p90    = percentile(0.90);
+    stats.m_p99    = percentile(0.99);
+    stats.m_max    = samples_.back();
+    stats.m_mean   = std::accumulate(samples_.begin(), samples_.end(), 0.0) / count;
+
+    double variance = 0.0;
+    for(const double sample : samples_)
+    {
+        variance += (sample - stats.m_mean) * (sample - stats.m_mean);
+    }
+    stats.m_stddev = std::sqrt(variance / count);
+
+    return stats;
+}
+
+
+/*************************************************************************************************/
+/* REGISTRATION -------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Register a benchmark running its own loop of `iterations_` operations.
+ *              Used by benchmarks that need to prepare state outside of the measured loop.
+ *************************************************************************************************/
+inline void
+suite::add_batch(std::string name_, BatchFunction batch_)
+{
+    m_benchmarks.push_back(benchmark{std::move(name_), std::move(batch_), {}});
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Register a benchmark measuring a single operation.
+ *
+ * \param       name_:      Name of the benchmark, conventionally `operation/type/length/container`.
+ * \param       operation_: Callable running the operation once.
+ *************************************************************************************************/
+template<typename OperationType>
+inline void
+suite::add(std::string name_, OperationType operation_)
+{
+    add_batch(std::move(name_),
+              [operation = std::move(operation_)](std::uint64_t iterations_) mutable
+              {
+                  for(std::uint64_t i = 0; i < iterations_; i++)
+                  {
+                      operation();
+                  }
+              });
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Attach a counter to the last registered benchmark.
+ *              The counter is only computed if the benchmark runs, once it has been measured.
+ *
+ * \param       name_:    Name of the counter, used as its column header.
+ * \param       compute_: Callable returning the value of the counter.
+ *************************************************************************************************/
+inline void
+suite::add_counter(std::string name_, CounterFunction compute_)
+{
+    if(m_benchmarks.empty())
+    {
+        throw std::logic_error("A counter must follow the benchmark it belongs to");
+    }
+    m_benchmarks.back().m_counters.push_back(counter_source{std::move(name_), std::move(compute_)});
+}
+
+
+/*************************************************************************************************/
+/* RUNNING ------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Run every benchmark matching the filter of the options.
+ *
+ * \param       options_:  Settings of the run.
+ * \param       progress_: Stream receiving one line per benchmark as it completes.
+ *************************************************************************************************/
+inline const std::vector<result>&
+suite::run(const options& options_, std::ostream& progress_)
+{
+    m_results.clear();
+    for(const benchmark& bench : m_benchmarks)
+    {
+        if(bench.m_name.find(options_.m_filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        m_results.push_back(measure(bench, options_));
+
+        result& last = m_results.back();
+        for(const counter_source& source : bench.m_counters)
+        {
+            last.m_counters.push_back(counter{source.m_name, source.m_compute()});
+        }
+
+        progress_ << std::left << std::setw(48) << last.m_name << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(14) << last.m_statistics.m_median
+                  << " ns\n"
+                  << std::flush;
+    }
+    return m_results;
+}
+
+inline const std::vector<result>&
+suite::results() const noexcept
+{
+    return m_results;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Measure a benchmark.
+ *              The number of iterations per batch doubles until a batch lasts at least the
+ *              minimum batch time; every following batch runs that many iterations.
+ *************************************************************************************************/
+inline result
+suite::measure(const benchmark& benchmark_, const options& options_)
+{
+    using Clock = std::chrono::steady_clock;
+
+    auto timeBatch = [&](std::uint64_t iterations_)
+    {
+        const Clock::time_point start = Clock::now();
+        benchmark_.m_batch(iterations_);
+        clobber_memory();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+    };
+
+    std::uint64_t iterations = 1;
+    while(timeBatch(iterations) < options_.m_minBatchTime)
+    {
+        iterations *= 2;
+    }
+
+    for(std::uint32_t i = 0; i < options_.m_warmupBatches; i++)
+    {
+        timeBatch(iterations);
+    }
+
+    std::vector<double> samples;
+    samples.reserve(options_.m_repetitions);
+    for(std::uint32_t i = 0; i < options_.m_repetitions; i++)
+    {
+        const double elapsed = static_cast<double>(timeBatch(iterations).count());
+        samples.push_back(elapsed / static_cast<double>(iterations));
+    }
+
+    return result{benchmark_.m_name,
+                  iterations,
+                  options_.m_repetitions,
+                  statistics::compute(std::move(samples)),
+                  {}};
+}
+
+
+/*************************************************************************************************/
+/* REPORTING ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Write the results as an aligned, human-readable table. Times are in nanoseconds.
+ *              Counters follow the timings, as `name=value`.
+ *************************************************************************************************/
+inline void
+suite::write_table(std::ostream& os_) const
+{
+    os_ << std::left << std::setw(48) << "benchmark" << std::right << std::setw(14) << "median"
+        << std::setw(14) << "p90" << std::setw(14) << "p99" << std::setw(14) << "min"
+        << std::setw(14) << "max" << std::setw(10) << "stddev%" << '\n';
+
+    os_ << std::fixed << std::setprecision(1);
+    for(const result& res : m_results)
+    {
+        const statistics& stats = res.m_statistics;
+        const double      spread =
+          stats.m_mean == 0.0 ? 0.0 : 100.0 * stats.m_stddev / stats.m_mean;
+
+        os_ << std::left << std::setw(48) << res.m_name << std::right << std::setw(14)
+            << stats.m_median << std::setw(14) << stats.m_p90 << std::setw(14) << stats.m_p99
+            << std::setw(14) << stats.m_min << std::setw(14) << stats.m_max << std::setw(10)
+            << spread;
+        for(const counter& count : res.m_counters)
+        {
+            os_ << "  " << count.m_name << '=' << std::setprecision(0) << count.m_value
+                << std::setprecision(1);
+        }
+        os_ << '\n';
+    }
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Write the results as CSV, one line per benchmark. Times are in nanoseconds.
+ *              Counters are gathered in the last column, as `name=value` pairs separated by `;`.
+ *************************************************************************************************/
+inline void
+suite::write_csv(std::ostream& os_) const
+{
+    os_ << "name,iterations,repetitions,min_ns,median_ns,p90_ns,p99_ns,max_ns,mean_ns,stddev_ns,"
+           "counters\n";
+    os_ << std::fixed << std::setprecision(3);
+    for(const result& res : m_results)
+    {
+        const statistics& stats = res.m_statistics;
+        os_ << '"' << res.m_name << "\"," << res.m_iterations << ',' << res.m_repetitions << ','
+            << stats.m_min << ',' << stats.m_median << ',' << stats.m_p90 << ',' << stats.m_p99
+            << ',' << stats.m_max << ',' << stats.m_mean << ',' << stats.m_stddev << ",\"";
+        for(std::size_t i = 0; i < res.m_counters.size(); i++)
+        {
+            os_ << (i == 0 ? "" : ";") << res.m_counters[i].m_name << '='
+                << res.m_counters[i].m_value;
+        }
+        os_ << "\"\n";
+    }
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Write the results as a JSON document. Times are in nanoseconds.
+ *************************************************************************************************/
+inline void
+suite::write_json(std::ostream& os_) const
+{
+    os_ << "{\n  \"benchmarks\": [";
+    os_ << std::fixed << std::setprecision(3);
+    for(std::size_t i = 0; i < m_results.size(); i++)
+    {
+        const result&     res   = m_results[i];
+        const statistics& stats = res.m_statistics;
+
+        os_ << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << res.m_name
+            << "\", \"iterations\": " << res.m_iterations
+            << ", \"repetitions\": " << res.m_repetitions << ", \"min_ns\": " << stats.m_min
+            << ", \"median_ns\": " << stats.m_median << ", \"p90_ns\": " << stats.m_p90
+            << ", \"p99_ns\": " << stats.m_p99 << ", \"max_ns\": " << stats.m_max
+            << ", \"mean_ns\": " << stats.m_mean << ", \"stddev_ns\": " << stats.m_stddev
+            << ", \"counters\": {";
+        for(std::size_t j = 0; j < res.m_counters.size(); j++)
+        {
+            os_ << (j == 0 ? "\"" : ", \"") << res.m_counters[j].m_name
+                << "\": " << res.m_counters[j].m_value;
+        }
+        os_ << "}}";
+    }
+    os_ << "\n  ]\n}\n";
+}
+
+}        // namespace pel::bench
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,272 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./feature_bench.hpp"
+#include "../src/chunked_vector.hpp"
+#include "../src/concurrent_vector.hpp"
+#include "../src/simd.hpp"
+#include "../src/soa_vector.hpp"
+#include "../src/vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+/*------------------------------------*/
+/* Concurrent vectors */
+
+/**
+ * \brief   Runs `threads_` threads each calling `function_` with their thread number, and waits for
+ *          all of them to finish.
+ */
+template<typename Function>
+void
+runThreads(std::uint32_t threads_, const Function& function_)
+{
+    std::vector<std::thread> workers;
+    workers.reserve(threads_);
+    for(std::uint32_t t = 0; t < threads_; t++)
+    {
+        workers.emplace_back(function_, t);
+    }
+    for(std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void
+addConcurrentBenchmarks(pel::bench::suite& suite_)
+{
+    constexpr std::size_t length = 100'000;
+
+    for(const std::uint32_t threads : {1U, 2U, 4U, 8U, 16U, 32U, 64U})
+    {
+        const std::size_t perThread = length / threads;
+        const std::string suffix =
+          "/int/" + std::to_string(length) + '/' + std::to_string(threads) + "_threads/";
+
+        suite_.add("parallel_append" + suffix + "mutex+pel::vector",
+                   [=]
+                   {
+                       pel::vector<int, std::allocator<int>> vec;
+                       std::mutex                            mutex;
+                       runThreads(threads,
+                                  [&](std::uint32_t thread_)
+                                  {
+                                      for(std::size_t i = 0; i < perThread; i++)
+                                      {
+                                          const std::lock_guard lock{mutex};
+                                          vec.push_back(static_cast<int>(thread_));
+                                      }
+                                  });
+                       pel::bench::do_not_optimize(vec.data());
+                   });
+
+        suite_.add("parallel_append" + suffix + "pel::concurrent_vector",
+                   [=]
+                   {
+                       pel::concurrent_vector<int> vec;
+                       runThreads(threads,
+                                  [&](std::uint32_t thread_)
+                                  {
+                                      for(std::size_t i = 0; i < perThread; i++)
+                                      {
+                                          vec.push_back(static_cast<int>(thread_));
+                                      }
+                                  });
+                       pel::bench::do_not_optimize(vec.length());
+                   });
+    }
+}
+
+
+/*------------------------------------*/
+/* Chunked vectors */
+
+struct LogEvent
+{
+    std::uint64_t timestamp;
+    std::uint32_t source;
+    std::uint32_t payload;
+
+    friend std::ostream& operator<<(std::ostream& os_, const LogEvent& event_)
+    {
+        return os_ << event_.timestamp << ':' << event_.source << ':' << event_.payload;
+    }
+};
+
+template<typename VectorType>
+void
+addEventLogBenchmarks(pel::bench::suite& suite_, const std::string& container_)
+{
+    constexpr std::size_t length = 1'000'000;
+    const std::string     suffix = "/log_event/" + std::to_string(length) + '/' + container_;
+
+    auto fill = [](VectorType& log_)
+    {
+        for(std::size_t i = 0; i < length; i++)
+        {
+            log_.push_back(
+              LogEvent{i, static_cast<std::uint32_t>(i % 64), static_cast<std::uint32_t>(i)});
+        }
+    };
+
+    suite_.add("append" + suffix,
+               [fill]
+               {
+                   VectorType log;
+                   fill(log);
+                   pel::bench::do_not_optimize(log.length());
+               });
+
+    const auto log = std::make_shared<VectorType>();
+    fill(*log);
+
+    suite_.add("indexed_read" + suffix,
+               [log]
+               {
+                   std::uint64_t checksum = 0;
+                   for(std::size_t i = 0; i < log->length(); i++)
+                   {
+                       checksum += (*log)[i].payload;
+                   }
+                   pel::bench::do_not_optimize(checksum);
+               });
+}
+
+
+/*------------------------------------*/
+/* Structures of arrays */
+
+struct Particle
+{
+    float         x, y, z;
+    float         vx, vy, vz;
+    float         mass;
+    std::uint32_t id;
+
+    friend std::ostream& operator<<(std::ostream& os_, const Particle& particle_)
+    {
+        return os_ << particle_.id << '@' << particle_.x << ',' << particle_.y << ','
+                   << particle_.z;
+    }
+};
+
+using ParticleColumns =
+  pel::soa_vector<float, float, float, float, float, float, float, std::uint32_t>;
+
+void
+addSoaBenchmarks(pel::bench::suite& suite_)
+{
+    constexpr std::size_t length = 1'000'000;
+    constexpr float       dt     = 0.01f;
+    const std::string     suffix = "/particle/" + std::to_string(length) + '/';
+
+    const auto aos = std::make_shared<pel::vector<Particle, std::allocator<Particle>>>();
+    const auto soa = std::make_shared<ParticleColumns>();
+    aos->resize(length);
+    soa->reserve(length);
+    for(std::size_t i = 0; i < length; i++)
+    {
+        const float         value = static_cast<float>(i % 1024);
+        const std::uint32_t id    = static_cast<std::uint32_t>(i);
+        (*aos)[i] = Particle{value, value, value, 1.0f, 1.0f, 1.0f, 1.0f, id};
+        soa->emplace_back(value, value, value, 1.0f, 1.0f, 1.0f, 1.0f, id);
+    }
+
+    suite_.add("sum_x" + suffix + "aos",
+               [aos]
+               {
+                   float total = 0;
+                   for(const Particle& particle : *aos)
+                   {
+                       total += particle.x;
+                   }
+                   pel::bench::do_not_optimize(total);
+               });
+    suite_.add("sum_x" + suffix + "soa",
+               [soa]
+               {
+                   float total = 0;
+                   for(const float x : soa->column<0>())
+                   {
+                       total += x;
+                   }
+                   pel::bench::do_not_optimize(total);
+               });
+    suite_.add("sum_x" + suffix + "soa+pel::simd",
+               [soa]
+               {
+                   const auto x = soa->column<0>();
+                   pel::bench::do_not_optimize(pel::simd::sum(x.data(), x.data() + x.size()));
+               });
+
+    suite_.add("integrate_x" + suffix + "aos",
+               [aos]
+               {
+                   for(Particle& particle : *aos)
+                   {
+                       particle.x += particle.vx * dt;
+                   }
+                   pel::bench::clobber_memory();
+               });
+    suite_.add("integrate_x" + suffix + "soa",
+               [soa]
+               {
+                   float*       x  = soa->data<0>();
+                   const float* vx = soa->data<3>();
+                   for(std::size_t i = 0; i < soa->length(); i++)
+                   {
+                       x[i] += vx[i] * dt;
+                   }
+                   pel::bench::clobber_memory();
+               });
+}
+
+}        // namespace
+
+
+void
+addContainerBenchmarks(pel::bench::suite& suite_)
+{
+    addConcurrentBenchmarks(suite_);
+    addEventLogBenchmarks<pel::vector<LogEvent>>(suite_, "pel::vector");
+    addEventLogBenchmarks<pel::chunked_vector<LogEvent>>(suite_, "pel::chunked_vector");
+    addSoaBenchmarks(suite_);
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
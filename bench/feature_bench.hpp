@@ -0,0 +1,51 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./benchmark.hpp"
+
+
+/*************************************************************************************************/
+/* Feature benchmarks -------------------------------------------------------------------------- */
+/* Each function registers the benchmarks of one family of features in the suite. They are
+ * defined in the bench/ source file of the same name. */
+
+/** Growth policies, instrumentation, small_vector, generator constructors and uninitialized
+ *  resizes. */
+void addGrowthBenchmarks(pel::bench::suite& suite);
+
+/** Aligned storage, huge pages, arenas and the buffer cache. */
+void addAllocatorBenchmarks(pel::bench::suite& suite);
+
+/** SIMD kernels, expression templates and formatting. */
+void addAlgorithmBenchmarks(pel::bench::suite& suite);
+
+/** concurrent_vector, chunked_vector and soa_vector. */
+void addContainerBenchmarks(pel::bench::suite& suite);
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
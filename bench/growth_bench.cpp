@@ -0,0 +1,286 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./feature_bench.hpp"
+#include "../src/instrumentation_policy.hpp"
+#include "../src/small_vector.hpp"
+#include "../src/vector.hpp"
+#include "../src/vector_parallel.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+/*------------------------------------*/
+/* Growth policies */
+
+template<typename VectorType>
+void
+addAppendBenchmark(pel::bench::suite& suite_, const std::string& container_, std::size_t length_)
+{
+    suite_.add("append/int/" + std::to_string(length_) + '/' + container_,
+               [=]
+               {
+                   VectorType vec;
+                   for(std::size_t i = 0; i < length_; i++)
+                   {
+                       vec.push_back(static_cast<int>(i));
+                   }
+                   pel::bench::do_not_optimize(vec.data());
+               });
+}
+
+/**
+ * \brief   Counts how many times the capacity of a `std::vector` changes while appending `length_`
+ *          items one at a time.
+ */
+std::size_t
+countReallocations(std::size_t length_)
+{
+    std::vector<int> vec;
+    std::size_t      reallocations = 0;
+    std::size_t      lastCapacity  = vec.capacity();
+    for(std::size_t i = 0; i < length_; i++)
+    {
+        vec.push_back(static_cast<int>(i));
+        if(vec.capacity() != lastCapacity)
+        {
+            lastCapacity = vec.capacity();
+            reallocations++;
+        }
+    }
+    return reallocations;
+}
+
+/**
+ * \brief   Counts the reallocations a growth policy asks for while appending `length_` items one at
+ *          a time, as recorded by the instrumentation policy.
+ */
+template<typename GrowthPolicy>
+std::size_t
+countReallocations(std::size_t length_)
+{
+    pel::vector<int, std::allocator<int>, GrowthPolicy, pel::allocation_tracker<>> vec;
+    for(std::size_t i = 0; i < length_; i++)
+    {
+        vec.push_back(static_cast<int>(i));
+    }
+    return vec.instrumentation().statistics().m_growths;
+}
+
+template<typename GrowthPolicy>
+void
+addGrowthPolicyBenchmark(pel::bench::suite& suite_, const std::string& policy_, std::size_t length_)
+{
+    addAppendBenchmark<pel::vector<int, std::allocator<int>, GrowthPolicy>>(
+      suite_, "pel::vector(" + policy_ + ')', length_);
+    suite_.add_counter("reallocations",
+                       [=]
+                       { return static_cast<double>(countReallocations<GrowthPolicy>(length_)); });
+}
+
+void
+addGrowthPolicyBenchmarks(pel::bench::suite& suite_)
+{
+    for(std::size_t length = 1'000; length <= 100'000'000; length *= 10)
+    {
+        addAppendBenchmark<std::vector<int>>(suite_, "std::vector", length);
+        suite_.add_counter("reallocations",
+                           [=] { return static_cast<double>(countReallocations(length)); });
+
+        addGrowthPolicyBenchmark<pel::growth_1_5x>(suite_, "1.5x", length);
+        addGrowthPolicyBenchmark<pel::growth_2x>(suite_, "2x", length);
+        addGrowthPolicyBenchmark<pel::power_of_two_growth<>>(suite_, "pow2", length);
+
+        /* Exact fit reallocates on every append, which is quadratic */
+        if(length <= 10'000)
+        {
+            addGrowthPolicyBenchmark<pel::exact_fit_growth>(suite_, "exact", length);
+        }
+    }
+}
+
+
+/*------------------------------------*/
+/* Small vectors */
+
+template<typename VectorType>
+void
+addShortLivedBenchmark(pel::bench::suite& suite_,
+                       const std::string& container_,
+                       std::size_t        length_)
+{
+    suite_.add("short_lived/int/" + std::to_string(length_) + '/' + container_,
+               [=]
+               {
+                   VectorType vec;
+                   for(std::size_t i = 0; i < length_; i++)
+                   {
+                       vec.push_back(static_cast<int>(i));
+                   }
+                   pel::bench::do_not_optimize(vec.data());
+               });
+}
+
+void
+addSmallVectorBenchmarks(pel::bench::suite& suite_)
+{
+    for(const std::size_t length :
+        {std::size_t{0}, std::size_t{1}, std::size_t{4}, std::size_t{16}, std::size_t{64}})
+    {
+        addShortLivedBenchmark<pel::vector<int>>(suite_, "pel::vector", length);
+        addShortLivedBenchmark<pel::small_vector<int, 16>>(suite_, "pel::small_vector<16>", length);
+    }
+}
+
+
+/*------------------------------------*/
+/* Generator constructors */
+
+void
+addGeneratorBenchmarks(pel::bench::suite& suite_)
+{
+    constexpr std::size_t length = 1'000'000;
+    const std::string     suffix = "/int/" + std::to_string(length) + '/';
+
+    suite_.add("generate" + suffix + "std::function",
+               []
+               {
+                   /* Type-erased generator, like the former std::function overload */
+                   int                            counter   = 0;
+                   const std::function<int(void)> generator = [&counter]() { return counter++; };
+                   const pel::vector<int>         vec(length, generator);
+                   pel::bench::do_not_optimize(vec.data());
+               });
+
+    suite_.add("generate" + suffix + "lambda",
+               []
+               {
+                   int                    counter = 0;
+                   const pel::vector<int> vec(length, [&counter]() { return counter++; });
+                   pel::bench::do_not_optimize(vec.data());
+               });
+
+    suite_.add("generate" + suffix + "indexed",
+               []
+               {
+                   const pel::vector<int> vec(
+                     length, [](std::size_t index_) { return static_cast<int>(index_ * 3); });
+                   pel::bench::do_not_optimize(vec.data());
+               });
+
+    suite_.add("generate" + suffix + "parallel",
+               []
+               {
+                   const pel::vector<int> vec(pel::parallel,
+                                              length,
+                                              [](std::size_t index_)
+                                              { return static_cast<int>(index_ * 3); });
+                   pel::bench::do_not_optimize(vec.data());
+               });
+}
+
+
+/*------------------------------------*/
+/* Uninitialized resizes */
+
+/**
+ * \brief   Stands in for a `read` from a file or a socket, writing every byte it is given.
+ */
+std::size_t
+receiveInto(char* buffer_, std::size_t size_)
+{
+    std::fill_n(buffer_, size_, 'x');
+    return size_;
+}
+
+void
+addResizeBenchmarks(pel::bench::suite& suite_)
+{
+    constexpr std::size_t bytes  = 16 * 1024 * 1024;
+    const std::string     suffix = "/char/" + std::to_string(bytes) + '/';
+
+    suite_.add("receive" + suffix + "resize",
+               []
+               {
+                   pel::vector<char> buffer;
+                   buffer.resize(bytes);
+                   receiveInto(buffer.data(), buffer.length());
+                   pel::bench::do_not_optimize(buffer.data());
+               });
+
+    suite_.add("receive" + suffix + "resize_for_overwrite",
+               []
+               {
+                   pel::vector<char> buffer;
+                   buffer.resize_for_overwrite(bytes, receiveInto);
+                   pel::bench::do_not_optimize(buffer.data());
+               });
+}
+
+
+/*------------------------------------*/
+/* Instrumentation */
+
+void
+addInstrumentationBenchmarks(pel::bench::suite& suite_)
+{
+    using TrackedVector =
+      pel::vector<int,
+                  std::allocator<int>,
+                  pel::default_growth_policy,
+                  pel::allocation_tracker<pel::instrumentation_scope::by_type>>;
+
+    for(const std::size_t length : {std::size_t{1'000}, std::size_t{1'000'000}})
+    {
+        addAppendBenchmark<pel::vector<int, std::allocator<int>>>(
+          suite_, "pel::vector(no_instrumentation)", length);
+        addAppendBenchmark<TrackedVector>(suite_, "pel::vector(allocation_tracker)", length);
+    }
+}
+
+}        // namespace
+
+
+void
+addGrowthBenchmarks(pel::bench::suite& suite_)
+{
+    addGrowthPolicyBenchmarks(suite_);
+    addInstrumentationBenchmarks(suite_);
+    addSmallVectorBenchmarks(suite_);
+    addGeneratorBenchmarks(suite_);
+    addResizeBenchmarks(suite_);
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
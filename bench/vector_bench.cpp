@@ -0,0 +1,514 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./benchmark.hpp"
+#include "./feature_bench.hpp"
+#include "../src/vector.hpp"
+
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+/*------------------------------------*/
+/* Element types */
+
+/** Trivially copyable element spanning a whole cache line. */
+struct Payload64
+{
+    std::array<std::uint64_t, 8> words;
+
+    friend std::ostream& operator<<(std::ostream& os_, const Payload64& payload_)
+    {
+        return os_ << payload_.words[0];
+    }
+};
+
+template<typename ItemType>
+ItemType
+makeValue(std::size_t index_)
+{
+    if constexpr(std::is_same_v<ItemType, Payload64>)
+    {
+        return Payload64{{index_, index_, index_, index_, index_, index_, index_, index_}};
+    }
+    else if constexpr(std::is_same_v<ItemType, std::string>)
+    {
+        /* Long enough to never fit in the small string buffer */
+        return "element #" + std::to_string(index_) + " of a benchmark vector";
+    }
+    else
+    {
+        return static_cast<ItemType>(index_);
+    }
+}
+
+template<typename ItemType>
+std::uint64_t
+checksumOf(const ItemType& item_)
+{
+    if constexpr(std::is_same_v<ItemType, Payload64>)
+    {
+        return item_.words[0];
+    }
+    else if constexpr(std::is_same_v<ItemType, std::string>)
+    {
+        return item_.size();
+    }
+    else
+    {
+        return static_cast<std::uint64_t>(item_);
+    }
+}
+
+
+/*------------------------------------*/
+/* Container adapters */
+
+template<typename VectorType>
+std::size_t
+lengthOf(const VectorType& vec_)
+{
+    if constexpr(requires { vec_.length(); })
+    {
+        return vec_.length();
+    }
+    else
+    {
+        return vec_.size();
+    }
+}
+
+template<typename VectorType, typename ItemType>
+void
+insertAt(VectorType& vec_, std::size_t offset_, const ItemType& value_)
+{
+    if constexpr(requires { vec_.insert(value_, std::ptrdiff_t{}); })
+    {
+        vec_.insert(value_, static_cast<std::ptrdiff_t>(offset_));
+    }
+    else
+    {
+        vec_.insert(vec_.begin() + static_cast<std::ptrdiff_t>(offset_), value_);
+    }
+}
+
+template<typename VectorType>
+void
+appendTo(VectorType& vec_, const VectorType& source_)
+{
+    if constexpr(requires { vec_.push_back(source_); })
+    {
+        vec_.push_back(source_);
+    }
+    else
+    {
+        vec_.insert(vec_.end(), source_.begin(), source_.end());
+    }
+}
+
+template<typename VectorType>
+void
+unorderedEraseFront(VectorType& vec_)
+{
+    if constexpr(requires { vec_.unordered_erase(vec_.begin()); })
+    {
+        vec_.unordered_erase(vec_.begin());
+    }
+    else
+    {
+        std::swap(vec_.front(), vec_.back());
+        vec_.pop_back();
+    }
+}
+
+
+/*------------------------------------*/
+/* Benchmarks */
+
+/** Insertions in the middle are quadratic, so they are only measured on small vectors. */
+constexpr std::size_t maxInsertLength = 1'000;
+
+template<typename VectorType>
+void
+addVectorBenchmarks(pel::bench::suite& suite_, const std::string& suffix_, std::size_t length_)
+{
+    using ItemType = std::remove_cvref_t<decltype(*std::declval<VectorType&>().data())>;
+
+    const ItemType value = makeValue<ItemType>(42);
+
+    std::vector<ItemType> values;
+    for(std::size_t i = 0; i < length_; i++)
+    {
+        values.push_back(makeValue<ItemType>(i));
+    }
+
+    suite_.add("construct/" + suffix_,
+               [=]
+               {
+                   VectorType vec(length_, value);
+                   pel::bench::do_not_optimize(vec.data());
+               });
+
+    suite_.add("reserve/" + suffix_,
+               [=]
+               {
+                   VectorType vec;
+                   vec.reserve(length_);
+                   pel::bench::do_not_optimize(vec.data());
+               });
+
+    suite_.add("push_back/" + suffix_,
+               [=]
+               {
+                   VectorType vec;
+                   for(const ItemType& item : values)
+                   {
+                       vec.push_back(item);
+                   }
+                   pel::bench::do_not_optimize(vec.data());
+               });
+
+    if(length_ <= maxInsertLength)
+    {
+        suite_.add("insert_middle/" + suffix_,
+                   [=]
+                   {
+                       VectorType vec;
+                       vec.reserve(length_);
+                       for(const ItemType& item : values)
+                       {
+                           insertAt(vec, lengthOf(vec) / 2, item);
+                       }
+                       pel::bench::do_not_optimize(vec.data());
+                   });
+
+        suite_.add("insert_middle_grow/" + suffix_,
+                   [=]
+                   {
+                       VectorType vec;
+                       for(const ItemType& item : values)
+                       {
+                           insertAt(vec, lengthOf(vec) / 2, item);
+                       }
+                       pel::bench::do_not_optimize(vec.data());
+                   });
+    }
+
+    /* The erasures work on a fresh copy of the elements, see the copy rows for its cost */
+    const auto distinct = std::make_shared<VectorType>();
+    for(const ItemType& item : values)
+    {
+        distinct->push_back(item);
+    }
+
+    suite_.add("erase_if/" + suffix_,
+               [distinct]
+               {
+                   VectorType vec{*distinct};
+                   erase_if(vec,
+                            [position = 0U](const ItemType&) mutable
+                            { return position++ % 10 == 0; });
+                   pel::bench::do_not_optimize(vec.data());
+               });
+
+    if(length_ <= maxInsertLength)
+    {
+        suite_.add("erase_front/" + suffix_,
+                   [distinct]
+                   {
+                       VectorType vec{*distinct};
+                       while(lengthOf(vec) != 0)
+                       {
+                           vec.erase(vec.begin());
+                       }
+                       pel::bench::do_not_optimize(vec.data());
+                   });
+
+        suite_.add("unordered_erase_front/" + suffix_,
+                   [distinct]
+                   {
+                       VectorType vec{*distinct};
+                       while(lengthOf(vec) != 0)
+                       {
+                           unorderedEraseFront(vec);
+                       }
+                       pel::bench::do_not_optimize(vec.data());
+                   });
+    }
+
+    suite_.add("copy/" + suffix_,
+               [source = VectorType(length_, value)]
+               {
+                   VectorType copy{source};
+                   pel::bench::do_not_optimize(copy.data());
+               });
+
+    suite_.add("copy_assign/" + suffix_,
+               [source = VectorType(length_, value), assigned = VectorType{}]() mutable
+               {
+                   assigned = source;
+                   pel::bench::do_not_optimize(assigned.data());
+               });
+
+    suite_.add("move/" + suffix_,
+               [source = VectorType(length_, value)]() mutable
+               {
+                   VectorType moved{std::move(source)};
+                   source = std::move(moved);
+                   pel::bench::do_not_optimize(source.data());
+               });
+
+    suite_.add("iterate/" + suffix_,
+               [source = VectorType(length_, value)]
+               {
+                   std::uint64_t checksum = 0;
+                   for(const ItemType& item : source)
+                   {
+                       checksum += checksumOf(item);
+                   }
+                   pel::bench::do_not_optimize(checksum);
+               });
+}
+
+/** Appends strings by copy, from a temporary and in place, then appends a whole vector. */
+template<typename VectorType>
+void
+addStringBenchmarks(pel::bench::suite& suite_, const std::string& suffix_, std::size_t length_)
+{
+    /* Long enough to never fit in the small string buffer */
+    const std::string value(64, 'x');
+
+    suite_.add("push_back_copy/" + suffix_,
+               [=]
+               {
+                   VectorType vec;
+                   for(std::size_t i = 0; i < length_; i++)
+                   {
+                       vec.push_back(value);
+                   }
+                   pel::bench::do_not_optimize(vec.data());
+               });
+
+    suite_.add("push_back_move/" + suffix_,
+               [=]
+               {
+                   VectorType vec;
+                   for(std::size_t i = 0; i < length_; i++)
+                   {
+                       vec.push_back(std::string(64, 'x'));
+                   }
+                   pel::bench::do_not_optimize(vec.data());
+               });
+
+    suite_.add("emplace_back/" + suffix_,
+               [=]
+               {
+                   VectorType vec;
+                   for(std::size_t i = 0; i < length_; i++)
+                   {
+                       vec.emplace_back(64, 'x');
+                   }
+                   pel::bench::do_not_optimize(vec.data());
+               });
+
+    suite_.add("append_copy/" + suffix_,
+               [source = VectorType(length_, value)]
+               {
+                   VectorType vec(1, source.data()[0]);
+                   appendTo(vec, source);
+                   pel::bench::do_not_optimize(vec.data());
+               });
+}
+
+template<typename ItemType>
+void
+addTypeBenchmarks(pel::bench::suite& suite_, const std::string& typeName_)
+{
+    for(const std::size_t length : {std::size_t{16}, std::size_t{1'000}, std::size_t{100'000}})
+    {
+        const std::string suffix = typeName_ + '/' + std::to_string(length);
+
+        /* Lower bound of the copy rows */
+        if constexpr(std::is_trivially_copyable_v<ItemType>)
+        {
+            suite_.add("copy/" + suffix + "/memcpy",
+                       [source = std::vector<ItemType>(length), length]
+                       {
+                           const auto copy = std::make_unique_for_overwrite<ItemType[]>(length);
+                           std::memcpy(copy.get(), source.data(), length * sizeof(ItemType));
+                           pel::bench::do_not_optimize(copy.get());
+                       });
+        }
+        addVectorBenchmarks<std::vector<ItemType>>(suite_, suffix + "/std::vector", length);
+        addVectorBenchmarks<pel::vector<ItemType>>(suite_, suffix + "/pel::vector", length);
+
+        if constexpr(std::is_same_v<ItemType, std::string>)
+        {
+            addStringBenchmarks<std::vector<ItemType>>(suite_, suffix + "/std::vector", length);
+            addStringBenchmarks<pel::vector<ItemType>>(suite_, suffix + "/pel::vector", length);
+        }
+    }
+}
+
+
+/*------------------------------------*/
+/* Command line */
+
+void
+writeUsage(std::ostream& os_)
+{
+    os_ << "Usage: vectors_bench [--filter=<substring>] [--repetitions=<n>] [--warmup=<batches>]"
+           " [--min-time-ms=<ms>] [--csv=<file>] [--json=<file>] [--help]\n"
+           "\n"
+           "  --filter=<substring>  Only run the benchmarks whose name contains <substring>\n"
+           "  --repetitions=<n>     Number of measured batches of each benchmark\n"
+           "  --warmup=<batches>    Number of batches run before measuring\n"
+           "  --min-time-ms=<ms>    Minimum duration of a batch\n"
+           "  --csv=<file>          Also write the results to <file>, as CSV\n"
+           "  --json=<file>         Also write the results to <file>, as JSON\n"
+           "  --help                Print this help and exit\n";
+}
+
+bool
+parseArgument(std::string_view     argument_,
+              pel::bench::options& options_,
+              std::string&         csvPath_,
+              std::string&         jsonPath_)
+{
+    auto valueOf = [&](std::string_view key_, std::string_view& value_)
+    {
+        if(!argument_.starts_with(key_))
+        {
+            return false;
+        }
+        value_ = argument_.substr(key_.size());
+        return true;
+    };
+    auto toNumber = [](std::string_view text_, std::uint32_t& number_)
+    {
+        return std::from_chars(text_.data(), text_.data() + text_.size(), number_).ec
+               == std::errc{};
+    };
+
+    std::string_view value;
+    std::uint32_t    number = 0;
+    if(valueOf("--filter=", value))
+    {
+        options_.m_filter = value;
+    }
+    else if(valueOf("--repetitions=", value) && toNumber(value, number) && number > 0)
+    {
+        options_.m_repetitions = number;
+    }
+    else if(valueOf("--warmup=", value) && toNumber(value, number))
+    {
+        options_.m_warmupBatches = number;
+    }
+    else if(valueOf("--min-time-ms=", value) && toNumber(value, number))
+    {
+        options_.m_minBatchTime = std::chrono::milliseconds{number};
+    }
+    else if(valueOf("--csv=", value))
+    {
+        csvPath_ = value;
+    }
+    else if(valueOf("--json=", value))
+    {
+        jsonPath_ = value;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+}        // namespace
+
+
+int
+main(int argc, char** argv)
+{
+    pel::bench::options options;
+    std::string         csvPath;
+    std::string         jsonPath;
+
+    for(int i = 1; i < argc; i++)
+    {
+        if(std::string_view{argv[i]} == "--help")
+        {
+            writeUsage(std::cout);
+            return 0;
+        }
+        if(!parseArgument(argv[i], options, csvPath, jsonPath))
+        {
+            writeUsage(std::cerr);
+            return 1;
+        }
+    }
+
+    pel::bench::suite suite;
+    addTypeBenchmarks<int>(suite, "int");
+    addTypeBenchmarks<double>(suite, "double");
+    addTypeBenchmarks<Payload64>(suite, "payload64");
+    addTypeBenchmarks<std::string>(suite, "string");
+    addGrowthBenchmarks(suite);
+    addAllocatorBenchmarks(suite);
+    addAlgorithmBenchmarks(suite);
+    addContainerBenchmarks(suite);
+
+    suite.run(options, std::cout);
+    std::cout << '\n';
+    suite.write_table(std::cout);
+
+    if(!csvPath.empty())
+    {
+        std::ofstream csv{csvPath};
+        suite.write_csv(csv);
+    }
+    if(!jsonPath.empty())
+    {
+        std::ofstream json{jsonPath};
+        suite.write_json(json);
+    }
+
+    return 0;
+}
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
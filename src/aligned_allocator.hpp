@@ -0,0 +1,144 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+
+namespace pel
+{
+/** Alignment, in bytes, of the storage of SIMD-ready containers: one cache line, which is also the
+ *  width of an AVX-512 register. */
+inline constexpr std::size_t simd_alignment = 64;
+
+/**
+ **************************************************************************************************
+ * \brief       Allocator returning blocks aligned on `Alignment` bytes.
+ *
+ *              Aligned blocks never straddle more cache lines than necessary, and can be accessed
+ *              with aligned vector loads and stores.
+ *
+ *              This allocator implements the `capacity_granularity` extension (see
+ *              allocator_extensions.hpp): pel::vector rounds its capacity up to a whole number of
+ *              `Alignment`-byte blocks, so that kernels can always process the tail of the
+ *              elements with full-width vector instructions, without leaving the allocation.
+ *
+ * \tparam      ItemType:  Type of the elements to allocate.
+ * \tparam      Alignment: Alignment in bytes of the allocated blocks.
+ *              [defaults : simd_alignment]
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Alignment = simd_alignment>
+class aligned_allocator
+{
+    static_assert(std::has_single_bit(Alignment), "Alignment must be a power of two");
+    static_assert(Alignment >= alignof(ItemType), "Alignment cannot be weaker than the type's");
+
+public:
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+    using value_type                             = ItemType;
+    using size_type                              = std::size_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal                        = std::true_type;
+
+    template<typename OtherType>
+    struct rebind
+    {
+        using other = aligned_allocator<OtherType, Alignment>;
+    };
+
+    static constexpr std::size_t alignment = Alignment;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+    aligned_allocator() noexcept = default;
+
+    template<typename OtherType>
+    aligned_allocator(const aligned_allocator<OtherType, Alignment>& /*other_*/) noexcept
+    {
+    }
+
+
+    /*********************************************************************************************/
+    /* Allocation ------------------------------------------------------------------------------ */
+    [[nodiscard]] ItemType*
+    allocate(size_type count_)
+    {
+        if(count_ > std::numeric_limits<size_type>::max() / sizeof(ItemType))
+        {
+            throw std::bad_array_new_length();
+        }
+
+        return static_cast<ItemType*>(
+          ::operator new(count_ * sizeof(ItemType), std::align_val_t{Alignment}));
+    }
+
+    void
+    deallocate(ItemType* ptr_, size_type count_) noexcept
+    {
+        ::operator delete(ptr_, count_ * sizeof(ItemType), std::align_val_t{Alignment});
+    }
+
+
+    /*********************************************************************************************/
+    /* Allocator extensions -------------------------------------------------------------------- */
+
+    /** Number of elements filling a whole `Alignment`-byte block, when they can. */
+    static constexpr size_type capacity_granularity =
+      Alignment % sizeof(ItemType) == 0 ? Alignment / sizeof(ItemType) : 1;
+};
+
+template<typename ItemType, typename OtherType, std::size_t Alignment>
+constexpr bool
+operator==(const aligned_allocator<ItemType, Alignment>& /*lhs_*/,
+           const aligned_allocator<OtherType, Alignment>& /*rhs_*/) noexcept
+{
+    return true;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Allocator used by default by pel::vector.
+ *              Arithmetic types, which are handled by the pel::simd kernels, get storage aligned
+ *              on `simd_alignment` bytes. Other types use `std::allocator`.
+ *************************************************************************************************/
+template<typename ItemType>
+using default_allocator_t =
+  std::conditional_t<std::is_arithmetic_v<ItemType> && !std::is_same_v<ItemType, bool>,
+                     aligned_allocator<ItemType>,
+                     std::allocator<ItemType>>;
+
+}        // namespace pel
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
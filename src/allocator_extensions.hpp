@@ -0,0 +1,117 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <concepts>
+#include <cstddef>
+
+
+namespace pel
+{
+/**
+ **************************************************************************************************
+ * \brief       Optional allocator extension: grow or shrink a block without moving it.
+ *
+ *              `bool expand_in_place(ItemType* ptr, size_t oldCount, size_t newCount)`
+ *              returns true if the block now holds `newCount` elements at the same address.
+ *              Since no element is moved, this is usable for every element type.
+ *************************************************************************************************/
+template<typename AllocatorType>
+concept allocator_can_expand_in_place =
+  requires(AllocatorType& alloc_, typename AllocatorType::value_type* ptr_, std::size_t count_)
+{
+    {
+        alloc_.expand_in_place(ptr_, count_, count_)
+        } -> std::same_as<bool>;
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Optional allocator extension: resize a block, moving it if necessary.
+ *
+ *              `ItemType* reallocate(ItemType* ptr, size_t oldCount, size_t newCount)`
+ *              behaves like `std::realloc`: the content of the block is moved bitwise to the
+ *              returned address, which may be `ptr` itself. On failure, it throws and `ptr` is left
+ *              untouched.
+ *              Since elements are moved bitwise, this is only used for trivially relocatable types.
+ *************************************************************************************************/
+template<typename AllocatorType>
+concept allocator_can_reallocate =
+  requires(AllocatorType& alloc_, typename AllocatorType::value_type* ptr_, std::size_t count_)
+{
+    {
+        alloc_.reallocate(ptr_, count_, count_)
+        } -> std::same_as<typename AllocatorType::value_type*>;
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Optional allocator extension: allocate whole multiples of a number of elements.
+ *
+ *              `static constexpr std::size_t capacity_granularity`
+ *              is the number of elements by which capacities are rounded up, for instance so that
+ *              a block always holds whole SIMD registers. The extra elements are left unconstructed.
+ *************************************************************************************************/
+template<typename AllocatorType>
+concept allocator_has_capacity_granularity = requires
+{
+    {
+        AllocatorType::capacity_granularity
+        } -> std::convertible_to<std::size_t>;
+    requires AllocatorType::capacity_granularity > 0;
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Traits grouping the optional allocator extensions understood by the pel
+ *              containers, on top of std::allocator_traits.
+ *************************************************************************************************/
+template<typename AllocatorType>
+struct allocator_extension_traits
+{
+    static constexpr bool can_expand_in_place = allocator_can_expand_in_place<AllocatorType>;
+    static constexpr bool can_reallocate      = allocator_can_reallocate<AllocatorType>;
+
+    static constexpr std::size_t capacity_granularity = []
+    {
+        if constexpr(allocator_has_capacity_granularity<AllocatorType>)
+        {
+            return static_cast<std::size_t>(AllocatorType::capacity_granularity);
+        }
+        else
+        {
+            return std::size_t{1};
+        }
+    }();
+};
+
+}        // namespace pel
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,339 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+
+namespace pel
+{
+/**
+ **************************************************************************************************
+ * \brief       Monotonic memory resource for short-lived containers, such as the vectors built
+ *              while handling a single request.
+ *
+ *              Memory is handed out by bumping a pointer, first in an optional initial buffer
+ *              (e.g. an array on the stack), then in blocks obtained from an upstream resource.
+ *              Deallocating does nothing; everything is released at once by \ref reset(), in
+ *              O(1), which keeps the upstream blocks for the next request.
+ *
+ *              The most recent allocation can be grown or shrunk in place with \ref extend(),
+ *              which is what lets a pel::vector backed by an `arena_allocator` grow without
+ *              copying its elements.
+ *
+ * \note        Not thread-safe: an arena is meant to be owned by the thread handling a request.
+ *************************************************************************************************/
+class arena final : public std::pmr::memory_resource
+{
+public:
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+    explicit arena(std::size_t                blockSize_ = default_block_size,
+                   std::pmr::memory_resource* upstream_ = std::pmr::get_default_resource()) noexcept
+    : m_upstream{upstream_}, m_nextBlockSize{blockSize_}
+    {
+    }
+
+    arena(void*                      buffer_,
+          std::size_t                size_,
+          std::size_t                blockSize_ = default_block_size,
+          std::pmr::memory_resource* upstream_  = std::pmr::get_default_resource()) noexcept
+    : m_upstream{upstream_},
+      m_initialBegin{static_cast<std::byte*>(buffer_)},
+      m_initialEnd{static_cast<std::byte*>(buffer_) + size_},
+      m_current{m_initialBegin},
+      m_end{m_initialEnd},
+      m_nextBlockSize{blockSize_}
+    {
+    }
+
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    ~arena() override
+    {
+        while(m_blocks != nullptr)
+        {
+            block* next = m_blocks->m_next;
+            m_upstream->deallocate(m_blocks, m_blocks->m_size, alignof(block));
+            m_blocks = next;
+        }
+    }
+
+
+    /*********************************************************************************************/
+    /* Arena management ------------------------------------------------------------------------ */
+
+    /**
+     **********************************************************************************************
+     * \brief   Release every allocation at once, without destroying anything.
+     *          The upstream blocks are kept and reused by the next allocations.
+     *
+     * \note    Containers still using memory from this arena must not be used anymore.
+     **********************************************************************************************/
+    void
+    reset() noexcept
+    {
+        m_block   = nullptr;
+        m_current = m_initialBegin;
+        m_end     = m_initialEnd;
+        m_last    = nullptr;
+    }
+
+    /**
+     **********************************************************************************************
+     * \brief   Resize the most recent allocation without moving it.
+     *
+     * \param   ptr_:      Allocation to resize.
+     * \param   oldBytes_: Current size of the allocation.
+     * \param   newBytes_: Requested size of the allocation.
+     *
+     * \retval  bool: True if the allocation at `ptr_` is now `newBytes_` long.
+     **********************************************************************************************/
+    bool
+    extend(void* ptr_, std::size_t oldBytes_, std::size_t newBytes_) noexcept
+    {
+        auto* first = static_cast<std::byte*>(ptr_);
+        if(first != m_last || first + oldBytes_ != m_current
+           || newBytes_ > static_cast<std::size_t>(m_end - first))
+        {
+            return false;
+        }
+
+        m_current = first + newBytes_;
+        return true;
+    }
+
+
+    /*********************************************************************************************/
+    /* Memory resource ------------------------------------------------------------------------- */
+private:
+    void*
+    do_allocate(std::size_t bytes_, std::size_t alignment_) override
+    {
+        std::byte* first = align(m_current, alignment_);
+        if(first == nullptr || bytes_ > static_cast<std::size_t>(m_end - first))
+        {
+            first = next_block(bytes_, alignment_);
+        }
+
+        m_current = first + bytes_;
+        m_last    = first;
+        return first;
+    }
+
+    void
+    do_deallocate(void* /*ptr_*/, std::size_t /*bytes_*/, std::size_t /*alignment_*/) override
+    {
+        /* Monotonic: memory is only ever released by reset() */
+    }
+
+    [[nodiscard]] bool
+    do_is_equal(const std::pmr::memory_resource& other_) const noexcept override
+    {
+        return this == &other_;
+    }
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+    struct block
+    {
+        block*      m_next;
+        std::size_t m_size;
+    };
+
+    [[nodiscard]] std::byte*
+    align(std::byte* ptr_, std::size_t alignment_) const noexcept
+    {
+        const auto address = reinterpret_cast<std::uintptr_t>(ptr_);
+        const auto aligned = (address + alignment_ - 1) & ~(std::uintptr_t{alignment_} - 1);
+        if(ptr_ == nullptr || aligned > reinterpret_cast<std::uintptr_t>(m_end))
+        {
+            return nullptr;
+        }
+        return ptr_ + (aligned - address);
+    }
+
+    /**
+     **********************************************************************************************
+     * \brief   Move to the next upstream block able to hold `bytes_`, reusing the blocks kept by
+     *          \ref reset() before allocating a new one.
+     *
+     * \retval  std::byte*: Aligned address of `bytes_` free bytes in the new current block.
+     **********************************************************************************************/
+    std::byte*
+    next_block(std::size_t bytes_, std::size_t alignment_)
+    {
+        const std::size_t required = sizeof(block) + bytes_ + alignment_;
+        if(required < bytes_)
+        {
+            throw std::bad_alloc();
+        }
+
+        block* next = (m_block != nullptr) ? m_block->m_next : m_blocks;
+        if(next == nullptr || next->m_size < required)
+        {
+            while(m_nextBlockSize < required)
+            {
+                m_nextBlockSize *= 2;
+            }
+
+            void* memory  = m_upstream->allocate(m_nextBlockSize, alignof(block));
+            auto* created = static_cast<block*>(memory);
+            created->m_next = next;
+            created->m_size = m_nextBlockSize;
+            (m_block != nullptr ? m_block->m_next : m_blocks) = created;
+
+            next = created;
+            m_nextBlockSize *= 2;
+        }
+
+        m_block   = next;
+        m_current = reinterpret_cast<std::byte*>(next) + sizeof(block);
+        m_end     = reinterpret_cast<std::byte*>(next) + next->m_size;
+        return align(m_current, alignment_);
+    }
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+public:
+    static constexpr std::size_t default_block_size = std::size_t{64} * 1024;
+
+private:
+    std::pmr::memory_resource* m_upstream;
+
+    std::byte* m_initialBegin = nullptr;
+    std::byte* m_initialEnd   = nullptr;
+
+    block*     m_blocks  = nullptr;        //!< Every upstream block, in order of use.
+    block*     m_block   = nullptr;        //!< Block being used, nullptr for the initial buffer.
+    std::byte* m_current = nullptr;
+    std::byte* m_end     = nullptr;
+    std::byte* m_last    = nullptr;        //!< Start of the most recent allocation.
+
+    std::size_t m_nextBlockSize;
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Allocator drawing memory from a pel::arena.
+ *
+ *              Since the arena is monotonic, deallocation is a no-op, and the allocator implements
+ *              the `expand_in_place` extension (see allocator_extensions.hpp): a pel::vector that
+ *              owns the most recent allocation of its arena grows by bumping the arena's pointer,
+ *              without moving its elements.
+ *
+ * \tparam      ItemType: Type of the elements to allocate.
+ *************************************************************************************************/
+template<typename ItemType>
+class arena_allocator
+{
+public:
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+    using value_type                             = ItemType;
+    using size_type                              = std::size_t;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type;
+
+    template<typename OtherType>
+    struct rebind
+    {
+        using other = arena_allocator<OtherType>;
+    };
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+    arena_allocator(arena& arena_) noexcept : m_arena{&arena_} {}
+
+    template<typename OtherType>
+    arena_allocator(const arena_allocator<OtherType>& other_) noexcept : m_arena{other_.get_arena()}
+    {
+    }
+
+    [[nodiscard]] arena* get_arena() const noexcept { return m_arena; }
+
+
+    /*********************************************************************************************/
+    /* Allocation ------------------------------------------------------------------------------ */
+    [[nodiscard]] ItemType*
+    allocate(size_type count_)
+    {
+        if(count_ > static_cast<size_type>(-1) / sizeof(ItemType))
+        {
+            throw std::bad_array_new_length();
+        }
+        void* ptr = m_arena->allocate(count_ * sizeof(ItemType), alignof(ItemType));
+        return static_cast<ItemType*>(ptr);
+    }
+
+    void
+    deallocate(ItemType* /*ptr_*/, size_type /*count_*/) noexcept
+    {
+    }
+
+
+    /*********************************************************************************************/
+    /* Allocator extensions -------------------------------------------------------------------- */
+    bool
+    expand_in_place(ItemType* ptr_, size_type oldCount_, size_type newCount_) noexcept
+    {
+        if(newCount_ > static_cast<size_type>(-1) / sizeof(ItemType))
+        {
+            return false;
+        }
+        return m_arena->extend(ptr_, oldCount_ * sizeof(ItemType), newCount_ * sizeof(ItemType));
+    }
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    arena* m_arena;
+};
+
+template<typename ItemType, typename OtherType>
+constexpr bool
+operator==(const arena_allocator<ItemType>&  lhs_,
+           const arena_allocator<OtherType>& rhs_) noexcept
+{
+    return lhs_.get_arena() == rhs_.get_arena();
+}
+
+}        // namespace pel
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
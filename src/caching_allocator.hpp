@@ -0,0 +1,459 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+
+namespace pel
+{
+/**
+ **************************************************************************************************
+ * \brief       Counters of a thread's buffer cache.
+ *************************************************************************************************/
+struct cache_statistics
+{
+    std::uint64_t m_hits        = 0;        //!< Allocations served by the thread's own cache.
+    std::uint64_t m_depotHits   = 0;        //!< Allocations served by the shared depot.
+    std::uint64_t m_misses      = 0;        //!< Allocations that went to operator new.
+    std::uint64_t m_uncached    = 0;        //!< Allocations too big to ever be cached.
+    std::uint64_t m_depotPushes = 0;        //!< Releases sent to the depot, cache being full.
+    std::uint64_t m_frees       = 0;        //!< Releases given back to operator delete.
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Process-wide cache of recently released buffers, bucketed by power-of-two size.
+ *
+ *              Every thread owns a cache of free buffers, one list per size class, that it
+ *              allocates from and releases to without any synchronization. When a thread's cache
+ *              is full, released buffers go to a shared depot (one mutex per size class), which
+ *              is also where a thread looks on a miss before going to operator new. This is the
+ *              path through which buffers released by one thread and allocated by another come
+ *              back into use. A thread's cache is flushed to the depot when the thread exits.
+ *
+ *              The memory held by each thread cache and by the depot is bounded; buffers that do
+ *              not fit are given back to operator delete.
+ *
+ *              The depot is never destroyed, and a thread whose cache was already destroyed goes
+ *              straight to the depot, so containers with static storage duration can still
+ *              release their buffers when destroyed at exit.
+ *************************************************************************************************/
+class buffer_cache
+{
+public:
+    /*********************************************************************************************/
+    /* Limits ---------------------------------------------------------------------------------- */
+    static constexpr std::size_t min_block_size     = 64;
+    static constexpr std::size_t max_block_size     = std::size_t{1} * 1024 * 1024;
+    static constexpr std::size_t thread_cache_limit = std::size_t{8} * 1024 * 1024;
+    static constexpr std::size_t depot_limit        = std::size_t{64} * 1024 * 1024;
+    static constexpr std::size_t block_alignment    = 64;
+
+    static constexpr std::size_t size_classes =
+      std::countr_zero(max_block_size) - std::countr_zero(min_block_size) + 1;
+
+
+    /*********************************************************************************************/
+    /* Allocation ------------------------------------------------------------------------------ */
+    [[nodiscard]] static void*
+    allocate(std::size_t bytes_)
+    {
+        if(bytes_ > max_block_size)
+        {
+            count(&cache_statistics::m_uncached);
+            return ::operator new(bytes_, std::align_val_t{block_alignment});
+        }
+
+        const std::size_t sizeClass = size_class_of(bytes_);
+
+        /* Fast path: the thread's own cache, without any synchronization */
+        if(!t_cacheDestroyed)
+        {
+            if(free_block* block = t_cache.m_lists[sizeClass]; block != nullptr)
+            {
+                t_cache.m_lists[sizeClass] = block->m_next;
+                t_cache.m_bytes -= block_size_of(sizeClass);
+                t_cache.m_statistics.m_hits++;
+                return block;
+            }
+        }
+
+        /* Buffers released by other threads, or by this one when its cache was full */
+        if(void* block = shared_depot().pop(sizeClass); block != nullptr)
+        {
+            count(&cache_statistics::m_depotHits);
+            return block;
+        }
+
+        count(&cache_statistics::m_misses);
+        return ::operator new(block_size_of(sizeClass), std::align_val_t{block_alignment});
+    }
+
+    static void
+    deallocate(void* ptr_, std::size_t bytes_) noexcept
+    {
+        if(ptr_ == nullptr)
+        {
+            return;
+        }
+        if(bytes_ > max_block_size)
+        {
+            ::operator delete(ptr_, std::align_val_t{block_alignment});
+            return;
+        }
+
+        const std::size_t sizeClass = size_class_of(bytes_);
+        const std::size_t blockSize = block_size_of(sizeClass);
+
+        if(!t_cacheDestroyed && t_cache.m_bytes + blockSize <= thread_cache_limit)
+        {
+            t_cache.push(ptr_, sizeClass);
+            return;
+        }
+
+        if(shared_depot().push(ptr_, sizeClass))
+        {
+            count(&cache_statistics::m_depotPushes);
+            return;
+        }
+
+        count(&cache_statistics::m_frees);
+        ::operator delete(ptr_, std::align_val_t{block_alignment});
+    }
+
+    /**
+     **********************************************************************************************
+     * \brief   Check whether a buffer of `oldBytes_` bytes can hold `newBytes_` bytes.
+     *          Cached buffers are always as big as their size class.
+     **********************************************************************************************/
+    [[nodiscard]] static bool
+    fits_in_place(std::size_t oldBytes_, std::size_t newBytes_) noexcept
+    {
+        return oldBytes_ <= max_block_size && newBytes_ <= max_block_size
+               && size_class_of(oldBytes_) == size_class_of(newBytes_);
+    }
+
+
+    /*********************************************************************************************/
+    /* Statistics ------------------------------------------------------------------------------ */
+    /* Once the calling thread's cache is destroyed, its statistics are empty and it holds no
+     * memory; these functions remain callable from later thread_local destructors. */
+    [[nodiscard]] static cache_statistics
+    statistics() noexcept
+    {
+        return t_cacheDestroyed ? cache_statistics{} : t_cache.m_statistics;
+    }
+
+    static void
+    reset_statistics() noexcept
+    {
+        if(!t_cacheDestroyed)
+        {
+            t_cache.m_statistics = {};
+        }
+    }
+
+    /** Give every buffer of the calling thread's cache back to the depot or operator delete. */
+    static void
+    flush_thread_cache() noexcept
+    {
+        if(!t_cacheDestroyed)
+        {
+            t_cache.flush();
+        }
+    }
+
+    /** Memory held by the calling thread's cache, and by the shared depot, in bytes. */
+    [[nodiscard]] static std::size_t
+    thread_cache_bytes() noexcept
+    {
+        return t_cacheDestroyed ? 0 : t_cache.m_bytes;
+    }
+    [[nodiscard]] static std::size_t depot_bytes() noexcept { return shared_depot().bytes(); }
+
+
+    /*********************************************************************************************/
+    /* Private types and methods --------------------------------------------------------------- */
+private:
+    struct free_block
+    {
+        free_block* m_next;
+    };
+
+    [[nodiscard]] static std::size_t
+    size_class_of(std::size_t bytes_) noexcept
+    {
+        const std::size_t blockSize = bytes_ <= min_block_size ? min_block_size
+                                                               : std::bit_ceil(bytes_);
+        return static_cast<std::size_t>(std::countr_zero(blockSize)
+                                         - std::countr_zero(min_block_size));
+    }
+
+    [[nodiscard]] static constexpr std::size_t
+    block_size_of(std::size_t sizeClass_) noexcept
+    {
+        return min_block_size << sizeClass_;
+    }
+
+    /**
+     **********************************************************************************************
+     * \brief   Free buffers shared by every thread.
+     **********************************************************************************************/
+    class depot
+    {
+    public:
+        depot() = default;
+        depot(const depot&) = delete;
+        depot& operator=(const depot&) = delete;
+
+        [[nodiscard]] void*
+        pop(std::size_t sizeClass_) noexcept
+        {
+            const std::lock_guard lock{m_mutexes[sizeClass_]};
+
+            free_block* block = m_lists[sizeClass_];
+            if(block != nullptr)
+            {
+                m_lists[sizeClass_] = block->m_next;
+                m_bytes.fetch_sub(block_size_of(sizeClass_), std::memory_order_relaxed);
+            }
+            return block;
+        }
+
+        /**
+         ******************************************************************************************
+         * \brief   Keep a buffer, unless the depot would then hold more than `depot_limit`.
+         *          The mutexes only protect one size class each, so the bytes are reserved
+         *          with a compare-and-swap first: the limit then holds across every class.
+         ******************************************************************************************/
+        [[nodiscard]] bool
+        push(void* ptr_, std::size_t sizeClass_) noexcept
+        {
+            const std::size_t blockSize = block_size_of(sizeClass_);
+
+            std::size_t bytes = m_bytes.load(std::memory_order_relaxed);
+            do
+            {
+                if(bytes + blockSize > depot_limit)
+                {
+                    return false;
+                }
+            } while(!m_bytes.compare_exchange_weak(bytes, bytes + blockSize,
+                                                   std::memory_order_relaxed));
+
+            const std::lock_guard lock{m_mutexes[sizeClass_]};
+
+            auto* block         = static_cast<free_block*>(ptr_);
+            block->m_next       = m_lists[sizeClass_];
+            m_lists[sizeClass_] = block;
+            return true;
+        }
+
+        [[nodiscard]] std::size_t
+        bytes() const noexcept
+        {
+            return m_bytes.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::array<std::mutex, size_classes>  m_mutexes;
+        std::array<free_block*, size_classes> m_lists{};
+        std::atomic<std::size_t>              m_bytes{0};
+    };
+
+    /**
+     **********************************************************************************************
+     * \brief   Free buffers owned by a single thread.
+     **********************************************************************************************/
+    struct thread_cache
+    {
+        thread_cache() = default;
+        thread_cache(const thread_cache&) = delete;
+        thread_cache& operator=(const thread_cache&) = delete;
+
+        ~thread_cache()
+        {
+            flush();
+            t_cacheDestroyed = true;
+        }
+
+        void
+        push(void* ptr_, std::size_t sizeClass_) noexcept
+        {
+            auto* block         = static_cast<free_block*>(ptr_);
+            block->m_next       = m_lists[sizeClass_];
+            m_lists[sizeClass_] = block;
+            m_bytes += block_size_of(sizeClass_);
+        }
+
+        void
+        flush() noexcept
+        {
+            for(std::size_t sizeClass = 0; sizeClass < size_classes; sizeClass++)
+            {
+                while(free_block* block = m_lists[sizeClass])
+                {
+                    m_lists[sizeClass] = block->m_next;
+                    if(!shared_depot().push(block, sizeClass))
+                    {
+                        ::operator delete(block, std::align_val_t{block_alignment});
+                    }
+                }
+            }
+            m_bytes = 0;
+        }
+
+        std::array<free_block*, size_classes> m_lists{};
+        std::size_t                           m_bytes = 0;
+        cache_statistics                      m_statistics;
+    };
+
+
+    /** The depot, built on first use and never destroyed. */
+    [[nodiscard]] static depot&
+    shared_depot() noexcept
+    {
+        static depot* const instance = new depot;
+        return *instance;
+    }
+
+    /** Count an event in the calling thread's statistics, unless its cache was destroyed. */
+    static void
+    count(std::uint64_t cache_statistics::*counter_) noexcept
+    {
+        if(!t_cacheDestroyed)
+        {
+            (t_cache.m_statistics.*counter_)++;
+        }
+    }
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+    static thread_local thread_cache t_cache;
+    static thread_local bool         t_cacheDestroyed;
+};
+
+inline thread_local buffer_cache::thread_cache buffer_cache::t_cache;
+inline thread_local bool                       buffer_cache::t_cacheDestroyed = false;
+
+
+/**
+ **************************************************************************************************
+ * \brief       Allocator serving its blocks from the pel::buffer_cache.
+ *
+ *              Blocks are rounded up to a power of two, so this allocator implements the
+ *              `expand_in_place` extension (see allocator_extensions.hpp): a pel::vector growing
+ *              within the size class of its block does not move at all, and one growing past it
+ *              gets its new block from the cache, usually without taking any lock.
+ *
+ * \tparam      ItemType: Type of the elements to allocate.
+ *************************************************************************************************/
+template<typename ItemType>
+class caching_allocator
+{
+    static_assert(alignof(ItemType) <= buffer_cache::block_alignment,
+                  "caching_allocator does not support types aligned on more than 64 bytes");
+
+public:
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+    using value_type                             = ItemType;
+    using size_type                              = std::size_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal                        = std::true_type;
+
+    template<typename OtherType>
+    struct rebind
+    {
+        using other = caching_allocator<OtherType>;
+    };
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+    caching_allocator() noexcept = default;
+
+    template<typename OtherType>
+    caching_allocator(const caching_allocator<OtherType>& /*other_*/) noexcept
+    {
+    }
+
+
+    /*********************************************************************************************/
+    /* Allocation ------------------------------------------------------------------------------ */
+    [[nodiscard]] ItemType*
+    allocate(size_type count_)
+    {
+        if(count_ > static_cast<size_type>(-1) / sizeof(ItemType))
+        {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<ItemType*>(buffer_cache::allocate(count_ * sizeof(ItemType)));
+    }
+
+    void
+    deallocate(ItemType* ptr_, size_type count_) noexcept
+    {
+        buffer_cache::deallocate(ptr_, count_ * sizeof(ItemType));
+    }
+
+
+    /*********************************************************************************************/
+    /* Allocator extensions -------------------------------------------------------------------- */
+    bool
+    expand_in_place(ItemType* /*ptr_*/, size_type oldCount_, size_type newCount_) noexcept
+    {
+        if(newCount_ > static_cast<size_type>(-1) / sizeof(ItemType))
+        {
+            return false;
+        }
+        return buffer_cache::fits_in_place(oldCount_ * sizeof(ItemType),
+                                           newCount_ * sizeof(ItemType));
+    }
+};
+
+template<typename ItemType, typename OtherType>
+constexpr bool
+operator==(const caching_allocator<ItemType>& /*lhs_*/,
+           const caching_allocator<OtherType>& /*rhs_*/) noexcept
+{
+    return true;
+}
+
+}        // namespace pel
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
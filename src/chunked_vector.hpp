@@ -0,0 +1,192 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./segmented_iterator.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace pel
+{
+/** Default number of elements per block of a chunked_vector: as many as fit in 16 KiB. */
+template<typename ItemType>
+inline constexpr std::size_t chunked_vector_block_size =
+  std::bit_floor(std::max<std::size_t>(16384 / sizeof(ItemType), 1));
+
+/**
+ **************************************************************************************************
+ * \brief       Vector storing its elements in fixed-size blocks, indexed through a directory.
+ *
+ *              Growing allocates a single new block and appends its address to the directory:
+ *              existing elements are never copied nor moved, so references, pointers and
+ *              iterators stay valid until the element is removed. Since only one block is
+ *              allocated at a time, peak memory while growing stays close to the memory in use,
+ *              instead of the old and new buffers both being alive during a reallocation.
+ *              The directory itself still grows geometrically, but it only holds one pointer per
+ *              block.
+ *
+ *              Random access is O(1): a shift selects the block, a mask the offset within it.
+ *
+ * \tparam      ItemType:      Type of the elements.
+ * \tparam      AllocatorType: Allocator used to allocate the blocks.
+ *              [defaults : std::allocator<ItemType>]
+ * \tparam      BlockSize:     Number of elements per block, a power of two.
+ *              [defaults : as many elements as fit in 16 KiB]
+ *************************************************************************************************/
+template<typename ItemType,
+         typename AllocatorType = std::allocator<ItemType>,
+         std::size_t BlockSize  = chunked_vector_block_size<ItemType>>
+class chunked_vector
+{
+    static_assert(std::is_same_v<ItemType, typename AllocatorType::value_type>,
+                  "Allocator must match element type");
+    static_assert(std::has_single_bit(BlockSize), "Block size must be a power of two");
+
+public:
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+    using AllocatorTraits = std::allocator_traits<AllocatorType>;
+
+    using SizeType            = std::size_t;
+    using DifferenceType      = std::ptrdiff_t;
+    using IteratorType        = segmented_iterator<chunked_vector, ItemType>;
+    using ConstIteratorType   = segmented_iterator<const chunked_vector, const ItemType>;
+    using InitializerListType = std::initializer_list<ItemType>;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+    explicit chunked_vector(const AllocatorType& alloc_ = AllocatorType{});
+    explicit chunked_vector(SizeType             length_,
+                            const ItemType&      value_,
+                            const AllocatorType& alloc_ = AllocatorType{});
+    chunked_vector(InitializerListType ilist_, const AllocatorType& alloc_ = AllocatorType{});
+
+    chunked_vector(const chunked_vector& other_);
+    chunked_vector(chunked_vector&& move_) noexcept;
+    chunked_vector& operator=(const chunked_vector& copy_);
+    chunked_vector& operator=(chunked_vector&& move_) noexcept(
+      AllocatorTraits::propagate_on_container_move_assignment::value
+      || AllocatorTraits::is_always_equal::value);
+
+    ~chunked_vector();
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    [[nodiscard]] ItemType&       at(SizeType index_);
+    [[nodiscard]] const ItemType& at(SizeType index_) const;
+    [[nodiscard]] ItemType&       operator[](SizeType index_) noexcept;
+    [[nodiscard]] const ItemType& operator[](SizeType index_) const noexcept;
+
+    [[nodiscard]] ItemType&       front() noexcept;
+    [[nodiscard]] const ItemType& front() const noexcept;
+    [[nodiscard]] ItemType&       back() noexcept;
+    [[nodiscard]] const ItemType& back() const noexcept;
+
+    [[nodiscard]] SizeType                  block_count() const noexcept;
+    [[nodiscard]] std::span<ItemType>       block(SizeType block_) noexcept;
+    [[nodiscard]] std::span<const ItemType> block(SizeType block_) const noexcept;
+
+    [[nodiscard]] AllocatorType get_allocator() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Iterators ------------------------------------------------------------------------------- */
+    [[nodiscard]] IteratorType      begin() noexcept;
+    [[nodiscard]] IteratorType      end() noexcept;
+    [[nodiscard]] ConstIteratorType begin() const noexcept;
+    [[nodiscard]] ConstIteratorType end() const noexcept;
+    [[nodiscard]] ConstIteratorType cbegin() const noexcept;
+    [[nodiscard]] ConstIteratorType cend() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Element management ---------------------------------------------------------------------- */
+    ItemType& push_back(const ItemType& value_);
+    ItemType& push_back(ItemType&& value_);
+
+    template<typename... Args>
+    ItemType& emplace_back(Args&&... args_);
+
+    void pop_back();
+    void clear() noexcept;
+
+    void swap(chunked_vector& other_) noexcept;
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType length() const noexcept;
+    [[nodiscard]] bool     is_empty() const noexcept;
+    [[nodiscard]] SizeType capacity() const noexcept;
+
+    void reserve(SizeType newCapacity_);
+    void shrink_to_fit();
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    using DirectoryAllocatorType =
+      typename AllocatorTraits::template rebind_alloc<ItemType*>;
+    using DirectoryType = std::vector<ItemType*, DirectoryAllocatorType>;
+
+    static constexpr SizeType block_shift = std::countr_zero(BlockSize);
+    static constexpr SizeType block_mask  = BlockSize - 1;
+
+    void add_block();
+    void release_blocks(SizeType firstBlock_) noexcept;
+    void adopt(chunked_vector&& other_) noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    [[no_unique_address]] AllocatorType m_allocator;
+
+    DirectoryType m_blocks;
+    SizeType      m_length = 0;
+};
+
+}        // namespace pel
+
+
+#include "./chunked_vector.inl"
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
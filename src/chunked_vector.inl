@@ -0,0 +1,631 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./chunked_vector.hpp"
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Constructor for the chunked_vector class. Does not allocate anything.
+ *
+ * \param       alloc_: Allocator to use for all memory allocations
+ *              [defaults : AllocatorType{}]
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+chunked_vector<ItemType, AllocatorType, BlockSize>::chunked_vector(const AllocatorType& alloc_)
+: m_allocator{alloc_}, m_blocks{DirectoryAllocatorType{alloc_}}
+{
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Constructor filling the chunked_vector with `length_` copies of a value.
+ *
+ * \param       length_: Number of elements to construct.
+ * \param       value_:  Value to copy in every element.
+ * \param       alloc_:  Allocator to use for all memory allocations
+ *              [defaults : AllocatorType{}]
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+chunked_vector<ItemType, AllocatorType, BlockSize>::chunked_vector(SizeType             length_,
+                                                                   const ItemType&      value_,
+                                                                   const AllocatorType& alloc_)
+: chunked_vector{alloc_}
+{
+    reserve(length_);
+    for(SizeType i = 0; i < length_; i++)
+    {
+        emplace_back(value_);
+    }
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Constructor copying the elements of an initializer list.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+chunked_vector<ItemType, AllocatorType, BlockSize>::chunked_vector(InitializerListType  ilist_,
+                                                                   const AllocatorType& alloc_)
+: chunked_vector{alloc_}
+{
+    reserve(ilist_.size());
+    for(const ItemType& item : ilist_)
+    {
+        emplace_back(item);
+    }
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Copy constructor. Only allocates the blocks needed to hold the copied elements.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+chunked_vector<ItemType, AllocatorType, BlockSize>::chunked_vector(const chunked_vector& other_)
+: chunked_vector{AllocatorTraits::select_on_container_copy_construction(other_.m_allocator)}
+{
+    reserve(other_.length());
+    for(const ItemType& item : other_)
+    {
+        emplace_back(item);
+    }
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Move constructor. Steals the blocks of the other chunked_vector, leaving it empty.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+chunked_vector<ItemType, AllocatorType, BlockSize>::chunked_vector(chunked_vector&& move_) noexcept
+: m_allocator{move_.m_allocator},
+  m_blocks{std::move(move_.m_blocks)},
+  m_length{std::exchange(move_.m_length, 0)}
+{
+    move_.m_blocks.clear();
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Copy assignment operator for the chunked_vector class.
+ *              The allocator of `copy_` is only taken if it propagates on copy assignment, in
+ *              which case the current blocks are released first. The elements are then copied one
+ *              by one into the blocks that are kept.
+ *
+ * \param       copy_: chunked_vector to copy data from.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+chunked_vector<ItemType, AllocatorType, BlockSize>&
+chunked_vector<ItemType, AllocatorType, BlockSize>::operator=(const chunked_vector& copy_)
+{
+    if(this == &copy_)
+    {
+        return *this;
+    }
+
+    clear();
+    if constexpr(AllocatorTraits::propagate_on_container_copy_assignment::value)
+    {
+        /* The current blocks must be released before their allocator is replaced */
+        release_blocks(0);
+        m_allocator = copy_.m_allocator;
+
+        /* The directory follows the same allocator rules as the blocks */
+        const DirectoryType directory{DirectoryAllocatorType{m_allocator}};
+        m_blocks = directory;
+    }
+
+    reserve(copy_.length());
+    for(const ItemType& item : copy_)
+    {
+        emplace_back(item);
+    }
+    return *this;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Move assignment operator for the chunked_vector class.
+ *              The blocks of the other chunked_vector are taken if its allocator propagates on
+ *              move assignment, or compares equal to this chunked_vector's allocator. Otherwise,
+ *              they could not be released by this chunked_vector's allocator, so the elements are
+ *              moved one by one and the other chunked_vector is left empty, but keeps its blocks.
+ *
+ * \param       move_: chunked_vector to move data from.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+chunked_vector<ItemType, AllocatorType, BlockSize>&
+chunked_vector<ItemType, AllocatorType, BlockSize>::operator=(chunked_vector&& move_) noexcept(
+  AllocatorTraits::propagate_on_container_move_assignment::value
+  || AllocatorTraits::is_always_equal::value)
+{
+    if(this == &move_)
+    {
+        return *this;
+    }
+
+    if constexpr(AllocatorTraits::propagate_on_container_move_assignment::value)
+    {
+        /* The current blocks must be released before their allocator is replaced */
+        clear();
+        release_blocks(0);
+        m_allocator = move_.m_allocator;
+        adopt(std::move(move_));
+    }
+    else
+    {
+        if(m_allocator == move_.m_allocator)
+        {
+            adopt(std::move(move_));
+        }
+        else
+        {
+            clear();
+            reserve(move_.length());
+            for(ItemType& item : move_)
+            {
+                emplace_back(std::move(item));
+            }
+            move_.clear();
+        }
+    }
+    return *this;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Destructor for the chunked_vector class.
+ *              Destroys every element and releases every block.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+chunked_vector<ItemType, AllocatorType, BlockSize>::~chunked_vector()
+{
+    clear();
+    release_blocks(0);
+}
+
+
+/*************************************************************************************************/
+/* ELEMENT ACCESSORS --------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Access an element, with bounds checking.
+ *
+ * \throws      std::out_of_range: `index_` is past the length of the chunked_vector.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline ItemType&
+chunked_vector<ItemType, AllocatorType, BlockSize>::at(SizeType index_)
+{
+    if(index_ >= m_length)
+    {
+        throw std::out_of_range("chunked_vector::at: index is out of range");
+    }
+    return (*this)[index_];
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline const ItemType&
+chunked_vector<ItemType, AllocatorType, BlockSize>::at(SizeType index_) const
+{
+    if(index_ >= m_length)
+    {
+        throw std::out_of_range("chunked_vector::at: index is out of range");
+    }
+    return (*this)[index_];
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Access an element, without any check.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline ItemType&
+chunked_vector<ItemType, AllocatorType, BlockSize>::operator[](SizeType index_) noexcept
+{
+    return m_blocks[index_ >> block_shift][index_ & block_mask];
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline const ItemType&
+chunked_vector<ItemType, AllocatorType, BlockSize>::operator[](SizeType index_) const noexcept
+{
+    return m_blocks[index_ >> block_shift][index_ & block_mask];
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline ItemType&
+chunked_vector<ItemType, AllocatorType, BlockSize>::front() noexcept
+{
+    return (*this)[0];
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline const ItemType&
+chunked_vector<ItemType, AllocatorType, BlockSize>::front() const noexcept
+{
+    return (*this)[0];
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline ItemType&
+chunked_vector<ItemType, AllocatorType, BlockSize>::back() noexcept
+{
+    return (*this)[m_length - 1];
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline const ItemType&
+chunked_vector<ItemType, AllocatorType, BlockSize>::back() const noexcept
+{
+    return (*this)[m_length - 1];
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Number of blocks holding at least one element.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline typename chunked_vector<ItemType, AllocatorType, BlockSize>::SizeType
+chunked_vector<ItemType, AllocatorType, BlockSize>::block_count() const noexcept
+{
+    return (m_length + block_mask) >> block_shift;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Get the elements of a block as a contiguous span.
+ *              Walking the blocks one after the other lets bulk operations run over contiguous
+ *              memory, without computing the block of every element.
+ *
+ * \param       block_: Index of the block, smaller than \ref block_count().
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline std::span<ItemType>
+chunked_vector<ItemType, AllocatorType, BlockSize>::block(SizeType block_) noexcept
+{
+    const SizeType first = block_ << block_shift;
+    return {m_blocks[block_], std::min(BlockSize, m_length - first)};
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline std::span<const ItemType>
+chunked_vector<ItemType, AllocatorType, BlockSize>::block(SizeType block_) const noexcept
+{
+    const SizeType first = block_ << block_shift;
+    return {m_blocks[block_], std::min(BlockSize, m_length - first)};
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline AllocatorType
+chunked_vector<ItemType, AllocatorType, BlockSize>::get_allocator() const noexcept
+{
+    return m_allocator;
+}
+
+
+/*************************************************************************************************/
+/* ITERATORS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline typename chunked_vector<ItemType, AllocatorType, BlockSize>::IteratorType
+chunked_vector<ItemType, AllocatorType, BlockSize>::begin() noexcept
+{
+    return IteratorType{this, 0};
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline typename chunked_vector<ItemType, AllocatorType, BlockSize>::IteratorType
+chunked_vector<ItemType, AllocatorType, BlockSize>::end() noexcept
+{
+    return IteratorType{this, m_length};
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline typename chunked_vector<ItemType, AllocatorType, BlockSize>::ConstIteratorType
+chunked_vector<ItemType, AllocatorType, BlockSize>::begin() const noexcept
+{
+    return ConstIteratorType{this, 0};
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline typename chunked_vector<ItemType, AllocatorType, BlockSize>::ConstIteratorType
+chunked_vector<ItemType, AllocatorType, BlockSize>::end() const noexcept
+{
+    return ConstIteratorType{this, m_length};
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline typename chunked_vector<ItemType, AllocatorType, BlockSize>::ConstIteratorType
+chunked_vector<ItemType, AllocatorType, BlockSize>::cbegin() const noexcept
+{
+    return begin();
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline typename chunked_vector<ItemType, AllocatorType, BlockSize>::ConstIteratorType
+chunked_vector<ItemType, AllocatorType, BlockSize>::cend() const noexcept
+{
+    return end();
+}
+
+
+/*************************************************************************************************/
+/* ELEMENT MANAGEMENT -------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Append an element. Never moves the existing elements.
+ *
+ * \retval      ItemType&: Reference to the new element, valid until it is removed.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline ItemType&
+chunked_vector<ItemType, AllocatorType, BlockSize>::push_back(const ItemType& value_)
+{
+    return emplace_back(value_);
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline ItemType&
+chunked_vector<ItemType, AllocatorType, BlockSize>::push_back(ItemType&& value_)
+{
+    return emplace_back(std::move(value_));
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Construct an element in place at the end of the chunked_vector.
+ *              A new block is allocated when the last one is full; the existing elements are
+ *              never moved.
+ *
+ * \param       args_: Arguments to forward to the `ItemType` constructor.
+ *
+ * \retval      ItemType&: Reference to the new element, valid until it is removed.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+template<typename... Args>
+inline ItemType&
+chunked_vector<ItemType, AllocatorType, BlockSize>::emplace_back(Args&&... args_)
+{
+    if(m_length == capacity())
+    {
+        add_block();
+    }
+
+    ItemType* item = &(*this)[m_length];
+    AllocatorTraits::construct(m_allocator, item, std::forward<Args>(args_)...);
+    m_length++;
+    return *item;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy the last element. Its block is kept for later appends.
+ *
+ * \throws      std::length_error: The chunked_vector is empty.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline void
+chunked_vector<ItemType, AllocatorType, BlockSize>::pop_back()
+{
+    if(m_length == 0)
+    {
+        throw std::length_error("chunked_vector::pop_back: chunked_vector is empty");
+    }
+
+    m_length--;
+    AllocatorTraits::destroy(m_allocator, &(*this)[m_length]);
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy every element, keeping the blocks for later appends.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+void
+chunked_vector<ItemType, AllocatorType, BlockSize>::clear() noexcept
+{
+    if constexpr(!std::is_trivially_destructible_v<ItemType>)
+    {
+        const SizeType blocks = block_count();
+        for(SizeType index = 0; index < blocks; index++)
+        {
+            for(ItemType& item : block(index))
+            {
+                AllocatorTraits::destroy(m_allocator, &item);
+            }
+        }
+    }
+
+    m_length = 0;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Exchange the elements of two chunked_vectors. Never moves elements.
+ *              The allocators are only exchanged if they propagate on swap.
+ *
+ * \note        Otherwise, both allocators must compare equal, as each chunked_vector then releases
+ *              blocks that were allocated by the other one.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+void
+chunked_vector<ItemType, AllocatorType, BlockSize>::swap(chunked_vector& other_) noexcept
+{
+    using std::swap;
+    if constexpr(AllocatorTraits::propagate_on_container_swap::value)
+    {
+        swap(m_allocator, other_.m_allocator);
+    }
+    else
+    {
+        assert(m_allocator == other_.m_allocator);
+    }
+    m_blocks.swap(other_.m_blocks);
+    swap(m_length, other_.m_length);
+}
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline typename chunked_vector<ItemType, AllocatorType, BlockSize>::SizeType
+chunked_vector<ItemType, AllocatorType, BlockSize>::length() const noexcept
+{
+    return m_length;
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline bool
+chunked_vector<ItemType, AllocatorType, BlockSize>::is_empty() const noexcept
+{
+    return m_length == 0;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Number of elements that fit in the blocks allocated so far.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+inline typename chunked_vector<ItemType, AllocatorType, BlockSize>::SizeType
+chunked_vector<ItemType, AllocatorType, BlockSize>::capacity() const noexcept
+{
+    return m_blocks.size() << block_shift;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Allocate the blocks needed to hold `newCapacity_` elements.
+ *              Reserving sizes the directory once, so growing up to `newCapacity_` never
+ *              reallocates it.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+void
+chunked_vector<ItemType, AllocatorType, BlockSize>::reserve(SizeType newCapacity_)
+{
+    const SizeType blocks = (newCapacity_ + block_mask) >> block_shift;
+    if(blocks <= m_blocks.size())
+    {
+        return;
+    }
+
+    m_blocks.reserve(blocks);
+    while(m_blocks.size() < blocks)
+    {
+        add_block();
+    }
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Release the blocks past the last element, and shrink the directory.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+void
+chunked_vector<ItemType, AllocatorType, BlockSize>::shrink_to_fit()
+{
+    release_blocks(block_count());
+    m_blocks.shrink_to_fit();
+}
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Allocate a new block at the end of the directory.
+ *
+ * \throws      std::bad_alloc: Could not allocate the block or grow the directory. The
+ *                              chunked_vector is left unchanged.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+void
+chunked_vector<ItemType, AllocatorType, BlockSize>::add_block()
+{
+    ItemType* newBlock = AllocatorTraits::allocate(m_allocator, BlockSize);
+    try
+    {
+        m_blocks.push_back(newBlock);
+    }
+    catch(...)
+    {
+        AllocatorTraits::deallocate(m_allocator, newBlock, BlockSize);
+        throw;
+    }
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Release every block from `firstBlock_` to the end of the directory.
+ *              The released blocks must not hold any element.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+void
+chunked_vector<ItemType, AllocatorType, BlockSize>::release_blocks(SizeType firstBlock_) noexcept
+{
+    for(SizeType index = firstBlock_; index < m_blocks.size(); index++)
+    {
+        AllocatorTraits::deallocate(m_allocator, m_blocks[index], BlockSize);
+    }
+    m_blocks.resize(std::min(firstBlock_, m_blocks.size()));
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Take the blocks of another chunked_vector, which is left empty, without blocks.
+ *              The elements and blocks currently held by this chunked_vector are released first.
+ *
+ * \note        The blocks of `other_` must be releasable by this chunked_vector's allocator.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t BlockSize>
+void
+chunked_vector<ItemType, AllocatorType, BlockSize>::adopt(chunked_vector&& other_) noexcept
+{
+    clear();
+    release_blocks(0);
+
+    /* The directory follows the same allocator rules as the blocks */
+    m_blocks = std::move(other_.m_blocks);
+    other_.m_blocks.clear();
+    m_length = std::exchange(other_.m_length, 0);
+}
+
+}        // namespace pel
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
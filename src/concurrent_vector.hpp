@@ -0,0 +1,213 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./segmented_iterator.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+
+namespace pel
+{
+/**
+ **************************************************************************************************
+ * \brief       Vector supporting lock-free concurrent appends.
+ *
+ *              Elements live in segments of geometrically increasing size, which are never moved
+ *              nor freed while the container is alive: growing never relocates existing elements,
+ *              so references, pointers and iterators stay valid for concurrent readers.
+ *
+ *              Appending reserves an index with a single atomic increment of the length,
+ *              constructs the element in its segment, then publishes it through a per-slot flag.
+ *              No lock is taken. Segments are created ahead of time by the appending threads and
+ *              installed with a compare-and-swap (see \ref get_segment()).
+ *              Readers must only access published elements: the length counts the reserved
+ *              slots, some of which may still be under construction, or whose construction failed.
+ *              Iterators only cover the published prefix of the vector (see
+ *              \ref published_length()); later elements are reached by index, after checking
+ *              \ref is_published().
+ *
+ * \tparam      ItemType:         Type of the elements.
+ * \tparam      AllocatorType:    Allocator used to allocate the segments.
+ *              [defaults : std::allocator<ItemType>]
+ * \tparam      FirstSegmentSize: Number of elements of the first segment, a power of two. Every
+ *                                following segment is twice as big as the previous one.
+ *              [defaults : 32]
+ *
+ * \note        Appending, reading published elements and querying the length are thread-safe.
+ *              \ref clear(), \ref shrink_to_fit() and destruction are not.
+ *************************************************************************************************/
+template<typename ItemType,
+         typename AllocatorType       = std::allocator<ItemType>,
+         std::size_t FirstSegmentSize = 32>
+class concurrent_vector
+{
+    static_assert(std::is_same_v<ItemType, typename AllocatorType::value_type>,
+                  "Allocator must match element type");
+    static_assert(std::has_single_bit(FirstSegmentSize),
+                  "First segment size must be a power of two");
+
+public:
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+    using AllocatorTraits = std::allocator_traits<AllocatorType>;
+
+    using SizeType          = std::size_t;
+    using DifferenceType    = std::ptrdiff_t;
+    using IteratorType      = segmented_iterator<concurrent_vector, ItemType>;
+    using ConstIteratorType = segmented_iterator<const concurrent_vector, const ItemType>;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+    explicit concurrent_vector(const AllocatorType& alloc_ = AllocatorType{});
+
+    concurrent_vector(const concurrent_vector&) = delete;
+    concurrent_vector& operator=(const concurrent_vector&) = delete;
+
+    ~concurrent_vector();
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    [[nodiscard]] ItemType&       at(SizeType index_);
+    [[nodiscard]] const ItemType& at(SizeType index_) const;
+    [[nodiscard]] ItemType&       operator[](SizeType index_) noexcept;
+    [[nodiscard]] const ItemType& operator[](SizeType index_) const noexcept;
+
+    [[nodiscard]] bool is_published(SizeType index_) const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Iterators ------------------------------------------------------------------------------- */
+    [[nodiscard]] IteratorType      begin() noexcept;
+    [[nodiscard]] IteratorType      end() noexcept;
+    [[nodiscard]] ConstIteratorType begin() const noexcept;
+    [[nodiscard]] ConstIteratorType end() const noexcept;
+    [[nodiscard]] ConstIteratorType cbegin() const noexcept;
+    [[nodiscard]] ConstIteratorType cend() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Element management ---------------------------------------------------------------------- */
+    ItemType& push_back(const ItemType& value_);
+    ItemType& push_back(ItemType&& value_);
+
+    template<typename... Args>
+    ItemType& emplace_back(Args&&... args_);
+
+    SizeType grow_by(SizeType count_);
+    SizeType grow_by(SizeType count_, const ItemType& value_);
+
+    void clear() noexcept;
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType length() const noexcept;
+    [[nodiscard]] SizeType published_length() const noexcept;
+    [[nodiscard]] bool     is_empty() const noexcept;
+    [[nodiscard]] SizeType capacity() const noexcept;
+
+    void reserve(SizeType newCapacity_);
+    void shrink_to_fit() noexcept;
+
+
+    /*********************************************************************************************/
+    /* Private types and methods --------------------------------------------------------------- */
+private:
+    enum slot_state : std::uint8_t
+    {
+        slot_empty,
+        slot_published,
+        slot_failed,
+    };
+
+    struct slot
+    {
+        alignas(ItemType) std::byte m_storage[sizeof(ItemType)];
+        std::atomic<std::uint8_t> m_state{slot_empty};
+
+        [[nodiscard]] ItemType* item() noexcept
+        {
+            return std::launder(reinterpret_cast<ItemType*>(m_storage));
+        }
+    };
+
+    using SlotAllocatorType =
+      typename std::allocator_traits<AllocatorType>::template rebind_alloc<slot>;
+    using SlotTraits = std::allocator_traits<SlotAllocatorType>;
+
+    static constexpr SizeType first_segment_shift = std::countr_zero(FirstSegmentSize);
+    static constexpr SizeType segment_count =
+      std::numeric_limits<SizeType>::digits - first_segment_shift;
+
+    /** Times a thread yields while another one creates the segment it needs, before creating it
+     *  itself. */
+    static constexpr std::uint32_t segment_wait_spins = 1024;
+
+    [[nodiscard]] static constexpr SizeType segment_of(SizeType index_) noexcept;
+    [[nodiscard]] static constexpr SizeType segment_base(SizeType segment_) noexcept;
+    [[nodiscard]] static constexpr SizeType segment_size(SizeType segment_) noexcept;
+
+    [[nodiscard]] slot*       slot_at(SizeType index_) noexcept;
+    [[nodiscard]] const slot* slot_at(SizeType index_) const noexcept;
+
+    slot* get_segment(SizeType segment_, bool create_);
+    void  destroy_segment(SizeType segment_) noexcept;
+    void  mark_failed(SizeType index_) noexcept;
+
+    template<typename... Args>
+    ItemType& construct_at(SizeType index_, Args&&... args_);
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    [[no_unique_address]] AllocatorType m_allocator;
+
+    std::atomic<SizeType>                         m_length{0};
+    mutable std::atomic<SizeType>                 m_publishedLength{0};
+    std::array<std::atomic<slot*>, segment_count> m_segments{};
+};
+
+}        // namespace pel
+
+
+#include "./concurrent_vector.inl"
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,657 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./concurrent_vector.hpp"
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Constructor for the concurrent_vector class. Does not allocate anything.
+ *
+ * \param       alloc_: Allocator to use for all memory allocations
+ *              [defaults : AllocatorType{}]
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::concurrent_vector(
+  const AllocatorType& alloc_)
+: m_allocator{alloc_}
+{
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Destructor for the concurrent_vector class.
+ *              Destroys every published element and releases every segment.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::~concurrent_vector()
+{
+    for(SizeType segment = 0; segment < segment_count; segment++)
+    {
+        destroy_segment(segment);
+    }
+}
+
+
+/*************************************************************************************************/
+/* ELEMENT ACCESSORS --------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Access a published element, with bounds checking.
+ *
+ * \throws      std::out_of_range: `index_` is past the length of the vector, or the element at
+ *                                 `index_` is not published yet.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+inline ItemType&
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::at(SizeType index_)
+{
+    if(!is_published(index_))
+    {
+        throw std::out_of_range("concurrent_vector::at: element is not published");
+    }
+    return (*this)[index_];
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+inline const ItemType&
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::at(SizeType index_) const
+{
+    if(!is_published(index_))
+    {
+        throw std::out_of_range("concurrent_vector::at: element is not published");
+    }
+    return (*this)[index_];
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Access an element, without any check.
+ *              The element must have been published, either by this thread or by another one,
+ *              synchronized through \ref is_published().
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+inline ItemType&
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::operator[](SizeType index_) noexcept
+{
+    return *slot_at(index_)->item();
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+inline const ItemType&
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::operator[](
+  SizeType index_) const noexcept
+{
+    return *const_cast<slot*>(slot_at(index_))->item();
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Check whether the element at an index is constructed and visible to this thread.
+ *
+ * \retval      bool: False if the slot is past the length, under construction, or if its
+ *                    construction failed.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+inline bool
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::is_published(
+  SizeType index_) const noexcept
+{
+    if(index_ >= length())
+    {
+        return false;
+    }
+
+    const slot* segment = m_segments[segment_of(index_)].load(std::memory_order_acquire);
+    if(segment == nullptr)
+    {
+        return false;
+    }
+
+    const slot& target = segment[index_ - segment_base(segment_of(index_))];
+    return target.m_state.load(std::memory_order_acquire) == slot_published;
+}
+
+
+/*************************************************************************************************/
+/* ITERATORS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Iterators over the published prefix of the vector, from index 0 to
+ *              \ref published_length(). The end is taken when `end()` is called: elements
+ *              published afterwards are not part of the range.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+inline typename concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::IteratorType
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::begin() noexcept
+{
+    return IteratorType{this, 0};
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+inline typename concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::IteratorType
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::end() noexcept
+{
+    return IteratorType{this, published_length()};
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+inline typename concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::ConstIteratorType
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::begin() const noexcept
+{
+    return ConstIteratorType{this, 0};
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+inline typename concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::ConstIteratorType
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::end() const noexcept
+{
+    return ConstIteratorType{this, published_length()};
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+inline typename concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::ConstIteratorType
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::cbegin() const noexcept
+{
+    return begin();
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+inline typename concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::ConstIteratorType
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::cend() const noexcept
+{
+    return end();
+}
+
+
+/*************************************************************************************************/
+/* ELEMENT MANAGEMENT -------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Append an element. Thread-safe and lock-free.
+ *
+ * \retval      ItemType&: Reference to the new element, valid until the vector is cleared.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+inline ItemType&
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::push_back(const ItemType& value_)
+{
+    return emplace_back(value_);
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+inline ItemType&
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::push_back(ItemType&& value_)
+{
+    return emplace_back(std::move(value_));
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Construct an element in place at the end of the vector. Thread-safe and lock-free.
+ *
+ * \param       args_: Arguments to forward to the `ItemType` constructor.
+ *
+ * \retval      ItemType&: Reference to the new element, valid until the vector is cleared.
+ *
+ * \note        If the constructor throws, the reserved slot is marked as failed and is never
+ *              published; the length of the vector still accounts for it, and iteration stops
+ *              before it.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+template<typename... Args>
+inline ItemType&
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::emplace_back(Args&&... args_)
+{
+    const SizeType index = m_length.fetch_add(1, std::memory_order_relaxed);
+    return construct_at(index, std::forward<Args>(args_)...);
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Append `count_` value-initialized elements at once. Thread-safe and lock-free.
+ *              The new elements are contiguous in index space, even with concurrent appends.
+ *
+ * \retval      SizeType: Index of the first new element.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+inline typename concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::SizeType
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::grow_by(SizeType count_)
+{
+    const SizeType first = m_length.fetch_add(count_, std::memory_order_relaxed);
+
+    SizeType index = first;
+    try
+    {
+        for(; index < first + count_; index++)
+        {
+            construct_at(index);
+        }
+    }
+    catch(...)
+    {
+        /* The failing slot is already marked; the remaining ones will never be constructed */
+        for(index++; index < first + count_; index++)
+        {
+            mark_failed(index);
+        }
+        throw;
+    }
+
+    return first;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Append `count_` copies of a value at once. Thread-safe and lock-free.
+ *
+ * \retval      SizeType: Index of the first new element.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+inline typename concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::SizeType
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::grow_by(SizeType        count_,
+                                                                      const ItemType& value_)
+{
+    const SizeType first = m_length.fetch_add(count_, std::memory_order_relaxed);
+
+    SizeType index = first;
+    try
+    {
+        for(; index < first + count_; index++)
+        {
+            construct_at(index, value_);
+        }
+    }
+    catch(...)
+    {
+        for(index++; index < first + count_; index++)
+        {
+            mark_failed(index);
+        }
+        throw;
+    }
+
+    return first;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy every element, keeping the segments for later appends. Not thread-safe.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+void
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::clear() noexcept
+{
+    const SizeType oldLength = length();
+    for(SizeType index = 0; index < oldLength; index++)
+    {
+        slot* segment = m_segments[segment_of(index)].load(std::memory_order_relaxed);
+        if(segment == nullptr)
+        {
+            continue;
+        }
+
+        slot& target = segment[index - segment_base(segment_of(index))];
+        if(target.m_state.load(std::memory_order_relaxed) == slot_published)
+        {
+            AllocatorTraits::destroy(m_allocator, target.item());
+        }
+        target.m_state.store(slot_empty, std::memory_order_relaxed);
+    }
+
+    m_length.store(0, std::memory_order_relaxed);
+    m_publishedLength.store(0, std::memory_order_relaxed);
+}
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Number of reserved slots, including the ones still being constructed.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+inline typename concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::SizeType
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::length() const noexcept
+{
+    return m_length.load(std::memory_order_acquire);
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Number of leading elements that are all published, and visible to this thread.
+ *              It stops at the first slot still under construction, or whose construction failed.
+ *
+ * \note        The count is cached, so each slot is only examined once by the scans of all the
+ *              threads, as long as it is published.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+inline typename concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::SizeType
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::published_length() const noexcept
+{
+    const SizeType cached    = m_publishedLength.load(std::memory_order_acquire);
+    SizeType       published = cached;
+    while(is_published(published))
+    {
+        published++;
+    }
+
+    /* Other threads may have moved the cache further in the meantime */
+    SizeType expected = cached;
+    while(expected < published
+          && !m_publishedLength.compare_exchange_weak(
+            expected, published, std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
+    return published;
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+inline bool
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::is_empty() const noexcept
+{
+    return length() == 0;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Number of elements that fit in the consecutive segments allocated so far.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+inline typename concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::SizeType
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::capacity() const noexcept
+{
+    SizeType segment = 0;
+    while(segment < segment_count
+          && m_segments[segment].load(std::memory_order_acquire) != nullptr)
+    {
+        segment++;
+    }
+    return segment_base(segment);
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Allocate the segments needed to hold `newCapacity_` elements. Thread-safe.
+ *              Reserving ahead avoids having concurrent appends race to create the same segment.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+void
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::reserve(SizeType newCapacity_)
+{
+    if(newCapacity_ == 0)
+    {
+        return;
+    }
+
+    const SizeType lastSegment = segment_of(newCapacity_ - 1);
+    for(SizeType segment = 0; segment <= lastSegment; segment++)
+    {
+        get_segment(segment, true);
+    }
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Release the segments past the last element. Not thread-safe.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+void
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::shrink_to_fit() noexcept
+{
+    const SizeType firstUnused = is_empty() ? 0 : segment_of(length() - 1) + 1;
+    for(SizeType segment = firstUnused; segment < segment_count; segment++)
+    {
+        destroy_segment(segment);
+    }
+}
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Segment layout: segment `s` holds `FirstSegmentSize << s` elements, starting at
+ *              index `FirstSegmentSize * (2^s - 1)`.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+constexpr typename concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::SizeType
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::segment_of(SizeType index_) noexcept
+{
+    const int width = std::numeric_limits<SizeType>::digits
+                      - std::countl_zero((index_ >> first_segment_shift) + 1);
+    return static_cast<SizeType>(width) - 1;
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+constexpr typename concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::SizeType
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::segment_base(
+  SizeType segment_) noexcept
+{
+    return FirstSegmentSize * ((SizeType{1} << segment_) - 1);
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+constexpr typename concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::SizeType
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::segment_size(
+  SizeType segment_) noexcept
+{
+    return FirstSegmentSize << segment_;
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+inline typename concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::slot*
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::slot_at(SizeType index_) noexcept
+{
+    const SizeType segment = segment_of(index_);
+    return m_segments[segment].load(std::memory_order_acquire) + (index_ - segment_base(segment));
+}
+
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+inline const typename concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::slot*
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::slot_at(
+  SizeType index_) const noexcept
+{
+    const SizeType segment = segment_of(index_);
+    return m_segments[segment].load(std::memory_order_acquire) + (index_ - segment_base(segment));
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Get a segment, creating it if necessary.
+ *              Segments are created by the thread reserving their first slot, or ahead of time by
+ *              the thread reserving the middle slot of the previous segment. Other threads first
+ *              yield to let them finish, then create the segment themselves if it is still
+ *              missing, so a stalled thread never blocks the others.
+ *              Threads creating the same segment each allocate one; the first to install its
+ *              segment wins, and the others release theirs.
+ *
+ * \param       segment_: Segment to get.
+ * \param       create_:  Create the segment right away instead of waiting for another thread.
+ *
+ * \throws      std::length_error: The segment is past the maximum size of the vector.
+ * \throws      std::bad_alloc:    Could not allocate the segment.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+typename concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::slot*
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::get_segment(SizeType segment_,
+                                                                          bool     create_)
+{
+    if(segment_ >= segment_count)
+    {
+        throw std::length_error("concurrent_vector exceeds its maximum size");
+    }
+
+    slot* segment = m_segments[segment_].load(std::memory_order_acquire);
+    for(std::uint32_t spin = 0; segment == nullptr && !create_ && spin < segment_wait_spins; spin++)
+    {
+        std::this_thread::yield();
+        segment = m_segments[segment_].load(std::memory_order_acquire);
+    }
+    if(segment != nullptr)
+    {
+        return segment;
+    }
+
+    SlotAllocatorType slotAllocator{m_allocator};
+    const SizeType    size    = segment_size(segment_);
+    slot*             created = SlotTraits::allocate(slotAllocator, size);
+    for(SizeType i = 0; i < size; i++)
+    {
+        std::construct_at(created + i);
+    }
+
+    if(m_segments[segment_].compare_exchange_strong(segment,
+                                                    created,
+                                                    std::memory_order_acq_rel,
+                                                    std::memory_order_acquire))
+    {
+        return created;
+    }
+
+    /* Another thread installed this segment first */
+    SlotTraits::deallocate(slotAllocator, created, size);
+    return segment;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy the published elements of a segment, and release it.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+void
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::destroy_segment(
+  SizeType segment_) noexcept
+{
+    slot* segment = m_segments[segment_].exchange(nullptr, std::memory_order_acq_rel);
+    if(segment == nullptr)
+    {
+        return;
+    }
+
+    const SizeType size = segment_size(segment_);
+    for(SizeType i = 0; i < size; i++)
+    {
+        if constexpr(!std::is_trivially_destructible_v<ItemType>)
+        {
+            if(segment[i].m_state.load(std::memory_order_relaxed) == slot_published)
+            {
+                AllocatorTraits::destroy(m_allocator, segment[i].item());
+            }
+        }
+        std::destroy_at(segment + i);
+    }
+
+    SlotAllocatorType slotAllocator{m_allocator};
+    SlotTraits::deallocate(slotAllocator, segment, size);
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Mark a reserved slot whose element will never be constructed.
+ *              Never allocates: a slot whose segment could not be created has no state to mark,
+ *              and reads as not published like a failed one.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+void
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::mark_failed(
+  SizeType index_) noexcept
+{
+    slot* segment = m_segments[segment_of(index_)].load(std::memory_order_acquire);
+    if(segment != nullptr)
+    {
+        segment[index_ - segment_base(segment_of(index_))].m_state.store(
+          slot_failed, std::memory_order_release);
+    }
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Construct the element of a reserved slot, and publish it.
+ *              The thread reserving the middle slot of a segment also creates the next segment.
+ *
+ * \note        If the segment of the slot cannot be created or the constructor throws, the slot
+ *              is marked as failed before the exception is propagated.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentSize>
+template<typename... Args>
+inline ItemType&
+concurrent_vector<ItemType, AllocatorType, FirstSegmentSize>::construct_at(SizeType index_,
+                                                                           Args&&... args_)
+{
+    const SizeType segment = segment_of(index_);
+    const SizeType offset  = index_ - segment_base(segment);
+
+    slot* target = nullptr;
+    try
+    {
+        target = get_segment(segment, offset == 0) + offset;
+        AllocatorTraits::construct(m_allocator,
+                                   reinterpret_cast<ItemType*>(target->m_storage),
+                                   std::forward<Args>(args_)...);
+    }
+    catch(...)
+    {
+        mark_failed(index_);
+        throw;
+    }
+    target->m_state.store(slot_published, std::memory_order_release);
+
+    /* Create the next segment ahead of time, so that appending threads rarely wait for it.
+     * This is only a head start: on failure, the thread reserving its first slot creates it. */
+    if(offset == segment_size(segment) / 2 && segment + 1 < segment_count)
+    {
+        try
+        {
+            get_segment(segment + 1, true);
+        }
+        catch(const std::bad_alloc&)
+        {
+        }
+    }
+
+    return *target->item();
+}
+
+}        // namespace pel
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,154 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+
+
+namespace pel
+{
+/**
+ **************************************************************************************************
+ * \brief       Requirements for a growth policy usable by pel::vector.
+ *              A growth policy computes, in a single step, the capacity a container should grow
+ *              to when `requiredCapacity_` elements no longer fit in `currentCapacity_`.
+ *
+ * \note        The returned capacity must be greater or equal to `requiredCapacity_`.
+ *************************************************************************************************/
+template<typename PolicyType>
+concept growth_policy = requires(std::size_t currentCapacity_, std::size_t requiredCapacity_)
+{
+    {
+        PolicyType::next_capacity(currentCapacity_, requiredCapacity_)
+        } -> std::same_as<std::size_t>;
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Geometric growth policy.
+ *              Grows to the current capacity multiplied by `Numerator / Denominator`, or straight
+ *              to the required capacity when that is larger, which gives amortized O(1) appends.
+ *
+ * \tparam      Numerator:   Numerator of the growth factor.
+ * \tparam      Denominator: Denominator of the growth factor.
+ * \tparam      MinimumCapacity: Smallest capacity ever allocated when growing.
+ *              [defaults : 4]
+ *************************************************************************************************/
+template<std::size_t Numerator, std::size_t Denominator, std::size_t MinimumCapacity = 4>
+struct geometric_growth
+{
+    static_assert(Denominator != 0, "Growth factor denominator cannot be zero");
+    static_assert(Numerator > Denominator, "Growth factor must be greater than 1");
+
+    [[nodiscard]] static constexpr std::size_t
+    next_capacity(std::size_t currentCapacity_, std::size_t requiredCapacity_) noexcept
+    {
+        constexpr std::size_t maxCapacity = std::numeric_limits<std::size_t>::max() / Numerator;
+
+        /* Overflow guard: past this point, geometric growth is not possible anymore */
+        if(currentCapacity_ >= maxCapacity)
+        {
+            return requiredCapacity_ > currentCapacity_ ? requiredCapacity_ : currentCapacity_;
+        }
+
+        std::size_t grown = currentCapacity_ * Numerator / Denominator;
+        if(grown < MinimumCapacity)
+        {
+            grown = MinimumCapacity;
+        }
+
+        return grown < requiredCapacity_ ? requiredCapacity_ : grown;
+    }
+};
+
+using growth_1_5x = geometric_growth<3, 2>;
+using growth_2x   = geometric_growth<2, 1>;
+
+
+/**
+ **************************************************************************************************
+ * \brief       Power-of-two growth policy.
+ *              Always grows to the smallest power of two that can hold the required capacity.
+ *
+ * \tparam      MinimumCapacity: Smallest capacity ever allocated when growing.
+ *              [defaults : 4]
+ *************************************************************************************************/
+template<std::size_t MinimumCapacity = 4>
+struct power_of_two_growth
+{
+    static_assert(std::has_single_bit(MinimumCapacity), "Minimum capacity must be a power of two");
+
+    [[nodiscard]] static constexpr std::size_t
+    next_capacity([[maybe_unused]] std::size_t currentCapacity_,
+                  std::size_t                  requiredCapacity_) noexcept
+    {
+        if(requiredCapacity_ <= MinimumCapacity)
+        {
+            return MinimumCapacity;
+        }
+
+        /* Overflow guard: std::bit_ceil is undefined when the result is not representable */
+        if(requiredCapacity_ > (std::numeric_limits<std::size_t>::max() / 2) + 1)
+        {
+            return requiredCapacity_;
+        }
+
+        return std::bit_ceil(requiredCapacity_);
+    }
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Exact-fit growth policy.
+ *              Only ever allocates the required capacity. Minimizes memory usage, at the cost of
+ *              one reallocation per append.
+ *************************************************************************************************/
+struct exact_fit_growth
+{
+    [[nodiscard]] static constexpr std::size_t
+    next_capacity([[maybe_unused]] std::size_t currentCapacity_,
+                  std::size_t                  requiredCapacity_) noexcept
+    {
+        return requiredCapacity_;
+    }
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Default growth policy of the pel containers.
+ *************************************************************************************************/
+using default_growth_policy = growth_1_5x;
+
+}        // namespace pel
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,334 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+
+namespace pel
+{
+/** Size in bytes of a huge page on the platforms where they are used (2 MiB on x86-64 and ARM64
+ *  with 4 KiB base pages). */
+inline constexpr std::size_t huge_page_size = std::size_t{2} * 1024 * 1024;
+
+/**
+ **************************************************************************************************
+ * \brief       Allocator backing big blocks with huge pages, to reduce TLB misses and page faults.
+ *
+ *              Blocks smaller than `HugeThreshold` bytes live on the C heap. On Linux, bigger
+ *              blocks are mapped with `mmap`, aligned and rounded to `huge_page_size`, and marked
+ *              with `madvise(MADV_HUGEPAGE)` so that transparent huge pages back them. When
+ *              `UseHugeTLB` is set, explicit huge pages (`MAP_HUGETLB`) are tried first, falling
+ *              back to transparent huge pages when none are reserved on the system.
+ *
+ *              This allocator implements the `expand_in_place` and `reallocate` extensions (see
+ *              allocator_extensions.hpp): mapped blocks are resized with `mremap`, so growing a
+ *              pel::vector of trivially relocatable elements never copies them.
+ *
+ * \tparam      ItemType:      Type of the elements to allocate.
+ * \tparam      HugeThreshold: Size in bytes from which blocks are backed by huge pages.
+ *              [defaults : huge_page_size]
+ * \tparam      UseHugeTLB:    Try explicit huge pages before transparent huge pages.
+ *              [defaults : false]
+ *************************************************************************************************/
+template<typename ItemType, std::size_t HugeThreshold = huge_page_size, bool UseHugeTLB = false>
+class hugepage_allocator
+{
+    static_assert(alignof(ItemType) <= alignof(std::max_align_t),
+                  "hugepage_allocator does not support over-aligned types");
+
+public:
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+    using value_type                             = ItemType;
+    using size_type                              = std::size_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal                        = std::true_type;
+
+    template<typename OtherType>
+    struct rebind
+    {
+        using other = hugepage_allocator<OtherType, HugeThreshold, UseHugeTLB>;
+    };
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+    hugepage_allocator() noexcept = default;
+
+    template<typename OtherType>
+    hugepage_allocator(
+      const hugepage_allocator<OtherType, HugeThreshold, UseHugeTLB>& /*other_*/) noexcept
+    {
+    }
+
+
+    /*********************************************************************************************/
+    /* Allocation ------------------------------------------------------------------------------ */
+    [[nodiscard]] ItemType*
+    allocate(size_type count_)
+    {
+        if(count_ == 0)
+        {
+            return nullptr;
+        }
+        if(count_ > (static_cast<size_type>(-1) - 2 * huge_page_size) / sizeof(ItemType))
+        {
+            throw std::bad_array_new_length();
+        }
+
+        void* ptr = is_mapped(bytes_of(count_)) ? map(round_to_huge_page(bytes_of(count_)))
+                                                : std::malloc(bytes_of(count_));
+        if(ptr == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<ItemType*>(ptr);
+    }
+
+    void
+    deallocate(ItemType* ptr_, size_type count_) noexcept
+    {
+        if(ptr_ == nullptr)
+        {
+            return;
+        }
+
+        if(is_mapped(bytes_of(count_)))
+        {
+#if defined(__linux__)
+            ::munmap(ptr_, round_to_huge_page(bytes_of(count_)));
+#endif
+        }
+        else
+        {
+            std::free(ptr_);
+        }
+    }
+
+
+    /*********************************************************************************************/
+    /* Allocator extensions -------------------------------------------------------------------- */
+
+    /**
+     **********************************************************************************************
+     * \brief   Try to resize a block without moving it.
+     *          Only mapped blocks can be resized in place, by remapping their pages.
+     *
+     * \retval  bool: True if the block at `ptr_` now holds `newCount_` elements.
+     **********************************************************************************************/
+    bool
+    expand_in_place(ItemType* ptr_, size_type oldCount_, size_type newCount_) noexcept
+    {
+        if(ptr_ == nullptr || !is_mapped(bytes_of(oldCount_)) || !is_mapped(bytes_of(newCount_)))
+        {
+            return false;
+        }
+
+        const size_type oldSize = round_to_huge_page(bytes_of(oldCount_));
+        const size_type newSize = round_to_huge_page(bytes_of(newCount_));
+        if(oldSize == newSize)
+        {
+            return true;
+        }
+
+#if defined(__linux__)
+        return ::mremap(ptr_, oldSize, newSize, 0) != MAP_FAILED;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     **********************************************************************************************
+     * \brief   Resize a block, moving its content bitwise if it cannot be resized in place.
+     *          Mapped blocks are moved by remapping their pages, without copying them.
+     *
+     * \retval  ItemType*: New address of the block.
+     *
+     * \throws  std::bad_alloc: Could not resize the block. `ptr_` is left untouched.
+     **********************************************************************************************/
+    [[nodiscard]] ItemType*
+    reallocate(ItemType* ptr_, size_type oldCount_, size_type newCount_)
+    {
+        if(ptr_ == nullptr)
+        {
+            return allocate(newCount_);
+        }
+        if(newCount_ == 0)
+        {
+            deallocate(ptr_, oldCount_);
+            return nullptr;
+        }
+
+        const bool oldMapped = is_mapped(bytes_of(oldCount_));
+        const bool newMapped = is_mapped(bytes_of(newCount_));
+
+        void* ptr = nullptr;
+        if(oldMapped && newMapped)
+        {
+#if defined(__linux__)
+            const size_type newSize = round_to_huge_page(bytes_of(newCount_));
+
+            ptr = ::mremap(ptr_, round_to_huge_page(bytes_of(oldCount_)), newSize, MREMAP_MAYMOVE);
+            ptr = (ptr == MAP_FAILED) ? nullptr : ptr;
+            if(ptr != nullptr)
+            {
+                ::madvise(ptr, newSize, MADV_HUGEPAGE);
+            }
+#endif
+        }
+        else if(!oldMapped && !newMapped)
+        {
+            ptr = std::realloc(ptr_, bytes_of(newCount_));
+        }
+
+        /* Crossing the threshold, or the kernel refused to remap (e.g. explicit huge pages on older
+         * kernels): the block has to be copied */
+        if(ptr == nullptr && (oldMapped || newMapped))
+        {
+            ItemType* newPtr = allocate(newCount_);
+            std::memcpy(static_cast<void*>(newPtr),
+                        static_cast<const void*>(ptr_),
+                        bytes_of(oldCount_ < newCount_ ? oldCount_ : newCount_));
+            deallocate(ptr_, oldCount_);
+            ptr = newPtr;
+        }
+
+        if(ptr == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<ItemType*>(ptr);
+    }
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    [[nodiscard]] static constexpr size_type
+    bytes_of(size_type count_) noexcept
+    {
+        return count_ * sizeof(ItemType);
+    }
+
+    [[nodiscard]] static constexpr bool
+    is_mapped([[maybe_unused]] size_type bytes_) noexcept
+    {
+#if defined(__linux__)
+        return bytes_ >= HugeThreshold;
+#else
+        return false;
+#endif
+    }
+
+    [[nodiscard]] static constexpr size_type
+    round_to_huge_page(size_type bytes_) noexcept
+    {
+        return (bytes_ + huge_page_size - 1) / huge_page_size * huge_page_size;
+    }
+
+    /**
+     **********************************************************************************************
+     * \brief   Map `size_` bytes of memory backed by huge pages.
+     *          Transparent huge pages can only back ranges aligned on `huge_page_size`, so the
+     *          mapping is over-allocated by one huge page, then trimmed to an aligned range.
+     *
+     * \retval  void*: Address of the mapping, or nullptr if it could not be created.
+     **********************************************************************************************/
+    [[nodiscard]] static void*
+    map([[maybe_unused]] size_type size_) noexcept
+    {
+#if defined(__linux__)
+#if defined(MAP_HUGETLB)
+        if constexpr(UseHugeTLB)
+        {
+            void* ptr = ::mmap(nullptr,
+                               size_,
+                               PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                               -1,
+                               0);
+            if(ptr != MAP_FAILED)
+            {
+                return ptr;
+            }
+        }
+#endif
+
+        const size_type mappedSize = size_ + huge_page_size;
+
+        void* mapped =
+          ::mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(mapped == MAP_FAILED)
+        {
+            return nullptr;
+        }
+
+        const auto address = reinterpret_cast<std::uintptr_t>(mapped);
+        const auto aligned = (address + huge_page_size - 1) / huge_page_size * huge_page_size;
+        const size_type leading = aligned - address;
+
+        /* Give back the unaligned head and the unused tail of the mapping */
+        if(leading != 0)
+        {
+            ::munmap(mapped, leading);
+        }
+        if(huge_page_size - leading != 0)
+        {
+            ::munmap(reinterpret_cast<void*>(aligned + size_), huge_page_size - leading);
+        }
+
+        void* ptr = reinterpret_cast<void*>(aligned);
+        ::madvise(ptr, size_, MADV_HUGEPAGE);
+        return ptr;
+#else
+        return nullptr;
+#endif
+    }
+};
+
+template<typename ItemType, typename OtherType, std::size_t HugeThreshold, bool UseHugeTLB>
+constexpr bool
+operator==(const hugepage_allocator<ItemType, HugeThreshold, UseHugeTLB>& /*lhs_*/,
+           const hugepage_allocator<OtherType, HugeThreshold, UseHugeTLB>& /*rhs_*/) noexcept
+{
+    return true;
+}
+
+}        // namespace pel
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
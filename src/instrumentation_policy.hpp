@@ -0,0 +1,259 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <source_location>
+#include <string>
+#include <string_view>
+
+
+namespace pel
+{
+/**
+ **************************************************************************************************
+ * \brief       Change made to the memory block of a container.
+ *************************************************************************************************/
+enum class reallocation_kind
+{
+    allocate,        //!< First block allocated by an empty container.
+    in_place,        //!< Block resized by the allocator, without moving it.
+    bitwise,         //!< Block moved by the allocator itself (e.g. `realloc` or `mremap`).
+    relocate,        //!< Elements relocated to a new block, then the old block released.
+    release,         //!< Block released.
+};
+
+[[nodiscard]] const char*
+to_string(reallocation_kind kind_) noexcept;
+
+
+/**
+ **************************************************************************************************
+ * \brief       Description of a single change of the memory block of a container.
+ *************************************************************************************************/
+struct reallocation_event
+{
+    reallocation_kind m_kind        = reallocation_kind::allocate;
+    std::size_t       m_oldCapacity = 0;        //!< Capacity before the change, in elements.
+    std::size_t       m_newCapacity = 0;        //!< Capacity after the change, in elements.
+    std::size_t       m_length      = 0;        //!< Elements kept in the block.
+    std::size_t       m_itemSize    = 0;        //!< Size of an element, in bytes.
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Counters accumulated over the reallocation events of one or more containers.
+ *************************************************************************************************/
+struct allocation_statistics
+{
+    std::size_t m_allocations          = 0;        //!< Blocks obtained from the allocator.
+    std::size_t m_deallocations        = 0;        //!< Blocks handed back to the allocator.
+    std::size_t m_reallocations        = 0;        //!< Capacity changes of an existing block.
+    std::size_t m_inPlaceReallocations = 0;        //!< Reallocations that did not move the block.
+    std::size_t m_growths              = 0;        //!< Reallocations asked by the growth policy.
+    std::size_t m_bytesMoved           = 0;        //!< Bytes of elements moved between blocks.
+    std::size_t m_peakCapacity         = 0;        //!< Largest capacity, in elements.
+    std::size_t m_peakBytes            = 0;        //!< Largest block, in bytes.
+    std::size_t m_peakWastedBytes      = 0;        //!< Largest unused part of a new block.
+
+    void record(const reallocation_event& event_) noexcept;
+    void merge(const allocation_statistics& other_) noexcept;
+
+    void write_json(std::ostream& os_) const;
+};
+
+
+/*************************************************************************************************/
+/* Helpers ------------------------------------------------------------------------------------- */
+template<typename ItemType>
+[[nodiscard]] constexpr std::string_view
+instrumented_type_name() noexcept;
+
+void
+write_json_string(std::ostream& os_, std::string_view text_);
+
+
+/**
+ **************************************************************************************************
+ * \brief       Requirements for an instrumentation policy usable by pel::vector.
+ *              The container reports every change of its memory block to `on_reallocation`, and
+ *              every time it has to grow to fit new elements to `on_growth`.
+ *              Policies whose `enabled` constant is `false` are never called.
+ *************************************************************************************************/
+template<typename PolicyType>
+concept instrumentation_policy = std::default_initializable<PolicyType>
+                                 && requires(PolicyType&               policy_,
+                                             const reallocation_event& event_,
+                                             std::size_t               capacity_)
+{
+    {
+        PolicyType::enabled
+        } -> std::convertible_to<bool>;
+    policy_.template on_reallocation<int>(event_);
+    policy_.template on_growth<int>(capacity_, capacity_);
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Default instrumentation policy: records nothing.
+ *              Empty and stored with `[[no_unique_address]]`, it does not change the size of the
+ *              container, and the hooks compile to nothing.
+ *************************************************************************************************/
+struct no_instrumentation
+{
+    static constexpr bool enabled = false;
+
+    template<typename ItemType>
+    constexpr void on_reallocation(const reallocation_event&) noexcept
+    {
+    }
+
+    template<typename ItemType>
+    constexpr void on_growth(std::size_t, std::size_t) noexcept
+    {
+    }
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Key under which the statistics of destroyed containers are aggregated.
+ *************************************************************************************************/
+enum class instrumentation_scope
+{
+    instance,            //!< Statistics are only kept by each container.
+    by_type,             //!< Aggregated by element type.
+    by_call_site,        //!< Aggregated by the location given to `set_call_site`.
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Process-wide aggregation of the statistics of destroyed containers.
+ *
+ * \note        Thread-safe. Usable until the very end of the process, including from the
+ *              destructors of static containers.
+ *************************************************************************************************/
+class instrumentation_registry
+{
+public:
+    using SnapshotType = std::map<std::string, allocation_statistics, std::less<>>;
+
+    [[nodiscard]] static instrumentation_registry& instance();
+
+    void merge(std::string_view key_, const allocation_statistics& statistics_);
+    void reset();
+
+    [[nodiscard]] SnapshotType snapshot() const;
+    void                       write_json(std::ostream& os_) const;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    instrumentation_registry() = default;
+
+    mutable std::mutex m_mutex;
+    SnapshotType       m_statistics;
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Instrumentation policy recording the allocation statistics of a container, and the
+ *              history of its last reallocations.
+ *
+ *              When the container is destroyed, its statistics are merged in the
+ *              \ref instrumentation_registry, unless `Scope` is `instrumentation_scope::instance`.
+ *
+ * \tparam      Scope:         Key under which statistics are aggregated process-wide.
+ *              [defaults : instrumentation_scope::instance]
+ * \tparam      HistoryLength: Number of reallocation events kept, the oldest being overwritten.
+ *              [defaults : 64]
+ *
+ * \note        Copying or moving a container does not carry its statistics over: they describe the
+ *              memory blocks the instance itself allocated.
+ *************************************************************************************************/
+template<instrumentation_scope Scope = instrumentation_scope::instance,
+         std::size_t HistoryLength   = 64>
+class allocation_tracker
+{
+    static_assert(HistoryLength > 0, "History must hold at least one event");
+
+public:
+    static constexpr bool enabled = true;
+
+    allocation_tracker() noexcept = default;
+    allocation_tracker(const allocation_tracker&) noexcept;
+    allocation_tracker& operator=(const allocation_tracker&) noexcept;
+    ~allocation_tracker();
+
+    /*********************************************************************************************/
+    /* Hooks ----------------------------------------------------------------------------------- */
+    template<typename ItemType>
+    void on_reallocation(const reallocation_event& event_) noexcept;
+
+    template<typename ItemType>
+    void on_growth(std::size_t capacity_, std::size_t requiredCapacity_) noexcept;
+
+    /*********************************************************************************************/
+    /* Results --------------------------------------------------------------------------------- */
+    void set_call_site(std::source_location location_ = std::source_location::current()) noexcept;
+
+    [[nodiscard]] const allocation_statistics& statistics() const noexcept;
+    [[nodiscard]] std::size_t                  history_length() const noexcept;
+    [[nodiscard]] const reallocation_event&    history(std::size_t index_) const noexcept;
+    [[nodiscard]] std::string                  key() const;
+
+    void reset() noexcept;
+    void write_json(std::ostream& os_) const;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    allocation_statistics                         m_statistics;
+    std::array<reallocation_event, HistoryLength> m_history{};
+    std::size_t                                   m_events   = 0;
+    std::string_view                              m_typeName = {};
+    std::source_location                          m_callSite = {};
+};
+
+}        // namespace pel
+
+
+#include "./instrumentation_policy.inl"
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,490 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./instrumentation_policy.hpp"
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* HELPERS ------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Get the name of a reallocation kind.
+ *************************************************************************************************/
+[[nodiscard]] inline const char*
+to_string(reallocation_kind kind_) noexcept
+{
+    switch(kind_)
+    {
+        case reallocation_kind::allocate:
+            return "allocate";
+        case reallocation_kind::in_place:
+            return "in_place";
+        case reallocation_kind::bitwise:
+            return "bitwise";
+        case reallocation_kind::relocate:
+            return "relocate";
+        case reallocation_kind::release:
+        default:
+            return "release";
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the name of the function instantiated for `ItemType`, as given by the compiler.
+ *************************************************************************************************/
+template<typename ItemType>
+[[nodiscard]] constexpr std::string_view
+instrumented_function_name() noexcept
+{
+    return std::source_location::current().function_name();
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Get the name of a type, as written by the compiler.
+ *              Two instantiations of \ref instrumented_function_name only differ by the name of
+ *              their template argument, so the prefix and suffix around `int` are cut from the
+ *              name of any other instantiation.
+ *
+ * \note        Falls back to the whole function name if the compiler does not name template
+ *              arguments in it.
+ *************************************************************************************************/
+template<typename ItemType>
+[[nodiscard]] constexpr std::string_view
+instrumented_type_name() noexcept
+{
+    constexpr std::string_view probe  = instrumented_function_name<int>();
+    constexpr std::string_view name   = instrumented_function_name<ItemType>();
+    constexpr std::size_t      prefix = probe.find("int");
+
+    if constexpr(prefix == std::string_view::npos)
+    {
+        return name;
+    }
+    else
+    {
+        constexpr std::size_t suffix = probe.size() - prefix - 3;
+        return name.substr(prefix, name.size() - prefix - suffix);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Write a string as a quoted JSON string, escaping the characters that need it.
+ *************************************************************************************************/
+inline void
+write_json_string(std::ostream& os_, std::string_view text_)
+{
+    os_ << '"';
+    for(const char character : text_)
+    {
+        if(character == '"' || character == '\\')
+        {
+            os_ << '\\' << character;
+        }
+        else if(static_cast<unsigned char>(character) < 0x20)
+        {
+            os_ << ' ';
+        }
+        else
+        {
+            os_ << character;
+        }
+    }
+    os_ << '"';
+}
+
+
+/*************************************************************************************************/
+/* STATISTICS ---------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Account for a change of a memory block.
+ *
+ * \param       event_: Change made to the block.
+ *************************************************************************************************/
+inline void
+allocation_statistics::record(const reallocation_event& event_) noexcept
+{
+    switch(event_.m_kind)
+    {
+        case reallocation_kind::allocate:
+            m_allocations++;
+            break;
+        case reallocation_kind::in_place:
+            m_reallocations++;
+            m_inPlaceReallocations++;
+            break;
+        case reallocation_kind::bitwise:
+            m_reallocations++;
+            m_bytesMoved += event_.m_length * event_.m_itemSize;
+            break;
+        case reallocation_kind::relocate:
+            m_allocations++;
+            m_deallocations++;
+            m_reallocations++;
+            m_bytesMoved += event_.m_length * event_.m_itemSize;
+            break;
+        case reallocation_kind::release:
+        default:
+            m_deallocations++;
+            return;
+    }
+
+    m_peakCapacity    = std::max(m_peakCapacity, event_.m_newCapacity);
+    m_peakBytes       = std::max(m_peakBytes, event_.m_newCapacity * event_.m_itemSize);
+    m_peakWastedBytes = std::max(m_peakWastedBytes,
+                                 (event_.m_newCapacity - event_.m_length) * event_.m_itemSize);
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Add the counters of other statistics to these ones. Peaks are the largest of both.
+ *************************************************************************************************/
+inline void
+allocation_statistics::merge(const allocation_statistics& other_) noexcept
+{
+    m_allocations += other_.m_allocations;
+    m_deallocations += other_.m_deallocations;
+    m_reallocations += other_.m_reallocations;
+    m_inPlaceReallocations += other_.m_inPlaceReallocations;
+    m_growths += other_.m_growths;
+    m_bytesMoved += other_.m_bytesMoved;
+
+    m_peakCapacity    = std::max(m_peakCapacity, other_.m_peakCapacity);
+    m_peakBytes       = std::max(m_peakBytes, other_.m_peakBytes);
+    m_peakWastedBytes = std::max(m_peakWastedBytes, other_.m_peakWastedBytes);
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Write the statistics as a JSON object.
+ *************************************************************************************************/
+inline void
+allocation_statistics::write_json(std::ostream& os_) const
+{
+    os_ << "{\"allocations\": " << m_allocations << ", \"deallocations\": " << m_deallocations
+        << ", \"reallocations\": " << m_reallocations
+        << ", \"inPlaceReallocations\": " << m_inPlaceReallocations
+        << ", \"growths\": " << m_growths << ", \"bytesMoved\": " << m_bytesMoved
+        << ", \"peakCapacity\": " << m_peakCapacity << ", \"peakBytes\": " << m_peakBytes
+        << ", \"peakWastedBytes\": " << m_peakWastedBytes << "}";
+}
+
+
+/*************************************************************************************************/
+/* REGISTRY ------------------------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Get the registry shared by the whole process.
+ *              The registry is never destroyed: containers with static storage duration may be
+ *              built before it and destroyed after it would have been, and still merge their
+ *              statistics when destroyed at exit.
+ *************************************************************************************************/
+inline instrumentation_registry&
+instrumentation_registry::instance()
+{
+    static instrumentation_registry* const registry = new instrumentation_registry;
+    return *registry;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Add statistics to the ones already aggregated under a key.
+ *
+ * \param       key_:        Element type or call site the statistics belong to.
+ * \param       statistics_: Statistics to add.
+ *************************************************************************************************/
+inline void
+instrumentation_registry::merge(std::string_view key_, const allocation_statistics& statistics_)
+{
+    const std::lock_guard lock{m_mutex};
+
+    auto it = m_statistics.find(key_);
+    if(it == m_statistics.end())
+    {
+        it = m_statistics.emplace(std::string{key_}, allocation_statistics{}).first;
+    }
+    it->second.merge(statistics_);
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Forget every aggregated statistics.
+ *************************************************************************************************/
+inline void
+instrumentation_registry::reset()
+{
+    const std::lock_guard lock{m_mutex};
+    m_statistics.clear();
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Get a copy of the aggregated statistics, sorted by key.
+ *************************************************************************************************/
+inline instrumentation_registry::SnapshotType
+instrumentation_registry::snapshot() const
+{
+    const std::lock_guard lock{m_mutex};
+    return m_statistics;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Write the aggregated statistics as a JSON object, with one member per key.
+ *************************************************************************************************/
+inline void
+instrumentation_registry::write_json(std::ostream& os_) const
+{
+    const SnapshotType statistics = snapshot();
+
+    os_ << "{";
+    bool first = true;
+    for(const auto& [key, value] : statistics)
+    {
+        os_ << (first ? "" : ", ");
+        write_json_string(os_, key);
+        os_ << ": ";
+        value.write_json(os_);
+        first = false;
+    }
+    os_ << "}";
+}
+
+
+/*************************************************************************************************/
+/* ALLOCATION TRACKER -------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Copies start without statistics nor history: they describe the memory blocks of
+ *              another container.
+ *************************************************************************************************/
+template<instrumentation_scope Scope, std::size_t HistoryLength>
+allocation_tracker<Scope, HistoryLength>::allocation_tracker(
+  [[maybe_unused]] const allocation_tracker& other_) noexcept
+{
+}
+
+template<instrumentation_scope Scope, std::size_t HistoryLength>
+allocation_tracker<Scope, HistoryLength>&
+allocation_tracker<Scope, HistoryLength>::operator=(
+  [[maybe_unused]] const allocation_tracker& other_) noexcept
+{
+    return *this;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Destructor of the tracker. Merges its statistics in the
+ *              \ref instrumentation_registry, if they are aggregated.
+ *
+ * \note        Instrumentation is best-effort: failing to record statistics never throws.
+ *************************************************************************************************/
+template<instrumentation_scope Scope, std::size_t HistoryLength>
+allocation_tracker<Scope, HistoryLength>::~allocation_tracker()
+{
+    if constexpr(Scope != instrumentation_scope::instance)
+    {
+        if(m_events == 0 && m_statistics.m_growths == 0)
+        {
+            return;
+        }
+
+        try
+        {
+            instrumentation_registry::instance().merge(key(), m_statistics);
+        }
+        catch(...)
+        {
+        }
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Record a change of the memory block of the container.
+ *
+ * \tparam      ItemType: Type of the elements of the container.
+ * \param       event_:   Change made to the block.
+ *************************************************************************************************/
+template<instrumentation_scope Scope, std::size_t HistoryLength>
+template<typename ItemType>
+inline void
+allocation_tracker<Scope, HistoryLength>::on_reallocation(const reallocation_event& event_) noexcept
+{
+    m_typeName = instrumented_type_name<ItemType>();
+
+    m_statistics.record(event_);
+    m_history[m_events % HistoryLength] = event_;
+    m_events++;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Record that the container had to grow to fit new elements.
+ *
+ * \tparam      ItemType:          Type of the elements of the container.
+ * \param       capacity_:         Capacity of the container before growing.
+ * \param       requiredCapacity_: Capacity needed to fit the new elements.
+ *************************************************************************************************/
+template<instrumentation_scope Scope, std::size_t HistoryLength>
+template<typename ItemType>
+inline void
+allocation_tracker<Scope, HistoryLength>::on_growth(
+  [[maybe_unused]] std::size_t capacity_,
+  [[maybe_unused]] std::size_t requiredCapacity_) noexcept
+{
+    m_typeName = instrumented_type_name<ItemType>();
+
+    m_statistics.m_growths++;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Set the location under which statistics are aggregated, with
+ *              `instrumentation_scope::by_call_site`.
+ *
+ * \param       location_: Location of the container.
+ *              [defaults : location of the call]
+ *************************************************************************************************/
+template<instrumentation_scope Scope, std::size_t HistoryLength>
+inline void
+allocation_tracker<Scope, HistoryLength>::set_call_site(std::source_location location_) noexcept
+{
+    m_callSite = location_;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Get the statistics recorded so far.
+ *************************************************************************************************/
+template<instrumentation_scope Scope, std::size_t HistoryLength>
+inline const allocation_statistics&
+allocation_tracker<Scope, HistoryLength>::statistics() const noexcept
+{
+    return m_statistics;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Get the number of reallocation events held in the history.
+ *************************************************************************************************/
+template<instrumentation_scope Scope, std::size_t HistoryLength>
+inline std::size_t
+allocation_tracker<Scope, HistoryLength>::history_length() const noexcept
+{
+    return std::min(m_events, HistoryLength);
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Get an event of the history, the oldest one being at index 0.
+ *
+ * \param       index_: Index of the event, smaller than `history_length()`.
+ *************************************************************************************************/
+template<instrumentation_scope Scope, std::size_t HistoryLength>
+inline const reallocation_event&
+allocation_tracker<Scope, HistoryLength>::history(std::size_t index_) const noexcept
+{
+    const std::size_t oldest = m_events - history_length();
+    return m_history[(oldest + index_) % HistoryLength];
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Get the key under which statistics are aggregated: the call site if one was given
+ *              and `Scope` is `instrumentation_scope::by_call_site`, the element type otherwise.
+ *************************************************************************************************/
+template<instrumentation_scope Scope, std::size_t HistoryLength>
+inline std::string
+allocation_tracker<Scope, HistoryLength>::key() const
+{
+    if(Scope == instrumentation_scope::by_call_site && m_callSite.line() != 0)
+    {
+        return std::string{m_callSite.file_name()} + ":" + std::to_string(m_callSite.line()) + " "
+               + m_callSite.function_name();
+    }
+
+    return std::string{m_typeName};
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Forget the statistics and the history recorded so far.
+ *************************************************************************************************/
+template<instrumentation_scope Scope, std::size_t HistoryLength>
+inline void
+allocation_tracker<Scope, HistoryLength>::reset() noexcept
+{
+    m_statistics = allocation_statistics{};
+    m_events     = 0;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Write the statistics and the history as a JSON object.
+ *************************************************************************************************/
+template<instrumentation_scope Scope, std::size_t HistoryLength>
+inline void
+allocation_tracker<Scope, HistoryLength>::write_json(std::ostream& os_) const
+{
+    os_ << "{\"key\": ";
+    write_json_string(os_, key());
+    os_ << ", \"statistics\": ";
+    m_statistics.write_json(os_);
+    os_ << ", \"events\": " << m_events << ", \"history\": [";
+
+    for(std::size_t i = 0; i < history_length(); i++)
+    {
+        const reallocation_event& event = history(i);
+
+        os_ << (i == 0 ? "" : ", ") << "{\"kind\": \"" << to_string(event.m_kind)
+            << "\", \"oldCapacity\": " << event.m_oldCapacity
+            << ", \"newCapacity\": " << event.m_newCapacity << ", \"length\": " << event.m_length
+            << ", \"itemSize\": " << event.m_itemSize << "}";
+    }
+    os_ << "]}";
+}
+
+}        // namespace pel
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -26,7 +26,6 @@
 #include <iostream>
 #include <memory_resource>
 
-#include "./tests.inl"
 #include "./vector.hpp"
 
 
@@ -0,0 +1,263 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PEL_MAPPED_FILE_POSIX 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define PEL_MAPPED_FILE_POSIX 0
+#endif
+
+
+namespace pel
+{
+/**
+ **************************************************************************************************
+ * \brief       How a pel::mapped_file opens its file.
+ *************************************************************************************************/
+enum class mapped_file_mode
+{
+    open_or_create,        //!< Open the file, creating it empty if it does not exist.
+    open_existing,         //!< Open the file, failing if it does not exist.
+    truncate,              //!< Create the file, discarding any previous content.
+    read_only,             //!< Open an existing file, which can only be mapped for reading.
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       File handle, able to map its content in memory.
+ *
+ * \throws      std::system_error: Every failing system call reports its `errno`.
+ *
+ * \note        Only supported on POSIX systems. On other systems, opening a file throws.
+ *************************************************************************************************/
+class mapped_file
+{
+public:
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+    mapped_file(const std::filesystem::path& path_, mapped_file_mode mode_)
+    : m_path{path_}, m_readOnly{mode_ == mapped_file_mode::read_only}
+    {
+#if PEL_MAPPED_FILE_POSIX
+        int flags = O_RDWR;
+        switch(mode_)
+        {
+            case mapped_file_mode::open_or_create:
+                flags |= O_CREAT;
+                break;
+            case mapped_file_mode::open_existing:
+                break;
+            case mapped_file_mode::truncate:
+                flags |= O_CREAT | O_TRUNC;
+                break;
+            case mapped_file_mode::read_only:
+                flags = O_RDONLY;
+                break;
+        }
+
+        m_handle = ::open(m_path.c_str(), flags | O_CLOEXEC, 0644);
+        if(m_handle < 0)
+        {
+            throw_last_error("Could not open mapped file");
+        }
+#else
+        (void)mode_;
+        throw std::system_error(std::make_error_code(std::errc::function_not_supported),
+                                "Mapped files are not supported on this platform");
+#endif
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    ~mapped_file()
+    {
+#if PEL_MAPPED_FILE_POSIX
+        ::close(m_handle);
+#endif
+    }
+
+
+    /*********************************************************************************************/
+    /* File management ------------------------------------------------------------------------- */
+    [[nodiscard]] const std::filesystem::path&
+    path() const noexcept
+    {
+        return m_path;
+    }
+
+    [[nodiscard]] bool
+    is_read_only() const noexcept
+    {
+        return m_readOnly;
+    }
+
+    [[nodiscard]] std::size_t
+    size() const
+    {
+#if PEL_MAPPED_FILE_POSIX
+        struct stat status
+        {
+        };
+        if(::fstat(m_handle, &status) != 0)
+        {
+            throw_last_error("Could not query mapped file size");
+        }
+        return static_cast<std::size_t>(status.st_size);
+#else
+        return 0;
+#endif
+    }
+
+    void
+    resize(std::size_t bytes_)
+    {
+#if PEL_MAPPED_FILE_POSIX
+        if(::ftruncate(m_handle, static_cast<off_t>(bytes_)) != 0)
+        {
+            throw_last_error("Could not resize mapped file");
+        }
+#else
+        (void)bytes_;
+#endif
+    }
+
+
+    /*********************************************************************************************/
+    /* Mapping management ---------------------------------------------------------------------- */
+
+    /**
+     **********************************************************************************************
+     * \brief   Map the first `bytes_` bytes of the file.
+     *          Nothing is read: pages are faulted in lazily when first accessed.
+     **********************************************************************************************/
+    [[nodiscard]] void*
+    map(std::size_t bytes_)
+    {
+#if PEL_MAPPED_FILE_POSIX
+        const int protection = m_readOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+
+        void* ptr = ::mmap(nullptr, bytes_, protection, MAP_SHARED, m_handle, 0);
+        if(ptr == MAP_FAILED)
+        {
+            throw_last_error("Could not map file");
+        }
+        return ptr;
+#else
+        (void)bytes_;
+        return nullptr;
+#endif
+    }
+
+    /**
+     **********************************************************************************************
+     * \brief   Resize a mapping of the file.
+     *          The data lives in the file, so the mapping never has to be copied: on Linux the
+     *          page tables are moved with `mremap`, elsewhere the file is simply mapped again.
+     **********************************************************************************************/
+    [[nodiscard]] void*
+    remap(void* ptr_, std::size_t oldBytes_, std::size_t newBytes_)
+    {
+#if defined(__linux__)
+        void* ptr = ::mremap(ptr_, oldBytes_, newBytes_, MREMAP_MAYMOVE);
+        if(ptr == MAP_FAILED)
+        {
+            throw_last_error("Could not remap file");
+        }
+        return ptr;
+#else
+        void* ptr = map(newBytes_);
+        unmap(ptr_, oldBytes_);
+        return ptr;
+#endif
+    }
+
+    static void
+    unmap(void* ptr_, std::size_t bytes_) noexcept
+    {
+#if PEL_MAPPED_FILE_POSIX
+        ::munmap(ptr_, bytes_);
+#else
+        (void)ptr_;
+        (void)bytes_;
+#endif
+    }
+
+    /**
+     **********************************************************************************************
+     * \brief   Write the modified pages of a mapping back to the file.
+     *
+     * \param   async_: Schedule the write-back instead of waiting for it to complete.
+     **********************************************************************************************/
+    static void
+    sync(void* ptr_, std::size_t bytes_, bool async_)
+    {
+#if PEL_MAPPED_FILE_POSIX
+        if(::msync(ptr_, bytes_, async_ ? MS_ASYNC : MS_SYNC) != 0)
+        {
+            throw_last_error("Could not flush mapped file");
+        }
+#else
+        (void)ptr_;
+        (void)bytes_;
+        (void)async_;
+#endif
+    }
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    [[noreturn]] static void
+    throw_last_error(const char* what_)
+    {
+        throw std::system_error(errno, std::generic_category(), what_);
+    }
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    std::filesystem::path m_path;
+    int                   m_handle   = -1;
+    bool                  m_readOnly = false;
+};
+
+}        // namespace pel
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,303 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./mapped_file.hpp"
+#include "./vector.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+
+namespace pel
+{
+/**
+ **************************************************************************************************
+ * \brief       Allocator handing out the content of a file, mapped in memory.
+ *
+ *              Only one block can be allocated at a time: it always maps the file from its
+ *              start, and the file is resized to fit the block. Blocks are resized through the
+ *              `reallocate` extension (see allocator_extensions.hpp), which grows the file with
+ *              `ftruncate` and remaps it without copying anything.
+ *
+ * \tparam      ItemType: Type of the elements to allocate. Must be trivially copyable, since the
+ *                        elements are stored as-is in the file.
+ *************************************************************************************************/
+template<typename ItemType>
+class mapped_file_allocator
+{
+    static_assert(std::is_trivially_copyable_v<ItemType>,
+                  "mapped_file_allocator can only store trivially copyable types");
+
+public:
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+    using value_type = ItemType;
+    using size_type  = std::size_t;
+
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap            = std::false_type;
+    using is_always_equal                        = std::false_type;
+
+    template<typename OtherType>
+    struct rebind
+    {
+        using other = mapped_file_allocator<OtherType>;
+    };
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+    explicit mapped_file_allocator(std::shared_ptr<mapped_file> file_) noexcept
+    : m_file{std::move(file_)}
+    {
+    }
+
+    template<typename OtherType>
+    mapped_file_allocator(const mapped_file_allocator<OtherType>& other_) noexcept
+    : m_file{other_.file()}
+    {
+    }
+
+
+    /*********************************************************************************************/
+    /* Allocation ------------------------------------------------------------------------------ */
+    [[nodiscard]] ItemType*
+    allocate(size_type count_)
+    {
+        if(count_ == 0)
+        {
+            return nullptr;
+        }
+
+        m_file->resize(bytes_of(count_));
+        return static_cast<ItemType*>(m_file->map(bytes_of(count_)));
+    }
+
+    void
+    deallocate(ItemType* ptr_, size_type count_) noexcept
+    {
+        if(ptr_ != nullptr)
+        {
+            mapped_file::unmap(ptr_, bytes_of(count_));
+        }
+    }
+
+
+    /*********************************************************************************************/
+    /* Allocator extensions -------------------------------------------------------------------- */
+
+    /**
+     **********************************************************************************************
+     * \brief   Resize the file and its mapping. The content of the block is kept as-is.
+     *
+     * \retval  ItemType*: New address of the block.
+     *
+     * \throws  std::system_error: Could not resize the file or its mapping.
+     **********************************************************************************************/
+    [[nodiscard]] ItemType*
+    reallocate(ItemType* ptr_, size_type oldCount_, size_type newCount_)
+    {
+        if(ptr_ == nullptr)
+        {
+            return allocate(newCount_);
+        }
+        if(newCount_ == 0)
+        {
+            deallocate(ptr_, oldCount_);
+            return nullptr;
+        }
+
+        m_file->resize(bytes_of(newCount_));
+        return static_cast<ItemType*>(
+          m_file->remap(ptr_, bytes_of(oldCount_), bytes_of(newCount_)));
+    }
+
+
+    /*********************************************************************************************/
+    /* Accessors ------------------------------------------------------------------------------- */
+    [[nodiscard]] const std::shared_ptr<mapped_file>&
+    file() const noexcept
+    {
+        return m_file;
+    }
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    [[nodiscard]] static constexpr size_type
+    bytes_of(size_type count_) noexcept
+    {
+        return count_ * sizeof(ItemType);
+    }
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    std::shared_ptr<mapped_file> m_file;
+};
+
+template<typename ItemType, typename OtherType>
+bool
+operator==(const mapped_file_allocator<ItemType>&  lhs_,
+           const mapped_file_allocator<OtherType>& rhs_) noexcept
+{
+    return lhs_.file() == rhs_.file();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Vector whose elements live in a file mapped in memory.
+ *
+ *              Opening an existing file maps it as-is: nothing is read or copied, and pages are
+ *              only faulted in when accessed, so files bigger than the physical memory can be
+ *              used. Growing the vector grows the file with `ftruncate` and remaps it.
+ *              It is built on a pel::vector, whose element management methods it exposes. The
+ *              vector is a private base, so that the mapping cannot be moved out through a base
+ *              reference and escape the truncation done by the destructor.
+ *
+ *              The file may hold unused capacity while the vector is open; it is truncated to
+ *              the length of the vector when the vector is destroyed.
+ *
+ * \tparam      ItemType:     Type of the elements. Must be trivially copyable.
+ * \tparam      GrowthPolicy: Policy computing the new capacity when growing.
+ *              [defaults : default_growth_policy]
+ *************************************************************************************************/
+template<typename ItemType, typename GrowthPolicy = default_growth_policy>
+class mapped_vector : private vector<ItemType, mapped_file_allocator<ItemType>, GrowthPolicy>
+{
+    static_assert(is_trivially_relocatable_v<ItemType>,
+                  "mapped_vector can only store trivially relocatable types");
+
+public:
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+    using AllocatorType       = mapped_file_allocator<ItemType>;
+    using VectorType          = vector<ItemType, AllocatorType, GrowthPolicy>;
+    using AllocatorTraits     = std::allocator_traits<AllocatorType>;
+    using SizeType            = typename VectorType::SizeType;
+    using DifferenceType      = typename VectorType::DifferenceType;
+    using IteratorType        = typename VectorType::IteratorType;
+    using RIteratorType       = typename VectorType::RIteratorType;
+    using InitializerListType = typename VectorType::InitializerListType;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+    explicit mapped_vector(const std::filesystem::path& path_,
+                           mapped_file_mode             mode_ = mapped_file_mode::open_or_create);
+
+    mapped_vector(const mapped_vector&) = delete;
+    mapped_vector& operator=(const mapped_vector&) = delete;
+
+    ~mapped_vector() override;
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    using VectorType::at;
+    using VectorType::back;
+    using VectorType::begin;
+    using VectorType::cbegin;
+    using VectorType::cend;
+    using VectorType::end;
+    using VectorType::front;
+    using VectorType::get_allocator;
+    using VectorType::is_empty;
+    using VectorType::length;
+    using VectorType::operator[];
+
+    using VectorType::assign;
+    using VectorType::data;
+
+
+    /*********************************************************************************************/
+    /* Operator overloads ---------------------------------------------------------------------- */
+    mapped_vector& operator+=(const ItemType& rhs_);
+
+    mapped_vector& operator>>(int steps_);
+    mapped_vector& operator<<(int steps_);
+
+
+    /*********************************************************************************************/
+    /* Element management ---------------------------------------------------------------------- */
+    using VectorType::emplace;
+    using VectorType::emplace_back;
+    using VectorType::erase;
+    using VectorType::erase_if;
+    using VectorType::insert;
+    using VectorType::pop_back;
+    using VectorType::push_back;
+    using VectorType::replace;
+    using VectorType::replace_back;
+    using VectorType::replace_front;
+    using VectorType::unordered_erase;
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    using VectorType::capacity;
+    using VectorType::reserve;
+    using VectorType::resize;
+    using VectorType::resize_default_init;
+    using VectorType::resize_for_overwrite;
+    using VectorType::shrink_to_fit;
+
+
+    /*********************************************************************************************/
+    /* File management ------------------------------------------------------------------------- */
+    [[nodiscard]] const std::filesystem::path& path() const noexcept;
+
+    void flush(bool async_ = false);
+
+
+    /*********************************************************************************************/
+    /* Misc ------------------------------------------------------------------------------------ */
+    using VectorType::to_string;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    [[nodiscard]] static std::shared_ptr<mapped_file> open_file(const std::filesystem::path& path_,
+                                                                mapped_file_mode mode_);
+};
+
+}        // namespace pel
+
+
+#include "./mapped_vector.inl"
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
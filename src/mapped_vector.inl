@@ -0,0 +1,209 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./mapped_vector.hpp"
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Constructor for the mapped_vector class.
+ *              The content of an existing file is mapped directly, in constant time.
+ *
+ * \param       path_: Path of the file holding the elements.
+ * \param       mode_: How to open the file.
+ *              [defaults : mapped_file_mode::open_or_create]
+ *
+ * \throws      std::system_error:     Could not open or map the file.
+ * \throws      std::invalid_argument: The size of the file is not a multiple of the element size,
+ *                                     or `mode_` is `mapped_file_mode::read_only`.
+ *************************************************************************************************/
+template<typename ItemType, typename GrowthPolicy>
+mapped_vector<ItemType, GrowthPolicy>::mapped_vector(const std::filesystem::path& path_,
+                                                     mapped_file_mode             mode_)
+: VectorType{0, AllocatorType{open_file(path_, mode_)}}
+{
+    const std::size_t fileSize = this->m_allocator.file()->size();
+    if(fileSize % sizeof(ItemType) != 0)
+    {
+        throw std::invalid_argument("File size is not a multiple of the element size");
+    }
+
+    const SizeType fileLength = fileSize / sizeof(ItemType);
+    if(fileLength != 0)
+    {
+        this->adopt(AllocatorTraits::allocate(this->m_allocator, fileLength),
+                    fileLength,
+                    fileLength);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destructor for the mapped_vector class.
+ *              Truncates the file to the length of the vector, discarding the unused capacity.
+ *              The mapping itself is released by pel::vector's destructor.
+ *************************************************************************************************/
+template<typename ItemType, typename GrowthPolicy>
+mapped_vector<ItemType, GrowthPolicy>::~mapped_vector()
+{
+    try
+    {
+        this->m_allocator.file()->resize(this->length() * sizeof(ItemType));
+    }
+    catch(const std::system_error&)
+    {
+        /* The file keeps its unused capacity, the elements are still valid */
+    }
+}
+
+
+/*************************************************************************************************/
+/* OPERATOR OVERLOADS -------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Overload of the arithmetic += operator to add an element at the end of the vector.
+ *
+ * \param       rhs_: Item to add at the end of the vector.
+ *
+ * \retval      mapped_vector&: Reference the vector itself.
+ *************************************************************************************************/
+template<typename ItemType, typename GrowthPolicy>
+inline mapped_vector<ItemType, GrowthPolicy>&
+mapped_vector<ItemType, GrowthPolicy>::operator+=(const ItemType& rhs_)
+{
+    VectorType::operator+=(rhs_);
+    return *this;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Overload of the right-shift >> operator to shift the vector's elements to the right.
+ *
+ * \param       steps_: Shifts to the right.
+ *
+ * \retval      mapped_vector&: Reference the vector itself.
+ *************************************************************************************************/
+template<typename ItemType, typename GrowthPolicy>
+inline mapped_vector<ItemType, GrowthPolicy>&
+mapped_vector<ItemType, GrowthPolicy>::operator>>(int steps_)
+{
+    VectorType::operator>>(steps_);
+    return *this;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Overload of the left-shift << operator to shift the vector's elements to the left.
+ *
+ * \param       steps_: Shifts to the left.
+ *
+ * \retval      mapped_vector&: Reference the vector itself.
+ *************************************************************************************************/
+template<typename ItemType, typename GrowthPolicy>
+inline mapped_vector<ItemType, GrowthPolicy>&
+mapped_vector<ItemType, GrowthPolicy>::operator<<(int steps_)
+{
+    VectorType::operator<<(steps_);
+    return *this;
+}
+
+
+/*************************************************************************************************/
+/* FILE MANAGEMENT ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Get the path of the file holding the elements.
+ *************************************************************************************************/
+template<typename ItemType, typename GrowthPolicy>
+[[nodiscard]] const std::filesystem::path&
+mapped_vector<ItemType, GrowthPolicy>::path() const noexcept
+{
+    return this->m_allocator.file()->path();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Write the modified elements back to the file.
+ *
+ * \param       async_: Schedule the write-back instead of waiting for it to complete.
+ *              [defaults : false]
+ *
+ * \throws      std::system_error: Could not flush the mapping.
+ *************************************************************************************************/
+template<typename ItemType, typename GrowthPolicy>
+void
+mapped_vector<ItemType, GrowthPolicy>::flush(bool async_)
+{
+    if(this->data() != nullptr)
+    {
+        mapped_file::sync(this->data(), this->capacity() * sizeof(ItemType), async_);
+    }
+}
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Open the file holding the elements.
+ *              A mapped_vector writes to its file as soon as an element changes, so it cannot
+ *              be opened read-only.
+ *
+ * \throws      std::invalid_argument: `mode_` is `mapped_file_mode::read_only`.
+ * \throws      std::system_error:     Could not open the file.
+ *************************************************************************************************/
+template<typename ItemType, typename GrowthPolicy>
+std::shared_ptr<mapped_file>
+mapped_vector<ItemType, GrowthPolicy>::open_file(const std::filesystem::path& path_,
+                                                 mapped_file_mode             mode_)
+{
+    if(mode_ == mapped_file_mode::read_only)
+    {
+        throw std::invalid_argument("A mapped_vector cannot be opened read-only");
+    }
+
+    return std::make_shared<mapped_file>(path_, mode_);
+}
+
+}        // namespace pel
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
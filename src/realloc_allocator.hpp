@@ -0,0 +1,299 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+namespace pel
+{
+/**
+ **************************************************************************************************
+ * \brief       Allocator built on `malloc`/`realloc`, able to resize blocks without copying them.
+ *
+ *              Blocks smaller than `MapThreshold` bytes live on the C heap and are resized with
+ *              `std::realloc`. On Linux, bigger blocks are mapped directly with `mmap` and resized
+ *              with `mremap`, which only updates the page tables instead of copying the data.
+ *
+ *              This allocator implements the `expand_in_place` and `reallocate` extensions (see
+ *              allocator_extensions.hpp), used by pel::vector when growing.
+ *
+ * \tparam      ItemType:     Type of the elements to allocate.
+ * \tparam      MapThreshold: Size in bytes from which blocks are mapped instead of heap-allocated.
+ *              [defaults : 4 MiB]
+ *************************************************************************************************/
+template<typename ItemType, std::size_t MapThreshold = std::size_t{4} * 1024 * 1024>
+class realloc_allocator
+{
+    static_assert(alignof(ItemType) <= alignof(std::max_align_t),
+                  "realloc_allocator does not support over-aligned types");
+
+public:
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+    using value_type                             = ItemType;
+    using size_type                              = std::size_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal                        = std::true_type;
+
+    template<typename OtherType>
+    struct rebind
+    {
+        using other = realloc_allocator<OtherType, MapThreshold>;
+    };
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+    realloc_allocator() noexcept = default;
+
+    template<typename OtherType>
+    realloc_allocator(const realloc_allocator<OtherType, MapThreshold>& /*other_*/) noexcept
+    {
+    }
+
+
+    /*********************************************************************************************/
+    /* Allocation ------------------------------------------------------------------------------ */
+    [[nodiscard]] ItemType*
+    allocate(size_type count_)
+    {
+        if(count_ == 0)
+        {
+            return nullptr;
+        }
+        if(count_ > max_count())
+        {
+            throw std::bad_array_new_length();
+        }
+
+        void* ptr = nullptr;
+        if(is_mapped(bytes_of(count_)))
+        {
+#if defined(__linux__)
+            ptr = ::mmap(nullptr,
+                         round_to_page(bytes_of(count_)),
+                         PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS,
+                         -1,
+                         0);
+            ptr = (ptr == MAP_FAILED) ? nullptr : ptr;
+#endif
+        }
+        else
+        {
+            ptr = std::malloc(bytes_of(count_));
+        }
+
+        if(ptr == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<ItemType*>(ptr);
+    }
+
+    void
+    deallocate(ItemType* ptr_, size_type count_) noexcept
+    {
+        if(ptr_ == nullptr)
+        {
+            return;
+        }
+
+        if(is_mapped(bytes_of(count_)))
+        {
+#if defined(__linux__)
+            ::munmap(ptr_, round_to_page(bytes_of(count_)));
+#endif
+        }
+        else
+        {
+            std::free(ptr_);
+        }
+    }
+
+
+    /*********************************************************************************************/
+    /* Allocator extensions -------------------------------------------------------------------- */
+
+    /**
+     **********************************************************************************************
+     * \brief   Try to resize a block without moving it.
+     *          Only mapped blocks can be resized in place, by remapping their pages.
+     *
+     * \retval  bool: True if the block at `ptr_` now holds `newCount_` elements.
+     **********************************************************************************************/
+    bool
+    expand_in_place(ItemType* ptr_, size_type oldCount_, size_type newCount_) noexcept
+    {
+        if(ptr_ == nullptr || newCount_ > max_count() || !is_mapped(bytes_of(oldCount_))
+           || !is_mapped(bytes_of(newCount_)))
+        {
+            return false;
+        }
+
+        const size_type oldSize = round_to_page(bytes_of(oldCount_));
+        const size_type newSize = round_to_page(bytes_of(newCount_));
+        if(oldSize == newSize)
+        {
+            return true;
+        }
+
+#if defined(__linux__)
+        return ::mremap(ptr_, oldSize, newSize, 0) != MAP_FAILED;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     **********************************************************************************************
+     * \brief   Resize a block, moving its content bitwise if it cannot be resized in place.
+     *
+     * \retval  ItemType*: New address of the block.
+     *
+     * \throws  std::bad_alloc: Could not resize the block. `ptr_` is left untouched.
+     * \throws  std::bad_array_new_length: `newCount_` elements don't fit in memory.
+     **********************************************************************************************/
+    [[nodiscard]] ItemType*
+    reallocate(ItemType* ptr_, size_type oldCount_, size_type newCount_)
+    {
+        if(ptr_ == nullptr)
+        {
+            return allocate(newCount_);
+        }
+        if(newCount_ == 0)
+        {
+            deallocate(ptr_, oldCount_);
+            return nullptr;
+        }
+        if(newCount_ > max_count())
+        {
+            throw std::bad_array_new_length();
+        }
+
+        const bool oldMapped = is_mapped(bytes_of(oldCount_));
+        const bool newMapped = is_mapped(bytes_of(newCount_));
+
+        void* ptr = nullptr;
+        if(oldMapped && newMapped)
+        {
+#if defined(__linux__)
+            ptr = ::mremap(ptr_,
+                           round_to_page(bytes_of(oldCount_)),
+                           round_to_page(bytes_of(newCount_)),
+                           MREMAP_MAYMOVE);
+            ptr = (ptr == MAP_FAILED) ? nullptr : ptr;
+#endif
+        }
+        else if(!oldMapped && !newMapped)
+        {
+            ptr = std::realloc(ptr_, bytes_of(newCount_));
+        }
+        else
+        {
+            /* Crossing the threshold: the block changes kind and has to be copied */
+            ItemType* newPtr = allocate(newCount_);
+            std::memcpy(static_cast<void*>(newPtr),
+                        static_cast<const void*>(ptr_),
+                        bytes_of(oldCount_ < newCount_ ? oldCount_ : newCount_));
+            deallocate(ptr_, oldCount_);
+            ptr = newPtr;
+        }
+
+        if(ptr == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<ItemType*>(ptr);
+    }
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    /** Largest number of elements whose size, rounded to a page, doesn't overflow. */
+    [[nodiscard]] static size_type
+    max_count() noexcept
+    {
+        return (static_cast<size_type>(-1) - page_size()) / sizeof(ItemType);
+    }
+
+    [[nodiscard]] static constexpr size_type
+    bytes_of(size_type count_) noexcept
+    {
+        return count_ * sizeof(ItemType);
+    }
+
+    [[nodiscard]] static constexpr bool
+    is_mapped([[maybe_unused]] size_type bytes_) noexcept
+    {
+#if defined(__linux__)
+        return bytes_ >= MapThreshold;
+#else
+        return false;
+#endif
+    }
+
+    [[nodiscard]] static size_type
+    page_size() noexcept
+    {
+#if defined(__linux__)
+        static const auto pageSize = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+        return pageSize;
+#else
+        return 1;
+#endif
+    }
+
+    [[nodiscard]] static size_type
+    round_to_page(size_type bytes_) noexcept
+    {
+        return (bytes_ + page_size() - 1) / page_size() * page_size();
+    }
+};
+
+template<typename ItemType, typename OtherType, std::size_t MapThreshold>
+constexpr bool
+operator==(const realloc_allocator<ItemType, MapThreshold>& /*lhs_*/,
+           const realloc_allocator<OtherType, MapThreshold>& /*rhs_*/) noexcept
+{
+    return true;
+}
+
+}        // namespace pel
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
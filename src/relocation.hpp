@@ -0,0 +1,189 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+
+namespace pel
+{
+/**
+ **************************************************************************************************
+ * \brief       Trait telling whether an object of type `ItemType` can be moved to a new address
+ *              with a plain `memcpy`, without calling its move constructor and destructor.
+ *
+ * \note        Trivially copyable types are trivially relocatable. Other types (e.g. types
+ *              holding a `std::unique_ptr`) can opt-in by specializing this trait:
+ *              `template<> struct pel::is_trivially_relocatable<MyType> : std::true_type {};`
+ *************************************************************************************************/
+template<typename ItemType>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<ItemType>>
+{
+};
+
+template<typename ItemType>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<ItemType>::value;
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy every element of a range, through an allocator.
+ *
+ * \param       alloc_: Allocator that constructed the elements.
+ * \param       first_: Pointer to the first element to destroy.
+ * \param       last_:  Pointer past the last element to destroy.
+ *************************************************************************************************/
+template<typename AllocatorType, typename ItemType>
+inline void
+destroy_range(AllocatorType& alloc_, ItemType* first_, ItemType* last_) noexcept
+{
+    if constexpr(std::is_trivially_destructible_v<ItemType> == false)
+    {
+        for(; first_ != last_; ++first_)
+        {
+            std::allocator_traits<AllocatorType>::destroy(alloc_, first_);
+        }
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Relocate a range of elements to uninitialized memory.
+ *              Once relocated, the source range is left as uninitialized memory.
+ *
+ * \param       alloc_: Allocator used to construct and destroy the elements.
+ * \param       first_: Pointer to the first element to relocate.
+ * \param       last_:  Pointer past the last element to relocate.
+ * \param       dest_:  Uninitialized memory receiving the elements. Must not overlap the source.
+ *
+ * \retval      ItemType*: Pointer past the last relocated element in the destination.
+ *
+ * \note        Trivially relocatable types are relocated with a single `memcpy`. Other types are
+ *              move-constructed (copy-constructed if their move constructor can throw) and then
+ *              destroyed. If a construction throws, the elements already built in the destination
+ *              are destroyed. The source range is only left untouched when elements are copied;
+ *              move-only types with a throwing move constructor leave the elements already moved
+ *              from in a moved-from state.
+ *************************************************************************************************/
+template<typename AllocatorType, typename ItemType>
+inline ItemType*
+relocate(AllocatorType& alloc_, ItemType* first_, ItemType* last_, ItemType* dest_)
+{
+    if constexpr(is_trivially_relocatable_v<ItemType>)
+    {
+        if(first_ != last_)
+        {
+            std::memcpy(static_cast<void*>(dest_),
+                        static_cast<const void*>(first_),
+                        static_cast<std::size_t>(last_ - first_) * sizeof(ItemType));
+        }
+        return dest_ + (last_ - first_);
+    }
+    else
+    {
+        using AllocatorTraits = std::allocator_traits<AllocatorType>;
+
+        ItemType* current = dest_;
+        try
+        {
+            for(ItemType* it = first_; it != last_; ++it, ++current)
+            {
+                AllocatorTraits::construct(alloc_, current, std::move_if_noexcept(*it));
+            }
+        }
+        catch(...)
+        {
+            destroy_range(alloc_, dest_, current);
+            throw;
+        }
+
+        destroy_range(alloc_, first_, last_);
+        return current;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy a range of elements to uninitialized memory.
+ *
+ * \param       alloc_: Allocator used to construct and destroy the copies.
+ * \param       first_: Pointer to the first element to copy.
+ * \param       last_:  Pointer past the last element to copy.
+ * \param       dest_:  Uninitialized memory receiving the copies. Must not overlap the source.
+ *
+ * \retval      ItemType*: Pointer past the last copied element in the destination.
+ *
+ * \note        Trivially copyable types are copied with a single `memcpy`. Other types are
+ *              copy-constructed through the allocator. If a construction throws, the copies made so
+ *              far are destroyed.
+ *************************************************************************************************/
+template<typename AllocatorType, typename ItemType>
+inline ItemType*
+copy_to_uninitialized(AllocatorType&  alloc_,
+                      const ItemType* first_,
+                      const ItemType* last_,
+                      ItemType*       dest_)
+{
+    if constexpr(std::is_trivially_copyable_v<ItemType>)
+    {
+        if(first_ != last_)
+        {
+            std::memcpy(static_cast<void*>(dest_),
+                        static_cast<const void*>(first_),
+                        static_cast<std::size_t>(last_ - first_) * sizeof(ItemType));
+        }
+        return dest_ + (last_ - first_);
+    }
+    else
+    {
+        using AllocatorTraits = std::allocator_traits<AllocatorType>;
+
+        ItemType* current = dest_;
+        try
+        {
+            for(const ItemType* it = first_; it != last_; ++it, ++current)
+            {
+                AllocatorTraits::construct(alloc_, current, *it);
+            }
+        }
+        catch(...)
+        {
+            destroy_range(alloc_, dest_, current);
+            throw;
+        }
+
+        return current;
+    }
+}
+
+}        // namespace pel
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
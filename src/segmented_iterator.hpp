@@ -0,0 +1,149 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+
+namespace pel
+{
+/**
+ **************************************************************************************************
+ * \brief       Random-access iterator over the elements of a segmented container.
+ *              Holds the container and an index, so it stays valid when the container grows.
+ *
+ * \tparam      ContainerType: Container iterated over, const-qualified for const iterators.
+ * \tparam      ItemType:      Type of the elements, const-qualified for const iterators.
+ *************************************************************************************************/
+template<typename ContainerType, typename ItemType>
+class segmented_iterator
+{
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = std::remove_cv_t<ItemType>;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = ItemType*;
+    using reference         = ItemType&;
+
+    segmented_iterator() noexcept = default;
+    segmented_iterator(ContainerType* container_, std::size_t index_) noexcept
+    : m_container{container_}, m_index{index_}
+    {
+    }
+
+    /* Conversion from iterator to const iterator */
+    template<typename OtherContainerType, typename OtherItemType>
+        requires std::is_convertible_v<OtherItemType*, ItemType*>
+    segmented_iterator(const segmented_iterator<OtherContainerType, OtherItemType>& other_) noexcept
+    : m_container{other_.container()}, m_index{other_.index()}
+    {
+    }
+
+    [[nodiscard]] ContainerType* container() const noexcept { return m_container; }
+    [[nodiscard]] std::size_t    index() const noexcept { return m_index; }
+
+    reference operator*() const noexcept { return (*m_container)[m_index]; }
+    pointer   operator->() const noexcept { return &(*m_container)[m_index]; }
+    reference operator[](difference_type offset_) const noexcept
+    {
+        return (*m_container)[m_index + static_cast<std::size_t>(offset_)];
+    }
+
+    segmented_iterator& operator++() noexcept
+    {
+        ++m_index;
+        return *this;
+    }
+    segmented_iterator& operator--() noexcept
+    {
+        --m_index;
+        return *this;
+    }
+    segmented_iterator operator++(int) noexcept
+    {
+        segmented_iterator copy = *this;
+        ++m_index;
+        return copy;
+    }
+    segmented_iterator operator--(int) noexcept
+    {
+        segmented_iterator copy = *this;
+        --m_index;
+        return copy;
+    }
+
+    segmented_iterator& operator+=(difference_type offset_) noexcept
+    {
+        m_index += static_cast<std::size_t>(offset_);
+        return *this;
+    }
+    segmented_iterator& operator-=(difference_type offset_) noexcept
+    {
+        m_index -= static_cast<std::size_t>(offset_);
+        return *this;
+    }
+
+    friend segmented_iterator operator+(segmented_iterator it_, difference_type offset_) noexcept
+    {
+        return it_ += offset_;
+    }
+    friend segmented_iterator operator+(difference_type offset_, segmented_iterator it_) noexcept
+    {
+        return it_ += offset_;
+    }
+    friend segmented_iterator operator-(segmented_iterator it_, difference_type offset_) noexcept
+    {
+        return it_ -= offset_;
+    }
+    friend difference_type operator-(const segmented_iterator& lhs_,
+                                     const segmented_iterator& rhs_) noexcept
+    {
+        return static_cast<difference_type>(lhs_.m_index)
+               - static_cast<difference_type>(rhs_.m_index);
+    }
+
+    friend bool operator==(const segmented_iterator& lhs_, const segmented_iterator& rhs_) noexcept
+    {
+        return lhs_.m_index == rhs_.m_index;
+    }
+    friend std::strong_ordering operator<=>(const segmented_iterator& lhs_,
+                                            const segmented_iterator& rhs_) noexcept
+    {
+        return lhs_.m_index <=> rhs_.m_index;
+    }
+
+private:
+    ContainerType* m_container = nullptr;
+    std::size_t    m_index     = 0;
+};
+
+}        // namespace pel
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,313 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./mapped_file.hpp"
+#include "./vector.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+
+namespace pel
+{
+/**
+ **************************************************************************************************
+ * \brief       Error raised when serialized data cannot be written, read or validated.
+ *************************************************************************************************/
+class serialization_error : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Layout of the payload following a serialization header.
+ *************************************************************************************************/
+enum class serialization_format : std::uint16_t
+{
+    raw     = 0,        //!< Elements stored as-is, in memory layout. Trivially copyable types only.
+    chunked = 1,        //!< Elements written one by one through pel::serializer, in chunks.
+};
+
+inline constexpr std::array<char, 8> serialization_magic = {'P', 'E', 'L', 'V', 'E', 'C', 'T', 'R'};
+inline constexpr std::uint16_t       serialization_version           = 1;
+inline constexpr std::uint16_t       serialization_endianness_marker = 0x0102;
+inline constexpr std::size_t         serialization_chunk_size        = std::size_t{1} * 1024 * 1024;
+
+
+/**
+ **************************************************************************************************
+ * \brief       Header of a serialized vector, written before its elements.
+ *
+ *              The header is 64 bytes long, so that raw payloads mapped in memory are aligned for
+ *              any element type. The checksum covers the payload only.
+ *
+ *              A chunked payload is a sequence of chunks, each made of its size in bytes and its
+ *              number of elements (both as `std::uint64_t`), followed by the serialized elements.
+ *************************************************************************************************/
+struct serialization_header
+{
+    std::array<char, 8>  m_magic;
+    std::uint16_t        m_version;
+    std::uint16_t        m_endianness;
+    serialization_format m_format;
+    std::uint16_t        m_reserved0;
+    std::uint64_t        m_typeTag;
+    std::uint32_t        m_elementSize;
+    std::uint32_t        m_elementAlignment;
+    std::uint64_t        m_length;
+    std::uint64_t        m_payloadSize;
+    std::uint64_t        m_checksum;
+    std::uint64_t        m_reserved1;
+};
+
+static_assert(sizeof(serialization_header) == 64, "Serialization header must be 64 bytes long");
+static_assert(std::is_trivially_copyable_v<serialization_header>,
+              "Serialization header must be trivially copyable");
+
+
+/**
+ **************************************************************************************************
+ * \brief       Customization point to serialize types that are not trivially copyable.
+ *
+ *              Specializations provide:
+ *              - `static constexpr std::uint64_t type_tag`: Identifier of the serialized type.
+ *              - `static void write(std::string& buffer_, const ItemType& value_)`: Append the
+ *                serialized value to `buffer_`.
+ *              - `static ItemType read(std::string_view& buffer_)`: Read a value from the start of
+ *                `buffer_`, and remove the bytes read from it.
+ *
+ *              Trivially copyable types are always stored as-is, and only need a specialization
+ *              to provide a more specific `type_tag`.
+ *************************************************************************************************/
+template<typename ItemType>
+struct serializer
+{
+};
+
+template<typename ItemType>
+concept has_serializer = requires(std::string& buffer_, std::string_view& view_, const ItemType& v_)
+{
+    serializer<ItemType>::write(buffer_, v_);
+    {
+        serializer<ItemType>::read(view_)
+        } -> std::same_as<ItemType>;
+};
+
+template<typename ItemType>
+concept serializable = std::is_trivially_copyable_v<ItemType> || has_serializer<ItemType>;
+
+
+/*************************************************************************************************/
+/* Checksum ------------------------------------------------------------------------------------ */
+inline constexpr std::uint64_t checksum_seed  = 0xCBF29CE484222325ULL;
+inline constexpr std::uint64_t checksum_prime = 0x00000100000001B3ULL;
+
+[[nodiscard]] inline std::uint64_t
+update_checksum(std::uint64_t checksum_, const void* data_, std::size_t size_) noexcept;
+
+template<typename ItemType>
+[[nodiscard]] constexpr std::uint64_t
+serialization_type_tag() noexcept;
+
+
+/*************************************************************************************************/
+/* Buffer helpers ------------------------------------------------------------------------------ */
+template<typename ValueType>
+void
+serialize_value(std::string& buffer_, const ValueType& value_);
+
+template<typename ValueType>
+[[nodiscard]] ValueType
+deserialize_value(std::string_view& buffer_);
+
+
+/*************************************************************************************************/
+/* Stream serialization ------------------------------------------------------------------------ */
+template<serializable ItemType>
+void
+write_serialized(std::ostream& os_, const ItemType* data_, std::size_t length_);
+
+template<serializable ItemType>
+[[nodiscard]] serialization_header
+read_serialization_header(std::istream& is_);
+
+template<typename ItemType>
+void
+check_serialization_header(const serialization_header& header_);
+
+[[nodiscard]] inline std::uint64_t
+remaining_stream_size(std::istream& is_);
+
+template<typename ItemType>
+[[nodiscard]] constexpr std::size_t
+serialization_step_length() noexcept;
+
+[[nodiscard]] inline std::uint64_t
+read_serialized_raw(std::istream& is_,
+                    void*         destination_,
+                    std::size_t   size_,
+                    std::uint64_t checksum_);
+
+template<typename ItemType, typename EmplaceFunction>
+void
+read_serialized_chunks(std::istream&               is_,
+                       const serialization_header& header_,
+                       EmplaceFunction&&           emplace_);
+
+
+/*************************************************************************************************/
+/* Vectors ------------------------------------------------------------------------------------- */
+template<serializable ItemType,
+         typename AllocatorType,
+         typename GrowthPolicy,
+         typename Instrumentation>
+void
+save(const vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>& vector_,
+     std::ostream&                                                         os_);
+
+template<serializable ItemType,
+         typename AllocatorType,
+         typename GrowthPolicy,
+         typename Instrumentation>
+void
+load(vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>& vector_, std::istream& is_);
+
+
+/**
+ **************************************************************************************************
+ * \brief       Serializer for std::string: the length followed by the characters.
+ *************************************************************************************************/
+template<>
+struct serializer<std::string>
+{
+    static constexpr std::uint64_t type_tag = 0x5354524E47000001ULL;
+
+    static void
+    write(std::string& buffer_, const std::string& value_)
+    {
+        serialize_value<std::uint64_t>(buffer_, value_.size());
+        buffer_.append(value_);
+    }
+
+    [[nodiscard]] static std::string
+    read(std::string_view& buffer_)
+    {
+        const auto size = deserialize_value<std::uint64_t>(buffer_);
+        if(size > buffer_.size())
+        {
+            throw serialization_error("Serialized string is truncated");
+        }
+
+        std::string value{buffer_.substr(0, static_cast<std::size_t>(size))};
+        buffer_.remove_prefix(static_cast<std::size_t>(size));
+        return value;
+    }
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Read-only view over the elements of a serialized vector, mapped directly from its
+ *              file. Nothing is copied: pages are faulted in lazily when elements are accessed.
+ *
+ * \tparam      ItemType: Type of the elements. Must be trivially copyable, and the file must hold
+ *                        a raw payload of that type.
+ *************************************************************************************************/
+template<typename ItemType>
+class serialized_view
+{
+    static_assert(std::is_trivially_copyable_v<ItemType>,
+                  "serialized_view can only view trivially copyable types");
+    static_assert(alignof(ItemType) <= sizeof(serialization_header),
+                  "serialized_view cannot view over-aligned types");
+
+public:
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+    using SizeType     = std::size_t;
+    using IteratorType = const ItemType*;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+    explicit serialized_view(const std::filesystem::path& path_);
+
+    serialized_view(const serialized_view&) = delete;
+    serialized_view& operator=(const serialized_view&) = delete;
+
+    ~serialized_view();
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    [[nodiscard]] const ItemType* data() const noexcept;
+    [[nodiscard]] SizeType        length() const noexcept;
+
+    [[nodiscard]] IteratorType begin() const noexcept;
+    [[nodiscard]] IteratorType end() const noexcept;
+
+    [[nodiscard]] const ItemType& operator[](SizeType index_) const noexcept;
+    [[nodiscard]] const ItemType& at(SizeType index_) const;
+
+
+    /*********************************************************************************************/
+    /* Misc ------------------------------------------------------------------------------------ */
+    [[nodiscard]] const serialization_header& header() const noexcept;
+
+    [[nodiscard]] bool verify() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    mapped_file m_file;
+    std::size_t m_mappedSize = 0;
+    void*       m_mapping    = nullptr;
+};
+
+}        // namespace pel
+
+
+#include "./serialization.inl"
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,748 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./serialization.hpp"
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CHECKSUM ------------------------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Add a block of bytes to a checksum.
+ *              FNV-1a, applied to 64-bit words instead of single bytes to keep up with the
+ *              bandwidth of the storage. The remaining bytes are hashed one by one.
+ *
+ * \param       checksum_: Checksum of the previous blocks, or `checksum_seed`.
+ * \param       data_:     Block of bytes to hash.
+ * \param       size_:     Size of the block, in bytes.
+ *
+ * \retval      std::uint64_t: Updated checksum.
+ *
+ * \note        The result depends on how the data is split in blocks.
+ *************************************************************************************************/
+[[nodiscard]] inline std::uint64_t
+update_checksum(std::uint64_t checksum_, const void* data_, std::size_t size_) noexcept
+{
+    const auto* bytes = static_cast<const unsigned char*>(data_);
+
+    for(; size_ >= sizeof(std::uint64_t); size_ -= sizeof(std::uint64_t))
+    {
+        std::uint64_t word;
+        std::memcpy(&word, bytes, sizeof(std::uint64_t));
+        checksum_ = (checksum_ ^ word) * checksum_prime;
+        bytes += sizeof(std::uint64_t);
+    }
+
+    for(; size_ > 0; --size_)
+    {
+        checksum_ = (checksum_ ^ *bytes) * checksum_prime;
+        ++bytes;
+    }
+
+    return checksum_;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the identifier stored in the serialization header for a type.
+ *              Uses `serializer<ItemType>::type_tag` when available. Otherwise, the tag is built
+ *              from the kind of type (integer, floating point, ...), its size and its alignment.
+ *************************************************************************************************/
+template<typename ItemType>
+[[nodiscard]] constexpr std::uint64_t
+serialization_type_tag() noexcept
+{
+    if constexpr(requires { serializer<ItemType>::type_tag; })
+    {
+        return serializer<ItemType>::type_tag;
+    }
+    else
+    {
+        std::uint64_t kind = 'o';
+        if constexpr(std::is_same_v<ItemType, bool>)
+        {
+            kind = 'b';
+        }
+        else if constexpr(std::is_floating_point_v<ItemType>)
+        {
+            kind = 'f';
+        }
+        else if constexpr(std::is_integral_v<ItemType>)
+        {
+            kind = std::is_signed_v<ItemType> ? 'i' : 'u';
+        }
+
+        std::uint64_t tag = checksum_seed;
+        for(const std::uint64_t descriptor : {kind,
+                                              std::uint64_t{sizeof(ItemType)},
+                                              std::uint64_t{alignof(ItemType)}})
+        {
+            tag = (tag ^ descriptor) * checksum_prime;
+        }
+        return tag;
+    }
+}
+
+
+/*************************************************************************************************/
+/* BUFFER HELPERS ------------------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Append the bytes of a trivially copyable value to a serialization buffer.
+ *************************************************************************************************/
+template<typename ValueType>
+inline void
+serialize_value(std::string& buffer_, const ValueType& value_)
+{
+    static_assert(std::is_trivially_copyable_v<ValueType>, "Value must be trivially copyable");
+
+    buffer_.append(reinterpret_cast<const char*>(&value_), sizeof(ValueType));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Read a trivially copyable value from the start of a serialization buffer.
+ *
+ * \throws      pel::serialization_error: The buffer is too small to hold the value.
+ *************************************************************************************************/
+template<typename ValueType>
+[[nodiscard]] inline ValueType
+deserialize_value(std::string_view& buffer_)
+{
+    static_assert(std::is_trivially_copyable_v<ValueType>, "Value must be trivially copyable");
+
+    if(buffer_.size() < sizeof(ValueType))
+    {
+        throw serialization_error("Serialized value is truncated");
+    }
+
+    ValueType value;
+    std::memcpy(&value, buffer_.data(), sizeof(ValueType));
+    buffer_.remove_prefix(sizeof(ValueType));
+    return value;
+}
+
+
+/*************************************************************************************************/
+/* STREAM SERIALIZATION ------------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Write a header and a block of elements to a binary stream.
+ *
+ *              Trivially copyable elements are written as-is, in a single write. Other elements
+ *              are serialized through pel::serializer into chunks of about
+ *              `serialization_chunk_size` bytes, so that the memory overhead stays bounded.
+ *
+ * \param       os_:     Binary stream to write to.
+ * \param       data_:   First element to write.
+ * \param       length_: Number of elements to write.
+ *
+ * \throws      pel::serialization_error: Could not write to the stream.
+ *
+ * \note        Chunked payloads require a seekable stream, since the header is written again
+ *              once the size and checksum of the payload are known.
+ *************************************************************************************************/
+template<serializable ItemType>
+void
+write_serialized(std::ostream& os_, const ItemType* data_, std::size_t length_)
+{
+    serialization_header header{};
+    header.m_magic            = serialization_magic;
+    header.m_version          = serialization_version;
+    header.m_endianness       = serialization_endianness_marker;
+    header.m_typeTag          = serialization_type_tag<ItemType>();
+    header.m_elementSize      = static_cast<std::uint32_t>(sizeof(ItemType));
+    header.m_elementAlignment = static_cast<std::uint32_t>(alignof(ItemType));
+    header.m_length           = length_;
+
+    if constexpr(std::is_trivially_copyable_v<ItemType>)
+    {
+        const std::size_t payloadSize = length_ * sizeof(ItemType);
+
+        header.m_format      = serialization_format::raw;
+        header.m_payloadSize = payloadSize;
+        header.m_checksum    = update_checksum(checksum_seed, data_, payloadSize);
+
+        os_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        os_.write(reinterpret_cast<const char*>(data_), static_cast<std::streamsize>(payloadSize));
+    }
+    else
+    {
+        const std::ostream::pos_type headerPosition = os_.tellp();
+        if(headerPosition == std::ostream::pos_type(-1))
+        {
+            throw serialization_error("Chunked serialization requires a seekable stream");
+        }
+        header.m_format = serialization_format::chunked;
+        os_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        std::string   chunk;
+        std::uint64_t chunkLength = 0;
+        std::uint64_t payloadSize = 0;
+        std::uint64_t checksum    = checksum_seed;
+        chunk.reserve(serialization_chunk_size);
+
+        auto writeChunk = [&]()
+        {
+            const std::uint64_t chunkHeader[2] = {chunk.size(), chunkLength};
+            checksum = update_checksum(checksum, chunkHeader, sizeof(chunkHeader));
+            checksum = update_checksum(checksum, chunk.data(), chunk.size());
+
+            os_.write(reinterpret_cast<const char*>(chunkHeader), sizeof(chunkHeader));
+            os_.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+
+            payloadSize += sizeof(chunkHeader) + chunk.size();
+            chunkLength = 0;
+            chunk.clear();
+        };
+
+        for(std::size_t i = 0; i < length_; ++i)
+        {
+            serializer<ItemType>::write(chunk, data_[i]);
+            ++chunkLength;
+
+            if(chunk.size() >= serialization_chunk_size)
+            {
+                writeChunk();
+            }
+        }
+        if(chunkLength != 0)
+        {
+            writeChunk();
+        }
+
+        /* Write the header again, now that the payload is known */
+        header.m_payloadSize = payloadSize;
+        header.m_checksum    = checksum;
+
+        const std::ostream::pos_type endPosition = os_.tellp();
+        os_.seekp(headerPosition);
+        os_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        os_.seekp(endPosition);
+    }
+
+    if(!os_)
+    {
+        throw serialization_error("Could not write serialized vector");
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Read and validate a serialization header from a binary stream.
+ *
+ * \throws      pel::serialization_error: Could not read the header, or it does not describe a
+ *                                        vector of `ItemType`.
+ *************************************************************************************************/
+template<serializable ItemType>
+[[nodiscard]] serialization_header
+read_serialization_header(std::istream& is_)
+{
+    serialization_header header;
+    if(!is_.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        throw serialization_error("Could not read serialization header");
+    }
+
+    check_serialization_header<ItemType>(header);
+    return header;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Check that a serialization header describes a vector of `ItemType`, written in a
+ *              format that can be read on this platform.
+ *
+ * \throws      pel::serialization_error: The header does not match.
+ *************************************************************************************************/
+template<typename ItemType>
+void
+check_serialization_header(const serialization_header& header_)
+{
+    if(header_.m_magic != serialization_magic)
+    {
+        throw serialization_error("Data is not a serialized vector");
+    }
+    if(header_.m_endianness != serialization_endianness_marker)
+    {
+        throw serialization_error("Serialized vector has a different endianness");
+    }
+    if(header_.m_version > serialization_version)
+    {
+        throw serialization_error("Serialized vector has an unsupported version");
+    }
+    if(header_.m_typeTag != serialization_type_tag<ItemType>()
+       || header_.m_elementSize != sizeof(ItemType)
+       || header_.m_elementAlignment != alignof(ItemType))
+    {
+        throw serialization_error("Serialized vector has a different element type");
+    }
+
+    if constexpr(std::is_trivially_copyable_v<ItemType>)
+    {
+        if(header_.m_format != serialization_format::raw
+           || header_.m_length > header_.m_payloadSize / sizeof(ItemType)
+           || header_.m_payloadSize != header_.m_length * sizeof(ItemType))
+        {
+            throw serialization_error("Serialized vector has an inconsistent raw payload");
+        }
+    }
+    else
+    {
+        if(header_.m_format != serialization_format::chunked)
+        {
+            throw serialization_error("Serialized vector has an unexpected payload format");
+        }
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the number of bytes left in a binary stream after its current position.
+ *
+ * \retval      std::uint64_t: Number of bytes left, or the largest value if the stream can't be
+ *                             seeked.
+ *************************************************************************************************/
+[[nodiscard]] inline std::uint64_t
+remaining_stream_size(std::istream& is_)
+{
+    constexpr std::uint64_t unknownSize = std::numeric_limits<std::uint64_t>::max();
+
+    const std::istream::pos_type position = is_.tellg();
+    if(position == std::istream::pos_type(-1))
+    {
+        return unknownSize;
+    }
+
+    is_.seekg(0, std::ios::end);
+    const std::istream::pos_type endPosition = is_.tellg();
+    is_.clear();
+    is_.seekg(position);
+
+    if(endPosition == std::istream::pos_type(-1) || endPosition < position)
+    {
+        return unknownSize;
+    }
+    return static_cast<std::uint64_t>(endPosition - position);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the number of elements read at once from a stream whose size is unknown.
+ *              Steps are about `serialization_chunk_size` bytes long, and hold a multiple of 8
+ *              elements, so that reading a payload in steps doesn't change its checksum.
+ *************************************************************************************************/
+template<typename ItemType>
+[[nodiscard]] constexpr std::size_t
+serialization_step_length() noexcept
+{
+    return std::max(std::size_t{8}, serialization_chunk_size / sizeof(ItemType) / 8 * 8);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Read a block of a raw payload from a binary stream, in a single read.
+ *
+ * \param       is_:          Binary stream positioned on the block.
+ * \param       destination_: Memory able to hold `size_` bytes.
+ * \param       size_:        Size of the block, in bytes.
+ * \param       checksum_:    Checksum of the previous blocks, or `checksum_seed`.
+ *
+ * \retval      std::uint64_t: Checksum updated with the block.
+ *
+ * \throws      pel::serialization_error: The payload is truncated.
+ *************************************************************************************************/
+[[nodiscard]] inline std::uint64_t
+read_serialized_raw(std::istream& is_,
+                    void*         destination_,
+                    std::size_t   size_,
+                    std::uint64_t checksum_)
+{
+    if(!is_.read(static_cast<char*>(destination_), static_cast<std::streamsize>(size_)))
+    {
+        throw serialization_error("Serialized payload is truncated");
+    }
+
+    return update_checksum(checksum_, destination_, size_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Read a chunked payload from a binary stream, one chunk at a time.
+ *
+ * \param       is_:      Binary stream positioned after the header.
+ * \param       header_:  Validated header of the payload.
+ * \param       emplace_: Function called with each deserialized element, as an rvalue.
+ *
+ * \throws      pel::serialization_error: The payload is truncated or corrupted. The checksum is
+ *                                        only verified once all elements have been read.
+ *************************************************************************************************/
+template<typename ItemType, typename EmplaceFunction>
+void
+read_serialized_chunks(std::istream&               is_,
+                       const serialization_header& header_,
+                       EmplaceFunction&&           emplace_)
+{
+    std::string   chunk;
+    std::uint64_t remainingSize   = header_.m_payloadSize;
+    std::uint64_t remainingLength = header_.m_length;
+    std::uint64_t checksum        = checksum_seed;
+
+    while(remainingSize != 0)
+    {
+        std::uint64_t chunkHeader[2];
+        if(remainingSize < sizeof(chunkHeader)
+           || !is_.read(reinterpret_cast<char*>(chunkHeader), sizeof(chunkHeader)))
+        {
+            throw serialization_error("Serialized payload is truncated");
+        }
+        remainingSize -= sizeof(chunkHeader);
+
+        if(chunkHeader[0] > remainingSize || chunkHeader[1] > remainingLength)
+        {
+            throw serialization_error("Serialized chunk is inconsistent");
+        }
+
+        /* The chunk grows as its bytes arrive, so a corrupted size can't allocate more memory
+         * than the stream holds */
+        chunk.clear();
+        for(std::uint64_t remainingChunkSize = chunkHeader[0]; remainingChunkSize != 0;)
+        {
+            const std::size_t offset = chunk.size();
+            const std::size_t step   = static_cast<std::size_t>(
+              std::min<std::uint64_t>(remainingChunkSize, serialization_chunk_size));
+
+            chunk.resize(offset + step);
+            if(!is_.read(chunk.data() + offset, static_cast<std::streamsize>(step)))
+            {
+                throw serialization_error("Serialized payload is truncated");
+            }
+            remainingChunkSize -= step;
+        }
+        checksum = update_checksum(checksum, chunkHeader, sizeof(chunkHeader));
+        checksum = update_checksum(checksum, chunk.data(), chunk.size());
+
+        std::string_view chunkView{chunk};
+        for(std::uint64_t i = 0; i < chunkHeader[1]; ++i)
+        {
+            emplace_(serializer<ItemType>::read(chunkView));
+        }
+
+        remainingSize -= chunkHeader[0];
+        remainingLength -= chunkHeader[1];
+    }
+
+    if(remainingLength != 0)
+    {
+        throw serialization_error("Serialized payload is missing elements");
+    }
+    if(checksum != header_.m_checksum)
+    {
+        throw serialization_error("Serialized payload is corrupted");
+    }
+}
+
+
+/*************************************************************************************************/
+/* VECTORS ------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Write a vector to a binary stream, in the pel serialization format.
+ *
+ * \param       vector_: Vector to write.
+ * \param       os_:     Binary stream to write to.
+ *
+ * \throws      pel::serialization_error: Could not write to the stream.
+ *
+ * \note        Trivially copyable elements are written directly from the vector's memory, in a
+ *              single write. Other elements require a specialization of pel::serializer.
+ *************************************************************************************************/
+template<serializable ItemType,
+         typename AllocatorType,
+         typename GrowthPolicy,
+         typename Instrumentation>
+void
+save(const vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>& vector_,
+     std::ostream&                                                         os_)
+{
+    write_serialized(os_, vector_.data(), vector_.length());
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Replace the content of a vector with a vector read from a binary stream.
+ *
+ * \param       vector_: Vector to read into.
+ * \param       is_:     Binary stream to read from, positioned on a serialization header.
+ *
+ * \throws      pel::serialization_error: The stream does not hold a valid vector of `ItemType`.
+ *                                        The vector is left empty.
+ *
+ * \note        Trivially copyable elements are read directly into the memory of the vector, in a
+ *              single read when the size of the stream is known. Otherwise, the vector grows
+ *              about `serialization_chunk_size` bytes at a time, so that a corrupted header can't
+ *              reserve more memory than the stream holds.
+ *************************************************************************************************/
+template<serializable ItemType,
+         typename AllocatorType,
+         typename GrowthPolicy,
+         typename Instrumentation>
+void
+load(vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>& vector_, std::istream& is_)
+{
+    const serialization_header header    = read_serialization_header<ItemType>(is_);
+    const auto                 newLength = static_cast<std::size_t>(header.m_length);
+
+    vector_.erase(vector_.begin(), vector_.end());
+
+    /* The header can't be trusted before the checksum is verified, so memory is only reserved
+     * for what the stream can actually hold */
+    const std::uint64_t availableSize = remaining_stream_size(is_);
+    if(header.m_payloadSize > availableSize)
+    {
+        throw serialization_error("Serialized payload is truncated");
+    }
+
+    try
+    {
+        if constexpr(std::is_trivially_copyable_v<ItemType>)
+        {
+            const std::size_t stepLength =
+              availableSize != std::numeric_limits<std::uint64_t>::max()
+                ? newLength
+                : serialization_step_length<ItemType>();
+
+            std::uint64_t checksum = checksum_seed;
+            while(vector_.length() < newLength)
+            {
+                const std::size_t offset = vector_.length();
+                const std::size_t step   = std::min(newLength - offset, stepLength);
+
+                vector_.resize_for_overwrite(offset + step,
+                                             [&](ItemType* data_, std::size_t length_)
+                                             {
+                                                 checksum = read_serialized_raw(
+                                                   is_,
+                                                   data_ + offset,
+                                                   step * sizeof(ItemType),
+                                                   checksum);
+                                                 return length_;
+                                             });
+            }
+
+            if(checksum != header.m_checksum)
+            {
+                throw serialization_error("Serialized payload is corrupted");
+            }
+        }
+        else
+        {
+            vector_.reserve(std::min(newLength, serialization_step_length<ItemType>()));
+            read_serialized_chunks<ItemType>(is_,
+                                             header,
+                                             [&](ItemType&& item_)
+                                             {
+                                                 vector_.push_back(std::move(item_));
+                                             });
+        }
+    }
+    catch(...)
+    {
+        vector_.erase(vector_.begin(), vector_.end());
+        throw;
+    }
+}
+
+
+/*************************************************************************************************/
+/* SERIALIZED VIEW ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Constructor for the serialized_view class.
+ *              Maps the whole file and validates its header, without reading the elements.
+ *
+ * \param       path_: Path of a file written by pel::save.
+ *
+ * \throws      std::system_error:        Could not open or map the file.
+ * \throws      pel::serialization_error: The file does not hold a raw vector of `ItemType`.
+ *************************************************************************************************/
+template<typename ItemType>
+serialized_view<ItemType>::serialized_view(const std::filesystem::path& path_)
+: m_file{path_, mapped_file_mode::read_only}
+{
+    const std::size_t fileSize = m_file.size();
+    if(fileSize < sizeof(serialization_header))
+    {
+        throw serialization_error("File is too small to hold a serialized vector");
+    }
+
+    m_mapping    = m_file.map(fileSize);
+    m_mappedSize = fileSize;
+
+    try
+    {
+        check_serialization_header<ItemType>(header());
+        if(header().m_payloadSize > fileSize - sizeof(serialization_header))
+        {
+            throw serialization_error("Serialized payload is truncated");
+        }
+    }
+    catch(...)
+    {
+        mapped_file::unmap(m_mapping, m_mappedSize);
+        throw;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destructor for the serialized_view class.
+ *************************************************************************************************/
+template<typename ItemType>
+serialized_view<ItemType>::~serialized_view()
+{
+    mapped_file::unmap(m_mapping, m_mappedSize);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get a pointer to the first element of the view.
+ *************************************************************************************************/
+template<typename ItemType>
+[[nodiscard]] inline const ItemType*
+serialized_view<ItemType>::data() const noexcept
+{
+    return reinterpret_cast<const ItemType*>(static_cast<const std::byte*>(m_mapping)
+                                             + sizeof(serialization_header));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the number of elements in the view.
+ *************************************************************************************************/
+template<typename ItemType>
+[[nodiscard]] inline typename serialized_view<ItemType>::SizeType
+serialized_view<ItemType>::length() const noexcept
+{
+    return static_cast<SizeType>(header().m_length);
+}
+
+
+template<typename ItemType>
+[[nodiscard]] inline typename serialized_view<ItemType>::IteratorType
+serialized_view<ItemType>::begin() const noexcept
+{
+    return data();
+}
+
+
+template<typename ItemType>
+[[nodiscard]] inline typename serialized_view<ItemType>::IteratorType
+serialized_view<ItemType>::end() const noexcept
+{
+    return data() + length();
+}
+
+
+template<typename ItemType>
+[[nodiscard]] inline const ItemType&
+serialized_view<ItemType>::operator[](SizeType index_) const noexcept
+{
+    return data()[index_];
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get an element of the view, with bounds checking.
+ *
+ * \throws      std::out_of_range: `index_` is past the end of the view.
+ *************************************************************************************************/
+template<typename ItemType>
+[[nodiscard]] inline const ItemType&
+serialized_view<ItemType>::at(SizeType index_) const
+{
+    if(index_ >= length())
+    {
+        throw std::out_of_range("Index is out of the view");
+    }
+    return data()[index_];
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the header of the serialized vector.
+ *************************************************************************************************/
+template<typename ItemType>
+[[nodiscard]] inline const serialization_header&
+serialized_view<ItemType>::header() const noexcept
+{
+    return *static_cast<const serialization_header*>(m_mapping);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Verify the checksum of the elements.
+ *
+ * \note        Every element is read, which faults in the whole file.
+ *************************************************************************************************/
+template<typename ItemType>
+[[nodiscard]] bool
+serialized_view<ItemType>::verify() const noexcept
+{
+    const auto payloadSize = static_cast<std::size_t>(header().m_payloadSize);
+    return update_checksum(checksum_seed, data(), payloadSize) == header().m_checksum;
+}
+
+}        // namespace pel
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,175 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define PEL_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#else
+#define PEL_SIMD_X86 0
+#endif
+
+
+namespace pel::simd
+{
+/**
+ **************************************************************************************************
+ * \brief       Instruction sets for which explicit kernels are available, from the least to the
+ *              most capable.
+ *************************************************************************************************/
+enum class isa : std::uint8_t
+{
+    scalar,
+    sse2,
+    avx2,
+    avx512,
+};
+
+[[nodiscard]] inline const char* to_string(isa isa_) noexcept;
+
+[[nodiscard]] inline isa detect_isa() noexcept;
+[[nodiscard]] inline isa active_isa() noexcept;
+inline void              set_active_isa(isa isa_) noexcept;
+
+
+/**
+ **************************************************************************************************
+ * \brief       Element types handled by the algorithms of this file.
+ *              Explicit kernels exist for `std::int32_t`, `float` and `double`; other arithmetic
+ *              types always use the scalar kernels.
+ *************************************************************************************************/
+template<typename ItemType>
+concept arithmetic = std::is_arithmetic_v<ItemType> && !std::is_same_v<ItemType, bool>;
+
+template<typename ItemType>
+inline constexpr bool has_vector_kernels_v = std::is_same_v<ItemType, std::int32_t>
+                                             || std::is_same_v<ItemType, float>
+                                             || std::is_same_v<ItemType, double>;
+
+/**
+ **************************************************************************************************
+ * \brief       Type in which sums and dot products are accumulated.
+ *              Integers are widened to 64 bits, so that summing 32-bit values does not overflow.
+ *************************************************************************************************/
+template<typename ItemType>
+using sum_type_t = std::conditional_t<std::is_integral_v<ItemType>,
+                                      std::conditional_t<std::is_signed_v<ItemType>,
+                                                         std::int64_t,
+                                                         std::uint64_t>,
+                                      ItemType>;
+
+/**
+ **************************************************************************************************
+ * \brief       Containers storing their elements contiguously, such as pel::vector.
+ *************************************************************************************************/
+template<typename ContainerType>
+concept contiguous_container = requires(ContainerType& container_)
+{
+    {
+        container_.data()
+        } -> std::convertible_to<const void*>;
+    {
+        container_.length()
+        } -> std::convertible_to<std::size_t>;
+};
+
+template<contiguous_container ContainerType>
+using container_item_t = std::remove_cvref_t<decltype(*std::declval<ContainerType&>().data())>;
+
+
+/*************************************************************************************************/
+/* Algorithms ---------------------------------------------------------------------------------- */
+template<arithmetic ItemType>
+void fill(ItemType* first_, ItemType* last_, ItemType value_) noexcept;
+
+template<arithmetic ItemType>
+[[nodiscard]] const ItemType*
+find(const ItemType* first_, const ItemType* last_, ItemType value_) noexcept;
+
+template<arithmetic ItemType>
+[[nodiscard]] std::size_t
+count(const ItemType* first_, const ItemType* last_, ItemType value_) noexcept;
+
+template<arithmetic ItemType>
+[[nodiscard]] ItemType minimum(const ItemType* first_, const ItemType* last_) noexcept;
+
+template<arithmetic ItemType>
+[[nodiscard]] ItemType maximum(const ItemType* first_, const ItemType* last_) noexcept;
+
+template<arithmetic ItemType>
+[[nodiscard]] sum_type_t<ItemType> sum(const ItemType* first_, const ItemType* last_) noexcept;
+
+template<arithmetic ItemType>
+[[nodiscard]] sum_type_t<ItemType>
+dot(const ItemType* first1_, const ItemType* last1_, const ItemType* first2_) noexcept;
+
+
+/*************************************************************************************************/
+/* Container overloads ------------------------------------------------------------------------- */
+template<contiguous_container ContainerType>
+void fill(ContainerType& container_, container_item_t<ContainerType> value_) noexcept;
+
+template<contiguous_container ContainerType>
+[[nodiscard]] const container_item_t<ContainerType>*
+find(const ContainerType& container_, container_item_t<ContainerType> value_) noexcept;
+
+template<contiguous_container ContainerType>
+[[nodiscard]] std::size_t
+count(const ContainerType& container_, container_item_t<ContainerType> value_) noexcept;
+
+template<contiguous_container ContainerType>
+[[nodiscard]] container_item_t<ContainerType> minimum(const ContainerType& container_);
+
+template<contiguous_container ContainerType>
+[[nodiscard]] container_item_t<ContainerType> maximum(const ContainerType& container_);
+
+template<contiguous_container ContainerType>
+[[nodiscard]] sum_type_t<container_item_t<ContainerType>>
+sum(const ContainerType& container_) noexcept;
+
+template<contiguous_container ContainerType>
+[[nodiscard]] sum_type_t<container_item_t<ContainerType>>
+dot(const ContainerType& lhs_, const ContainerType& rhs_) noexcept;
+
+}        // namespace pel::simd
+
+
+#include "./simd.inl"
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,1431 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./simd.hpp"
+
+
+namespace pel::simd
+{
+/*************************************************************************************************/
+/* INSTRUCTION SET DETECTION ------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Get the name of an instruction set.
+ *************************************************************************************************/
+[[nodiscard]] inline const char*
+to_string(isa isa_) noexcept
+{
+    switch(isa_)
+    {
+        case isa::sse2:
+            return "SSE2";
+        case isa::avx2:
+            return "AVX2";
+        case isa::avx512:
+            return "AVX-512";
+        case isa::scalar:
+        default:
+            return "scalar";
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the most capable instruction set supported by the processor and the operating
+ *              system.
+ *************************************************************************************************/
+[[nodiscard]] inline isa
+detect_isa() noexcept
+{
+#if PEL_SIMD_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    const bool hasSse2    = (info[3] & (1 << 26)) != 0;
+    const bool hasPopcnt  = (info[2] & (1 << 23)) != 0;
+    const bool hasOsxsave = (info[2] & (1 << 27)) != 0;
+
+    /* The operating system must save the YMM (and ZMM) registers on context switches */
+    const unsigned long long xcr0       = hasOsxsave ? _xgetbv(0) : 0;
+    const bool               osSavesYmm = (xcr0 & 0x06) == 0x06;
+    const bool               osSavesZmm = (xcr0 & 0xE6) == 0xE6;
+
+    bool hasAvx2    = false;
+    bool hasAvx512f = false;
+    if(maxLeaf >= 7)
+    {
+        __cpuidex(info, 7, 0);
+        hasAvx2    = (info[1] & (1 << 5)) != 0;
+        hasAvx512f = (info[1] & (1 << 16)) != 0;
+    }
+
+    if(hasAvx512f && hasPopcnt && osSavesZmm)
+    {
+        return isa::avx512;
+    }
+    if(hasAvx2 && hasPopcnt && osSavesYmm)
+    {
+        return isa::avx2;
+    }
+    if(hasSse2)
+    {
+        return isa::sse2;
+    }
+#else
+    __builtin_cpu_init();
+    const bool hasPopcnt = __builtin_cpu_supports("popcnt");
+    if(__builtin_cpu_supports("avx512f") && hasPopcnt)
+    {
+        return isa::avx512;
+    }
+    if(__builtin_cpu_supports("avx2") && hasPopcnt)
+    {
+        return isa::avx2;
+    }
+    if(__builtin_cpu_supports("sse2"))
+    {
+        return isa::sse2;
+    }
+#endif
+#endif
+    return isa::scalar;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Storage of the instruction set used by the algorithms, detected on first use.
+ *************************************************************************************************/
+[[nodiscard]] inline std::atomic<isa>&
+active_isa_storage() noexcept
+{
+    static std::atomic<isa> activeIsa{detect_isa()};
+    return activeIsa;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the instruction set used by the algorithms.
+ *************************************************************************************************/
+[[nodiscard]] inline isa
+active_isa() noexcept
+{
+    return active_isa_storage().load(std::memory_order_relaxed);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Select the instruction set used by the algorithms, mostly for testing and
+ *              benchmarking. Instruction sets that are not supported are replaced by the most
+ *              capable supported one.
+ *************************************************************************************************/
+inline void
+set_active_isa(isa isa_) noexcept
+{
+    const isa supported = detect_isa();
+    active_isa_storage().store(isa_ < supported ? isa_ : supported, std::memory_order_relaxed);
+}
+
+
+/*************************************************************************************************/
+/* SCALAR KERNELS ------------------------------------------------------------------------------ */
+/*************************************************************************************************/
+namespace scalar
+{
+template<typename ItemType>
+inline void
+fill(ItemType* first_, std::size_t count_, ItemType value_) noexcept
+{
+    for(std::size_t i = 0; i < count_; ++i)
+    {
+        first_[i] = value_;
+    }
+}
+
+template<typename ItemType>
+[[nodiscard]] inline std::size_t
+find(const ItemType* first_, std::size_t count_, ItemType value_) noexcept
+{
+    for(std::size_t i = 0; i < count_; ++i)
+    {
+        if(first_[i] == value_)
+        {
+            return i;
+        }
+    }
+    return count_;
+}
+
+template<typename ItemType>
+[[nodiscard]] inline std::size_t
+count(const ItemType* first_, std::size_t count_, ItemType value_) noexcept
+{
+    std::size_t result = 0;
+    for(std::size_t i = 0; i < count_; ++i)
+    {
+        result += (first_[i] == value_) ? 1 : 0;
+    }
+    return result;
+}
+
+template<typename ItemType>
+[[nodiscard]] inline ItemType
+minimum(const ItemType* first_, std::size_t count_) noexcept
+{
+    ItemType result = first_[0];
+    for(std::size_t i = 1; i < count_; ++i)
+    {
+        result = (first_[i] < result) ? first_[i] : result;
+    }
+    return result;
+}
+
+template<typename ItemType>
+[[nodiscard]] inline ItemType
+maximum(const ItemType* first_, std::size_t count_) noexcept
+{
+    ItemType result = first_[0];
+    for(std::size_t i = 1; i < count_; ++i)
+    {
+        result = (first_[i] > result) ? first_[i] : result;
+    }
+    return result;
+}
+
+template<typename ItemType>
+[[nodiscard]] inline sum_type_t<ItemType>
+sum(const ItemType* first_, std::size_t count_) noexcept
+{
+    sum_type_t<ItemType> result{};
+    for(std::size_t i = 0; i < count_; ++i)
+    {
+        result += static_cast<sum_type_t<ItemType>>(first_[i]);
+    }
+    return result;
+}
+
+template<typename ItemType>
+[[nodiscard]] inline sum_type_t<ItemType>
+dot(const ItemType* first1_, const ItemType* first2_, std::size_t count_) noexcept
+{
+    sum_type_t<ItemType> result{};
+    for(std::size_t i = 0; i < count_; ++i)
+    {
+        result += static_cast<sum_type_t<ItemType>>(first1_[i])
+                  * static_cast<sum_type_t<ItemType>>(first2_[i]);
+    }
+    return result;
+}
+}        // namespace scalar
+
+
+/**
+ **************************************************************************************************
+ * \brief       Number of bits set in each 4-bit value.
+ *              SSE2 processors may lack the `popcnt` instruction, and comparison masks of SSE2
+ *              registers never have more than 4 bits.
+ *************************************************************************************************/
+inline constexpr std::uint8_t nibble_bit_count[16] = {
+  0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Reduce the lanes of a register, once stored in an array.
+ *************************************************************************************************/
+template<typename LaneType, std::size_t Width>
+[[nodiscard]] inline LaneType
+reduce_lanes_minimum(const LaneType (&lanes_)[Width]) noexcept
+{
+    return scalar::minimum(lanes_, Width);
+}
+
+template<typename LaneType, std::size_t Width>
+[[nodiscard]] inline LaneType
+reduce_lanes_maximum(const LaneType (&lanes_)[Width]) noexcept
+{
+    return scalar::maximum(lanes_, Width);
+}
+
+template<typename LaneType, std::size_t Width>
+[[nodiscard]] inline LaneType
+reduce_lanes_sum(const LaneType (&lanes_)[Width]) noexcept
+{
+    LaneType result{};
+    for(const LaneType lane : lanes_)
+    {
+        result += lane;
+    }
+    return result;
+}
+
+}        // namespace pel::simd
+
+
+#if PEL_SIMD_X86
+/*************************************************************************************************/
+/* VECTOR KERNELS ------------------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/* Kernels of each instruction set are compiled with that instruction set enabled, regardless of
+ * the flags the rest of the program is built with. They are only called when the processor
+ * supports them. */
+#define PEL_SIMD_PRAGMA(...) _Pragma(#__VA_ARGS__)
+#if defined(__clang__)
+#define PEL_SIMD_BEGIN_TARGET(target_)                                                            \
+    PEL_SIMD_PRAGMA(clang attribute push(__attribute__((target(target_))), apply_to = function))
+#define PEL_SIMD_END_TARGET() PEL_SIMD_PRAGMA(clang attribute pop)
+#elif defined(__GNUC__)
+#define PEL_SIMD_BEGIN_TARGET(target_)                                                            \
+    PEL_SIMD_PRAGMA(GCC push_options) PEL_SIMD_PRAGMA(GCC target(target_))
+#define PEL_SIMD_END_TARGET() PEL_SIMD_PRAGMA(GCC pop_options)
+#else
+#define PEL_SIMD_BEGIN_TARGET(target_)
+#define PEL_SIMD_END_TARGET()
+#endif
+
+
+/*-------------------------------------------------*/
+/* SSE2 */
+PEL_SIMD_BEGIN_TARGET("sse2")
+namespace pel::simd::sse2
+{
+template<typename ItemType>
+struct ops;
+
+template<>
+struct ops<std::int32_t>
+{
+    using ItemType        = std::int32_t;
+    using RegisterType    = __m128i;
+    using AccumulatorType = __m128i;        //!< Two 64-bit lanes.
+
+    static constexpr std::size_t width       = 4;
+    static constexpr bool        has_product = false;        //!< No signed 32-bit multiply in SSE2
+
+    static RegisterType
+    load(const ItemType* ptr_) noexcept
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr_));
+    }
+    static void
+    store(ItemType* ptr_, RegisterType value_) noexcept
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr_), value_);
+    }
+    static RegisterType
+    broadcast(ItemType value_) noexcept
+    {
+        return _mm_set1_epi32(value_);
+    }
+
+    /* SSE2 has no 32-bit minimum or maximum: blend with the result of a comparison instead */
+    static RegisterType
+    minimum(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        const __m128i greater = _mm_cmpgt_epi32(lhs_, rhs_);
+        return _mm_or_si128(_mm_and_si128(greater, rhs_), _mm_andnot_si128(greater, lhs_));
+    }
+    static RegisterType
+    maximum(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        const __m128i greater = _mm_cmpgt_epi32(lhs_, rhs_);
+        return _mm_or_si128(_mm_and_si128(greater, lhs_), _mm_andnot_si128(greater, rhs_));
+    }
+    static std::uint64_t
+    equal_mask(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        const __m128i equal = _mm_cmpeq_epi32(lhs_, rhs_);
+        return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(equal)));
+    }
+
+    static AccumulatorType
+    zero() noexcept
+    {
+        return _mm_setzero_si128();
+    }
+    static AccumulatorType
+    accumulate(AccumulatorType accumulator_, RegisterType value_) noexcept
+    {
+        /* Sign-extend to 64 bits by interleaving with the sign of each lane */
+        const __m128i sign = _mm_srai_epi32(value_, 31);
+        return _mm_add_epi64(accumulator_,
+                             _mm_add_epi64(_mm_unpacklo_epi32(value_, sign),
+                                           _mm_unpackhi_epi32(value_, sign)));
+    }
+
+    static std::int64_t
+    reduce_sum(AccumulatorType accumulator_) noexcept
+    {
+        alignas(16) std::int64_t lanes[2];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), accumulator_);
+        return reduce_lanes_sum(lanes);
+    }
+    static ItemType
+    reduce_minimum(RegisterType value_) noexcept
+    {
+        alignas(16) ItemType lanes[width];
+        store(lanes, value_);
+        return reduce_lanes_minimum(lanes);
+    }
+    static ItemType
+    reduce_maximum(RegisterType value_) noexcept
+    {
+        alignas(16) ItemType lanes[width];
+        store(lanes, value_);
+        return reduce_lanes_maximum(lanes);
+    }
+};
+
+template<>
+struct ops<float>
+{
+    using ItemType        = float;
+    using RegisterType    = __m128;
+    using AccumulatorType = __m128;
+
+    static constexpr std::size_t width       = 4;
+    static constexpr bool        has_product = true;
+
+    static RegisterType
+    load(const ItemType* ptr_) noexcept
+    {
+        return _mm_loadu_ps(ptr_);
+    }
+    static void
+    store(ItemType* ptr_, RegisterType value_) noexcept
+    {
+        _mm_storeu_ps(ptr_, value_);
+    }
+    static RegisterType
+    broadcast(ItemType value_) noexcept
+    {
+        return _mm_set1_ps(value_);
+    }
+    static RegisterType
+    minimum(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return _mm_min_ps(lhs_, rhs_);
+    }
+    static RegisterType
+    maximum(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return _mm_max_ps(lhs_, rhs_);
+    }
+    static std::uint64_t
+    equal_mask(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpeq_ps(lhs_, rhs_)));
+    }
+
+    static AccumulatorType
+    zero() noexcept
+    {
+        return _mm_setzero_ps();
+    }
+    static AccumulatorType
+    accumulate(AccumulatorType accumulator_, RegisterType value_) noexcept
+    {
+        return _mm_add_ps(accumulator_, value_);
+    }
+    static AccumulatorType
+    accumulate_product(AccumulatorType accumulator_,
+                       RegisterType    lhs_,
+                       RegisterType    rhs_) noexcept
+    {
+        return _mm_add_ps(accumulator_, _mm_mul_ps(lhs_, rhs_));
+    }
+
+    static ItemType
+    reduce_sum(AccumulatorType accumulator_) noexcept
+    {
+        alignas(16) ItemType lanes[width];
+        store(lanes, accumulator_);
+        return reduce_lanes_sum(lanes);
+    }
+    static ItemType
+    reduce_minimum(RegisterType value_) noexcept
+    {
+        alignas(16) ItemType lanes[width];
+        store(lanes, value_);
+        return reduce_lanes_minimum(lanes);
+    }
+    static ItemType
+    reduce_maximum(RegisterType value_) noexcept
+    {
+        alignas(16) ItemType lanes[width];
+        store(lanes, value_);
+        return reduce_lanes_maximum(lanes);
+    }
+};
+
+template<>
+struct ops<double>
+{
+    using ItemType        = double;
+    using RegisterType    = __m128d;
+    using AccumulatorType = __m128d;
+
+    static constexpr std::size_t width       = 2;
+    static constexpr bool        has_product = true;
+
+    static RegisterType
+    load(const ItemType* ptr_) noexcept
+    {
+        return _mm_loadu_pd(ptr_);
+    }
+    static void
+    store(ItemType* ptr_, RegisterType value_) noexcept
+    {
+        _mm_storeu_pd(ptr_, value_);
+    }
+    static RegisterType
+    broadcast(ItemType value_) noexcept
+    {
+        return _mm_set1_pd(value_);
+    }
+    static RegisterType
+    minimum(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return _mm_min_pd(lhs_, rhs_);
+    }
+    static RegisterType
+    maximum(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return _mm_max_pd(lhs_, rhs_);
+    }
+    static std::uint64_t
+    equal_mask(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return static_cast<unsigned>(_mm_movemask_pd(_mm_cmpeq_pd(lhs_, rhs_)));
+    }
+
+    static AccumulatorType
+    zero() noexcept
+    {
+        return _mm_setzero_pd();
+    }
+    static AccumulatorType
+    accumulate(AccumulatorType accumulator_, RegisterType value_) noexcept
+    {
+        return _mm_add_pd(accumulator_, value_);
+    }
+    static AccumulatorType
+    accumulate_product(AccumulatorType accumulator_,
+                       RegisterType    lhs_,
+                       RegisterType    rhs_) noexcept
+    {
+        return _mm_add_pd(accumulator_, _mm_mul_pd(lhs_, rhs_));
+    }
+
+    static ItemType
+    reduce_sum(AccumulatorType accumulator_) noexcept
+    {
+        alignas(16) ItemType lanes[width];
+        store(lanes, accumulator_);
+        return reduce_lanes_sum(lanes);
+    }
+    static ItemType
+    reduce_minimum(RegisterType value_) noexcept
+    {
+        alignas(16) ItemType lanes[width];
+        store(lanes, value_);
+        return reduce_lanes_minimum(lanes);
+    }
+    static ItemType
+    reduce_maximum(RegisterType value_) noexcept
+    {
+        alignas(16) ItemType lanes[width];
+        store(lanes, value_);
+        return reduce_lanes_maximum(lanes);
+    }
+};
+
+#include "./simd_kernels.inl"
+}        // namespace pel::simd::sse2
+PEL_SIMD_END_TARGET()
+
+
+/*-------------------------------------------------*/
+/* AVX2 */
+PEL_SIMD_BEGIN_TARGET("avx2,popcnt")
+namespace pel::simd::avx2
+{
+template<typename ItemType>
+struct ops;
+
+template<>
+struct ops<std::int32_t>
+{
+    using ItemType        = std::int32_t;
+    using RegisterType    = __m256i;
+    using AccumulatorType = __m256i;        //!< Four 64-bit lanes.
+
+    static constexpr std::size_t width       = 8;
+    static constexpr bool        has_product = true;
+
+    static RegisterType
+    load(const ItemType* ptr_) noexcept
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr_));
+    }
+    static void
+    store(ItemType* ptr_, RegisterType value_) noexcept
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr_), value_);
+    }
+    static RegisterType
+    broadcast(ItemType value_) noexcept
+    {
+        return _mm256_set1_epi32(value_);
+    }
+    static RegisterType
+    minimum(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return _mm256_min_epi32(lhs_, rhs_);
+    }
+    static RegisterType
+    maximum(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return _mm256_max_epi32(lhs_, rhs_);
+    }
+    static std::uint64_t
+    equal_mask(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        const __m256i equal = _mm256_cmpeq_epi32(lhs_, rhs_);
+        return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(equal)));
+    }
+
+    static AccumulatorType
+    zero() noexcept
+    {
+        return _mm256_setzero_si256();
+    }
+    static AccumulatorType
+    accumulate(AccumulatorType accumulator_, RegisterType value_) noexcept
+    {
+        const __m256i low  = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(value_));
+        const __m256i high = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(value_, 1));
+        return _mm256_add_epi64(accumulator_, _mm256_add_epi64(low, high));
+    }
+    static AccumulatorType
+    accumulate_product(AccumulatorType accumulator_,
+                       RegisterType    lhs_,
+                       RegisterType    rhs_) noexcept
+    {
+        /* _mm256_mul_epi32 multiplies the even lanes into 64-bit results: shift for the odd ones */
+        const __m256i even = _mm256_mul_epi32(lhs_, rhs_);
+        const __m256i odd =
+          _mm256_mul_epi32(_mm256_srli_epi64(lhs_, 32), _mm256_srli_epi64(rhs_, 32));
+        return _mm256_add_epi64(accumulator_, _mm256_add_epi64(even, odd));
+    }
+
+    static std::int64_t
+    reduce_sum(AccumulatorType accumulator_) noexcept
+    {
+        alignas(32) std::int64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), accumulator_);
+        return reduce_lanes_sum(lanes);
+    }
+    static ItemType
+    reduce_minimum(RegisterType value_) noexcept
+    {
+        alignas(32) ItemType lanes[width];
+        store(lanes, value_);
+        return reduce_lanes_minimum(lanes);
+    }
+    static ItemType
+    reduce_maximum(RegisterType value_) noexcept
+    {
+        alignas(32) ItemType lanes[width];
+        store(lanes, value_);
+        return reduce_lanes_maximum(lanes);
+    }
+};
+
+template<>
+struct ops<float>
+{
+    using ItemType        = float;
+    using RegisterType    = __m256;
+    using AccumulatorType = __m256;
+
+    static constexpr std::size_t width       = 8;
+    static constexpr bool        has_product = true;
+
+    static RegisterType
+    load(const ItemType* ptr_) noexcept
+    {
+        return _mm256_loadu_ps(ptr_);
+    }
+    static void
+    store(ItemType* ptr_, RegisterType value_) noexcept
+    {
+        _mm256_storeu_ps(ptr_, value_);
+    }
+    static RegisterType
+    broadcast(ItemType value_) noexcept
+    {
+        return _mm256_set1_ps(value_);
+    }
+    static RegisterType
+    minimum(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return _mm256_min_ps(lhs_, rhs_);
+    }
+    static RegisterType
+    maximum(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return _mm256_max_ps(lhs_, rhs_);
+    }
+    static std::uint64_t
+    equal_mask(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(lhs_, rhs_, _CMP_EQ_OQ)));
+    }
+
+    static AccumulatorType
+    zero() noexcept
+    {
+        return _mm256_setzero_ps();
+    }
+    static AccumulatorType
+    accumulate(AccumulatorType accumulator_, RegisterType value_) noexcept
+    {
+        return _mm256_add_ps(accumulator_, value_);
+    }
+    static AccumulatorType
+    accumulate_product(AccumulatorType accumulator_,
+                       RegisterType    lhs_,
+                       RegisterType    rhs_) noexcept
+    {
+        return _mm256_add_ps(accumulator_, _mm256_mul_ps(lhs_, rhs_));
+    }
+
+    static ItemType
+    reduce_sum(AccumulatorType accumulator_) noexcept
+    {
+        alignas(32) ItemType lanes[width];
+        store(lanes, accumulator_);
+        return reduce_lanes_sum(lanes);
+    }
+    static ItemType
+    reduce_minimum(RegisterType value_) noexcept
+    {
+        alignas(32) ItemType lanes[width];
+        store(lanes, value_);
+        return reduce_lanes_minimum(lanes);
+    }
+    static ItemType
+    reduce_maximum(RegisterType value_) noexcept
+    {
+        alignas(32) ItemType lanes[width];
+        store(lanes, value_);
+        return reduce_lanes_maximum(lanes);
+    }
+};
+
+template<>
+struct ops<double>
+{
+    using ItemType        = double;
+    using RegisterType    = __m256d;
+    using AccumulatorType = __m256d;
+
+    static constexpr std::size_t width       = 4;
+    static constexpr bool        has_product = true;
+
+    static RegisterType
+    load(const ItemType* ptr_) noexcept
+    {
+        return _mm256_loadu_pd(ptr_);
+    }
+    static void
+    store(ItemType* ptr_, RegisterType value_) noexcept
+    {
+        _mm256_storeu_pd(ptr_, value_);
+    }
+    static RegisterType
+    broadcast(ItemType value_) noexcept
+    {
+        return _mm256_set1_pd(value_);
+    }
+    static RegisterType
+    minimum(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return _mm256_min_pd(lhs_, rhs_);
+    }
+    static RegisterType
+    maximum(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return _mm256_max_pd(lhs_, rhs_);
+    }
+    static std::uint64_t
+    equal_mask(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(lhs_, rhs_, _CMP_EQ_OQ)));
+    }
+
+    static AccumulatorType
+    zero() noexcept
+    {
+        return _mm256_setzero_pd();
+    }
+    static AccumulatorType
+    accumulate(AccumulatorType accumulator_, RegisterType value_) noexcept
+    {
+        return _mm256_add_pd(accumulator_, value_);
+    }
+    static AccumulatorType
+    accumulate_product(AccumulatorType accumulator_,
+                       RegisterType    lhs_,
+                       RegisterType    rhs_) noexcept
+    {
+        return _mm256_add_pd(accumulator_, _mm256_mul_pd(lhs_, rhs_));
+    }
+
+    static ItemType
+    reduce_sum(AccumulatorType accumulator_) noexcept
+    {
+        alignas(32) ItemType lanes[width];
+        store(lanes, accumulator_);
+        return reduce_lanes_sum(lanes);
+    }
+    static ItemType
+    reduce_minimum(RegisterType value_) noexcept
+    {
+        alignas(32) ItemType lanes[width];
+        store(lanes, value_);
+        return reduce_lanes_minimum(lanes);
+    }
+    static ItemType
+    reduce_maximum(RegisterType value_) noexcept
+    {
+        alignas(32) ItemType lanes[width];
+        store(lanes, value_);
+        return reduce_lanes_maximum(lanes);
+    }
+};
+
+#include "./simd_kernels.inl"
+}        // namespace pel::simd::avx2
+PEL_SIMD_END_TARGET()
+
+
+/*-------------------------------------------------*/
+/* AVX-512 */
+PEL_SIMD_BEGIN_TARGET("avx512f,popcnt")
+namespace pel::simd::avx512
+{
+/* The unmasked forms of many AVX-512 intrinsics pass an undefined register as their merge source,
+ * which some compilers report as an uninitialised read once inlined. The zero-masked forms with
+ * every lane selected compile to the same instructions and merge into `_mm512_setzero_*` instead,
+ * and the reductions go through memory like the other instruction sets. */
+inline constexpr __mmask8  all_lanes_8  = 0xFF;
+inline constexpr __mmask16 all_lanes_16 = 0xFFFF;
+
+template<typename ItemType>
+struct ops;
+
+template<>
+struct ops<std::int32_t>
+{
+    using ItemType        = std::int32_t;
+    using RegisterType    = __m512i;
+    using AccumulatorType = __m512i;        //!< Eight 64-bit lanes.
+
+    static constexpr std::size_t width       = 16;
+    static constexpr bool        has_product = true;
+
+    static RegisterType
+    load(const ItemType* ptr_) noexcept
+    {
+        return _mm512_loadu_si512(ptr_);
+    }
+    static void
+    store(ItemType* ptr_, RegisterType value_) noexcept
+    {
+        _mm512_storeu_si512(ptr_, value_);
+    }
+    static RegisterType
+    broadcast(ItemType value_) noexcept
+    {
+        return _mm512_set1_epi32(value_);
+    }
+    static RegisterType
+    minimum(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return _mm512_maskz_min_epi32(all_lanes_16, lhs_, rhs_);
+    }
+    static RegisterType
+    maximum(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return _mm512_maskz_max_epi32(all_lanes_16, lhs_, rhs_);
+    }
+    static std::uint64_t
+    equal_mask(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return _mm512_cmpeq_epi32_mask(lhs_, rhs_);
+    }
+
+    static AccumulatorType
+    zero() noexcept
+    {
+        return _mm512_setzero_si512();
+    }
+    static AccumulatorType
+    accumulate(AccumulatorType accumulator_, RegisterType value_) noexcept
+    {
+        const __m256i lower = _mm512_maskz_extracti64x4_epi64(all_lanes_8, value_, 0);
+        const __m256i upper = _mm512_maskz_extracti64x4_epi64(all_lanes_8, value_, 1);
+        const __m512i low   = _mm512_maskz_cvtepi32_epi64(all_lanes_8, lower);
+        const __m512i high  = _mm512_maskz_cvtepi32_epi64(all_lanes_8, upper);
+        return _mm512_add_epi64(accumulator_, _mm512_add_epi64(low, high));
+    }
+    static AccumulatorType
+    accumulate_product(AccumulatorType accumulator_,
+                       RegisterType    lhs_,
+                       RegisterType    rhs_) noexcept
+    {
+        const __m512i even = _mm512_maskz_mul_epi32(all_lanes_8, lhs_, rhs_);
+        const __m512i odd  = _mm512_maskz_mul_epi32(all_lanes_8,
+                                                   _mm512_maskz_srli_epi64(all_lanes_8, lhs_, 32),
+                                                   _mm512_maskz_srli_epi64(all_lanes_8, rhs_, 32));
+        return _mm512_add_epi64(accumulator_, _mm512_add_epi64(even, odd));
+    }
+
+    static std::int64_t
+    reduce_sum(AccumulatorType accumulator_) noexcept
+    {
+        alignas(64) std::int64_t lanes[8];
+        _mm512_store_si512(lanes, accumulator_);
+        return reduce_lanes_sum(lanes);
+    }
+    static ItemType
+    reduce_minimum(RegisterType value_) noexcept
+    {
+        alignas(64) ItemType lanes[width];
+        _mm512_store_si512(lanes, value_);
+        return reduce_lanes_minimum(lanes);
+    }
+    static ItemType
+    reduce_maximum(RegisterType value_) noexcept
+    {
+        alignas(64) ItemType lanes[width];
+        _mm512_store_si512(lanes, value_);
+        return reduce_lanes_maximum(lanes);
+    }
+};
+
+template<>
+struct ops<float>
+{
+    using ItemType        = float;
+    using RegisterType    = __m512;
+    using AccumulatorType = __m512;
+
+    static constexpr std::size_t width       = 16;
+    static constexpr bool        has_product = true;
+
+    static RegisterType
+    load(const ItemType* ptr_) noexcept
+    {
+        return _mm512_loadu_ps(ptr_);
+    }
+    static void
+    store(ItemType* ptr_, RegisterType value_) noexcept
+    {
+        _mm512_storeu_ps(ptr_, value_);
+    }
+    static RegisterType
+    broadcast(ItemType value_) noexcept
+    {
+        return _mm512_set1_ps(value_);
+    }
+    static RegisterType
+    minimum(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return _mm512_maskz_min_ps(all_lanes_16, lhs_, rhs_);
+    }
+    static RegisterType
+    maximum(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return _mm512_maskz_max_ps(all_lanes_16, lhs_, rhs_);
+    }
+    static std::uint64_t
+    equal_mask(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return _mm512_cmp_ps_mask(lhs_, rhs_, _CMP_EQ_OQ);
+    }
+
+    static AccumulatorType
+    zero() noexcept
+    {
+        return _mm512_setzero_ps();
+    }
+    static AccumulatorType
+    accumulate(AccumulatorType accumulator_, RegisterType value_) noexcept
+    {
+        return _mm512_add_ps(accumulator_, value_);
+    }
+    static AccumulatorType
+    accumulate_product(AccumulatorType accumulator_,
+                       RegisterType    lhs_,
+                       RegisterType    rhs_) noexcept
+    {
+        return _mm512_add_ps(accumulator_, _mm512_mul_ps(lhs_, rhs_));
+    }
+
+    static ItemType
+    reduce_sum(AccumulatorType accumulator_) noexcept
+    {
+        alignas(64) ItemType lanes[width];
+        _mm512_store_ps(lanes, accumulator_);
+        return reduce_lanes_sum(lanes);
+    }
+    static ItemType
+    reduce_minimum(RegisterType value_) noexcept
+    {
+        alignas(64) ItemType lanes[width];
+        _mm512_store_ps(lanes, value_);
+        return reduce_lanes_minimum(lanes);
+    }
+    static ItemType
+    reduce_maximum(RegisterType value_) noexcept
+    {
+        alignas(64) ItemType lanes[width];
+        _mm512_store_ps(lanes, value_);
+        return reduce_lanes_maximum(lanes);
+    }
+};
+
+template<>
+struct ops<double>
+{
+    using ItemType        = double;
+    using RegisterType    = __m512d;
+    using AccumulatorType = __m512d;
+
+    static constexpr std::size_t width       = 8;
+    static constexpr bool        has_product = true;
+
+    static RegisterType
+    load(const ItemType* ptr_) noexcept
+    {
+        return _mm512_loadu_pd(ptr_);
+    }
+    static void
+    store(ItemType* ptr_, RegisterType value_) noexcept
+    {
+        _mm512_storeu_pd(ptr_, value_);
+    }
+    static RegisterType
+    broadcast(ItemType value_) noexcept
+    {
+        return _mm512_set1_pd(value_);
+    }
+    static RegisterType
+    minimum(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return _mm512_maskz_min_pd(all_lanes_8, lhs_, rhs_);
+    }
+    static RegisterType
+    maximum(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return _mm512_maskz_max_pd(all_lanes_8, lhs_, rhs_);
+    }
+    static std::uint64_t
+    equal_mask(RegisterType lhs_, RegisterType rhs_) noexcept
+    {
+        return _mm512_cmp_pd_mask(lhs_, rhs_, _CMP_EQ_OQ);
+    }
+
+    static AccumulatorType
+    zero() noexcept
+    {
+        return _mm512_setzero_pd();
+    }
+    static AccumulatorType
+    accumulate(AccumulatorType accumulator_, RegisterType value_) noexcept
+    {
+        return _mm512_add_pd(accumulator_, value_);
+    }
+    static AccumulatorType
+    accumulate_product(AccumulatorType accumulator_,
+                       RegisterType    lhs_,
+                       RegisterType    rhs_) noexcept
+    {
+        return _mm512_add_pd(accumulator_, _mm512_mul_pd(lhs_, rhs_));
+    }
+
+    static ItemType
+    reduce_sum(AccumulatorType accumulator_) noexcept
+    {
+        alignas(64) ItemType lanes[width];
+        _mm512_store_pd(lanes, accumulator_);
+        return reduce_lanes_sum(lanes);
+    }
+    static ItemType
+    reduce_minimum(RegisterType value_) noexcept
+    {
+        alignas(64) ItemType lanes[width];
+        _mm512_store_pd(lanes, value_);
+        return reduce_lanes_minimum(lanes);
+    }
+    static ItemType
+    reduce_maximum(RegisterType value_) noexcept
+    {
+        alignas(64) ItemType lanes[width];
+        _mm512_store_pd(lanes, value_);
+        return reduce_lanes_maximum(lanes);
+    }
+};
+
+#include "./simd_kernels.inl"
+}        // namespace pel::simd::avx512
+PEL_SIMD_END_TARGET()
+
+#endif
+
+
+namespace pel::simd
+{
+/*************************************************************************************************/
+/* ALGORITHMS ---------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Set all the elements of a range to `value_`.
+ *************************************************************************************************/
+template<arithmetic ItemType>
+inline void
+fill(ItemType* first_, ItemType* last_, ItemType value_) noexcept
+{
+    const auto length = static_cast<std::size_t>(last_ - first_);
+
+#if PEL_SIMD_X86
+    if constexpr(has_vector_kernels_v<ItemType>)
+    {
+        switch(active_isa())
+        {
+            case isa::avx512:
+                return avx512::fill(first_, length, value_);
+            case isa::avx2:
+                return avx2::fill(first_, length, value_);
+            case isa::sse2:
+                return sse2::fill(first_, length, value_);
+            case isa::scalar:
+                break;
+        }
+    }
+#endif
+    scalar::fill(first_, length, value_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Find the first element of a range equal to `value_`.
+ *
+ * \retval      const ItemType*: First matching element, or `last_` if there is none.
+ *************************************************************************************************/
+template<arithmetic ItemType>
+[[nodiscard]] inline const ItemType*
+find(const ItemType* first_, const ItemType* last_, ItemType value_) noexcept
+{
+    const auto length = static_cast<std::size_t>(last_ - first_);
+
+#if PEL_SIMD_X86
+    if constexpr(has_vector_kernels_v<ItemType>)
+    {
+        switch(active_isa())
+        {
+            case isa::avx512:
+                return first_ + avx512::find(first_, length, value_);
+            case isa::avx2:
+                return first_ + avx2::find(first_, length, value_);
+            case isa::sse2:
+                return first_ + sse2::find(first_, length, value_);
+            case isa::scalar:
+                break;
+        }
+    }
+#endif
+    return first_ + scalar::find(first_, length, value_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Count the elements of a range equal to `value_`.
+ *************************************************************************************************/
+template<arithmetic ItemType>
+[[nodiscard]] inline std::size_t
+count(const ItemType* first_, const ItemType* last_, ItemType value_) noexcept
+{
+    const auto length = static_cast<std::size_t>(last_ - first_);
+
+#if PEL_SIMD_X86
+    if constexpr(has_vector_kernels_v<ItemType>)
+    {
+        switch(active_isa())
+        {
+            case isa::avx512:
+                return avx512::count(first_, length, value_);
+            case isa::avx2:
+                return avx2::count(first_, length, value_);
+            case isa::sse2:
+                return sse2::count(first_, length, value_);
+            case isa::scalar:
+                break;
+        }
+    }
+#endif
+    return scalar::count(first_, length, value_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the smallest element of a non-empty range.
+ *
+ * \note        For floating point types, the result is unspecified if the range holds NaNs.
+ *************************************************************************************************/
+template<arithmetic ItemType>
+[[nodiscard]] inline ItemType
+minimum(const ItemType* first_, const ItemType* last_) noexcept
+{
+    const auto length = static_cast<std::size_t>(last_ - first_);
+
+#if PEL_SIMD_X86
+    if constexpr(has_vector_kernels_v<ItemType>)
+    {
+        switch(active_isa())
+        {
+            case isa::avx512:
+                return avx512::minimum(first_, length);
+            case isa::avx2:
+                return avx2::minimum(first_, length);
+            case isa::sse2:
+                return sse2::minimum(first_, length);
+            case isa::scalar:
+                break;
+        }
+    }
+#endif
+    return scalar::minimum(first_, length);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the largest element of a non-empty range.
+ *
+ * \note        For floating point types, the result is unspecified if the range holds NaNs.
+ *************************************************************************************************/
+template<arithmetic ItemType>
+[[nodiscard]] inline ItemType
+maximum(const ItemType* first_, const ItemType* last_) noexcept
+{
+    const auto length = static_cast<std::size_t>(last_ - first_);
+
+#if PEL_SIMD_X86
+    if constexpr(has_vector_kernels_v<ItemType>)
+    {
+        switch(active_isa())
+        {
+            case isa::avx512:
+                return avx512::maximum(first_, length);
+            case isa::avx2:
+                return avx2::maximum(first_, length);
+            case isa::sse2:
+                return sse2::maximum(first_, length);
+            case isa::scalar:
+                break;
+        }
+    }
+#endif
+    return scalar::maximum(first_, length);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Sum the elements of a range.
+ *
+ * \note        Floating point additions are reordered, so results can differ from a sequential
+ *              sum by rounding errors.
+ *************************************************************************************************/
+template<arithmetic ItemType>
+[[nodiscard]] inline sum_type_t<ItemType>
+sum(const ItemType* first_, const ItemType* last_) noexcept
+{
+    const auto length = static_cast<std::size_t>(last_ - first_);
+
+#if PEL_SIMD_X86
+    if constexpr(has_vector_kernels_v<ItemType>)
+    {
+        switch(active_isa())
+        {
+            case isa::avx512:
+                return avx512::sum(first_, length);
+            case isa::avx2:
+                return avx2::sum(first_, length);
+            case isa::sse2:
+                return sse2::sum(first_, length);
+            case isa::scalar:
+                break;
+        }
+    }
+#endif
+    return scalar::sum(first_, length);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Sum the products of the elements of two ranges of the same length.
+ *
+ * \note        Floating point additions are reordered, so results can differ from a sequential
+ *              sum by rounding errors.
+ *************************************************************************************************/
+template<arithmetic ItemType>
+[[nodiscard]] inline sum_type_t<ItemType>
+dot(const ItemType* first1_, const ItemType* last1_, const ItemType* first2_) noexcept
+{
+    const auto length = static_cast<std::size_t>(last1_ - first1_);
+
+#if PEL_SIMD_X86
+    if constexpr(has_vector_kernels_v<ItemType>)
+    {
+        switch(active_isa())
+        {
+            case isa::avx512:
+                return avx512::dot(first1_, first2_, length);
+            case isa::avx2:
+                return avx2::dot(first1_, first2_, length);
+            case isa::sse2:
+                return sse2::dot(first1_, first2_, length);
+            case isa::scalar:
+                break;
+        }
+    }
+#endif
+    return scalar::dot(first1_, first2_, length);
+}
+
+
+/*************************************************************************************************/
+/* CONTAINER OVERLOADS ------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+template<contiguous_container ContainerType>
+inline void
+fill(ContainerType& container_, container_item_t<ContainerType> value_) noexcept
+{
+    simd::fill(container_.data(), container_.data() + container_.length(), value_);
+}
+
+template<contiguous_container ContainerType>
+[[nodiscard]] inline const container_item_t<ContainerType>*
+find(const ContainerType& container_, container_item_t<ContainerType> value_) noexcept
+{
+    return simd::find(container_.data(), container_.data() + container_.length(), value_);
+}
+
+template<contiguous_container ContainerType>
+[[nodiscard]] inline std::size_t
+count(const ContainerType& container_, container_item_t<ContainerType> value_) noexcept
+{
+    return simd::count(container_.data(), container_.data() + container_.length(), value_);
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Get the smallest element of a container.
+ *
+ * \throws      std::out_of_range("Cannot get the minimum of an empty container")
+ *************************************************************************************************/
+template<contiguous_container ContainerType>
+[[nodiscard]] inline container_item_t<ContainerType>
+minimum(const ContainerType& container_)
+{
+    if(container_.length() == 0) [[unlikely]]
+    {
+        throw std::out_of_range("Cannot get the minimum of an empty container");
+    }
+    return simd::minimum(container_.data(), container_.data() + container_.length());
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Get the largest element of a container.
+ *
+ * \throws      std::out_of_range("Cannot get the maximum of an empty container")
+ *************************************************************************************************/
+template<contiguous_container ContainerType>
+[[nodiscard]] inline container_item_t<ContainerType>
+maximum(const ContainerType& container_)
+{
+    if(container_.length() == 0) [[unlikely]]
+    {
+        throw std::out_of_range("Cannot get the maximum of an empty container");
+    }
+    return simd::maximum(container_.data(), container_.data() + container_.length());
+}
+
+template<contiguous_container ContainerType>
+[[nodiscard]] inline sum_type_t<container_item_t<ContainerType>>
+sum(const ContainerType& container_) noexcept
+{
+    return simd::sum(container_.data(), container_.data() + container_.length());
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Sum the products of the elements of two containers.
+ *              Only the elements present in both containers are used.
+ *************************************************************************************************/
+template<contiguous_container ContainerType>
+[[nodiscard]] inline sum_type_t<container_item_t<ContainerType>>
+dot(const ContainerType& lhs_, const ContainerType& rhs_) noexcept
+{
+    const std::size_t length = lhs_.length() < rhs_.length() ? lhs_.length() : rhs_.length();
+    return simd::dot(lhs_.data(), lhs_.data() + length, rhs_.data());
+}
+
+}        // namespace pel::simd
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
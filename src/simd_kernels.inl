@@ -0,0 +1,284 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * This file holds the vectorized kernels shared by every instruction set. It has no include guard:
+ * simd.inl includes it once per instruction set, inside the namespace of that instruction set and
+ * with the matching target enabled. The enclosing namespace provides `ops<ItemType>`, which wraps
+ * the intrinsics of the instruction set for a given element type.
+ */
+
+
+/**
+ **************************************************************************************************
+ * \brief       Set `count_` elements to `value_`, one register at a time.
+ *************************************************************************************************/
+template<typename ItemType>
+void
+fill(ItemType* first_, std::size_t count_, ItemType value_) noexcept
+{
+    using Ops = ops<ItemType>;
+
+    const typename Ops::RegisterType broadcast = Ops::broadcast(value_);
+
+    std::size_t i = 0;
+    for(; i + Ops::width <= count_; i += Ops::width)
+    {
+        Ops::store(first_ + i, broadcast);
+    }
+    for(; i < count_; ++i)
+    {
+        first_[i] = value_;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the index of the first element equal to `value_`, or `count_` if none is.
+ *************************************************************************************************/
+template<typename ItemType>
+[[nodiscard]] std::size_t
+find(const ItemType* first_, std::size_t count_, ItemType value_) noexcept
+{
+    using Ops = ops<ItemType>;
+
+    const typename Ops::RegisterType broadcast = Ops::broadcast(value_);
+
+    std::size_t i = 0;
+    for(; i + Ops::width <= count_; i += Ops::width)
+    {
+        const std::uint64_t mask = Ops::equal_mask(Ops::load(first_ + i), broadcast);
+        if(mask != 0)
+        {
+            return i + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+    }
+    for(; i < count_; ++i)
+    {
+        if(first_[i] == value_)
+        {
+            return i;
+        }
+    }
+    return count_;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Count the elements equal to `value_`.
+ *************************************************************************************************/
+template<typename ItemType>
+[[nodiscard]] std::size_t
+count(const ItemType* first_, std::size_t count_, ItemType value_) noexcept
+{
+    using Ops = ops<ItemType>;
+
+    const typename Ops::RegisterType broadcast = Ops::broadcast(value_);
+
+    std::size_t result = 0;
+    std::size_t i      = 0;
+    for(; i + Ops::width <= count_; i += Ops::width)
+    {
+        const std::uint64_t mask = Ops::equal_mask(Ops::load(first_ + i), broadcast);
+        if constexpr(Ops::width <= 4)
+        {
+            result += nibble_bit_count[mask];
+        }
+        else
+        {
+            result += static_cast<std::size_t>(std::popcount(mask));
+        }
+    }
+    for(; i < count_; ++i)
+    {
+        result += (first_[i] == value_) ? 1 : 0;
+    }
+    return result;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the smallest of `count_` elements. `count_` must not be 0.
+ *************************************************************************************************/
+template<typename ItemType>
+[[nodiscard]] ItemType
+minimum(const ItemType* first_, std::size_t count_) noexcept
+{
+    using Ops = ops<ItemType>;
+
+    if(count_ < Ops::width)
+    {
+        return scalar::minimum(first_, count_);
+    }
+
+    typename Ops::RegisterType extremum = Ops::load(first_);
+
+    std::size_t i = Ops::width;
+    for(; i + Ops::width <= count_; i += Ops::width)
+    {
+        extremum = Ops::minimum(extremum, Ops::load(first_ + i));
+    }
+
+    ItemType result = Ops::reduce_minimum(extremum);
+    for(; i < count_; ++i)
+    {
+        result = (first_[i] < result) ? first_[i] : result;
+    }
+    return result;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the largest of `count_` elements. `count_` must not be 0.
+ *************************************************************************************************/
+template<typename ItemType>
+[[nodiscard]] ItemType
+maximum(const ItemType* first_, std::size_t count_) noexcept
+{
+    using Ops = ops<ItemType>;
+
+    if(count_ < Ops::width)
+    {
+        return scalar::maximum(first_, count_);
+    }
+
+    typename Ops::RegisterType extremum = Ops::load(first_);
+
+    std::size_t i = Ops::width;
+    for(; i + Ops::width <= count_; i += Ops::width)
+    {
+        extremum = Ops::maximum(extremum, Ops::load(first_ + i));
+    }
+
+    ItemType result = Ops::reduce_maximum(extremum);
+    for(; i < count_; ++i)
+    {
+        result = (first_[i] > result) ? first_[i] : result;
+    }
+    return result;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Sum `count_` elements.
+ *              Four independent accumulators hide the latency of the additions.
+ *************************************************************************************************/
+template<typename ItemType>
+[[nodiscard]] sum_type_t<ItemType>
+sum(const ItemType* first_, std::size_t count_) noexcept
+{
+    using Ops = ops<ItemType>;
+
+    typename Ops::AccumulatorType accumulator0 = Ops::zero();
+    typename Ops::AccumulatorType accumulator1 = Ops::zero();
+    typename Ops::AccumulatorType accumulator2 = Ops::zero();
+    typename Ops::AccumulatorType accumulator3 = Ops::zero();
+
+    std::size_t i = 0;
+    for(; i + 4 * Ops::width <= count_; i += 4 * Ops::width)
+    {
+        accumulator0 = Ops::accumulate(accumulator0, Ops::load(first_ + i));
+        accumulator1 = Ops::accumulate(accumulator1, Ops::load(first_ + i + Ops::width));
+        accumulator2 = Ops::accumulate(accumulator2, Ops::load(first_ + i + 2 * Ops::width));
+        accumulator3 = Ops::accumulate(accumulator3, Ops::load(first_ + i + 3 * Ops::width));
+    }
+    for(; i + Ops::width <= count_; i += Ops::width)
+    {
+        accumulator0 = Ops::accumulate(accumulator0, Ops::load(first_ + i));
+    }
+
+    sum_type_t<ItemType> result = Ops::reduce_sum(accumulator0) + Ops::reduce_sum(accumulator1)
+                                  + Ops::reduce_sum(accumulator2) + Ops::reduce_sum(accumulator3);
+    for(; i < count_; ++i)
+    {
+        result += static_cast<sum_type_t<ItemType>>(first_[i]);
+    }
+    return result;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Sum the products of `count_` pairs of elements.
+ *              Falls back to the scalar kernel when the instruction set has no suitable
+ *              multiplication for the element type.
+ *************************************************************************************************/
+template<typename ItemType>
+[[nodiscard]] sum_type_t<ItemType>
+dot(const ItemType* first1_, const ItemType* first2_, std::size_t count_) noexcept
+{
+    using Ops = ops<ItemType>;
+
+    if constexpr(!Ops::has_product)
+    {
+        return scalar::dot(first1_, first2_, count_);
+    }
+    else
+    {
+        typename Ops::AccumulatorType accumulator0 = Ops::zero();
+        typename Ops::AccumulatorType accumulator1 = Ops::zero();
+        typename Ops::AccumulatorType accumulator2 = Ops::zero();
+        typename Ops::AccumulatorType accumulator3 = Ops::zero();
+
+        std::size_t i = 0;
+        for(; i + 4 * Ops::width <= count_; i += 4 * Ops::width)
+        {
+            accumulator0 = Ops::accumulate_product(
+              accumulator0, Ops::load(first1_ + i), Ops::load(first2_ + i));
+            accumulator1 = Ops::accumulate_product(accumulator1,
+                                                   Ops::load(first1_ + i + Ops::width),
+                                                   Ops::load(first2_ + i + Ops::width));
+            accumulator2 = Ops::accumulate_product(accumulator2,
+                                                   Ops::load(first1_ + i + 2 * Ops::width),
+                                                   Ops::load(first2_ + i + 2 * Ops::width));
+            accumulator3 = Ops::accumulate_product(accumulator3,
+                                                   Ops::load(first1_ + i + 3 * Ops::width),
+                                                   Ops::load(first2_ + i + 3 * Ops::width));
+        }
+        for(; i + Ops::width <= count_; i += Ops::width)
+        {
+            accumulator0 = Ops::accumulate_product(
+              accumulator0, Ops::load(first1_ + i), Ops::load(first2_ + i));
+        }
+
+        sum_type_t<ItemType> result = Ops::reduce_sum(accumulator0) + Ops::reduce_sum(accumulator1)
+                                      + Ops::reduce_sum(accumulator2)
+                                      + Ops::reduce_sum(accumulator3);
+        for(; i < count_; ++i)
+        {
+            result += static_cast<sum_type_t<ItemType>>(first1_[i])
+                      * static_cast<sum_type_t<ItemType>>(first2_[i]);
+        }
+        return result;
+    }
+}
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,327 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./vector.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+
+namespace pel
+{
+/**
+ **************************************************************************************************
+ * \brief       Inline storage of a pel::small_vector.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t InlineCapacity>
+struct small_vector_buffer
+{
+    [[nodiscard]] ItemType*
+    storage() noexcept
+    {
+        return reinterpret_cast<ItemType*>(m_storage);
+    }
+
+    alignas(ItemType) std::byte m_storage[sizeof(ItemType) * InlineCapacity];
+    bool m_inUse = false;
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Allocator handing out the inline buffer of a pel::small_vector when the requested
+ *              block fits in it, and forwarding to an upstream allocator otherwise.
+ *
+ * \note        Copies of this allocator refer to the same inline buffer. Assigning an allocator
+ *              only assigns the upstream allocator, so that a container never starts using the
+ *              inline buffer of another container.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t InlineCapacity, typename UpstreamAllocatorType>
+class small_vector_allocator
+{
+public:
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+    using value_type     = ItemType;
+    using BufferType     = small_vector_buffer<ItemType, InlineCapacity>;
+    using UpstreamTraits = std::allocator_traits<UpstreamAllocatorType>;
+
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap            = std::false_type;
+    using is_always_equal                        = std::false_type;
+
+    template<typename OtherType>
+    struct rebind
+    {
+        using OtherUpstream = typename UpstreamTraits::template rebind_alloc<OtherType>;
+        using other         = small_vector_allocator<OtherType, InlineCapacity, OtherUpstream>;
+    };
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+    small_vector_allocator(BufferType* buffer_, const UpstreamAllocatorType& upstream_)
+    : m_buffer{buffer_}, m_upstream{upstream_}
+    {
+    }
+
+    small_vector_allocator(const small_vector_allocator& other_) = default;
+
+    template<typename OtherType, typename OtherUpstreamType>
+    small_vector_allocator(
+      const small_vector_allocator<OtherType, InlineCapacity, OtherUpstreamType>& other_)
+    : m_buffer{nullptr}, m_upstream{other_.upstream()}
+    {
+    }
+
+    small_vector_allocator&
+    operator=(const small_vector_allocator& other_)
+    {
+        m_upstream = other_.m_upstream;
+        return *this;
+    }
+
+    ~small_vector_allocator() = default;
+
+
+    /*********************************************************************************************/
+    /* Allocation ------------------------------------------------------------------------------ */
+    [[nodiscard]] ItemType*
+    allocate(std::size_t count_)
+    {
+        if(m_buffer != nullptr && !m_buffer->m_inUse && count_ <= InlineCapacity)
+        {
+            m_buffer->m_inUse = true;
+            return m_buffer->storage();
+        }
+
+        return UpstreamTraits::allocate(m_upstream, count_);
+    }
+
+    void
+    deallocate(ItemType* ptr_, std::size_t count_) noexcept
+    {
+        if(is_inline(ptr_))
+        {
+            m_buffer->m_inUse = false;
+            return;
+        }
+
+        UpstreamTraits::deallocate(m_upstream, ptr_, count_);
+    }
+
+    /**
+     **********************************************************************************************
+     * \brief   The inline buffer can be resized freely up to its capacity.
+     *          Upstream blocks are resized in place only if the upstream allocator supports it.
+     **********************************************************************************************/
+    bool
+    expand_in_place(ItemType* ptr_, std::size_t oldCount_, std::size_t newCount_) noexcept
+    {
+        if(is_inline(ptr_))
+        {
+            return newCount_ <= InlineCapacity;
+        }
+
+        if constexpr(allocator_can_expand_in_place<UpstreamAllocatorType>)
+        {
+            return m_upstream.expand_in_place(ptr_, oldCount_, newCount_);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+
+    /*********************************************************************************************/
+    /* Accessors ------------------------------------------------------------------------------- */
+    [[nodiscard]] const UpstreamAllocatorType&
+    upstream() const noexcept
+    {
+        return m_upstream;
+    }
+
+    [[nodiscard]] bool
+    is_inline(const ItemType* ptr_) const noexcept
+    {
+        return m_buffer != nullptr && ptr_ == m_buffer->storage();
+    }
+
+    friend bool
+    operator==(const small_vector_allocator& lhs_, const small_vector_allocator& rhs_) noexcept
+    {
+        return lhs_.m_buffer == rhs_.m_buffer && lhs_.m_upstream == rhs_.m_upstream;
+    }
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    BufferType*           m_buffer;
+    UpstreamAllocatorType m_upstream;
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Vector keeping up to `InlineCapacity` elements inside the object itself, only
+ *              spilling to `AllocatorType` when more elements are needed.
+ *
+ *              It is built on a pel::vector whose allocator hands out the inline buffer first, and
+ *              exposes its API. The vector is a private base: moving it out through a base
+ *              reference would steal the inline buffer, so a small_vector cannot be sliced.
+ *
+ * \tparam      ItemType:       Type of the elements.
+ * \tparam      InlineCapacity: Number of elements that fit without allocating.
+ * \tparam      AllocatorType:  Allocator used once the inline buffer is exceeded.
+ * \tparam      GrowthPolicy:   Growth policy used once the inline buffer is exceeded.
+ *************************************************************************************************/
+template<typename ItemType,
+         std::size_t InlineCapacity,
+         typename AllocatorType = std::allocator<ItemType>,
+         typename GrowthPolicy  = default_growth_policy>
+class small_vector
+: private small_vector_buffer<ItemType, InlineCapacity>,
+  private vector<ItemType,
+                small_vector_allocator<ItemType, InlineCapacity, AllocatorType>,
+                GrowthPolicy>
+{
+    static_assert(InlineCapacity > 0, "small_vector needs an inline capacity");
+
+public:
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+    using BufferType         = small_vector_buffer<ItemType, InlineCapacity>;
+    using SmallAllocatorType = small_vector_allocator<ItemType, InlineCapacity, AllocatorType>;
+    using VectorType         = vector<ItemType, SmallAllocatorType, GrowthPolicy>;
+
+    using AllocatorTraits     = typename VectorType::AllocatorTraits;
+    using SizeType            = typename VectorType::SizeType;
+    using DifferenceType      = typename VectorType::DifferenceType;
+    using IteratorType        = typename VectorType::IteratorType;
+    using RIteratorType       = typename VectorType::RIteratorType;
+    using InitializerListType = typename VectorType::InitializerListType;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+    explicit small_vector(const AllocatorType& alloc_ = AllocatorType{});
+    explicit small_vector(SizeType             length_,
+                          const ItemType&      value_,
+                          const AllocatorType& alloc_ = AllocatorType{});
+    small_vector(InitializerListType ilist_, const AllocatorType& alloc_ = AllocatorType{});
+
+    small_vector(const small_vector& copy_);
+    small_vector(small_vector&& move_) noexcept(std::is_nothrow_move_constructible_v<ItemType>);
+
+    small_vector& operator=(const small_vector& copy_);
+    small_vector& operator=(small_vector&& move_);
+
+    ~small_vector() override = default;
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    using VectorType::at;
+    using VectorType::back;
+    using VectorType::begin;
+    using VectorType::cbegin;
+    using VectorType::cend;
+    using VectorType::end;
+    using VectorType::front;
+    using VectorType::get_allocator;
+    using VectorType::is_empty;
+    using VectorType::length;
+    using VectorType::operator[];
+
+    using VectorType::assign;
+    using VectorType::data;
+
+
+    /*********************************************************************************************/
+    /* Operator overloads ---------------------------------------------------------------------- */
+    small_vector& operator+=(const ItemType& rhs_);
+
+    small_vector& operator>>(int steps_);
+    small_vector& operator<<(int steps_);
+
+
+    /*********************************************************************************************/
+    /* Element management ---------------------------------------------------------------------- */
+    using VectorType::emplace;
+    using VectorType::emplace_back;
+    using VectorType::erase;
+    using VectorType::erase_if;
+    using VectorType::insert;
+    using VectorType::pop_back;
+    using VectorType::push_back;
+    using VectorType::replace;
+    using VectorType::replace_back;
+    using VectorType::replace_front;
+    using VectorType::unordered_erase;
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    using VectorType::capacity;
+    using VectorType::reserve;
+    using VectorType::resize;
+    using VectorType::resize_default_init;
+    using VectorType::resize_for_overwrite;
+    using VectorType::shrink_to_fit;
+
+    [[nodiscard]] static constexpr SizeType inline_capacity() noexcept;
+    [[nodiscard]] bool                      is_inline() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Misc ------------------------------------------------------------------------------------ */
+    using VectorType::to_string;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    [[nodiscard]] static SmallAllocatorType make_allocator(BufferType*          buffer_,
+                                                           const AllocatorType& alloc_) noexcept;
+
+    void use_inline_storage();
+    void clear_elements() noexcept;
+    void copy_elements(const small_vector& other_);
+    void take_elements(small_vector&& other_);
+};
+
+}        // namespace pel
+
+
+#include "./small_vector.inl"
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,416 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./small_vector.hpp"
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Constructor for the small_vector class.
+ *              Does not allocate: the inline buffer is used as initial storage.
+ *
+ * \param       alloc_: Allocator to use once the inline buffer is exceeded.
+ *              [defaults : AllocatorType{}]
+ *************************************************************************************************/
+template<typename ItemType,
+         std::size_t InlineCapacity,
+         typename AllocatorType,
+         typename GrowthPolicy>
+small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>::small_vector(
+  const AllocatorType& alloc_)
+: BufferType{}, VectorType{0, make_allocator(this, alloc_)}
+{
+    use_inline_storage();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Default-value constructor for the small_vector class.
+ *
+ * \param       length_: Number of elements to create.
+ * \param       value_:  Value to initialize all the elements with.
+ * \param       alloc_:  Allocator to use once the inline buffer is exceeded.
+ *              [defaults : AllocatorType{}]
+ *************************************************************************************************/
+template<typename ItemType,
+         std::size_t InlineCapacity,
+         typename AllocatorType,
+         typename GrowthPolicy>
+small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>::small_vector(
+  SizeType             length_,
+  const ItemType&      value_,
+  const AllocatorType& alloc_)
+: BufferType{}, VectorType{length_, value_, make_allocator(this, alloc_)}
+{
+    use_inline_storage();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Initializer list constructor for the small_vector class.
+ *
+ * \param       ilist_: Initializer list of all the values to put in the new small_vector.
+ * \param       alloc_: Allocator to use once the inline buffer is exceeded.
+ *              [defaults : AllocatorType{}]
+ *************************************************************************************************/
+template<typename ItemType,
+         std::size_t InlineCapacity,
+         typename AllocatorType,
+         typename GrowthPolicy>
+small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>::small_vector(
+  InitializerListType  ilist_,
+  const AllocatorType& alloc_)
+: BufferType{}, VectorType{ilist_, make_allocator(this, alloc_)}
+{
+    use_inline_storage();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy constructor for the small_vector class.
+ *
+ * \param       copy_: small_vector to copy data from.
+ *************************************************************************************************/
+template<typename ItemType,
+         std::size_t InlineCapacity,
+         typename AllocatorType,
+         typename GrowthPolicy>
+small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>::small_vector(
+  const small_vector& copy_)
+: BufferType{}, VectorType{0, make_allocator(this, copy_.get_allocator().upstream())}
+{
+    use_inline_storage();
+    copy_elements(copy_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move constructor for the small_vector class.
+ *              Heap storage is stolen from the other small_vector, while inline elements are
+ *              relocated into this small_vector's own inline buffer.
+ *
+ * \param       move_: small_vector to move data from.
+ *************************************************************************************************/
+template<typename ItemType,
+         std::size_t InlineCapacity,
+         typename AllocatorType,
+         typename GrowthPolicy>
+small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>::small_vector(
+  small_vector&& move_) noexcept(std::is_nothrow_move_constructible_v<ItemType>)
+: BufferType{}, VectorType{0, make_allocator(this, move_.get_allocator().upstream())}
+{
+    take_elements(std::move(move_));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy assignment operator for the small_vector class.
+ *
+ * \param       copy_: small_vector to copy data from.
+ *************************************************************************************************/
+template<typename ItemType,
+         std::size_t InlineCapacity,
+         typename AllocatorType,
+         typename GrowthPolicy>
+small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>&
+small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>::operator=(
+  const small_vector& copy_)
+{
+    if(this != std::addressof(copy_))
+    {
+        clear_elements();
+        copy_elements(copy_);
+    }
+    return *this;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move assignment operator for the small_vector class.
+ *
+ * \param       move_: small_vector to move data from.
+ *************************************************************************************************/
+template<typename ItemType,
+         std::size_t InlineCapacity,
+         typename AllocatorType,
+         typename GrowthPolicy>
+small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>&
+small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>::operator=(
+  small_vector&& move_)
+{
+    if(this != std::addressof(move_))
+    {
+        clear_elements();
+        take_elements(std::move(move_));
+    }
+    return *this;
+}
+
+
+/*************************************************************************************************/
+/* OPERATOR OVERLOADS -------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Overload of the arithmetic += operator to add an element at the end of the vector.
+ *
+ * \param       rhs_: Item to add at the end of the vector.
+ *
+ * \retval      small_vector&: Reference the vector itself.
+ *************************************************************************************************/
+template<typename ItemType,
+         std::size_t InlineCapacity,
+         typename AllocatorType,
+         typename GrowthPolicy>
+inline small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>&
+small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>::operator+=(
+  const ItemType& rhs_)
+{
+    VectorType::operator+=(rhs_);
+    return *this;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Overload of the right-shift >> operator to shift the vector's elements to the right.
+ *
+ * \param       steps_: Shifts to the right.
+ *
+ * \retval      small_vector&: Reference the vector itself.
+ *************************************************************************************************/
+template<typename ItemType,
+         std::size_t InlineCapacity,
+         typename AllocatorType,
+         typename GrowthPolicy>
+inline small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>&
+small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>::operator>>(int steps_)
+{
+    VectorType::operator>>(steps_);
+    return *this;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Overload of the left-shift << operator to shift the vector's elements to the left.
+ *
+ * \param       steps_: Shifts to the left.
+ *
+ * \retval      small_vector&: Reference the vector itself.
+ *************************************************************************************************/
+template<typename ItemType,
+         std::size_t InlineCapacity,
+         typename AllocatorType,
+         typename GrowthPolicy>
+inline small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>&
+small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>::operator<<(int steps_)
+{
+    VectorType::operator<<(steps_);
+    return *this;
+}
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Number of elements that can be held without allocating.
+ *
+ * \retval      SizeType: Capacity of the inline buffer.
+ *************************************************************************************************/
+template<typename ItemType,
+         std::size_t InlineCapacity,
+         typename AllocatorType,
+         typename GrowthPolicy>
+[[nodiscard]] constexpr
+  typename small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>::SizeType
+  small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>::inline_capacity() noexcept
+{
+    return InlineCapacity;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Check if the elements are currently stored in the inline buffer.
+ *
+ * \retval      bool: True if no heap memory is currently used.
+ *************************************************************************************************/
+template<typename ItemType,
+         std::size_t InlineCapacity,
+         typename AllocatorType,
+         typename GrowthPolicy>
+[[nodiscard]] inline bool
+small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>::is_inline() const noexcept
+{
+    return this->get_allocator().is_inline(this->data());
+}
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Build the allocator of a small_vector, bound to its own inline buffer.
+ *              Static, as it is called before the vector base of the small_vector is constructed.
+ *
+ * \param       buffer_: Inline buffer of the small_vector.
+ * \param       alloc_:  Upstream allocator.
+ *************************************************************************************************/
+template<typename ItemType,
+         std::size_t InlineCapacity,
+         typename AllocatorType,
+         typename GrowthPolicy>
+[[nodiscard]] inline
+  typename small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>::SmallAllocatorType
+  small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>::make_allocator(
+    BufferType*          buffer_,
+    const AllocatorType& alloc_) noexcept
+{
+    return SmallAllocatorType{buffer_, alloc_};
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Make sure the capacity is at least the inline capacity.
+ *              If no memory is held yet, this selects the inline buffer without allocating.
+ *************************************************************************************************/
+template<typename ItemType,
+         std::size_t InlineCapacity,
+         typename AllocatorType,
+         typename GrowthPolicy>
+inline void
+small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>::use_inline_storage()
+{
+    if(this->capacity() < InlineCapacity)
+    {
+        this->reserve(InlineCapacity);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy all the elements, keeping the current storage.
+ *************************************************************************************************/
+template<typename ItemType,
+         std::size_t InlineCapacity,
+         typename AllocatorType,
+         typename GrowthPolicy>
+inline void
+small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>::clear_elements() noexcept
+{
+    destroy_range(this->m_allocator, this->begin().ptr(), this->end().ptr());
+    this->change_size(0);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy-construct the elements of another small_vector at the end of this one.
+ *
+ * \param       other_: small_vector to copy elements from.
+ *************************************************************************************************/
+template<typename ItemType,
+         std::size_t InlineCapacity,
+         typename AllocatorType,
+         typename GrowthPolicy>
+inline void
+small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>::copy_elements(
+  const small_vector& other_)
+{
+    if(this->capacity() < this->length() + other_.length())
+    {
+        this->reserve(this->length() + other_.length());
+    }
+
+    for(const ItemType& element : other_)
+    {
+        AllocatorTraits::construct(this->m_allocator, this->end().ptr(), element);
+        this->add_size(1);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Take the elements of another small_vector, which is left empty.
+ *              Heap storage is stolen when the upstream allocators are equal. Otherwise, the
+ *              elements are relocated one by one.
+ *
+ * \param       other_: small_vector to take elements from.
+ *
+ * \note        This small_vector must not hold any element.
+ *************************************************************************************************/
+template<typename ItemType,
+         std::size_t InlineCapacity,
+         typename AllocatorType,
+         typename GrowthPolicy>
+inline void
+small_vector<ItemType, InlineCapacity, AllocatorType, GrowthPolicy>::take_elements(
+  small_vector&& other_)
+{
+    if(!other_.is_inline() && this->get_allocator().upstream() == other_.get_allocator().upstream())
+    {
+        this->adopt(std::move(static_cast<VectorType&>(other_)));
+        other_.use_inline_storage();
+        return;
+    }
+
+    const SizeType otherLength = other_.length();
+    if(this->capacity() < otherLength)
+    {
+        this->reserve(otherLength);
+    }
+    use_inline_storage();
+
+    relocate(this->m_allocator, other_.begin().ptr(), other_.end().ptr(), this->begin().ptr());
+    this->change_size(otherLength);
+    other_.change_size(0);
+}
+
+}        // namespace pel
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
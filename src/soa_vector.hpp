@@ -0,0 +1,193 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./aligned_allocator.hpp"
+#include "./growth_policy.hpp"
+#include "./relocation.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace pel
+{
+/**
+ **************************************************************************************************
+ * \brief       Structure-of-arrays vector: every field of the elements lives in its own column.
+ *
+ *              `soa_vector<float, float, int>` stores all the first fields contiguously, then all
+ *              the second fields, and so on. Kernels touching a single field only stream that
+ *              column through the cache, instead of the whole structure of every element, and
+ *              can process it with the `pel::simd` kernels through \ref column().
+ *
+ *              All columns share a single allocation, aligned on `simd_alignment` bytes, and each
+ *              column starts on its own `simd_alignment` boundary. They grow together, following
+ *              `default_growth_policy`.
+ *
+ *              Elements are accessed through proxy references: `operator[]` returns a
+ *              `std::tuple` of references to the fields of the element, which can be read with
+ *              `std::get` or structured bindings, and assigned from a `std::tuple` of values.
+ *
+ * \tparam      Fields: Types of the fields of the elements, in order. They must be nothrow
+ *                      move-constructible, so that growing can relocate the columns one by one.
+ *************************************************************************************************/
+template<typename... Fields>
+class soa_vector
+{
+    static_assert(sizeof...(Fields) > 0, "soa_vector needs at least one field");
+    static_assert((std::is_nothrow_move_constructible_v<Fields> && ...),
+                  "Fields of a soa_vector must be nothrow move-constructible");
+    static_assert(((alignof(Fields) <= simd_alignment) && ...),
+                  "Fields of a soa_vector cannot be over-aligned past simd_alignment");
+
+public:
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+    using SizeType           = std::size_t;
+    using ValueType          = std::tuple<Fields...>;
+    using ReferenceType      = std::tuple<Fields&...>;
+    using ConstReferenceType = std::tuple<const Fields&...>;
+
+    template<std::size_t Index>
+    using FieldType = std::tuple_element_t<Index, ValueType>;
+
+    static constexpr SizeType field_count = sizeof...(Fields);
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+    soa_vector() noexcept = default;
+    explicit soa_vector(SizeType length_);
+
+    soa_vector(const soa_vector& other_);
+    soa_vector(soa_vector&& move_) noexcept;
+    soa_vector& operator=(const soa_vector& copy_);
+    soa_vector& operator=(soa_vector&& move_) noexcept;
+
+    ~soa_vector();
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    [[nodiscard]] ReferenceType      at(SizeType index_);
+    [[nodiscard]] ConstReferenceType at(SizeType index_) const;
+    [[nodiscard]] ReferenceType      operator[](SizeType index_) noexcept;
+    [[nodiscard]] ConstReferenceType operator[](SizeType index_) const noexcept;
+
+    template<std::size_t Index>
+    [[nodiscard]] FieldType<Index>* data() noexcept;
+    template<std::size_t Index>
+    [[nodiscard]] const FieldType<Index>* data() const noexcept;
+
+    template<std::size_t Index>
+    [[nodiscard]] std::span<FieldType<Index>> column() noexcept;
+    template<std::size_t Index>
+    [[nodiscard]] std::span<const FieldType<Index>> column() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Element management ---------------------------------------------------------------------- */
+    void push_back(const ValueType& value_);
+    void push_back(ValueType&& value_);
+
+    template<typename... Args>
+        requires(sizeof...(Args) == sizeof...(Fields)
+                 && (std::is_constructible_v<Fields, Args &&> && ...))
+    void emplace_back(Args&&... args_);
+
+    void pop_back();
+    void clear() noexcept;
+
+    void swap(soa_vector& other_) noexcept;
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType length() const noexcept;
+    [[nodiscard]] bool     is_empty() const noexcept;
+    [[nodiscard]] SizeType capacity() const noexcept;
+
+    void reserve(SizeType newCapacity_);
+    void resize(SizeType newLength_);
+    void shrink_to_fit();
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    using ColumnsType     = std::tuple<Fields*...>;
+    using StorageType     = aligned_allocator<std::byte>;
+    using IndexSequence   = std::index_sequence_for<Fields...>;
+    using OffsetArrayType = std::array<SizeType, sizeof...(Fields) + 1>;
+
+    /** Capacities are multiples of this, so that every column fills whole aligned blocks. */
+    static constexpr SizeType capacity_granularity =
+      std::max({aligned_allocator<Fields>::capacity_granularity...});
+
+    [[nodiscard]] static constexpr OffsetArrayType column_offsets(SizeType capacity_) noexcept;
+    [[nodiscard]] static ColumnsType columns_in(std::byte* storage_, SizeType capacity_) noexcept;
+
+    [[nodiscard]] static constexpr SizeType rounded_capacity(SizeType capacity_) noexcept;
+
+    void reallocate(SizeType newCapacity_);
+    void adopt_storage(std::byte*         newStorage_,
+                       const ColumnsType& newColumns_,
+                       SizeType           newCapacity_) noexcept;
+
+    template<typename... Args>
+    static void construct_fields(const ColumnsType& columns_, SizeType index_, Args&&... args_);
+    static void destroy_fields(const ColumnsType& columns_,
+                               SizeType           index_,
+                               SizeType           fieldCount_) noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    [[no_unique_address]] StorageType m_allocator;
+
+    std::byte*  m_storage = nullptr;
+    ColumnsType m_columns{};
+    SizeType    m_length   = 0;
+    SizeType    m_capacity = 0;
+};
+
+}        // namespace pel
+
+
+#include "./soa_vector.inl"
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,607 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./soa_vector.hpp"
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Constructor creating `length_` value-initialized elements.
+ *              Delegates to the default constructor first, so that the destructor releases the
+ *              elements already created if one of them throws.
+ *************************************************************************************************/
+template<typename... Fields>
+soa_vector<Fields...>::soa_vector(SizeType length_)
+: soa_vector{}
+{
+    resize(length_);
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Copy constructor. Columns of trivially copyable fields are copied with `memcpy`.
+ *************************************************************************************************/
+template<typename... Fields>
+soa_vector<Fields...>::soa_vector(const soa_vector& other_)
+: soa_vector{}
+{
+    reserve(other_.m_length);
+
+    if constexpr((std::is_trivially_copyable_v<Fields> && ...))
+    {
+        if(other_.m_length != 0)
+        {
+            [&]<std::size_t... Index>(std::index_sequence<Index...>)
+            {
+                (std::memcpy(std::get<Index>(m_columns),
+                             std::get<Index>(other_.m_columns),
+                             other_.m_length * sizeof(FieldType<Index>)),
+                 ...);
+            }(IndexSequence{});
+        }
+        m_length = other_.m_length;
+    }
+    else
+    {
+        for(SizeType i = 0; i < other_.m_length; i++)
+        {
+            std::apply(
+              [this](const Fields&... fields_)
+              {
+                  emplace_back(fields_...);
+              },
+              other_[i]);
+        }
+    }
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Move constructor. Steals the storage of the other soa_vector, leaving it empty.
+ *************************************************************************************************/
+template<typename... Fields>
+soa_vector<Fields...>::soa_vector(soa_vector&& move_) noexcept
+: m_storage{std::exchange(move_.m_storage, nullptr)},
+  m_columns{std::exchange(move_.m_columns, ColumnsType{})},
+  m_length{std::exchange(move_.m_length, 0)},
+  m_capacity{std::exchange(move_.m_capacity, 0)}
+{
+}
+
+template<typename... Fields>
+soa_vector<Fields...>&
+soa_vector<Fields...>::operator=(const soa_vector& copy_)
+{
+    if(this != &copy_)
+    {
+        soa_vector copy{copy_};
+        swap(copy);
+    }
+    return *this;
+}
+
+template<typename... Fields>
+soa_vector<Fields...>&
+soa_vector<Fields...>::operator=(soa_vector&& move_) noexcept
+{
+    if(this != &move_)
+    {
+        soa_vector moved{std::move(move_)};
+        swap(moved);
+    }
+    return *this;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Destructor for the soa_vector class.
+ *              Destroys every element and releases the storage of the columns.
+ *************************************************************************************************/
+template<typename... Fields>
+soa_vector<Fields...>::~soa_vector()
+{
+    clear();
+    if(m_storage != nullptr)
+    {
+        m_allocator.deallocate(m_storage, column_offsets(m_capacity).back());
+    }
+}
+
+
+/*************************************************************************************************/
+/* ELEMENT ACCESSORS --------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Access the fields of an element, with bounds checking.
+ *
+ * \throws      std::out_of_range: `index_` is past the length of the soa_vector.
+ *************************************************************************************************/
+template<typename... Fields>
+inline typename soa_vector<Fields...>::ReferenceType
+soa_vector<Fields...>::at(SizeType index_)
+{
+    if(index_ >= m_length)
+    {
+        throw std::out_of_range("soa_vector::at: index is out of range");
+    }
+    return (*this)[index_];
+}
+
+template<typename... Fields>
+inline typename soa_vector<Fields...>::ConstReferenceType
+soa_vector<Fields...>::at(SizeType index_) const
+{
+    if(index_ >= m_length)
+    {
+        throw std::out_of_range("soa_vector::at: index is out of range");
+    }
+    return (*this)[index_];
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Access the fields of an element, without any check.
+ *
+ * \retval      ReferenceType: Tuple of references to every field of the element.
+ *************************************************************************************************/
+template<typename... Fields>
+inline typename soa_vector<Fields...>::ReferenceType
+soa_vector<Fields...>::operator[](SizeType index_) noexcept
+{
+    return std::apply(
+      [index_](Fields*... columns_)
+      {
+          return ReferenceType{columns_[index_]...};
+      },
+      m_columns);
+}
+
+template<typename... Fields>
+inline typename soa_vector<Fields...>::ConstReferenceType
+soa_vector<Fields...>::operator[](SizeType index_) const noexcept
+{
+    return std::apply(
+      [index_](const Fields*... columns_)
+      {
+          return ConstReferenceType{columns_[index_]...};
+      },
+      m_columns);
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Get a pointer to the first element of a column, aligned on `simd_alignment`.
+ *
+ * \tparam      Index: Index of the field in `Fields`.
+ *************************************************************************************************/
+template<typename... Fields>
+template<std::size_t Index>
+inline typename soa_vector<Fields...>::template FieldType<Index>*
+soa_vector<Fields...>::data() noexcept
+{
+    return std::get<Index>(m_columns);
+}
+
+template<typename... Fields>
+template<std::size_t Index>
+inline const typename soa_vector<Fields...>::template FieldType<Index>*
+soa_vector<Fields...>::data() const noexcept
+{
+    return std::get<Index>(m_columns);
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Get a column as a contiguous span, to pass to the `pel::simd` kernels or to any
+ *              algorithm working on contiguous memory.
+ *
+ * \tparam      Index: Index of the field in `Fields`.
+ *************************************************************************************************/
+template<typename... Fields>
+template<std::size_t Index>
+inline std::span<typename soa_vector<Fields...>::template FieldType<Index>>
+soa_vector<Fields...>::column() noexcept
+{
+    return {std::get<Index>(m_columns), m_length};
+}
+
+template<typename... Fields>
+template<std::size_t Index>
+inline std::span<const typename soa_vector<Fields...>::template FieldType<Index>>
+soa_vector<Fields...>::column() const noexcept
+{
+    return {std::get<Index>(m_columns), m_length};
+}
+
+
+/*************************************************************************************************/
+/* ELEMENT MANAGEMENT -------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Append an element, given as a tuple holding the value of every field.
+ *************************************************************************************************/
+template<typename... Fields>
+inline void
+soa_vector<Fields...>::push_back(const ValueType& value_)
+{
+    std::apply(
+      [this](const Fields&... fields_)
+      {
+          emplace_back(fields_...);
+      },
+      value_);
+}
+
+template<typename... Fields>
+inline void
+soa_vector<Fields...>::push_back(ValueType&& value_)
+{
+    std::apply(
+      [this](Fields&... fields_)
+      {
+          emplace_back(std::move(fields_)...);
+      },
+      value_);
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Append an element, constructing each field in place from its own argument.
+ *
+ * \param       args_: One argument per field, forwarded to the constructor of that field.
+ *
+ * \note        When the soa_vector is full, the new element is built in the new storage before
+ *              the old elements are relocated, so that the arguments may refer to elements of
+ *              this soa_vector.
+ *
+ * \note        If the constructor of a field throws, the fields already constructed are
+ *              destroyed, and the soa_vector is left unchanged.
+ *************************************************************************************************/
+template<typename... Fields>
+template<typename... Args>
+    requires(sizeof...(Args) == sizeof...(Fields)
+             && (std::is_constructible_v<Fields, Args &&> && ...))
+inline void
+soa_vector<Fields...>::emplace_back(Args&&... args_)
+{
+    if(m_length != m_capacity)
+    {
+        construct_fields(m_columns, m_length, std::forward<Args>(args_)...);
+        m_length++;
+        return;
+    }
+
+    const SizeType newCapacity =
+      rounded_capacity(default_growth_policy::next_capacity(m_capacity, m_length + 1));
+    std::byte* const  newStorage = m_allocator.allocate(column_offsets(newCapacity).back());
+    const ColumnsType newColumns = columns_in(newStorage, newCapacity);
+    try
+    {
+        construct_fields(newColumns, m_length, std::forward<Args>(args_)...);
+    }
+    catch(...)
+    {
+        m_allocator.deallocate(newStorage, column_offsets(newCapacity).back());
+        throw;
+    }
+
+    adopt_storage(newStorage, newColumns, newCapacity);
+    m_length++;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy the last element.
+ *
+ * \throws      std::length_error: The soa_vector is empty.
+ *************************************************************************************************/
+template<typename... Fields>
+inline void
+soa_vector<Fields...>::pop_back()
+{
+    if(m_length == 0)
+    {
+        throw std::length_error("soa_vector::pop_back: soa_vector is empty");
+    }
+
+    m_length--;
+    destroy_fields(m_columns, m_length, field_count);
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy every element, keeping the storage.
+ *************************************************************************************************/
+template<typename... Fields>
+void
+soa_vector<Fields...>::clear() noexcept
+{
+    std::apply(
+      [this](Fields*... columns_)
+      {
+          (std::destroy_n(columns_, m_length), ...);
+      },
+      m_columns);
+    m_length = 0;
+}
+
+template<typename... Fields>
+void
+soa_vector<Fields...>::swap(soa_vector& other_) noexcept
+{
+    std::swap(m_storage, other_.m_storage);
+    std::swap(m_columns, other_.m_columns);
+    std::swap(m_length, other_.m_length);
+    std::swap(m_capacity, other_.m_capacity);
+}
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+template<typename... Fields>
+inline typename soa_vector<Fields...>::SizeType
+soa_vector<Fields...>::length() const noexcept
+{
+    return m_length;
+}
+
+template<typename... Fields>
+inline bool
+soa_vector<Fields...>::is_empty() const noexcept
+{
+    return m_length == 0;
+}
+
+template<typename... Fields>
+inline typename soa_vector<Fields...>::SizeType
+soa_vector<Fields...>::capacity() const noexcept
+{
+    return m_capacity;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Grow every column to hold at least `newCapacity_` elements.
+ *************************************************************************************************/
+template<typename... Fields>
+void
+soa_vector<Fields...>::reserve(SizeType newCapacity_)
+{
+    if(newCapacity_ > m_capacity)
+    {
+        reallocate(newCapacity_);
+    }
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Change the number of elements. New elements have every field value-initialized.
+ *************************************************************************************************/
+template<typename... Fields>
+void
+soa_vector<Fields...>::resize(SizeType newLength_)
+{
+    if(newLength_ < m_length)
+    {
+        std::apply(
+          [&](Fields*... columns_)
+          {
+              (std::destroy(columns_ + newLength_, columns_ + m_length), ...);
+          },
+          m_columns);
+        m_length = newLength_;
+        return;
+    }
+
+    reserve(newLength_);
+    while(m_length < newLength_)
+    {
+        emplace_back(Fields{}...);
+    }
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Shrink the storage of the columns to the smallest capacity holding the elements.
+ *************************************************************************************************/
+template<typename... Fields>
+void
+soa_vector<Fields...>::shrink_to_fit()
+{
+    reallocate(m_length);
+}
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Byte offset of every column within the storage, for a given capacity.
+ *              Each column starts on a `simd_alignment` boundary. The last offset is the size of
+ *              the whole storage.
+ *************************************************************************************************/
+template<typename... Fields>
+constexpr typename soa_vector<Fields...>::OffsetArrayType
+soa_vector<Fields...>::column_offsets(SizeType capacity_) noexcept
+{
+    constexpr SizeType sizes[] = {sizeof(Fields)...};
+
+    OffsetArrayType offsets{};
+    for(SizeType field = 0; field < field_count; field++)
+    {
+        const SizeType end = offsets[field] + capacity_ * sizes[field];
+        offsets[field + 1] = (end + simd_alignment - 1) & ~(simd_alignment - 1);
+    }
+    return offsets;
+}
+
+template<typename... Fields>
+inline typename soa_vector<Fields...>::ColumnsType
+soa_vector<Fields...>::columns_in(std::byte* storage_, SizeType capacity_) noexcept
+{
+    if(storage_ == nullptr)
+    {
+        return ColumnsType{};
+    }
+
+    const OffsetArrayType offsets = column_offsets(capacity_);
+    return [&]<std::size_t... Index>(std::index_sequence<Index...>)
+    {
+        return ColumnsType{reinterpret_cast<Fields*>(storage_ + offsets[Index])...};
+    }(IndexSequence{});
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Round a capacity up to `capacity_granularity`.
+ *************************************************************************************************/
+template<typename... Fields>
+constexpr typename soa_vector<Fields...>::SizeType
+soa_vector<Fields...>::rounded_capacity(SizeType capacity_) noexcept
+{
+    return (capacity_ + capacity_granularity - 1) / capacity_granularity * capacity_granularity;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Move every column to a new storage of `newCapacity_` elements, rounded up to
+ *              `capacity_granularity`.
+ *
+ * \param       newCapacity_: New capacity, not smaller than the length.
+ *************************************************************************************************/
+template<typename... Fields>
+void
+soa_vector<Fields...>::reallocate(SizeType newCapacity_)
+{
+    newCapacity_ = rounded_capacity(newCapacity_);
+    if(newCapacity_ == m_capacity)
+    {
+        return;
+    }
+
+    std::byte* newStorage =
+      newCapacity_ == 0 ? nullptr : m_allocator.allocate(column_offsets(newCapacity_).back());
+    adopt_storage(newStorage, columns_in(newStorage, newCapacity_), newCapacity_);
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Relocate the elements to an already allocated storage, and release the old one.
+ *              Fields are nothrow move-constructible, so relocating the columns cannot fail
+ *              halfway.
+ *************************************************************************************************/
+template<typename... Fields>
+void
+soa_vector<Fields...>::adopt_storage(std::byte*         newStorage_,
+                                     const ColumnsType& newColumns_,
+                                     SizeType           newCapacity_) noexcept
+{
+    [&]<std::size_t... Index>(std::index_sequence<Index...>)
+    {
+        auto relocateColumn = [&]<std::size_t ColumnIndex>()
+        {
+            std::allocator<FieldType<ColumnIndex>> alloc;
+            relocate(alloc,
+                     std::get<ColumnIndex>(m_columns),
+                     std::get<ColumnIndex>(m_columns) + m_length,
+                     std::get<ColumnIndex>(newColumns_));
+        };
+        (relocateColumn.template operator()<Index>(), ...);
+    }(IndexSequence{});
+
+    if(m_storage != nullptr)
+    {
+        m_allocator.deallocate(m_storage, column_offsets(m_capacity).back());
+    }
+
+    m_storage  = newStorage_;
+    m_columns  = newColumns_;
+    m_capacity = newCapacity_;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Construct every field of the element at `index_` of `columns_`, one argument per
+ *              field. If a constructor throws, the fields already constructed are destroyed.
+ *************************************************************************************************/
+template<typename... Fields>
+template<typename... Args>
+void
+soa_vector<Fields...>::construct_fields(const ColumnsType& columns_,
+                                        SizeType           index_,
+                                        Args&&... args_)
+{
+    SizeType constructed = 0;
+    try
+    {
+        [&]<std::size_t... Index>(std::index_sequence<Index...>)
+        {
+            ((std::construct_at(std::get<Index>(columns_) + index_, std::forward<Args>(args_)),
+              constructed++),
+             ...);
+        }(IndexSequence{});
+    }
+    catch(...)
+    {
+        destroy_fields(columns_, index_, constructed);
+        throw;
+    }
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy the first `fieldCount_` fields of the element at `index_` of `columns_`.
+ *************************************************************************************************/
+template<typename... Fields>
+void
+soa_vector<Fields...>::destroy_fields(const ColumnsType& columns_,
+                                      SizeType           index_,
+                                      SizeType           fieldCount_) noexcept
+{
+    [&]<std::size_t... Index>(std::index_sequence<Index...>)
+    {
+        ((Index < fieldCount_ ? std::destroy_at(std::get<Index>(columns_) + index_) : void()),
+         ...);
+    }(IndexSequence{});
+}
+
+}        // namespace pel
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,335 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* Overflow policies --------------------------------------------------------------------------- */
+
+/**
+ **************************************************************************************************
+ * \brief       Requirements for the overflow policy of a pel::static_vector.
+ *              `on_overflow()` is called whenever an operation would exceed the capacity, and
+ *              `on_invalid_offset(message_)` whenever an offset lies outside the static_vector.
+ *              If they return, the operation is abandoned and reports `false`.
+ *************************************************************************************************/
+template<typename PolicyType>
+concept overflow_policy = requires(const char* message_)
+{
+    {
+        PolicyType::is_noexcept
+        } -> std::convertible_to<bool>;
+    PolicyType::on_overflow();
+    PolicyType::on_invalid_offset(message_);
+};
+
+/**
+ * \brief       Throw an `std::length_error` on overflow, and an `std::invalid_argument` on an
+ *              invalid offset.
+ */
+struct overflow_throw
+{
+    static constexpr bool is_noexcept = false;
+
+    [[noreturn]] static void
+    on_overflow()
+    {
+        throw std::length_error("static_vector capacity exceeded");
+    }
+
+    [[noreturn]] static void
+    on_invalid_offset(const char* message_)
+    {
+        throw std::invalid_argument(message_);
+    }
+};
+
+/**
+ * \brief       Assert on overflow and on an invalid offset. In release builds, the operation
+ *              returns `false`.
+ */
+struct overflow_assert
+{
+    static constexpr bool is_noexcept = true;
+
+    static void
+    on_overflow() noexcept
+    {
+        assert(false && "static_vector capacity exceeded");
+    }
+
+    static void
+    on_invalid_offset(const char*) noexcept
+    {
+        assert(false && "static_vector offset out of range");
+    }
+};
+
+/**
+ * \brief       Silently return `false` on overflow and on an invalid offset.
+ */
+struct overflow_return_false
+{
+    static constexpr bool is_noexcept = true;
+
+    static constexpr void
+    on_overflow() noexcept
+    {
+    }
+
+    static constexpr void
+    on_invalid_offset(const char*) noexcept
+    {
+    }
+};
+
+
+/*************************************************************************************************/
+/* Storage ------------------------------------------------------------------------------------- */
+
+/**
+ **************************************************************************************************
+ * \brief       Smallest unsigned integer type able to hold `Capacity`.
+ *************************************************************************************************/
+template<std::size_t Capacity>
+using static_vector_size_t = std::conditional_t<
+  Capacity <= UINT8_MAX,
+  std::uint8_t,
+  std::conditional_t<Capacity <= UINT16_MAX,
+                     std::uint16_t,
+                     std::conditional_t<Capacity <= UINT32_MAX, std::uint32_t, std::size_t>>>;
+
+/**
+ **************************************************************************************************
+ * \brief       Inline storage of a pel::static_vector.
+ *              Trivial types are stored in a plain array. It is left uninitialized at runtime, but
+ *              value-initialized during constant evaluation, so that a static_vector of trivial
+ *              elements can be a `constexpr` variable. Other types are stored in a union, so that
+ *              they are only constructed when inserted; the union stays trivially copyable if the
+ *              elements are.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, bool = std::is_trivial_v<ItemType>>
+struct static_vector_storage
+{
+    constexpr static_vector_storage() noexcept
+    {
+        if(std::is_constant_evaluated())
+        {
+            for(ItemType& item : m_items)
+            {
+                item = ItemType{};
+            }
+        }
+    }
+
+    ItemType m_items[Capacity];
+};
+
+template<typename ItemType, std::size_t Capacity>
+struct static_vector_storage<ItemType, Capacity, false>
+{
+    constexpr static_vector_storage() noexcept
+    {
+    }
+    constexpr ~static_vector_storage()
+    {
+    }
+    constexpr ~static_vector_storage()
+        requires std::is_trivially_destructible_v<ItemType>
+    = default;
+
+    static_vector_storage(const static_vector_storage&) = delete;
+    static_vector_storage& operator=(const static_vector_storage&) = delete;
+    static_vector_storage(const static_vector_storage&)
+        requires std::is_trivially_copyable_v<ItemType>
+    = default;
+    static_vector_storage& operator=(const static_vector_storage&)
+        requires std::is_trivially_copyable_v<ItemType>
+    = default;
+
+    union
+    {
+        ItemType m_items[Capacity];
+    };
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Fixed-capacity vector storing all its elements inline. Never allocates.
+ *
+ *              The capacity is a compile-time constant, and the object only contains the elements
+ *              and their count. Operations that would exceed the capacity are reported through
+ *              `OverflowPolicy`, and are `noexcept` unless the policy throws.
+ *
+ *              With trivially copyable elements, the static_vector itself is trivially copyable:
+ *              copies and moves copy the whole storage, and it can be passed through `memcpy`.
+ *
+ * \tparam      ItemType:       Type of the elements.
+ * \tparam      Capacity:       Maximum number of elements.
+ * \tparam      OverflowPolicy: What to do when the capacity is exceeded.
+ *              [defaults : overflow_assert]
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy = overflow_assert>
+class static_vector
+{
+    static_assert(Capacity > 0, "static_vector needs a capacity");
+    static_assert(overflow_policy<OverflowPolicy>,
+                  "OverflowPolicy must satisfy pel::overflow_policy");
+
+    static constexpr bool policy_noexcept = OverflowPolicy::is_noexcept;
+    static constexpr bool copy_noexcept = std::is_nothrow_copy_constructible_v<ItemType>;
+    static constexpr bool move_noexcept = std::is_nothrow_move_constructible_v<ItemType>;
+    static constexpr bool trivial_copy  = std::is_trivially_copyable_v<ItemType>;
+    template<typename... Args>
+    static constexpr bool build_noexcept = std::is_nothrow_constructible_v<ItemType, Args...>;
+
+public:
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+    using SizeType            = std::size_t;
+    using DifferenceType      = std::ptrdiff_t;
+    using IteratorType        = ItemType*;
+    using ConstIteratorType   = const ItemType*;
+    using InitializerListType = std::initializer_list<ItemType>;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+    constexpr static_vector() noexcept = default;
+    constexpr explicit static_vector(SizeType length_, const ItemType& value_) noexcept(
+      policy_noexcept && copy_noexcept);
+    constexpr static_vector(InitializerListType ilist_) noexcept(policy_noexcept && copy_noexcept);
+
+    constexpr static_vector(const static_vector& copy_) noexcept(copy_noexcept);
+    constexpr static_vector(static_vector&& move_) noexcept(move_noexcept);
+    constexpr static_vector& operator=(const static_vector& copy_) noexcept(copy_noexcept);
+    constexpr static_vector& operator=(static_vector&& move_) noexcept(move_noexcept);
+
+    constexpr static_vector(const static_vector&) requires trivial_copy = default;
+    constexpr static_vector(static_vector&&) requires trivial_copy = default;
+    constexpr static_vector& operator=(const static_vector&) requires trivial_copy = default;
+    constexpr static_vector& operator=(static_vector&&) requires trivial_copy = default;
+
+    constexpr ~static_vector();
+    constexpr ~static_vector() requires std::is_trivially_destructible_v<ItemType> = default;
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    [[nodiscard]] constexpr ItemType&       at(SizeType index_);
+    [[nodiscard]] constexpr const ItemType& at(SizeType index_) const;
+    [[nodiscard]] constexpr ItemType&       operator[](SizeType index_) noexcept;
+    [[nodiscard]] constexpr const ItemType& operator[](SizeType index_) const noexcept;
+    [[nodiscard]] constexpr ItemType&       front() noexcept;
+    [[nodiscard]] constexpr ItemType&       back() noexcept;
+    [[nodiscard]] constexpr ItemType*       data() noexcept;
+    [[nodiscard]] constexpr const ItemType* data() const noexcept;
+
+    constexpr bool assign(const ItemType& value_, DifferenceType offset_ = 0, SizeType count_ = 1)
+      noexcept(policy_noexcept && copy_noexcept);
+    constexpr bool assign(InitializerListType ilist_, DifferenceType offset_ = 0) noexcept(
+      policy_noexcept && copy_noexcept);
+
+
+    /*********************************************************************************************/
+    /* Iterators ------------------------------------------------------------------------------- */
+    [[nodiscard]] constexpr IteratorType      begin() noexcept;
+    [[nodiscard]] constexpr IteratorType      end() noexcept;
+    [[nodiscard]] constexpr ConstIteratorType begin() const noexcept;
+    [[nodiscard]] constexpr ConstIteratorType end() const noexcept;
+    [[nodiscard]] constexpr ConstIteratorType cbegin() const noexcept;
+    [[nodiscard]] constexpr ConstIteratorType cend() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Element management ---------------------------------------------------------------------- */
+    constexpr void pop_back() noexcept;
+    constexpr void clear() noexcept;
+
+    constexpr bool push_back(const ItemType& value_) noexcept(policy_noexcept && copy_noexcept);
+    constexpr bool push_back(ItemType&& value_) noexcept(policy_noexcept && move_noexcept);
+    constexpr bool push_back(InitializerListType ilist_) noexcept(policy_noexcept
+                                                                   && copy_noexcept);
+
+    template<typename... Args>
+    constexpr bool emplace_back(Args&&... args_) noexcept(policy_noexcept
+                                                           && build_noexcept<Args...>);
+
+    template<typename... Args>
+    constexpr bool emplace(DifferenceType offset_, SizeType count_, Args&&... args_) noexcept(
+      policy_noexcept && build_noexcept<Args...> && copy_noexcept && move_noexcept);
+
+    constexpr bool insert(const ItemType& value_, DifferenceType offset_, SizeType count_ = 1)
+      noexcept(policy_noexcept && copy_noexcept && move_noexcept);
+    constexpr bool insert(InitializerListType ilist_, DifferenceType offset_ = 0) noexcept(
+      policy_noexcept && copy_noexcept && move_noexcept);
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] constexpr SizeType        length() const noexcept;
+    [[nodiscard]] constexpr bool            is_empty() const noexcept;
+    [[nodiscard]] static constexpr SizeType capacity() noexcept;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    [[nodiscard]] constexpr bool check_fit(SizeType extraLength_) noexcept(policy_noexcept);
+    [[nodiscard]] constexpr bool check_offset(DifferenceType offset_,
+                                              const char*    message_) noexcept(policy_noexcept);
+
+    template<typename BuilderType>
+    constexpr void open_gap(SizeType offset_, SizeType count_, BuilderType builder_);
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    static_vector_storage<ItemType, Capacity> m_storage;
+    static_vector_size_t<Capacity>            m_length = 0;
+};
+
+}        // namespace pel
+
+
+#include "./static_vector.inl"
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
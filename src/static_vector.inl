@@ -0,0 +1,799 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./static_vector.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "./relocation.hpp"
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Default-value constructor for the static_vector class.
+ *
+ * \param       length_: Number of elements to create.
+ * \param       value_:  Value to initialize all the elements with.
+ *
+ * \note        If `length_` exceeds the capacity, the overflow policy is invoked and the
+ *              static_vector is left empty.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+constexpr static_vector<ItemType, Capacity, OverflowPolicy>::static_vector(
+  SizeType        length_,
+  const ItemType& value_) noexcept(policy_noexcept && copy_noexcept)
+{
+    if(check_fit(length_))
+    {
+        for(SizeType i = 0; i < length_; i++)
+        {
+            std::construct_at(data() + i, value_);
+            m_length++;
+        }
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Initializer list constructor for the static_vector class.
+ *
+ * \param       ilist_: Initializer list of all the values to put in the static_vector.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+constexpr static_vector<ItemType, Capacity, OverflowPolicy>::static_vector(
+  InitializerListType ilist_) noexcept(policy_noexcept && copy_noexcept)
+{
+    push_back(ilist_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy constructor for the static_vector class.
+ *
+ * \param       copy_: static_vector to copy data from.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+constexpr static_vector<ItemType, Capacity, OverflowPolicy>::static_vector(
+  const static_vector& copy_) noexcept(copy_noexcept)
+{
+    for(const ItemType& element : copy_)
+    {
+        std::construct_at(data() + m_length, element);
+        m_length++;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move constructor for the static_vector class.
+ *              Elements are moved one by one; the other static_vector keeps its moved-from
+ *              elements.
+ *
+ * \param       move_: static_vector to move data from.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+constexpr static_vector<ItemType, Capacity, OverflowPolicy>::static_vector(
+  static_vector&& move_) noexcept(move_noexcept)
+{
+    for(ItemType& element : move_)
+    {
+        std::construct_at(data() + m_length, std::move(element));
+        m_length++;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy assignment operator for the static_vector class.
+ *
+ * \param       copy_: static_vector to copy data from.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+constexpr static_vector<ItemType, Capacity, OverflowPolicy>&
+static_vector<ItemType, Capacity, OverflowPolicy>::operator=(const static_vector& copy_) noexcept(
+  copy_noexcept)
+{
+    if(this != std::addressof(copy_))
+    {
+        clear();
+        for(const ItemType& element : copy_)
+        {
+            std::construct_at(data() + m_length, element);
+            m_length++;
+        }
+    }
+    return *this;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move assignment operator for the static_vector class.
+ *
+ * \param       move_: static_vector to move data from.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+constexpr static_vector<ItemType, Capacity, OverflowPolicy>&
+static_vector<ItemType, Capacity, OverflowPolicy>::operator=(static_vector&& move_) noexcept(
+  move_noexcept)
+{
+    if(this != std::addressof(move_))
+    {
+        clear();
+        for(ItemType& element : move_)
+        {
+            std::construct_at(data() + m_length, std::move(element));
+            m_length++;
+        }
+    }
+    return *this;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destructor for the static_vector class.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+constexpr static_vector<ItemType, Capacity, OverflowPolicy>::~static_vector()
+{
+    clear();
+}
+
+
+/*************************************************************************************************/
+/* ELEMENT ACCESSORS --------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Bounds-checked element access.
+ *
+ * \param       index_: Index of the element.
+ *
+ * \throws      std::out_of_range("Invalid static_vector index")
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+[[nodiscard]] constexpr ItemType&
+static_vector<ItemType, Capacity, OverflowPolicy>::at(SizeType index_)
+{
+    if(index_ >= length())
+    {
+        throw std::out_of_range("Invalid static_vector index");
+    }
+    return data()[index_];
+}
+
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+[[nodiscard]] constexpr const ItemType&
+static_vector<ItemType, Capacity, OverflowPolicy>::at(SizeType index_) const
+{
+    if(index_ >= length())
+    {
+        throw std::out_of_range("Invalid static_vector index");
+    }
+    return data()[index_];
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Unchecked element access.
+ *
+ * \param       index_: Index of the element.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+[[nodiscard]] constexpr ItemType&
+static_vector<ItemType, Capacity, OverflowPolicy>::operator[](SizeType index_) noexcept
+{
+    return data()[index_];
+}
+
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+[[nodiscard]] constexpr const ItemType&
+static_vector<ItemType, Capacity, OverflowPolicy>::operator[](SizeType index_) const noexcept
+{
+    return data()[index_];
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Access the first and last elements. The static_vector must not be empty.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+[[nodiscard]] constexpr ItemType&
+static_vector<ItemType, Capacity, OverflowPolicy>::front() noexcept
+{
+    return data()[0];
+}
+
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+[[nodiscard]] constexpr ItemType&
+static_vector<ItemType, Capacity, OverflowPolicy>::back() noexcept
+{
+    return data()[m_length - 1];
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get a pointer to the beginning of the static_vector's data space.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+[[nodiscard]] constexpr ItemType*
+static_vector<ItemType, Capacity, OverflowPolicy>::data() noexcept
+{
+    return m_storage.m_items;
+}
+
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+[[nodiscard]] constexpr const ItemType*
+static_vector<ItemType, Capacity, OverflowPolicy>::data() const noexcept
+{
+    return m_storage.m_items;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Assign a value to a certain offset for a certain amount of elements.
+ *              Elements past the current length are constructed, extending the static_vector.
+ *
+ * \param       value_:  Value to assign.
+ * \param       offset_: Offset at which data should be assigned. Must not exceed the length.
+ *              [defaults : 0]
+ * \param       count_:  Number of elements to be assigned a new value.
+ *              [defaults : 1]
+ *
+ * \retval      bool: False if the offset is invalid or the assignment would exceed the capacity.
+ *
+ * \throws      std::invalid_argument("Invalid assign offset")
+ *              Offset was out of bounds, and the overflow policy may throw.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+constexpr bool
+static_vector<ItemType, Capacity, OverflowPolicy>::assign(const ItemType& value_,
+                                                          DifferenceType  offset_,
+                                                          SizeType        count_) noexcept(
+  policy_noexcept && copy_noexcept)
+{
+    if(!check_offset(offset_, "Invalid assign offset"))
+    {
+        return false;
+    }
+
+    const auto offset = static_cast<SizeType>(offset_);
+    if(offset + count_ > length() && !check_fit(offset + count_ - length()))
+    {
+        return false;
+    }
+
+    for(SizeType i = offset; i < offset + count_; i++)
+    {
+        if(i < length())
+        {
+            data()[i] = value_;
+        }
+        else
+        {
+            std::construct_at(data() + i, value_);
+            m_length++;
+        }
+    }
+    return true;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Assign values to a certain offset through an initializer list.
+ *              Elements past the current length are constructed, extending the static_vector.
+ *
+ * \param       ilist_:  Values to assign.
+ * \param       offset_: Offset at which data should be assigned. Must not exceed the length.
+ *              [defaults : 0]
+ *
+ * \retval      bool: False if the offset is invalid or the assignment would exceed the capacity.
+ *
+ * \throws      std::invalid_argument("Invalid assign offset")
+ *              Offset was out of bounds, and the overflow policy may throw.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+constexpr bool
+static_vector<ItemType, Capacity, OverflowPolicy>::assign(InitializerListType ilist_,
+                                                          DifferenceType offset_) noexcept(
+  policy_noexcept && copy_noexcept)
+{
+    if(!check_offset(offset_, "Invalid assign offset"))
+    {
+        return false;
+    }
+
+    const auto offset = static_cast<SizeType>(offset_);
+    if(offset + ilist_.size() > length() && !check_fit(offset + ilist_.size() - length()))
+    {
+        return false;
+    }
+
+    SizeType i = offset;
+    for(const ItemType& value : ilist_)
+    {
+        if(i < length())
+        {
+            data()[i] = value;
+        }
+        else
+        {
+            std::construct_at(data() + i, value);
+            m_length++;
+        }
+        i++;
+    }
+    return true;
+}
+
+
+/*************************************************************************************************/
+/* ITERATORS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+[[nodiscard]] constexpr typename static_vector<ItemType, Capacity, OverflowPolicy>::IteratorType
+static_vector<ItemType, Capacity, OverflowPolicy>::begin() noexcept
+{
+    return data();
+}
+
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+[[nodiscard]] constexpr typename static_vector<ItemType, Capacity, OverflowPolicy>::IteratorType
+static_vector<ItemType, Capacity, OverflowPolicy>::end() noexcept
+{
+    return data() + m_length;
+}
+
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+[[nodiscard]] constexpr
+  typename static_vector<ItemType, Capacity, OverflowPolicy>::ConstIteratorType
+  static_vector<ItemType, Capacity, OverflowPolicy>::begin() const noexcept
+{
+    return data();
+}
+
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+[[nodiscard]] constexpr
+  typename static_vector<ItemType, Capacity, OverflowPolicy>::ConstIteratorType
+  static_vector<ItemType, Capacity, OverflowPolicy>::end() const noexcept
+{
+    return data() + m_length;
+}
+
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+[[nodiscard]] constexpr
+  typename static_vector<ItemType, Capacity, OverflowPolicy>::ConstIteratorType
+  static_vector<ItemType, Capacity, OverflowPolicy>::cbegin() const noexcept
+{
+    return data();
+}
+
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+[[nodiscard]] constexpr
+  typename static_vector<ItemType, Capacity, OverflowPolicy>::ConstIteratorType
+  static_vector<ItemType, Capacity, OverflowPolicy>::cend() const noexcept
+{
+    return data() + m_length;
+}
+
+
+/*************************************************************************************************/
+/* ELEMENT MANAGEMENT -------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Remove the last element of the static_vector.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+constexpr void
+static_vector<ItemType, Capacity, OverflowPolicy>::pop_back() noexcept
+{
+    if(m_length == 0)
+    {
+        return;
+    }
+
+    m_length--;
+    std::destroy_at(data() + m_length);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Remove all the elements of the static_vector.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+constexpr void
+static_vector<ItemType, Capacity, OverflowPolicy>::clear() noexcept
+{
+    std::destroy(data(), data() + m_length);
+    m_length = 0;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Add an element to the end of the static_vector.
+ *
+ * \param       value_: Element to push back at the end of the static_vector.
+ *
+ * \retval      bool: False if the static_vector was full.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+constexpr bool
+static_vector<ItemType, Capacity, OverflowPolicy>::push_back(const ItemType& value_) noexcept(
+  policy_noexcept && copy_noexcept)
+{
+    return emplace_back(value_);
+}
+
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+constexpr bool
+static_vector<ItemType, Capacity, OverflowPolicy>::push_back(ItemType&& value_) noexcept(
+  policy_noexcept && move_noexcept)
+{
+    return emplace_back(std::move(value_));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Add elements from an initializer list to the end of the static_vector.
+ *              Either all the elements are added, or none of them.
+ *
+ * \param       ilist_: Initializer list containing elements to push back.
+ *
+ * \retval      bool: False if the elements did not fit.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+constexpr bool
+static_vector<ItemType, Capacity, OverflowPolicy>::push_back(InitializerListType ilist_) noexcept(
+  policy_noexcept && copy_noexcept)
+{
+    if(!check_fit(ilist_.size()))
+    {
+        return false;
+    }
+
+    for(const ItemType& value : ilist_)
+    {
+        std::construct_at(data() + m_length, value);
+        m_length++;
+    }
+    return true;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Constructs an element in place at the end of the static_vector.
+ *
+ * \param       args_: The arguments needed to be passed to the constructor of an element.
+ *
+ * \retval      bool: False if the static_vector was full.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+template<typename... Args>
+constexpr bool
+static_vector<ItemType, Capacity, OverflowPolicy>::emplace_back(Args&&... args_) noexcept(
+  policy_noexcept && build_noexcept<Args...>)
+{
+    if(!check_fit(1))
+    {
+        return false;
+    }
+
+    std::construct_at(data() + m_length, std::forward<Args>(args_)...);
+    m_length++;
+    return true;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Constructs elements in the middle of the static_vector, right-shifting items on
+ *              the right to fit.
+ *
+ * \param       offset_: Position to construct the elements at.
+ * \param       count_:  Number of elements to construct.
+ * \param       args_:   The arguments needed to be passed to the constructor of an element.
+ *
+ * \retval      bool: False if the offset is invalid or the elements did not fit.
+ *
+ * \throws      std::invalid_argument("Invalid insert offset")
+ *              Offset was out of bounds, and the overflow policy may throw.
+ *
+ * \note        The element is constructed before anything is shifted, since the arguments may
+ *              refer to elements of the static_vector. It is then moved in place, or copied
+ *              `count_` times.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+template<typename... Args>
+constexpr bool
+static_vector<ItemType, Capacity, OverflowPolicy>::emplace(DifferenceType offset_,
+                                                           SizeType       count_,
+                                                           Args&&... args_) noexcept(
+  policy_noexcept && build_noexcept<Args...> && copy_noexcept && move_noexcept)
+{
+    if(!check_offset(offset_, "Invalid insert offset") || !check_fit(count_))
+    {
+        return false;
+    }
+
+    /* The arguments may refer to elements that the shift is about to move */
+    ItemType value(std::forward<Args>(args_)...);
+
+    /* clang-format off */
+    open_gap(static_cast<SizeType>(offset_), count_,
+             [&](ItemType* destination_, SizeType /*index_*/)
+             {
+                 if(count_ == 1)
+                 {
+                     std::construct_at(destination_, std::move(value));
+                 }
+                 else
+                 {
+                     std::construct_at(destination_, std::as_const(value));
+                 }
+             });
+    /* clang-format on */
+    return true;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Insert copies of an element in the middle of the static_vector, right-shifting
+ *              items on the right to fit.
+ *
+ * \param       value_:  Element to insert.
+ * \param       offset_: Position to insert the element at.
+ * \param       count_:  Number of copies to insert.
+ *              [defaults : 1]
+ *
+ * \retval      bool: False if the offset is invalid or the elements did not fit.
+ *
+ * \throws      std::invalid_argument("Invalid insert offset")
+ *              Offset was out of bounds, and the overflow policy may throw.
+ *
+ * \note        `value_` may be an element of the static_vector, so it is copied before the
+ *              elements are shifted.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+constexpr bool
+static_vector<ItemType, Capacity, OverflowPolicy>::insert(const ItemType& value_,
+                                                          DifferenceType  offset_,
+                                                          SizeType        count_) noexcept(
+  policy_noexcept && copy_noexcept && move_noexcept)
+{
+    return emplace(offset_, count_, value_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Insert elements from an initializer list in the middle of the static_vector,
+ *              right-shifting items on the right to fit.
+ *
+ * \param       ilist_:  Elements to insert.
+ * \param       offset_: Position to insert the elements at.
+ *              [defaults : 0]
+ *
+ * \retval      bool: False if the offset is invalid or the elements did not fit.
+ *
+ * \throws      std::invalid_argument("Invalid insert offset")
+ *              Offset was out of bounds, and the overflow policy may throw.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+constexpr bool
+static_vector<ItemType, Capacity, OverflowPolicy>::insert(InitializerListType ilist_,
+                                                          DifferenceType offset_) noexcept(
+  policy_noexcept && copy_noexcept && move_noexcept)
+{
+    if(!check_offset(offset_, "Invalid insert offset") || !check_fit(ilist_.size()))
+    {
+        return false;
+    }
+
+    /* clang-format off */
+    open_gap(static_cast<SizeType>(offset_), ilist_.size(),
+             [&](ItemType* destination_, SizeType index_)
+             {
+                 std::construct_at(destination_, ilist_.begin()[index_]);
+             });
+    /* clang-format on */
+    return true;
+}
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+[[nodiscard]] constexpr typename static_vector<ItemType, Capacity, OverflowPolicy>::SizeType
+static_vector<ItemType, Capacity, OverflowPolicy>::length() const noexcept
+{
+    return m_length;
+}
+
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+[[nodiscard]] constexpr bool
+static_vector<ItemType, Capacity, OverflowPolicy>::is_empty() const noexcept
+{
+    return m_length == 0;
+}
+
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+[[nodiscard]] constexpr typename static_vector<ItemType, Capacity, OverflowPolicy>::SizeType
+static_vector<ItemType, Capacity, OverflowPolicy>::capacity() noexcept
+{
+    return Capacity;
+}
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Check if the static_vector can hold the required extra elements.
+ *              If it cannot, invoke the overflow policy.
+ *
+ * \param       extraLength_: Numbers of elements to add to the current length.
+ *
+ * \retval      bool: True if the elements fit.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+[[nodiscard]] constexpr bool
+static_vector<ItemType, Capacity, OverflowPolicy>::check_fit(SizeType extraLength_) noexcept(
+  policy_noexcept)
+{
+    if(extraLength_ > Capacity - length())
+    {
+        OverflowPolicy::on_overflow();
+        return false;
+    }
+    return true;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Check if an offset lies within the static_vector, its end included.
+ *              If it does not, invoke the invalid offset handler of the overflow policy.
+ *
+ * \param       offset_:  Offset to check.
+ * \param       message_: Description of the error, given to the overflow policy.
+ *
+ * \retval      bool: True if the offset is valid.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+[[nodiscard]] constexpr bool
+static_vector<ItemType, Capacity, OverflowPolicy>::check_offset(
+  DifferenceType offset_, const char* message_) noexcept(policy_noexcept)
+{
+    if(offset_ < 0 || static_cast<SizeType>(offset_) > length())
+    {
+        OverflowPolicy::on_invalid_offset(message_);
+        return false;
+    }
+    return true;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Right-shift the elements after `offset_` by `count_` positions, and build the new
+ *              elements in the gap with `builder_(destination, index)`.
+ *              If a construction throws, the gap is closed again before rethrowing.
+ *
+ * \note        The caller must have checked that the elements fit.
+ *************************************************************************************************/
+template<typename ItemType, std::size_t Capacity, typename OverflowPolicy>
+template<typename BuilderType>
+constexpr void
+static_vector<ItemType, Capacity, OverflowPolicy>::open_gap(SizeType    offset_,
+                                                            SizeType    count_,
+                                                            BuilderType builder_)
+{
+    /* The caller checked that `length() + count_` fits, so the clamp only tells the optimizer that
+     * the shifted tail stays inside the storage */
+    ItemType*      first      = data() + offset_;
+    const SizeType tailLength = std::min(length(), Capacity - count_) - offset_;
+
+    /* clang-format off */
+    auto shift = [&](ItemType* source_, ItemType* destination_)
+                 {
+                     if(!std::is_constant_evaluated() && is_trivially_relocatable_v<ItemType>)
+                     {
+                         std::memmove(static_cast<void*>(destination_),
+                                      static_cast<const void*>(source_),
+                                      tailLength * sizeof(ItemType));
+                     }
+                     else if(destination_ > source_)
+                     {
+                         for(SizeType i = tailLength; i > 0; i--)
+                         {
+                             std::construct_at(destination_ + i - 1, std::move(source_[i - 1]));
+                             std::destroy_at(source_ + i - 1);
+                         }
+                     }
+                     else
+                     {
+                         for(SizeType i = 0; i < tailLength; i++)
+                         {
+                             std::construct_at(destination_ + i, std::move(source_[i]));
+                             std::destroy_at(source_ + i);
+                         }
+                     }
+                 };
+    /* clang-format on */
+
+    shift(first, first + count_);
+
+    SizeType built = 0;
+    try
+    {
+        for(; built < count_; built++)
+        {
+            builder_(first + built, built);
+        }
+    }
+    catch(...)
+    {
+        std::destroy(first, first + built);
+        shift(first + count_, first);
+        throw;
+    }
+
+    m_length = static_cast<static_vector_size_t<Capacity>>(m_length + count_);
+}
+
+}        // namespace pel
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -26,14 +26,24 @@
 /*************************************************************************************************/
 /* File includes ------------------------------------------------------------------------------- */
 #include "./container_base/src/container_base.hpp"
+#include "./aligned_allocator.hpp"
+#include "./allocator_extensions.hpp"
+#include "./growth_policy.hpp"
+#include "./instrumentation_policy.hpp"
+#include "./relocation.hpp"
 
 #include <algorithm>
 #include <compare>
+#include <concepts>
 #include <functional>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <ostream>
 #include <sstream>
 #include <stdexcept>
+#include <string>
+#include <utility>
 
 
 namespace pel
@@ -43,11 +53,63 @@ constexpr bool vector_safeness = true;
 template<typename ItemType>
 using vector_iterator = iterator_base<ItemType>;
 
-template<typename ItemType, typename AllocatorType = std::allocator<ItemType>>
+/** Tag selecting the parallel overload of the generator constructor, defined along with that
+ *  constructor in vector_parallel.hpp. */
+struct parallel_t;
+
+/**
+ **************************************************************************************************
+ * \brief       Callables generating the elements of a vector, either from nothing or from the
+ *              index of the element to generate.
+ *************************************************************************************************/
+template<typename GeneratorType, typename ItemType>
+concept nullary_generator = std::invocable<GeneratorType&>
+                            && std::convertible_to<std::invoke_result_t<GeneratorType&>, ItemType>;
+
+template<typename GeneratorType, typename ItemType>
+concept indexed_generator =
+  std::invocable<GeneratorType&, std::size_t>
+  && std::convertible_to<std::invoke_result_t<GeneratorType&, std::size_t>, ItemType>;
+
+template<typename GeneratorType, typename ItemType>
+concept element_generator =
+  (nullary_generator<GeneratorType, ItemType> || indexed_generator<GeneratorType, ItemType>)
+  && !std::same_as<std::remove_cvref_t<GeneratorType>, ItemType>;
+
+/**
+ **************************************************************************************************
+ * \brief       Lazy element-wise expressions over vectors.
+ *              Arithmetic operators on vectors return lightweight expression nodes instead of new
+ *              vectors. Nothing is computed until the expression is assigned to a vector or
+ *              reduced, at which point the whole expression is evaluated in a single loop,
+ *              without any temporary vector.
+ *
+ * \note        The operators, and the vector constructor and assignment operator evaluating the
+ *              expressions, are defined in vector_expression.hpp.
+ *              Expression nodes copy their sub-expressions and scalars, but only reference the
+ *              storage of the vectors they read. These vectors must outlive the expression.
+ *************************************************************************************************/
+template<typename ExpressionType>
+concept vector_expression = requires(const ExpressionType& expression_, std::size_t index_)
+{
+    requires ExpressionType::is_vector_expression;
+    {
+        expression_.length()
+        } -> std::same_as<std::size_t>;
+    expression_[index_];
+};
+
+template<typename ItemType,
+         typename AllocatorType   = default_allocator_t<ItemType>,
+         typename GrowthPolicy    = default_growth_policy,
+         typename Instrumentation = no_instrumentation>
 class vector : public container_base<ItemType, vector_iterator<ItemType>, AllocatorType>
 {
     static_assert(std::is_same_v<ItemType, typename AllocatorType::value_type>,
                   "Allocator must match element type");
+    static_assert(growth_policy<GrowthPolicy>, "GrowthPolicy must satisfy pel::growth_policy");
+    static_assert(instrumentation_policy<Instrumentation>,
+                  "Instrumentation must satisfy pel::instrumentation_policy");
 
 public:
     /*********************************************************************************************/
@@ -60,6 +122,10 @@ public:
     using RIteratorType       = typename IteratorType::ReverseIteratorType;
     using InitializerListType = std::initializer_list<ItemType>;
 
+    /** Vector of the same elements, using another allocator. */
+    template<typename OtherAllocatorType>
+    using OtherVectorType = vector<ItemType, OtherAllocatorType, GrowthPolicy, Instrumentation>;
+
 
     /*********************************************************************************************/
     /* Constructors ---------------------------------------------------------------------------- */
@@ -74,21 +140,34 @@ public:
     /*-----------------------------------------------*/
     /* Copy constructor and copy-assignment operator */
     template<typename OtherAllocatorType = AllocatorType>
-    explicit vector(const vector<ItemType, OtherAllocatorType>& otherVector_,
-                    const AllocatorType&                        alloc_ = AllocatorType{});
+    explicit vector(const OtherVectorType<OtherAllocatorType>& otherVector_,
+                    const AllocatorType& alloc_ = AllocatorType{});
     explicit vector(const vector& otherVector_);
     template<typename OtherAllocatorType = AllocatorType>
-    vector& operator=(const vector<ItemType, OtherAllocatorType>& copy_);
+    vector& operator=(const OtherVectorType<OtherAllocatorType>& copy_);
     vector& operator=(const vector& copy_);
 
     /*-----------------------------------------------*/
     /* Move constructor and move-assignment operator */
-    template<typename OtherAllocatorType = AllocatorType>
-    explicit vector(vector<ItemType, OtherAllocatorType>&& move_,
-                    AllocatorType&                         alloc_ = AllocatorType{});
-    template<typename OtherAllocatorType = AllocatorType>
-    vector& operator=(vector<ItemType, OtherAllocatorType>&& move_);
-
+    vector(vector&& move_) noexcept;
+    vector(vector&& move_, const AllocatorType& alloc_);
+    template<typename OtherAllocatorType>
+        requires(!std::is_same_v<OtherAllocatorType, AllocatorType>)
+    explicit vector(OtherVectorType<OtherAllocatorType>&& move_,
+                    const AllocatorType& alloc_ = AllocatorType{});
+    vector& operator=(vector&& move_) noexcept(
+      AllocatorTraits::propagate_on_container_move_assignment::value ||
+      AllocatorTraits::is_always_equal::value);
+    template<typename OtherAllocatorType>
+        requires(!std::is_same_v<OtherAllocatorType, AllocatorType>)
+    vector& operator=(OtherVectorType<OtherAllocatorType>&& move_);
+
+    /*-----------------------------------------------------------*/
+    /* Expression constructor and expression-assignment operator */
+    template<vector_expression ExpressionType>
+    vector(const ExpressionType& expression_, const AllocatorType& alloc_ = AllocatorType{});
+    template<vector_expression ExpressionType>
+    vector& operator=(const ExpressionType& expression_);
 
     /*----------------------*/
     /* Special constructors */
@@ -99,9 +178,18 @@ public:
                     Args&&... args_,
                     const AllocatorType& alloc_ = AllocatorType{});
 
-    explicit vector(SizeType                      length_,
-                    std::function<ItemType(void)> function_,
-                    const AllocatorType&          alloc_ = AllocatorType{});
+    template<typename GeneratorType>
+        requires element_generator<GeneratorType, ItemType>
+    explicit vector(SizeType             length_,
+                    GeneratorType&&      generator_,
+                    const AllocatorType& alloc_ = AllocatorType{});
+
+    template<typename GeneratorType>
+        requires indexed_generator<const GeneratorType, ItemType>
+    explicit vector(parallel_t,
+                    SizeType             length_,
+                    const GeneratorType& generator_,
+                    const AllocatorType& alloc_ = AllocatorType{});
 
     /*------------*/
     /* Destructor */
@@ -119,22 +207,33 @@ public:
 
     /*********************************************************************************************/
     /* Operator overloads ---------------------------------------------------------------------- */
-    vector<ItemType, AllocatorType>& operator+=(const ItemType& rhs_);
+    vector& operator+=(const ItemType& rhs_);
 
-    const vector<ItemType, AllocatorType> operator++(int);
-    const vector<ItemType, AllocatorType> operator--(int);
+    const vector operator++(int);
+    const vector operator--(int);
 
-    vector<ItemType, AllocatorType>& operator>>(int steps_);
-    vector<ItemType, AllocatorType>& operator<<(int steps_);
+    vector& operator>>(int steps_);
+    vector& operator<<(int steps_);
 
 
     /*********************************************************************************************/
     /* Element management ---------------------------------------------------------------------- */
     void pop_back();
+
+    IteratorType erase(IteratorType position_);
+    IteratorType erase(IteratorType first_, IteratorType last_);
+    IteratorType unordered_erase(IteratorType position_);
+
+    template<typename Predicate>
+    SizeType erase_if(Predicate predicate_);
+
     void push_back(const ItemType& value_);
+    void push_back(ItemType&& value_);
     void push_back(InitializerListType ilist_);
     template<typename OtherAllocatorType = AllocatorType>
-    void push_back(const vector<ItemType, OtherAllocatorType>& otherVector_);
+    void push_back(const OtherVectorType<OtherAllocatorType>& otherVector_);
+    template<typename OtherAllocatorType = AllocatorType>
+    void push_back(OtherVectorType<OtherAllocatorType>&& otherVector_);
 
     template<typename... Args>
     void emplace_back(Args&&... args_);
@@ -155,6 +254,14 @@ public:
                         IteratorType   sourceEnd_,
                         DifferenceType offset_ = 0);
 
+    IteratorType insert(std::move_iterator<IteratorType> sourceBegin_,
+                        std::move_iterator<IteratorType> sourceEnd_,
+                        IteratorType                     position_);
+
+    IteratorType insert(std::move_iterator<IteratorType> sourceBegin_,
+                        std::move_iterator<IteratorType> sourceEnd_,
+                        DifferenceType                   offset_ = 0);
+
     IteratorType insert(InitializerListType ilist_, SizeType offset_ = 0);
 
 
@@ -169,6 +276,12 @@ public:
 
     void reserve(SizeType newCapacity_);
     void resize(SizeType newLength_);
+    void resize(SizeType newLength_, const ItemType& value_);
+    void resize_default_init(SizeType newLength_);
+
+    template<typename OperationType>
+        requires std::is_invocable_r_v<std::size_t, OperationType&, ItemType*, std::size_t>
+    void resize_for_overwrite(SizeType newLength_, OperationType&& operation_);
 
     void shrink_to_fit();
 
@@ -178,21 +291,63 @@ public:
     [[nodiscard]] std::string to_string() const override;
 
 
+    /*********************************************************************************************/
+    /* Instrumentation ------------------------------------------------------------------------- */
+    [[nodiscard]] Instrumentation&       instrumentation() noexcept;
+    [[nodiscard]] const Instrumentation& instrumentation() const noexcept;
+
+    void write_instrumentation(std::ostream& os_) const
+        requires Instrumentation::enabled;
+
+
+    /*********************************************************************************************/
+    /* Protected methods ----------------------------------------------------------------------- */
+protected:
+    void adopt(ItemType* data_, SizeType length_, SizeType capacity_) noexcept;
+    void adopt(vector&& other_) noexcept;
+
+
     /*********************************************************************************************/
     /* Private methods ------------------------------------------------------------------------- */
 private:
+    template<typename, typename, typename, typename>
+    friend class vector;
+
     void vector_constructor(SizeType size_);
 
     void check_fit(SizeType extraLength_);
 
-    SizeType step_size() noexcept;
+    void copy_elements(const ItemType* first_, SizeType count_);
+
+    void record_reallocation(reallocation_kind kind_,
+                             SizeType          oldCapacity_,
+                             SizeType          newCapacity_,
+                             SizeType          length_) noexcept;
+
+    template<typename ConstructFunction>
+    void resize_with(SizeType newLength_, ConstructFunction construct_);
+
+    template<typename ConstructFunction>
+    IteratorType insert_with(SizeType offset_, SizeType count_, ConstructFunction construct_);
+
+    static constexpr SizeType rounded_capacity(SizeType capacity_) noexcept;
+
+    /** Whether growing places every element directly in a new block, instead of resizing the
+     *  block first and shifting the elements afterwards. Only then are the elements still in
+     *  place while the inserted ones are constructed. */
+    static constexpr bool grows_by_relocation =
+      (is_trivially_relocatable_v<ItemType> || std::is_nothrow_move_constructible_v<ItemType>)
+      && !allocator_extension_traits<AllocatorType>::can_expand_in_place
+      && !(allocator_extension_traits<AllocatorType>::can_reallocate
+           && is_trivially_relocatable_v<ItemType>);
 
 
     /*********************************************************************************************/
     /* Variables ------------------------------------------------------------------------------- */
 private:
-    SizeType      m_capacity      = 0;
-    SizeType      m_stepSize      = 4;
+    SizeType m_capacity = 0;
+
+    [[no_unique_address]] Instrumentation m_instrumentation;
 };
 
 }        // namespace pel
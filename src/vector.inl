@@ -41,15 +41,20 @@ namespace pel
  *
  * \note        This method is not directly part of the pel::vector class, and is rather appended
  *              to the std::ostream class.
+ *              For integral and string elements, pel::to_string and pel::format_to (see
+ *              vector_format.hpp) produce the same text without going through the stream. Floating
+ *              point elements differ: the stream writes 6 significant digits, while these write the
+ *              shortest exact representation.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
 inline static std::ostream&
-operator<<(std::ostream& os_, const vector<ItemType, AllocatorType>& vec_) noexcept
+operator<<(std::ostream&                                                         os_,
+           const vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>& vec_) noexcept
 {
     /* Add capacity and length header */
     os_ << "Capacity : [" << vec_.capacity() << "]   |   Length: [" << vec_.length() << "]\n";
 
-    for(ItemType& element : vec_)
+    for(const ItemType& element : vec_)
     {
         os_ << element << '\n';
     }
@@ -58,6 +63,50 @@ operator<<(std::ostream& os_, const vector<ItemType, AllocatorType>& vec_) noexc
 }
 
 
+/**
+ **************************************************************************************************
+ * \brief       Remove every element of a vector matching a predicate, in a single pass.
+ *              Same as `vector_.erase_if(predicate_)`, for symmetry with `std::erase_if`.
+ *
+ * \param       vector_:    Vector to remove elements from.
+ * \param       predicate_: Callable returning `true` for the elements to remove.
+ *
+ * \retval      std::size_t: Number of removed elements.
+ *************************************************************************************************/
+template<typename ItemType,
+         typename AllocatorType,
+         typename GrowthPolicy,
+         typename Instrumentation,
+         typename Predicate>
+inline std::size_t
+erase_if(vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>& vector_,
+         Predicate                                                       predicate_)
+{
+    return vector_.erase_if(std::move(predicate_));
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Remove every element of a vector equal to a value, in a single pass.
+ *
+ * \param       vector_: Vector to remove elements from.
+ * \param       value_:  Value of the elements to remove.
+ *
+ * \retval      std::size_t: Number of removed elements.
+ *************************************************************************************************/
+template<typename ItemType,
+         typename AllocatorType,
+         typename GrowthPolicy,
+         typename Instrumentation,
+         typename ValueType>
+inline std::size_t
+erase(vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>& vector_,
+      const ValueType&                                                value_)
+{
+    return vector_.erase_if([&value_](const ItemType& item_) { return item_ == value_; });
+}
+
+
 /*************************************************************************************************/
 /* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
 /*************************************************************************************************/
@@ -71,9 +120,10 @@ operator<<(std::ostream& os_, const vector<ItemType, AllocatorType>& vec_) noexc
  * \param       alloc_:  Allocator to use for all memory allocations
  *              [defaults : AllocatorType{}]
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-vector<ItemType, AllocatorType>::vector(SizeType length_, const AllocatorType& alloc_)
-: m_allocator{alloc_}
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::vector(SizeType             length_,
+                                                                       const AllocatorType& alloc_)
+: container_base{alloc_}
 {
     vector_constructor(length_);
 }
@@ -88,10 +138,10 @@ vector<ItemType, AllocatorType>::vector(SizeType length_, const AllocatorType& a
  * \param       alloc_:  Allocator to use for all memory allocations
  *              [defaults : AllocatorType{}]
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-vector<ItemType, AllocatorType>::vector(SizeType             length_,
-                                        const ItemType&      value_,
-                                        const AllocatorType& alloc_)
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::vector(SizeType             length_,
+                                                                       const ItemType&      value_,
+                                                                       const AllocatorType& alloc_)
 : container_base{alloc_}
 {
     vector_constructor(length_);
@@ -116,44 +166,64 @@ vector<ItemType, AllocatorType>::vector(SizeType             length_,
  * \param       alloc_:         Allocator to use for all memory allocations
  *              [defaults : AllocatorType{}]
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-vector<ItemType, AllocatorType>::vector(const IteratorType   beginIterator_,
-                                        const IteratorType   endIterator_,
-                                        const AllocatorType& alloc_)
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::vector(
+  const IteratorType   beginIterator_,
+  const IteratorType   endIterator_,
+  const AllocatorType& alloc_)
 : container_base{alloc_}
 {
-    vector_constructor(endIterator_ - beginIterator_);
-
-    std::copy(beginIterator_, endIterator_, begin());
+    copy_elements(beginIterator_.ptr(), static_cast<SizeType>(endIterator_ - beginIterator_));
 }
 
 
 /**
  **************************************************************************************************
  * \brief       Copy constructor for the vector class.
+ *              Allocates exactly `otherVector_.length()` elements, and copies them in bulk.
  *
  * \param       otherVector_: Vector to copy data from.
  * \param       alloc_:       Allocator to use for all memory allocations
  *              [defaults : AllocatorType{}]
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
 template<typename OtherAllocatorType>
-vector<ItemType, AllocatorType>::vector(const vector<ItemType, OtherAllocatorType>& otherVector_,
-                                        const AllocatorType&                        alloc_)
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::vector(
+  const vector<ItemType, OtherAllocatorType, GrowthPolicy, Instrumentation>& otherVector_,
+  const AllocatorType&                                                       alloc_)
 : container_base{alloc_}
 {
-    vector_constructor(otherVector_.length());
-
-    std::copy(otherVector_.begin(), otherVector_.begin(), begin());
+    copy_elements(otherVector_.data(), otherVector_.length());
 }
 
-template<typename ItemType, typename AllocatorType>
-vector<ItemType, AllocatorType>::vector(const vector& otherVector_)
-: container_base{otherVector_.get_allocator()}
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::vector(const vector& otherVector_)
+: container_base{AllocatorTraits::select_on_container_copy_construction(otherVector_.m_allocator)}
 {
-    vector_constructor(otherVector_.length());
+    copy_elements(otherVector_.data(), otherVector_.length());
+}
 
-    std::copy(otherVector_.begin(), otherVector_.begin(), begin());
+/**
+ **************************************************************************************************
+ * \brief       Copy assignment operator for the vector class, from a vector using another
+ *              allocator.
+ *
+ * \param       copy_: Vector to copy data from.
+ *
+ * \note        The vector keeps its own allocator, and its memory when it is big enough to hold
+ *              every element of `copy_`.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+template<typename OtherAllocatorType>
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>&
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::operator=(
+  const vector<ItemType, OtherAllocatorType, GrowthPolicy, Instrumentation>& copy_)
+{
+    if(static_cast<const void*>(this) != static_cast<const void*>(std::addressof(copy_)))
+    {
+        copy_elements(copy_.data(), copy_.length());
+    }
+    return *this;
 }
 
 /**
@@ -161,73 +231,174 @@ vector<ItemType, AllocatorType>::vector(const vector& otherVector_)
  * \brief       Copy assignment operator for the vector class.
  *
  * \param       copy_: Vector to copy data from.
+ *
+ * \note        The allocator of `copy_` is only taken if the allocator propagates on copy
+ *              assignment. The memory is kept when it is big enough to hold every element of
+ *              `copy_`, and was allocated by an allocator equal to the one used from now on.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-template<typename OtherAllocatorType>
-typename vector<ItemType, AllocatorType>&
-vector<ItemType, AllocatorType>::operator=(const vector<ItemType, OtherAllocatorType>& copy_)
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>&
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::operator=(const vector& copy_)
 {
-    vector_constructor(copy_.length());
+    if(this != std::addressof(copy_))
+    {
+        if constexpr(AllocatorTraits::propagate_on_container_copy_assignment::value)
+        {
+            if(m_allocator != copy_.m_allocator)
+            {
+                vector_constructor(0);
+            }
+            m_allocator = copy_.m_allocator;
+        }
 
-    std::copy(copy_.begin(), copy_.begin(), begin());
-    m_allocator = copy_.get_allocator();
+        copy_elements(copy_.data(), copy_.length());
+    }
+    return *this;
 }
 
-template<typename ItemType, typename AllocatorType>
-vector<ItemType, AllocatorType>&
-vector<ItemType, AllocatorType>::operator=(const vector<ItemType, AllocatorType>& copy_)
+
+/**
+ **************************************************************************************************
+ * \brief       Move constructor for the vector class.
+ *              The memory of the other vector is taken along with its allocator, which is the
+ *              only one able to release it. The other vector is left empty, without memory.
+ *
+ * \param       move_: Vector to move data from.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::vector(vector&& move_) noexcept
+: container_base{move_.get_allocator()}
 {
-    return operator=<ItemType, AllocatorType>(copy_);
+    /* Grab the other vector's resources */
+    m_beginIterator = IteratorType{move_.data()};
+    m_endIterator   = IteratorType{move_.data() + move_.length()};
+    m_capacity      = move_.capacity();
+
+    /* Invalidate the other vector */
+    move_.m_beginIterator = IteratorType{nullptr};
+    move_.m_endIterator   = IteratorType{nullptr};
+    move_.m_capacity      = 0;
 }
 
+/**
+ **************************************************************************************************
+ * \brief       Move constructor for the vector class, with an allocator of its own.
+ *
+ * \param       move_:  Vector to move data from.
+ * \param       alloc_: Allocator to use for all memory allocations.
+ *
+ * \note        The memory of the other vector is only taken if `alloc_` compares equal to its
+ *              allocator. Otherwise, the elements are moved one by one into memory obtained from
+ *              `alloc_`, and the other vector is left empty, but keeps its memory.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::vector(vector&&             move_,
+                                                                       const AllocatorType& alloc_)
+: container_base{alloc_}
+{
+    if(m_allocator == move_.m_allocator)
+    {
+        m_beginIterator = IteratorType{move_.data()};
+        m_endIterator   = IteratorType{move_.data() + move_.length()};
+        m_capacity      = move_.capacity();
+
+        move_.m_beginIterator = IteratorType{nullptr};
+        move_.m_endIterator   = IteratorType{nullptr};
+        move_.m_capacity      = 0;
+        return;
+    }
+
+    reserve(move_.length());
+    push_back(std::move(move_));
+}
 
 /**
  **************************************************************************************************
- * \brief       Move constructor for the vector class.
+ * \brief       Move constructor for the vector class, from a vector using another allocator.
+ *              Memory can't be released by another allocator type, so the elements are moved one
+ *              by one. The other vector is left empty, but keeps its memory.
  *
- * \param       otherVector_: Vector to move data from.
- * \param       alloc_:       Allocator to use for all memory allocations
+ * \param       move_:  Vector to move data from.
+ * \param       alloc_: Allocator to use for all memory allocations
  *              [defaults : AllocatorType{}]
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
 template<typename OtherAllocatorType>
-vector<ItemType, AllocatorType>::vector(vector<ItemType, OtherAllocatorType>&& move_,
-                                        AllocatorType&                         alloc_)
-: container_base{alloc_},
-  m_beginIterator{std::move(move_.m_beginIterator)},
-  m_endIterator{std::move(move_.m_endIterator)},
-  m_capacity{move_.m_capacity}
+    requires(!std::is_same_v<OtherAllocatorType, AllocatorType>)
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::vector(
+  vector<ItemType, OtherAllocatorType, GrowthPolicy, Instrumentation>&& move_,
+  const AllocatorType&                                                  alloc_)
+: container_base{alloc_}
 {
+    reserve(move_.length());
+    push_back(std::move(move_));
 }
 
 /**
  **************************************************************************************************
  * \brief       Move assignment operator for the vector class.
+ *              The memory of the other vector is taken if its allocator propagates on move
+ *              assignment, or compares equal to this vector's allocator. Otherwise, it could not
+ *              be released by this vector's allocator, so the elements are moved one by one and
+ *              the other vector is left empty, but keeps its memory.
  *
- * \param       move__: Vector to move data from.
+ * \param       move_: Vector to move data from.
  *
  * \note        Will do nothing if attempting to move a vector into itself
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-template<typename OtherAllocatorType>
-typename vector<ItemType, AllocatorType>&
-vector<ItemType, AllocatorType>::operator=(vector<ItemType, OtherAllocatorType>&& move_)
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>&
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::operator=(vector&& move_) noexcept(
+  AllocatorTraits::propagate_on_container_move_assignment::value ||
+  AllocatorTraits::is_always_equal::value)
 {
-    if(this != std::addressof(move_))
+    if(this == std::addressof(move_))
     {
-        /* Grab the other vector's resources */
-        m_allocator     = move_.get_allocator();
-        m_beginIterator = move_.begin();
-        m_endIterator   = move_.end();
-        m_capacity      = move_.capacity();
+        return *this;
+    }
 
-        /* Invalidate the other vector */
-        move_.m_beginIterator = IteratorType{nullptr};
-        move_.m_endIterator   = IteratorType{nullptr};
+    if constexpr(AllocatorTraits::propagate_on_container_move_assignment::value)
+    {
+        /* The current memory must be released before its allocator is replaced */
+        vector_constructor(0);
+        m_allocator = move_.m_allocator;
+        adopt(std::move(move_));
+    }
+    else
+    {
+        if(m_allocator == move_.m_allocator)
+        {
+            adopt(std::move(move_));
+        }
+        else
+        {
+            erase(begin(), end());
+            push_back(std::move(move_));
+        }
     }
     return *this;
 }
 
+/**
+ **************************************************************************************************
+ * \brief       Move assignment operator for the vector class, from a vector using another
+ *              allocator. Memory can't be released by another allocator type, so the elements
+ *              are moved one by one. The other vector is left empty, but keeps its memory.
+ *
+ * \param       move_: Vector to move data from.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+template<typename OtherAllocatorType>
+    requires(!std::is_same_v<OtherAllocatorType, AllocatorType>)
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>&
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::operator=(
+  vector<ItemType, OtherAllocatorType, GrowthPolicy, Instrumentation>&& move_)
+{
+    erase(begin(), end());
+    push_back(std::move(move_));
+    return *this;
+}
+
 /**
  **************************************************************************************************
  * \brief       Initializer list constructor for the vector class.
@@ -236,14 +407,12 @@ vector<ItemType, AllocatorType>::operator=(vector<ItemType, OtherAllocatorType>&
  * \param       alloc_: Allocator to use for all memory allocations
  *              [defaults : AllocatorType{}]
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-vector<ItemType, AllocatorType>::vector(InitializerListType ilist_, const AllocatorType& alloc_)
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::vector(InitializerListType  ilist_,
+                                                                       const AllocatorType& alloc_)
 : container_base{alloc_}
 {
-    vector_constructor(ilist_.size());
-
-    std::copy(ilist_.begin(), ilist_.end(), begin());
-    change_size(ilist_.size());
+    copy_elements(ilist_.begin(), ilist_.size());
 }
 
 
@@ -257,11 +426,11 @@ vector<ItemType, AllocatorType>::vector(InitializerListType ilist_, const Alloca
  * \param       alloc_:   Allocator to use for all memory allocations
  *              [defaults : AllocatorType{}]
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
 template<typename... Args>
-vector<ItemType, AllocatorType>::vector(SizeType length_,
-                                        Args&&... args_,
-                                        const AllocatorType& alloc_)
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::vector(SizeType length_,
+                                                                       Args&&... args_,
+                                                                       const AllocatorType& alloc_)
 : container_base{alloc_}
 {
     vector_constructor(length_);
@@ -284,22 +453,46 @@ vector<ItemType, AllocatorType>::vector(SizeType length_,
  * \brief       Generator-taking constructor for the vector class.
  *              Takes a generator function as parameter to create `length_` items in the vector.
  *
- * \param       length_ :   Number of elements to create
- * \param       function_ : Function (returning `ItemType` and taking no arguments) called to
- *                          initialize all the values in the vector.
- * \param       alloc_:     Allocator to use for all memory allocations
+ * \param       length_ :    Number of elements to create
+ * \param       generator_ : Callable returning a value convertible to `ItemType`, called either
+ *                           with no arguments or with the index of the element to create.
+ * \param       alloc_:      Allocator to use for all memory allocations
  *              [defaults : AllocatorType{}]
+ *
+ * \note        The generator is called directly, without type erasure, and every element is
+ *              constructed in place from its result, in order.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-vector<ItemType, AllocatorType>::vector(SizeType                      length_,
-                                        std::function<ItemType(void)> function_,
-                                        const AllocatorType&          alloc_)
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+template<typename GeneratorType>
+    requires element_generator<GeneratorType, ItemType>
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::vector(
+  SizeType             length_,
+  GeneratorType&&      generator_,
+  const AllocatorType& alloc_)
 : container_base{alloc_}
 {
     vector_constructor(length_);
-    add_size(length_);
 
-    std::generate(begin(), end(), function_);
+    try
+    {
+        for(SizeType i = 0; i < length_; ++i)
+        {
+            if constexpr(indexed_generator<GeneratorType, ItemType>)
+            {
+                AllocatorTraits::construct(m_allocator, end().ptr(), std::invoke(generator_, i));
+            }
+            else
+            {
+                AllocatorTraits::construct(m_allocator, end().ptr(), std::invoke(generator_));
+            }
+            add_size(1);
+        }
+    }
+    catch(...)
+    {
+        vector_constructor(0);
+        throw;
+    }
 }
 
 
@@ -307,11 +500,16 @@ vector<ItemType, AllocatorType>::vector(SizeType                      length_,
  **************************************************************************************************
  * \brief       Destructor for the vector class.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-vector<ItemType, AllocatorType>::~vector()
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::~vector()
 {
     /* Free and destroy elements in the allocated memory */
-    AllocatorTraits::deallocate(m_allocator, begin().ptr(), capacity());
+    destroy_range(m_allocator, begin().ptr(), end().ptr());
+    if(begin().ptr() != nullptr)
+    {
+        record_reallocation(reallocation_kind::release, capacity(), 0, 0);
+        AllocatorTraits::deallocate(m_allocator, begin().ptr(), capacity());
+    }
 }
 
 
@@ -326,9 +524,9 @@ vector<ItemType, AllocatorType>::~vector()
  *
  * \retval      ItemType*: Pointer to the beginning of the vector's data.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
 [[nodiscard]] inline ItemType*
-vector<ItemType, AllocatorType>::data() noexcept
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::data() noexcept
 {
     return begin().ptr();
 }
@@ -340,9 +538,9 @@ vector<ItemType, AllocatorType>::data() noexcept
  *
  * \retval      ItemType*: Const pointer to the beginning of the vector's data.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
 [[nodiscard]] inline const ItemType*
-vector<ItemType, AllocatorType>::data() const noexcept
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::data() const noexcept
 {
     return begin().ptr();
 }
@@ -358,18 +556,19 @@ vector<ItemType, AllocatorType>::data() const noexcept
  * \param       count_:  Number of elements to be assigned a new value.
  *              [defaults : 1]
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
 inline void
-vector<ItemType, AllocatorType>::assign(const ItemType& value_,
-                                        DifferenceType  offset_,
-                                        SizeType        count_)
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::assign(const ItemType& value_,
+                                                                       DifferenceType  offset_,
+                                                                       SizeType        count_)
 {
     if constexpr(vector_safeness == true)
     {
         check_fit(count_);
     }
 
-    std::fill_n(begin() + offset_, count_, value_);
+    /* Compilers vectorize the fill through a raw pointer, but not through the iterator */
+    std::fill_n((begin() + offset_).ptr(), count_, value_);
 }
 
 
@@ -381,9 +580,10 @@ vector<ItemType, AllocatorType>::assign(const ItemType& value_,
  * \param       offset_: Offset at which data should be assigned.
  *              [defaults : 0]
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
 inline void
-vector<ItemType, AllocatorType>::assign(InitializerListType ilist_, DifferenceType offset_)
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::assign(InitializerListType ilist_,
+                                                                       DifferenceType      offset_)
 {
     if constexpr(vector_safeness == true)
     {
@@ -408,9 +608,9 @@ vector<ItemType, AllocatorType>::assign(InitializerListType ilist_, DifferenceTy
  *
  * \retval      vector&: Reference the vector itself.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-inline vector<ItemType, AllocatorType>&
-vector<ItemType, AllocatorType>::operator+=(const ItemType& rhs_)
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>&
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::operator+=(const ItemType& rhs_)
 {
     push_back(rhs_);
     return *this;
@@ -424,9 +624,9 @@ vector<ItemType, AllocatorType>::operator+=(const ItemType& rhs_)
  *
  * \retval      vector&: Reference the vector itself.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-inline const vector<ItemType, AllocatorType>
-vector<ItemType, AllocatorType>::operator++(int)
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline const vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::operator++(int)
 {
     reserve(capacity() + 1);
     return *this;
@@ -444,9 +644,9 @@ vector<ItemType, AllocatorType>::operator++(int)
  *              it's current size, the last element of the vector will be popped back and
  *              destroyed (safely).
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-inline const vector<ItemType, AllocatorType>
-vector<ItemType, AllocatorType>::operator--(int)
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline const vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::operator--(int)
 {
     if(capacity() == length())
     {
@@ -466,9 +666,9 @@ vector<ItemType, AllocatorType>::operator--(int)
  *
  * \retval      vector&: Reference the vector itself.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-inline vector<ItemType, AllocatorType>&
-vector<ItemType, AllocatorType>::operator>>(int steps_)
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>&
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::operator>>(int steps_)
 {
     std::shift_right(cbegin(), cend(), steps_);
 
@@ -484,9 +684,9 @@ vector<ItemType, AllocatorType>::operator>>(int steps_)
  *
  * \retval      vector&: Reference the vector itself.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-inline vector<ItemType, AllocatorType>&
-vector<ItemType, AllocatorType>::operator<<(int steps_)
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>&
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::operator<<(int steps_)
 {
     std::shift_left(cbegin(), cend(), steps_);
 
@@ -504,14 +704,35 @@ vector<ItemType, AllocatorType>::operator<<(int steps_)
  *
  * \param       value_: Element to push back at the end of the vector.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
 inline void
-vector<ItemType, AllocatorType>::push_back(const ItemType& value_)
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::push_back(const ItemType& value_)
 {
-    check_fit(1);
+    const ItemType* const first = data();
+    if(length() == capacity() && std::less_equal<>{}(first, &value_)
+       && std::less<>{}(&value_, first + length()))
+    {
+        /* Growing may relocate the element before it is copied */
+        ItemType copy = value_;
+        emplace_back(std::move(copy));
+        return;
+    }
 
-    end().value() = value_;
-    add_size(1);
+    emplace_back(value_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move an element to the end of the vector, after the current last item.
+ *
+ * \param       value_: Element to move at the end of the vector.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline void
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::push_back(ItemType&& value_)
+{
+    emplace_back(std::move(value_));
 }
 
 
@@ -522,14 +743,12 @@ vector<ItemType, AllocatorType>::push_back(const ItemType& value_)
  *
  * \param       ilist_: Initializer list containing elements to push back at the end of the vector.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
 inline void
-vector<ItemType, AllocatorType>::push_back(const InitializerListType ilist_)
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::push_back(
+  const InitializerListType ilist_)
 {
-    check_fit(ilist_.size());
-
-    std::copy(ilist_.begin(), ilist_.end(), end());
-    add_size(ilist_.size());
+    insert(ilist_, length());
 }
 
 
@@ -540,15 +759,75 @@ vector<ItemType, AllocatorType>::push_back(const InitializerListType ilist_)
  *
  * \param       otherVector_: Vector containing elements to push back at the end of the vector.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+template<typename OtherAllocatorType>
+inline void
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::push_back(
+  const vector<ItemType, OtherAllocatorType, GrowthPolicy, Instrumentation>& otherVector_)
+{
+    if(static_cast<const void*>(&otherVector_) == static_cast<const void*>(this))
+    {
+        /* Self-append: grow first, since growing in place may move the elements to copy */
+        check_fit(otherVector_.length());
+    }
+
+    const ItemType* const source = otherVector_.data();
+    insert_with(length(),
+                otherVector_.length(),
+                [&](ItemType* item_, SizeType index_)
+                { AllocatorTraits::construct(m_allocator, item_, source[index_]); });
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move the elements of another vector to the end of the vector, after the current
+ *              last item. The other vector is left empty, but keeps its memory.
+ *
+ * \param       otherVector_: Vector containing elements to move at the end of the vector.
+ *
+ * \note        Trivially relocatable elements are relocated with a single `memcpy`. Moving a
+ *              vector at its own end copies its elements instead, and keeps them.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
 template<typename OtherAllocatorType>
 inline void
-vector<ItemType, AllocatorType>::push_back(const vector<ItemType, OtherAllocatorType>& otherVector_)
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::push_back(
+  vector<ItemType, OtherAllocatorType, GrowthPolicy, Instrumentation>&& otherVector_)
 {
-    check_fit(otherVector_.length());
+    if(static_cast<const void*>(&otherVector_) == static_cast<const void*>(this))
+    {
+        push_back(std::as_const(otherVector_));
+        return;
+    }
 
-    std::copy(otherVector_.cbegin(), otherVector_.cend(), end());
-    add_size(otherVector_.length());
+    ItemType* const source = otherVector_.data();
+    const SizeType  count  = otherVector_.length();
+
+    if constexpr(is_trivially_relocatable_v<ItemType>)
+    {
+        check_fit(count);
+        if(count != 0)
+        {
+            std::memcpy(static_cast<void*>(data() + length()),
+                        static_cast<const void*>(source),
+                        count * sizeof(ItemType));
+        }
+        add_size(count);
+    }
+    else
+    {
+        insert_with(length(),
+                    count,
+                    [&](ItemType* item_, SizeType index_)
+                    {
+                        AllocatorTraits::construct(
+                          m_allocator, item_, std::move_if_noexcept(source[index_]));
+                    });
+        destroy_range(otherVector_.m_allocator, source, source + count);
+    }
+
+    otherVector_.change_size(0);
 }
 
 
@@ -556,16 +835,230 @@ vector<ItemType, AllocatorType>::push_back(const vector<ItemType, OtherAllocator
  **************************************************************************************************
  * \brief       Remove the last element of the vector.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
 inline void
-vector<ItemType, AllocatorType>::pop_back()
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::pop_back()
 {
     if(length() == 0)
     {
         return;
     }
 
-    std::destroy_at(--end());
+    AllocatorTraits::destroy(m_allocator, data() + length() - 1);
+    change_size(length() - 1);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Remove an element from the vector, left-shifting the elements on its right.
+ *
+ * \param       position_: Position of the element to remove.
+ *
+ * \retval      IteratorType: Position of the element that followed the removed one.
+ *
+ * \throws      std::invalid_argument("Cannot erase the end of a vector")
+ *              `position_` is the end of the vector.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline typename vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::IteratorType
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::erase(IteratorType position_)
+{
+    if constexpr(vector_safeness == true)
+    {
+        if(position_ == end())
+        {
+            throw std::invalid_argument("Cannot erase the end of a vector");
+        }
+    }
+
+    return erase(position_, position_ + 1);
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Remove a range of elements from the vector, left-shifting the elements on its
+ *              right in a single pass.
+ *
+ * \param       first_: Position of the first element to remove.
+ * \param       last_:  Position past the last element to remove.
+ *
+ * \retval      IteratorType: Position of the element that followed the removed range.
+ *
+ * \note        Trivially relocatable elements are shifted with a single `memmove`, after the
+ *              removed elements are destroyed. Other elements are move-assigned over the removed
+ *              ones, and the moved-from elements at the end of the vector are destroyed.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline typename vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::IteratorType
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::erase(IteratorType first_,
+                                                                      IteratorType last_)
+{
+    if constexpr(vector_safeness == true)
+    {
+        check_if_valid(first_);
+        check_if_valid(last_);
+        if(last_ < first_)
+        {
+            throw std::invalid_argument("Invalid erase range");
+        }
+    }
+
+    ItemType* const first   = first_.ptr();
+    ItemType* const last    = last_.ptr();
+    ItemType* const tail    = data() + length();
+    const SizeType  removed = static_cast<SizeType>(last - first);
+
+    if(removed == 0)
+    {
+        return first_;
+    }
+
+    if constexpr(is_trivially_relocatable_v<ItemType>)
+    {
+        destroy_range(m_allocator, first, last);
+        std::memmove(static_cast<void*>(first),
+                     static_cast<const void*>(last),
+                     static_cast<std::size_t>(tail - last) * sizeof(ItemType));
+    }
+    else
+    {
+        std::move(last, tail, first);
+        destroy_range(m_allocator, tail - removed, tail);
+    }
+
+    change_size(length() - removed);
+    return first_;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Remove an element from the vector in O(1), by moving the last element in its place.
+ *              The order of the elements is not preserved.
+ *
+ * \param       position_: Position of the element to remove.
+ *
+ * \retval      IteratorType: Position of the element that took the place of the removed one, or
+ *                            the end of the vector if the last element was removed.
+ *
+ * \throws      std::invalid_argument("Cannot erase the end of a vector")
+ *              `position_` is the end of the vector.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline typename vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::IteratorType
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::unordered_erase(
+  IteratorType position_)
+{
+    if constexpr(vector_safeness == true)
+    {
+        check_if_valid(position_);
+        if(position_ == end())
+        {
+            throw std::invalid_argument("Cannot erase the end of a vector");
+        }
+    }
+
+    ItemType* const position = position_.ptr();
+    ItemType* const back     = data() + length() - 1;
+
+    if(position != back)
+    {
+        if constexpr(is_trivially_relocatable_v<ItemType>)
+        {
+            AllocatorTraits::destroy(m_allocator, position);
+            std::memcpy(static_cast<void*>(position),
+                        static_cast<const void*>(back),
+                        sizeof(ItemType));
+            change_size(length() - 1);
+            return position_;
+        }
+        else
+        {
+            *position = std::move(*back);
+        }
+    }
+
+    AllocatorTraits::destroy(m_allocator, back);
+    change_size(length() - 1);
+    return position_;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Remove every element matching a predicate, in a single pass.
+ *              The order of the remaining elements is preserved.
+ *
+ * \param       predicate_: Callable returning `true` for the elements to remove.
+ *
+ * \retval      SizeType: Number of removed elements.
+ *
+ * \note        Trivially relocatable elements are compacted by moving each run of kept elements
+ *              with a single `memmove`. If the predicate throws, the elements not examined yet are
+ *              shifted next to the kept ones, so the vector stays contiguous.
+ *              Other elements are compacted with `std::remove_if`.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+template<typename Predicate>
+inline typename vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::SizeType
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::erase_if(Predicate predicate_)
+{
+    ItemType* const first = data();
+    ItemType* const last  = first + length();
+
+    if constexpr(is_trivially_relocatable_v<ItemType>)
+    {
+        ItemType* out = std::find_if(first, last, std::ref(predicate_));
+        if(out == last)
+        {
+            return 0;
+        }
+        AllocatorTraits::destroy(m_allocator, out);
+
+        /* [run, last) holds the live elements that were not moved down yet */
+        ItemType* run = out + 1;
+        try
+        {
+            while(run != last)
+            {
+                ItemType*         runEnd    = std::find_if(run, last, std::ref(predicate_));
+                const std::size_t runLength = static_cast<std::size_t>(runEnd - run);
+
+                std::memmove(static_cast<void*>(out),
+                             static_cast<const void*>(run),
+                             runLength * sizeof(ItemType));
+                out += runLength;
+
+                if(runEnd == last)
+                {
+                    break;
+                }
+                AllocatorTraits::destroy(m_allocator, runEnd);
+                run = runEnd + 1;
+            }
+        }
+        catch(...)
+        {
+            const std::size_t remaining = static_cast<std::size_t>(last - run);
+            std::memmove(static_cast<void*>(out),
+                         static_cast<const void*>(run),
+                         remaining * sizeof(ItemType));
+            change_size(static_cast<SizeType>(out - first) + remaining);
+            throw;
+        }
+
+        const SizeType removed = static_cast<SizeType>(last - out);
+        change_size(static_cast<SizeType>(out - first));
+        return removed;
+    }
+    else
+    {
+        ItemType* const newLast = std::remove_if(first, last, std::ref(predicate_));
+        const SizeType  removed = static_cast<SizeType>(last - newLast);
+
+        destroy_range(m_allocator, newLast, last);
+        change_size(length() - removed);
+        return removed;
+    }
 }
 
 
@@ -573,19 +1066,42 @@ vector<ItemType, AllocatorType>::pop_back()
  **************************************************************************************************
  * \brief       Constructs an element at the last position.
  *              This function is often to be favored instead of 'push_back' when building new
- *              items, since it avoids a copy.
+ *              items, since it avoids a copy: the element is constructed directly in the vector's
+ *              memory, through the allocator.
  *
- * \param       args: The arguments needed to be passed to the constructor of an element.
+ * \param       args_: The arguments needed to be passed to the constructor of an element.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
 template<typename... Args>
 inline void
-vector<ItemType, AllocatorType>::emplace_back(Args&&... args_)
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::emplace_back(Args&&... args_)
 {
-    check_fit(1);
-
-    end().value() = ItemType(std::forward<Args>(args_)...);
+    if(length() == capacity())
+    {
+        /* The arguments may refer to elements that are about to be relocated: the new element is
+         * built before they move, either directly in the new block, or in a temporary when the
+         * block is resized in place */
+        if constexpr(grows_by_relocation)
+        {
+            insert_with(length(),
+                        1,
+                        [&](ItemType* item_, SizeType)
+                        {
+                            AllocatorTraits::construct(
+                              m_allocator, item_, std::forward<Args>(args_)...);
+                        });
+        }
+        else
+        {
+            ItemType value(std::forward<Args>(args_)...);
+            check_fit(1);
+            AllocatorTraits::construct(m_allocator, data() + length(), std::move(value));
+            add_size(1);
+        }
+        return;
+    }
 
+    AllocatorTraits::construct(m_allocator, data() + length(), std::forward<Args>(args_)...);
     add_size(1);
 }
 
@@ -597,33 +1113,25 @@ vector<ItemType, AllocatorType>::emplace_back(Args&&... args_)
  *
  * \param       position_: Position in vector to insert the element.
  * \param       count_:    Number of elements to insert from the initial offset.
- * \param       args:      The arguments needed to be passed to the constructor of an element.
+ * \param       args_:     The arguments needed to be passed to the constructor of an element.
  *
  * \retval      IteratorType: Position at which the element has been constructed.
  *                            (if multiple elements have been inserted, return position of the last
  *                             inserted element).
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
 template<typename... Args>
-inline typename vector<ItemType, AllocatorType>::IteratorType
-vector<ItemType, AllocatorType>::emplace(IteratorType position_, SizeType count_, Args&&... args_)
+inline typename vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::IteratorType
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::emplace(IteratorType position_,
+                                                                        SizeType     count_,
+                                                                        Args&&... args_)
 {
     if constexpr(vector_safeness == true)
     {
         check_if_valid(position_);
     }
 
-    check_fit(count_);
-    add_size(count_);
-
-    std::shift_right(position_, end(), count_);
-
-    for(SizeType i = 0; i < count_; i++)
-    {
-        position_[i] = ItemType(std::forward<Args>(args_)...);
-    }
-
-    return position_ + count_;
+    return emplace(position_ - begin(), count_, std::forward<Args>(args_)...);
 }
 
 
@@ -634,20 +1142,62 @@ vector<ItemType, AllocatorType>::emplace(IteratorType position_, SizeType count_
 *
 * \param       offset_:   Position to insert the element at.
 * \param       count_:    Number of elements to insert from the initial offset.
-* \param       args:      The arguments needed to be passed to the constructor of an element.
+* \param       args_:     The arguments needed to be passed to the constructor of an element.
 *
 * \retval      IteratorType: Position at which the element has been constructed.
 *                            (if multiple elements have been inserted, return position of the last
 *                             inserted element).
+*
+* \throws      std::invalid_argument("Invalid insert offset")
+*              Offset was out of bounds.
+*
+* \note        The arguments may refer to elements of the vector. A single element is constructed
+*              directly in place when none of them moves before it is built: at the end of the
+*              vector when no growth is needed, or in the new block when growing relocates the
+*              elements. Otherwise, and when inserting several copies, the element is first
+*              built in a temporary, which is then moved in place or copied `count_` times.
 *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
 template<typename... Args>
-inline typename vector<ItemType, AllocatorType>::IteratorType
-vector<ItemType, AllocatorType>::emplace(DifferenceType offset_, SizeType count_, Args&&... args_)
+inline typename vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::IteratorType
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::emplace(DifferenceType offset_,
+                                                                        SizeType       count_,
+                                                                        Args&&... args_)
 {
-    IteratorType position = cbegin() + offset_;
+    const SizeType offset = static_cast<SizeType>(offset_);
+
+    if(count_ == 0)
+    {
+        return insert_with(offset, 0, [](ItemType*, SizeType) noexcept {});
+    }
+
+    if(count_ == 1)
+    {
+        const bool constructedFirst =
+          length() == capacity() ? grows_by_relocation : offset == length();
+        if(constructedFirst)
+        {
+            return insert_with(offset,
+                               1,
+                               [&](ItemType* item_, SizeType)
+                               {
+                                   AllocatorTraits::construct(
+                                     m_allocator, item_, std::forward<Args>(args_)...);
+                               });
+        }
+
+        ItemType value(std::forward<Args>(args_)...);
+        return insert_with(offset,
+                           1,
+                           [&](ItemType* item_, SizeType)
+                           { AllocatorTraits::construct(m_allocator, item_, std::move(value)); });
+    }
 
-    return emplace(position, count_, std::forward<Args>(args)...);
+    const ItemType value(std::forward<Args>(args_)...);
+    return insert_with(offset,
+                       count_,
+                       [&](ItemType* item_, SizeType)
+                       { AllocatorTraits::construct(m_allocator, item_, value); });
 }
 
 
@@ -665,28 +1215,18 @@ vector<ItemType, AllocatorType>::emplace(DifferenceType offset_, SizeType count_
  *                            (if multiple elements have been inserted, return position of the last
  *                             inserted element).
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-inline typename vector<ItemType, AllocatorType>::IteratorType
-vector<ItemType, AllocatorType>::insert(const ItemType&    value_,
-                                        const IteratorType position_,
-                                        SizeType           count_)
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline typename vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::IteratorType
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::insert(const ItemType&    value_,
+                                                                       const IteratorType position_,
+                                                                       SizeType           count_)
 {
     if constexpr(vector_safeness == true)
     {
         check_if_valid(position_);
     }
 
-    check_fit(count_);
-    add_size(count_);
-
-    std::shift_right(position_, end(), count_);
-
-    for(SizeType i = 0; i < count_; i++)
-    {
-        position_[i] = value_;
-    }
-
-    return position_ + count_;
+    return insert(value_, position_ - begin(), count_);
 }
 
 
@@ -706,16 +1246,30 @@ vector<ItemType, AllocatorType>::insert(const ItemType&    value_,
  *
  * \throws      std::invalid_argument("Invalid insert offset")
  *              Offset was out of bounds.
+ *
+ * \note        `value_` may be an element of the vector, in which case it is copied before the
+ *              elements are shifted.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-inline typename vector<ItemType, AllocatorType>::IteratorType
-vector<ItemType, AllocatorType>::insert(const ItemType& value_,
-                                        DifferenceType  offset_,
-                                        SizeType        count_)
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline typename vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::IteratorType
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::insert(const ItemType& value_,
+                                                                       DifferenceType  offset_,
+                                                                       SizeType        count_)
 {
-    IteratorType position = cbegin() + offset_;
+    const ItemType* const first = data();
+    if(std::less_equal<>{}(first, &value_) && std::less<>{}(&value_, first + length()))
+    {
+        const ItemType copy = value_;
+        return insert_with(static_cast<SizeType>(offset_),
+                           count_,
+                           [&](ItemType* item_, SizeType)
+                           { AllocatorTraits::construct(m_allocator, item_, copy); });
+    }
 
-    return insert(value_, position, count_);
+    return insert_with(static_cast<SizeType>(offset_),
+                       count_,
+                       [&](ItemType* item_, SizeType)
+                       { AllocatorTraits::construct(m_allocator, item_, value_); });
 }
 
 
@@ -732,26 +1286,19 @@ vector<ItemType, AllocatorType>::insert(const ItemType& value_,
  *                            (if multiple elements have been inserted, return position of the last
  *                             inserted element).
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-inline typename vector<ItemType, AllocatorType>::IteratorType
-vector<ItemType, AllocatorType>::insert(const IteratorType sourceBegin_,
-                                        const IteratorType sourceEnd_,
-                                        const IteratorType position_)
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline typename vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::IteratorType
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::insert(
+  const IteratorType sourceBegin_,
+  const IteratorType sourceEnd_,
+  const IteratorType position_)
 {
     if constexpr(vector_safeness == true)
     {
         check_if_valid(position_);
     }
 
-    SizeType sourceSize = sourceEnd_ - sourceBegin_;
-
-    check_fit(sourceSize);
-    add_size(sourceSize);
-
-    std::shift_right(position_, cend(), sourceSize);
-    std::copy(sourceBegin_, sourceEnd_, position_);
-
-    return position_ + sourceSize;
+    return insert(sourceBegin_, sourceEnd_, position_ - begin());
 }
 
 
@@ -771,35 +1318,70 @@ vector<ItemType, AllocatorType>::insert(const IteratorType sourceBegin_,
  *
  * \throws      std::invalid_argument("Invalid insert offset")
  *              Offset was out of bounds.
+ * \throws      std::invalid_argument("Invalid insert range")
+ *              The end of the source range is before its beginning.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-inline typename vector<ItemType, AllocatorType>::IteratorType
-vector<ItemType, AllocatorType>::insert(const IteratorType sourceBegin_,
-                                        const IteratorType sourceEnd_,
-                                        DifferenceType     offset_)
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline typename vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::IteratorType
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::insert(
+  const IteratorType sourceBegin_,
+  const IteratorType sourceEnd_,
+  DifferenceType     offset_)
 {
-    if constexpr(vector_safeness)
+    if constexpr(vector_safeness == true)
     {
-        if(offset_ > length())
+        if(sourceEnd_ < sourceBegin_)
         {
-            throw std::invalid_argument("Invalid insert offset");
+            throw std::invalid_argument("Invalid insert range");
         }
     }
 
-    IteratorType position = cbegin() + offset_;
+    const ItemType* const source = sourceBegin_.ptr();
+    return insert_with(static_cast<SizeType>(offset_),
+                       static_cast<SizeType>(sourceEnd_ - sourceBegin_),
+                       [&](ItemType* item_, SizeType index_)
+                       { AllocatorTraits::construct(m_allocator, item_, source[index_]); });
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move elements in the middle of the vector from another vector, right-shifting
+ *              items on the right to fit.
+ *
+ * \param       sourceBegin_: Begin move iterator from another vector.
+ * \param       sourceEnd_:   End move iterator from another vector.
+ * \param       position_:    Position in vector to start move-inserting data at.
+ *
+ * \retval      IteratorType: Position at which the element has been inserted.
+ *                            (if multiple elements have been inserted, return position of the last
+ *                             inserted element).
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline typename vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::IteratorType
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::insert(
+  const std::move_iterator<IteratorType> sourceBegin_,
+  const std::move_iterator<IteratorType> sourceEnd_,
+  const IteratorType                     position_)
+{
+    if constexpr(vector_safeness == true)
+    {
+        check_if_valid(position_);
+    }
 
-    return insert(sourceBegin_, sourceEnd_, position);
+    return insert(sourceBegin_, sourceEnd_, position_ - begin());
 }
 
 
 /**
  **************************************************************************************************
- * \brief       Insert elements in the middle of the vector from an initializer list,
- *              right-shifting items on the right to fit.
+ * \brief       Move elements in the middle of the vector from another vector, right-shifting
+ *              items on the right to fit. The moved-from elements are left in the other vector.
  *
- * \param       ilist_:  Initializer list containing element to copy-insert into vector.
- * \param       offset_: Offset in vector to start copy-inserting data at.
- *                       [defaults : 0]
+ * \param       sourceBegin_: Begin move iterator from another vector.
+ * \param       sourceEnd_:   End move iterator from another vector.
+ * \param       offset_:      Offset in vector to start move-inserting data at.
+ *              [defaults : 0]
  *
  * \retval      IteratorType: Position at which the element has been inserted.
  *                            (if multiple elements have been inserted, return position of the last
@@ -807,22 +1389,62 @@ vector<ItemType, AllocatorType>::insert(const IteratorType sourceBegin_,
  *
  * \throws      std::invalid_argument("Invalid insert offset")
  *              Offset was out of bounds.
+ * \throws      std::invalid_argument("Invalid insert range")
+ *              The end of the source range is before its beginning.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-inline typename vector<ItemType, AllocatorType>::IteratorType
-vector<ItemType, AllocatorType>::insert(const InitializerListType ilist_, SizeType offset_)
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline typename vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::IteratorType
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::insert(
+  const std::move_iterator<IteratorType> sourceBegin_,
+  const std::move_iterator<IteratorType> sourceEnd_,
+  DifferenceType                         offset_)
 {
     if constexpr(vector_safeness == true)
     {
-        if(offset_ > length())
+        if(sourceEnd_ < sourceBegin_)
         {
-            throw std::invalid_argument("Invalid insert offset");
+            throw std::invalid_argument("Invalid insert range");
         }
     }
 
-    IteratorType position = cbegin() + offset_;
+    ItemType* const source = sourceBegin_.base().ptr();
+    return insert_with(static_cast<SizeType>(offset_),
+                       static_cast<SizeType>(sourceEnd_ - sourceBegin_),
+                       [&](ItemType* item_, SizeType index_)
+                       {
+                           AllocatorTraits::construct(
+                             m_allocator, item_, std::move(source[index_]));
+                       });
+}
 
-    return insert(ilist_.begin(), ilist_.end(), position);
+
+/**
+ **************************************************************************************************
+ * \brief       Insert elements in the middle of the vector from an initializer list,
+ *              right-shifting items on the right to fit.
+ *
+ * \param       ilist_:  Initializer list containing element to copy-insert into vector.
+ * \param       offset_: Offset in vector to start copy-inserting data at.
+ *                       [defaults : 0]
+ *
+ * \retval      IteratorType: Position at which the element has been inserted.
+ *                            (if multiple elements have been inserted, return position of the last
+ *                             inserted element).
+ *
+ * \throws      std::invalid_argument("Invalid insert offset")
+ *              Offset was out of bounds.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline typename vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::IteratorType
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::insert(
+  const InitializerListType ilist_,
+  SizeType                  offset_)
+{
+    const ItemType* const source = ilist_.begin();
+    return insert_with(offset_,
+                       ilist_.size(),
+                       [&](ItemType* item_, SizeType index_)
+                       { AllocatorTraits::construct(m_allocator, item_, source[index_]); });
 }
 
 
@@ -836,9 +1458,10 @@ vector<ItemType, AllocatorType>::insert(const InitializerListType ilist_, SizeTy
  *
  * \retval      IteratorType: Position at which the element has been replaced.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-inline typename vector<ItemType, AllocatorType>::IteratorType
-vector<ItemType, AllocatorType>::replace(const ItemType& value_, SizeType offset_)
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline typename vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::IteratorType
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::replace(const ItemType& value_,
+                                                                        SizeType        offset_)
 {
     at(offset_) = value_;
 
@@ -855,9 +1478,9 @@ vector<ItemType, AllocatorType>::replace(const ItemType& value_, SizeType offset
  * \retval      IteratorType: Iterator to the element that was replaced.
  *                            (end iterator - 1)
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-inline typename vector<ItemType, AllocatorType>::IteratorType
-vector<ItemType, AllocatorType>::replace_back(const ItemType& value_)
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline typename vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::IteratorType
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::replace_back(const ItemType& value_)
 {
     IteratorType position = end() - 1;
 
@@ -875,9 +1498,10 @@ vector<ItemType, AllocatorType>::replace_back(const ItemType& value_)
  * \retval      IteratorType: Iterator to the element that was replaced.
  *                            (begin iterator)
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-inline typename vector<ItemType, AllocatorType>::IteratorType
-vector<ItemType, AllocatorType>::replace_front(const ItemType& value_)
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline typename vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::IteratorType
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::replace_front(
+  const ItemType& value_)
 {
     IteratorType position = begin();
 
@@ -897,9 +1521,9 @@ vector<ItemType, AllocatorType>::replace_front(const ItemType& value_)
  *
  * \retval      SizeType: Elements that can fit in the allocated space.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-[[nodiscard]] inline typename vector<ItemType, AllocatorType>::SizeType
-vector<ItemType, AllocatorType>::capacity() const noexcept
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline typename vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::SizeType
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::capacity() const noexcept
 {
     return m_capacity;
 }
@@ -914,9 +1538,9 @@ vector<ItemType, AllocatorType>::capacity() const noexcept
  * \note        This function works for shrinking as well as expanding the vector's allocated
  *              memory space.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
 inline void
-vector<ItemType, AllocatorType>::reserve(SizeType newCapacity_)
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::reserve(SizeType newCapacity_)
 {
     /* Check if resizing is necessary */
     if(newCapacity_ == capacity())
@@ -932,6 +1556,7 @@ vector<ItemType, AllocatorType>::reserve(SizeType newCapacity_)
 /**
  **************************************************************************************************
  * \brief       Change amount of elements currently stocked in the vector.
+ *              New elements are value-initialized, which zero-fills trivial types.
  *
  * \param       newLength_: Size in elements of the vector.
  *
@@ -939,23 +1564,109 @@ vector<ItemType, AllocatorType>::reserve(SizeType newCapacity_)
  *              \ref reserve() allocates memory space, but doesn't make changes to  the iterators
  *              or elements (unless shrinking below current vector's length).
  *              resize() changes the amount of elements contained in the vector, and can call
- *              \ref reserve() if in need of more memory.
+ *              \ref reserve() if in need of more memory. Shrinking destroys the elements past the
+ *              new length, but keeps the allocated memory.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline void
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::resize(SizeType newLength_)
+{
+    resize_with(newLength_,
+                [&](ItemType* item_) { AllocatorTraits::construct(m_allocator, item_); });
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Change amount of elements currently stocked in the vector, copying a value into
+ *              every new element.
+ *
+ * \param       newLength_: Size in elements of the vector.
+ * \param       value_:     Value to initialize the new elements with.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
 inline void
-vector<ItemType, AllocatorType>::resize(SizeType newLength_)
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::resize(SizeType        newLength_,
+                                                                       const ItemType& value_)
 {
-    /* Check if reserving memory is necessary */
-    if(newLength_ > capacity())
+    resize_with(newLength_,
+                [&](ItemType* item_) { AllocatorTraits::construct(m_allocator, item_, value_); });
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Change amount of elements currently stocked in the vector, without initializing
+ *              the new elements when `ItemType` is trivially default constructible.
+ *              The new elements hold indeterminate values, and must be written before being read.
+ *
+ * \param       newLength_: Size in elements of the vector.
+ *
+ * \note        Other types are value-initialized through the allocator, like \ref resize().
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline void
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::resize_default_init(
+  SizeType newLength_)
+{
+    if constexpr(std::is_trivially_default_constructible_v<ItemType>)
     {
-        reserve(newLength_);
+        resize_with(newLength_, [](ItemType*) noexcept {});
     }
+    else
+    {
+        resize(newLength_);
+    }
+}
 
-    /* Check if freeing some memory is necessary */
-    /** \todo */
 
-    /* Resize */
-    change_size(newLength_);
+/**
+ **************************************************************************************************
+ * \brief       Grow the vector without initializing the new elements, and let an operation write
+ *              them directly in the vector's memory, such as a `read` from a file or a socket.
+ *              Filling the vector this way costs a single write pass over the memory.
+ *
+ * \param       newLength_: Maximum size in elements of the vector.
+ * \param       operation_: Callable taking the vector's data pointer and `newLength_`, writing the
+ *                          elements, and returning the final length of the vector.
+ *
+ * \throws      std::length_error("resize_for_overwrite operation returned a length too big")
+ *
+ * \note        Elements past the returned length are destroyed. If the operation throws, or
+ *              returns a length too big, the vector is shrunk back to its previous length.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+template<typename OperationType>
+    requires std::is_invocable_r_v<std::size_t, OperationType&, ItemType*, std::size_t>
+inline void
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::resize_for_overwrite(
+  SizeType        newLength_,
+  OperationType&& operation_)
+{
+    const SizeType oldLength = length();
+    resize_default_init(newLength_);
+
+    SizeType finalLength = 0;
+    try
+    {
+        finalLength = static_cast<SizeType>(std::invoke(operation_, data(), newLength_));
+    }
+    catch(...)
+    {
+        resize_with(std::min(oldLength, newLength_), [](ItemType*) noexcept {});
+        throw;
+    }
+
+    if constexpr(vector_safeness == true)
+    {
+        if(finalLength > newLength_)
+        {
+            resize_with(std::min(oldLength, newLength_), [](ItemType*) noexcept {});
+            throw std::length_error("resize_for_overwrite operation returned a length too big");
+        }
+    }
+
+    resize_with(finalLength, [](ItemType*) noexcept {});
 }
 
 
@@ -964,9 +1675,9 @@ vector<ItemType, AllocatorType>::resize(SizeType newLength_)
  * \brief       Shrink allocated memory to fit exactly the number of elements currently being
  *              contained in the vector.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
 inline void
-vector<ItemType, AllocatorType>::shrink_to_fit()
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::shrink_to_fit()
 {
     if(length() == capacity())
     {
@@ -987,10 +1698,14 @@ vector<ItemType, AllocatorType>::shrink_to_fit()
  *
  * \retval      A string containing the capacity, the size, and all the elements converted to a
  *              string.
+ *
+ * \note        Goes through a `std::ostringstream`, like `operator<<`. pel::to_string (see
+ *              vector_format.hpp) avoids the stream, but writes floating point elements in their
+ *              shortest exact representation.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
 [[nodiscard]] inline std::string
-vector<ItemType, AllocatorType>::to_string() const
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::to_string() const
 {
     std::ostringstream os;
     os << *this;
@@ -998,6 +1713,110 @@ vector<ItemType, AllocatorType>::to_string() const
 }
 
 
+/*************************************************************************************************/
+/* INSTRUMENTATION ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Get the instrumentation policy of the vector, holding the statistics it recorded.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline Instrumentation&
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::instrumentation() noexcept
+{
+    return m_instrumentation;
+}
+
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline const Instrumentation&
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::instrumentation() const noexcept
+{
+    return m_instrumentation;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Write the current state of the vector and the statistics recorded by its
+ *              instrumentation policy as a JSON object.
+ *
+ * \param       os_: Output stream to write to.
+ *
+ * \note        `wastedBytes` is the memory currently reserved but not used by any element.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+void
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::write_instrumentation(
+  std::ostream& os_) const
+    requires Instrumentation::enabled
+{
+    os_ << "{\"length\": " << length() << ", \"capacity\": " << capacity()
+        << ", \"itemSize\": " << sizeof(ItemType)
+        << ", \"wastedBytes\": " << (capacity() - length()) * sizeof(ItemType)
+        << ", \"instrumentation\": ";
+    m_instrumentation.write_json(os_);
+    os_ << "}";
+}
+
+
+/*************************************************************************************************/
+/* PROTECTED METHODS --------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Take ownership of a block of memory obtained from this vector's allocator.
+ *              Used by derived containers whose allocator can hand out already populated memory
+ *              (e.g. an existing file mapping), to avoid copying it element by element.
+ *
+ * \param       data_:     Block of memory to adopt.
+ * \param       length_:   Number of elements already constructed at the start of the block.
+ * \param       capacity_: Number of elements the block can hold.
+ *
+ * \note        The vector must not hold any memory when calling this method.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+void
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::adopt(ItemType* data_,
+                                                                      SizeType  length_,
+                                                                      SizeType  capacity_) noexcept
+{
+    record_reallocation(reallocation_kind::allocate, 0, capacity_, length_);
+
+    m_beginIterator = IteratorType(data_);
+    m_endIterator   = IteratorType(data_ + length_);
+    m_capacity      = capacity_;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Take ownership of the memory of another vector, which is left empty, without
+ *              memory. The memory currently held by this vector is released first.
+ *              Used by derived containers that know when the memory of another one can be
+ *              released by this vector's allocator, even if both allocators don't compare equal.
+ *
+ * \param       other_: Vector to take the memory of.
+ *
+ * \note        The memory of `other_` must be releasable by this vector's allocator.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+void
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::adopt(vector&& other_) noexcept
+{
+    vector_constructor(0);
+
+    m_beginIterator = other_.m_beginIterator;
+    m_endIterator   = other_.m_endIterator;
+    m_capacity      = other_.m_capacity;
+
+    other_.m_beginIterator = IteratorType{nullptr};
+    other_.m_endIterator   = IteratorType{nullptr};
+    other_.m_capacity      = 0;
+}
+
+
 /*************************************************************************************************/
 /* PRIVATE METHODS ----------------------------------------------------------------------------- */
 /*************************************************************************************************/
@@ -1009,25 +1828,107 @@ vector<ItemType, AllocatorType>::to_string() const
  * \param       size_: Size (in elements) to allocate.
  *
  * \throws      std::bad_alloc: Could not allocate block of memory.
+ *
+ * \note        Reallocating to a size of 0 releases the memory block without allocating a new one.
+ *              If the allocator supports it, the block is first resized in place (see
+ *              allocator_extensions.hpp). Otherwise, elements are relocated to a new memory block
+ *              with \ref pel::relocate, which is a single `memcpy` for trivially relocatable types.
+ *              Elements that do not fit in the new block when shrinking are destroyed.
+ *              The capacity is rounded up to the allocator's `capacity_granularity`, if any.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
 void
-vector<ItemType, AllocatorType>::vector_constructor(SizeType size_)
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::vector_constructor(SizeType size_)
 {
+    using ExtensionTraits = allocator_extension_traits<AllocatorType>;
+
+    ItemType*      oldPtr    = begin().ptr();
+    const SizeType oldLength = length();
+    const SizeType newLength = std::min(oldLength, size_);
+
+    /* Destroy the elements that will not fit anymore */
+    destroy_range(m_allocator, oldPtr + newLength, oldPtr + oldLength);
+    m_endIterator = IteratorType(oldPtr + newLength);
+
+    /* Empty vectors don't hold any memory */
+    if(size_ == 0)
+    {
+        if(oldPtr != nullptr)
+        {
+            record_reallocation(reallocation_kind::release, capacity(), 0, 0);
+            AllocatorTraits::deallocate(m_allocator, oldPtr, capacity());
+        }
+        m_beginIterator = IteratorType{nullptr};
+        m_endIterator   = IteratorType{nullptr};
+        m_capacity      = 0;
+        return;
+    }
+
+    /* Round the capacity up to what the allocator hands out (e.g. whole SIMD registers) */
+    if constexpr(ExtensionTraits::capacity_granularity > 1)
+    {
+        size_ = rounded_capacity(size_);
+        if(size_ == capacity())
+        {
+            return;
+        }
+    }
+
+    if(oldPtr != nullptr)
+    {
+        /* Resize the block without moving anything */
+        if constexpr(ExtensionTraits::can_expand_in_place)
+        {
+            if(m_allocator.expand_in_place(oldPtr, capacity(), size_))
+            {
+                record_reallocation(reallocation_kind::in_place, capacity(), size_, newLength);
+                m_capacity = size_;
+                return;
+            }
+        }
+
+        /* Let the allocator move the block bitwise (e.g. realloc/mremap) */
+        if constexpr(ExtensionTraits::can_reallocate && is_trivially_relocatable_v<ItemType>)
+        {
+            ItemType* tempPtr = m_allocator.reallocate(oldPtr, capacity(), size_);
+            record_reallocation(reallocation_kind::bitwise, capacity(), size_, newLength);
+
+            m_beginIterator = IteratorType(tempPtr);
+            m_endIterator   = IteratorType(tempPtr + newLength);
+            m_capacity      = size_;
+            return;
+        }
+    }
+
     /* Reallocate block of memory */
     ItemType* tempPtr = AllocatorTraits::allocate(m_allocator, size_);
-    ItemType* oldPtr  = begin().ptr();
 
-    /* Move data from old vector memory to new memory */
-    std::move(begin(), end(), tempPtr);
+    /* Relocate data from old vector memory to new memory */
+    if(oldPtr != nullptr)
+    {
+        try
+        {
+            relocate(m_allocator, oldPtr, oldPtr + newLength, tempPtr);
+        }
+        catch(...)
+        {
+            AllocatorTraits::deallocate(m_allocator, tempPtr, size_);
+            throw;
+        }
+    }
 
     /* Set iterators */
-    DifferenceType diff = length();
-    m_beginIterator     = IteratorType(static_cast<ItemType*>(tempPtr));
-    m_endIterator       = IteratorType(begin() + diff);
+    m_beginIterator = IteratorType(tempPtr);
+    m_endIterator   = IteratorType(tempPtr + newLength);
 
     /* Deallocate old memory */
-    m_allocator.deallocate(oldPtr, capacity());
+    if(oldPtr != nullptr)
+    {
+        AllocatorTraits::deallocate(m_allocator, oldPtr, capacity());
+    }
+    const reallocation_kind kind = oldPtr != nullptr ? reallocation_kind::relocate
+                                                     : reallocation_kind::allocate;
+    record_reallocation(kind, capacity(), size_, newLength);
     m_capacity = size_;
 }
 
@@ -1035,35 +1936,387 @@ vector<ItemType, AllocatorType>::vector_constructor(SizeType size_)
 /**
  **************************************************************************************************
  * \brief       Check if the vector is big enough to hold the required extra elements.
- *              If it is not currently big enough, reserve some memory.
+ *              If it is not currently big enough, reserve the capacity computed by the
+ *              `GrowthPolicy` for the required length, in a single reallocation.
  *
  * \param       extraLength_: Numbers of elements to add to the current length.
  *************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
 inline void
-vector<ItemType, AllocatorType>::check_fit(SizeType extraLength_)
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::check_fit(SizeType extraLength_)
 {
-    if(length() + extraLength_ > capacity())
+    const SizeType requiredCapacity = length() + extraLength_;
+
+    if(requiredCapacity > capacity())
     {
-        reserve(capacity() + step_size());
+        if constexpr(Instrumentation::enabled)
+        {
+            m_instrumentation.template on_growth<ItemType>(capacity(), requiredCapacity);
+        }
+
+        reserve(GrowthPolicy::next_capacity(capacity(), requiredCapacity));
     }
 }
 
 
 /**
-**************************************************************************************************
-* \brief       Get and increases the allocation step size.
-*              Whenever this function is called, set the allocation step size to 150%, rounded to
-*              the upper even number.
-*              (Step size of 10 becomes 16).
-*
-* \retval      The adjusted step size.
-*************************************************************************************************/
-template<typename ItemType, typename AllocatorType>
-typename vector<ItemType, AllocatorType>::SizeType
-vector<ItemType, AllocatorType>::step_size() noexcept
+ **************************************************************************************************
+ * \brief       Report a change of the memory block to the instrumentation policy, if it is
+ *              enabled.
+ *
+ * \param       kind_:        Change made to the memory block.
+ * \param       oldCapacity_: Capacity before the change.
+ * \param       newCapacity_: Capacity after the change.
+ * \param       length_:      Number of elements kept in the block.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline void
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::record_reallocation(
+  reallocation_kind kind_,
+  SizeType          oldCapacity_,
+  SizeType          newCapacity_,
+  SizeType          length_) noexcept
+{
+    if constexpr(Instrumentation::enabled)
+    {
+        m_instrumentation.template on_reallocation<ItemType>(
+          reallocation_event{kind_, oldCapacity_, newCapacity_, length_, sizeof(ItemType)});
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Change the length of the vector, constructing the new elements with a function.
+ *              Growing reserves memory through the `GrowthPolicy`; shrinking destroys the elements
+ *              past the new length, without releasing memory.
+ *
+ * \param       newLength_: Size in elements of the vector.
+ * \param       construct_: Callable constructing an element at the address it receives.
+ *
+ * \note        If a construction throws, the elements constructed so far are destroyed and the
+ *              length of the vector is left unchanged.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+template<typename ConstructFunction>
+inline void
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::resize_with(
+  SizeType          newLength_,
+  ConstructFunction construct_)
+{
+    const SizeType oldLength = length();
+
+    if(newLength_ <= oldLength)
+    {
+        destroy_range(m_allocator, data() + newLength_, data() + oldLength);
+        change_size(newLength_);
+        return;
+    }
+
+    check_fit(newLength_ - oldLength);
+
+    ItemType* const first   = data() + oldLength;
+    ItemType* const last    = data() + newLength_;
+    ItemType*       current = first;
+    try
+    {
+        for(; current != last; ++current)
+        {
+            construct_(current);
+        }
+    }
+    catch(...)
+    {
+        destroy_range(m_allocator, first, current);
+        throw;
+    }
+
+    change_size(newLength_);
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Insert elements in the middle of the vector, moving every element at most once.
+ *
+ * \param       offset_:    Offset in vector of the first inserted element.
+ * \param       count_:     Number of elements to insert.
+ * \param       construct_: Callable constructing the inserted element of an index at the address
+ *                          it receives.
+ *
+ * \retval      IteratorType: Position of the last inserted element, or the insert position if no
+ *                            element was inserted.
+ *
+ * \throws      std::invalid_argument("Invalid insert offset")
+ *              Offset was out of bounds.
+ *
+ * \note        When the vector has to grow, a new block is allocated and the inserted elements,
+ *              the prefix and the suffix are placed directly at their final positions, so the
+ *              suffix is only moved once. This requires elements that can be relocated without
+ *              throwing, and allocators that can't resize their blocks in place; otherwise, the
+ *              vector grows first and the suffix is then shifted.
+ *              In place, the suffix is shifted with a single `memmove` for trivially relocatable
+ *              elements, and relocated backward for elements that can be moved without throwing.
+ *              In both cases, if an inserted element throws on construction, the vector is left
+ *              unchanged. Other elements are appended and rotated into place.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+template<typename ConstructFunction>
+inline typename vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::IteratorType
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::insert_with(
+  SizeType          offset_,
+  SizeType          count_,
+  ConstructFunction construct_)
+{
+    constexpr bool nothrowRelocation =
+      is_trivially_relocatable_v<ItemType> || std::is_nothrow_move_constructible_v<ItemType>;
+
+    if constexpr(vector_safeness == true)
+    {
+        if(offset_ > length())
+        {
+            throw std::invalid_argument("Invalid insert offset");
+        }
+    }
+
+    const SizeType       oldLength    = length();
+    const SizeType       newLength    = oldLength + count_;
+    const DifferenceType lastInserted = static_cast<DifferenceType>(
+      count_ != 0 ? offset_ + count_ - 1 : offset_);
+
+    if(newLength > capacity())
+    {
+        if constexpr(grows_by_relocation)
+        {
+            if constexpr(Instrumentation::enabled)
+            {
+                m_instrumentation.template on_growth<ItemType>(capacity(), newLength);
+            }
+
+            const SizeType newCapacity =
+              rounded_capacity(GrowthPolicy::next_capacity(capacity(), newLength));
+
+            ItemType* const oldPtr = data();
+            ItemType* const newPtr = AllocatorTraits::allocate(m_allocator, newCapacity);
+
+            /* Inserted elements are built first, since they may refer to elements of the vector */
+            SizeType constructed = 0;
+            try
+            {
+                for(; constructed < count_; constructed++)
+                {
+                    construct_(newPtr + offset_ + constructed, constructed);
+                }
+            }
+            catch(...)
+            {
+                destroy_range(m_allocator, newPtr + offset_, newPtr + offset_ + constructed);
+                AllocatorTraits::deallocate(m_allocator, newPtr, newCapacity);
+                throw;
+            }
+
+            relocate(m_allocator, oldPtr, oldPtr + offset_, newPtr);
+            relocate(m_allocator, oldPtr + offset_, oldPtr + oldLength, newPtr + offset_ + count_);
+
+            if(oldPtr != nullptr)
+            {
+                AllocatorTraits::deallocate(m_allocator, oldPtr, capacity());
+            }
+            const reallocation_kind kind = oldPtr != nullptr ? reallocation_kind::relocate
+                                                             : reallocation_kind::allocate;
+            record_reallocation(kind, capacity(), newCapacity, oldLength);
+
+            m_beginIterator = IteratorType(newPtr);
+            m_endIterator   = IteratorType(newPtr + newLength);
+            m_capacity      = newCapacity;
+            return begin() + lastInserted;
+        }
+        else
+        {
+            check_fit(count_);
+        }
+    }
+
+    ItemType* const position   = data() + offset_;
+    ItemType* const oldEnd     = data() + oldLength;
+    const SizeType  tailLength = oldLength - offset_;
+
+    if constexpr(nothrowRelocation)
+    {
+        /* Open a gap of uninitialized memory, then construct the inserted elements in it */
+        const auto shiftTail = [&](ItemType* from_, ItemType* to_) noexcept
+        {
+            if constexpr(is_trivially_relocatable_v<ItemType>)
+            {
+                std::memmove(static_cast<void*>(to_),
+                             static_cast<const void*>(from_),
+                             tailLength * sizeof(ItemType));
+            }
+            else if(to_ > from_)
+            {
+                for(SizeType i = tailLength; i > 0; i--)
+                {
+                    AllocatorTraits::construct(m_allocator, to_ + i - 1, std::move(from_[i - 1]));
+                    AllocatorTraits::destroy(m_allocator, from_ + i - 1);
+                }
+            }
+            else
+            {
+                for(SizeType i = 0; i < tailLength; i++)
+                {
+                    AllocatorTraits::construct(m_allocator, to_ + i, std::move(from_[i]));
+                    AllocatorTraits::destroy(m_allocator, from_ + i);
+                }
+            }
+        };
+
+        shiftTail(position, position + count_);
+
+        SizeType constructed = 0;
+        try
+        {
+            for(; constructed < count_; constructed++)
+            {
+                construct_(position + constructed, constructed);
+            }
+        }
+        catch(...)
+        {
+            destroy_range(m_allocator, position, position + constructed);
+            shiftTail(position + count_, position);
+            throw;
+        }
+
+        change_size(newLength);
+    }
+    else
+    {
+        /* Moving can throw: append the inserted elements, then rotate them into place */
+        SizeType constructed = 0;
+        try
+        {
+            for(; constructed < count_; constructed++)
+            {
+                construct_(oldEnd + constructed, constructed);
+            }
+        }
+        catch(...)
+        {
+            destroy_range(m_allocator, oldEnd, oldEnd + constructed);
+            throw;
+        }
+
+        change_size(newLength);
+        std::rotate(position, oldEnd, oldEnd + count_);
+    }
+
+    return begin() + lastInserted;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Round a capacity up to a multiple of the allocator's `capacity_granularity`, if any.
+ *
+ * \param       capacity_: Capacity (in elements) to round up.
+ *
+ * \retval      SizeType: Rounded capacity, or `capacity_` if rounding it up would overflow.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+constexpr typename vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::SizeType
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::rounded_capacity(
+  SizeType capacity_) noexcept
+{
+    using ExtensionTraits = allocator_extension_traits<AllocatorType>;
+
+    constexpr SizeType granularity = ExtensionTraits::capacity_granularity;
+    if constexpr(granularity > 1)
+    {
+        const SizeType remainder = capacity_ % granularity;
+        if(remainder != 0 && capacity_ <= std::numeric_limits<SizeType>::max() - granularity)
+        {
+            capacity_ += granularity - remainder;
+        }
+    }
+
+    return capacity_;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Replace the elements of the vector with copies of a range of elements.
+ *
+ * \param       first_: Pointer to the first element to copy. Must not be an element of the vector.
+ * \param       count_: Number of elements to copy.
+ *
+ * \note        When the capacity suffices, the memory is reused: trivially copyable elements are
+ *              copied with a single `memcpy`, other elements are copy-assigned over the current
+ *              ones and copy-constructed past them. Otherwise, exactly `count_` elements are
+ *              allocated (rounded up to the allocator's `capacity_granularity`) and copied with
+ *              \ref pel::copy_to_uninitialized before the current memory is released, so the
+ *              vector is left unchanged if a copy throws.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+void
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::copy_elements(
+  const ItemType* first_,
+  SizeType        count_)
 {
-    return ((m_stepSize += m_stepSize / 2) % 2 == 0) ? m_stepSize : ++m_stepSize;
+    ItemType* const oldPtr    = data();
+    const SizeType  oldLength = length();
+
+    if(count_ <= capacity())
+    {
+        if constexpr(std::is_trivially_copyable_v<ItemType>)
+        {
+            if(count_ != 0)
+            {
+                std::memcpy(static_cast<void*>(oldPtr),
+                            static_cast<const void*>(first_),
+                            count_ * sizeof(ItemType));
+            }
+        }
+        else
+        {
+            const SizeType assigned = std::min(oldLength, count_);
+            std::copy(first_, first_ + assigned, oldPtr);
+
+            if(oldPtr != nullptr)
+            {
+                destroy_range(m_allocator, oldPtr + assigned, oldPtr + oldLength);
+            }
+            change_size(assigned);
+            copy_to_uninitialized(
+              m_allocator, first_ + assigned, first_ + count_, oldPtr + assigned);
+        }
+
+        change_size(count_);
+        return;
+    }
+
+    const SizeType  newCapacity = rounded_capacity(count_);
+    ItemType* const newPtr      = AllocatorTraits::allocate(m_allocator, newCapacity);
+    try
+    {
+        copy_to_uninitialized(m_allocator, first_, first_ + count_, newPtr);
+    }
+    catch(...)
+    {
+        AllocatorTraits::deallocate(m_allocator, newPtr, newCapacity);
+        throw;
+    }
+
+    if(oldPtr != nullptr)
+    {
+        destroy_range(m_allocator, oldPtr, oldPtr + oldLength);
+        record_reallocation(reallocation_kind::release, capacity(), 0, 0);
+        AllocatorTraits::deallocate(m_allocator, oldPtr, capacity());
+    }
+    record_reallocation(reallocation_kind::allocate, 0, newCapacity, count_);
+
+    m_beginIterator = IteratorType(newPtr);
+    m_endIterator   = IteratorType(newPtr + count_);
+    m_capacity      = newCapacity;
 }
 
 }        // namespace pel
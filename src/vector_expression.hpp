@@ -0,0 +1,261 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./simd.hpp"
+#include "./vector.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+namespace pel
+{
+/**
+ **************************************************************************************************
+ * \brief       Leaf of an expression, reading the elements of a vector.
+ *************************************************************************************************/
+template<typename ItemType>
+class expression_leaf
+{
+public:
+    using ValueType = ItemType;
+    static constexpr bool is_vector_expression = true;
+
+    constexpr expression_leaf(const ItemType* data_, std::size_t length_) noexcept
+    : m_data{data_}, m_length{length_}
+    {
+    }
+
+    [[nodiscard]] constexpr const ItemType* data() const noexcept { return m_data; }
+    [[nodiscard]] constexpr std::size_t     length() const noexcept { return m_length; }
+
+    [[nodiscard]] constexpr const ItemType& operator[](std::size_t index_) const noexcept
+    {
+        return m_data[index_];
+    }
+
+private:
+    const ItemType* m_data;
+    std::size_t     m_length;
+};
+
+/**
+ **************************************************************************************************
+ * \brief       Scalar operand of an expression, broadcast to every element.
+ *************************************************************************************************/
+template<typename ItemType>
+class expression_scalar
+{
+public:
+    using ValueType = ItemType;
+
+    constexpr explicit expression_scalar(const ItemType& value_) : m_value{value_} {}
+
+    [[nodiscard]] constexpr const ItemType& operator[](std::size_t) const noexcept
+    {
+        return m_value;
+    }
+
+private:
+    ItemType m_value;
+};
+
+/**
+ **************************************************************************************************
+ * \brief       Element-wise unary operation on an expression.
+ *************************************************************************************************/
+template<typename OperationType, typename OperandType>
+class expression_unary
+{
+public:
+    using ValueType = std::remove_cvref_t<
+      std::invoke_result_t<const OperationType&, const typename OperandType::ValueType&>>;
+    static constexpr bool is_vector_expression = true;
+
+    constexpr explicit expression_unary(const OperandType& operand_) : m_operand{operand_} {}
+
+    [[nodiscard]] constexpr std::size_t length() const noexcept { return m_operand.length(); }
+
+    [[nodiscard]] constexpr ValueType operator[](std::size_t index_) const
+    {
+        return m_operation(m_operand[index_]);
+    }
+
+    [[nodiscard]] constexpr const OperandType& operand() const noexcept { return m_operand; }
+
+private:
+    OperandType                         m_operand;
+    [[no_unique_address]] OperationType m_operation{};
+};
+
+/**
+ **************************************************************************************************
+ * \brief       Element-wise binary operation between two expressions, or between an expression
+ *              and a scalar.
+ *
+ * \throws      std::length_error if both operands are expressions of different lengths.
+ *************************************************************************************************/
+template<typename OperationType, typename LhsType, typename RhsType>
+class expression_binary
+{
+public:
+    using ValueType = std::remove_cvref_t<std::invoke_result_t<const OperationType&,
+                                                               const typename LhsType::ValueType&,
+                                                               const typename RhsType::ValueType&>>;
+    static constexpr bool is_vector_expression = true;
+
+    constexpr expression_binary(const LhsType& lhs_, const RhsType& rhs_);
+
+    [[nodiscard]] constexpr std::size_t length() const noexcept;
+
+    [[nodiscard]] constexpr ValueType operator[](std::size_t index_) const
+    {
+        return m_operation(m_lhs[index_], m_rhs[index_]);
+    }
+
+    [[nodiscard]] constexpr const LhsType& lhs() const noexcept { return m_lhs; }
+    [[nodiscard]] constexpr const RhsType& rhs() const noexcept { return m_rhs; }
+
+private:
+    LhsType                             m_lhs;
+    RhsType                             m_rhs;
+    [[no_unique_address]] OperationType m_operation{};
+};
+
+
+/*************************************************************************************************/
+/* Operands ------------------------------------------------------------------------------------ */
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+[[nodiscard]] expression_leaf<ItemType>
+make_expression(
+  const vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>& vector_) noexcept;
+
+template<vector_expression ExpressionType>
+[[nodiscard]] constexpr const ExpressionType&
+make_expression(const ExpressionType& expression_) noexcept;
+
+/**
+ **************************************************************************************************
+ * \brief       Types usable as operands of the expression operators: vectors and expressions, and
+ *              arithmetic scalars combined with one of those.
+ *************************************************************************************************/
+template<typename OperandType>
+concept expression_operand = requires(const OperandType& operand_)
+{
+    make_expression(operand_);
+};
+
+template<typename ScalarType>
+concept expression_scalar_operand = simd::arithmetic<ScalarType>;
+
+template<typename LhsType, typename RhsType>
+concept expression_operands =
+  (expression_operand<LhsType> && expression_operand<RhsType>)
+  || (expression_operand<LhsType> && expression_scalar_operand<RhsType>)
+  || (expression_scalar_operand<LhsType> && expression_operand<RhsType>);
+
+/**
+ **************************************************************************************************
+ * \brief       Node type storing an operand inside an expression.
+ *************************************************************************************************/
+template<typename OperandType>
+struct expression_node
+{
+    using type =
+      std::remove_cvref_t<decltype(make_expression(std::declval<const OperandType&>()))>;
+};
+
+template<expression_scalar_operand OperandType>
+struct expression_node<OperandType>
+{
+    using type = expression_scalar<OperandType>;
+};
+
+template<typename OperandType>
+using expression_node_t = typename expression_node<OperandType>::type;
+
+template<typename OperationType, typename LhsType, typename RhsType>
+using binary_expression_t =
+  expression_binary<OperationType, expression_node_t<LhsType>, expression_node_t<RhsType>>;
+
+
+/*************************************************************************************************/
+/* Operators ----------------------------------------------------------------------------------- */
+template<typename LhsType, typename RhsType>
+    requires expression_operands<LhsType, RhsType>
+[[nodiscard]] binary_expression_t<std::plus<>, LhsType, RhsType>
+operator+(const LhsType& lhs_, const RhsType& rhs_);
+
+template<typename LhsType, typename RhsType>
+    requires expression_operands<LhsType, RhsType>
+[[nodiscard]] binary_expression_t<std::minus<>, LhsType, RhsType>
+operator-(const LhsType& lhs_, const RhsType& rhs_);
+
+template<typename LhsType, typename RhsType>
+    requires expression_operands<LhsType, RhsType>
+[[nodiscard]] binary_expression_t<std::multiplies<>, LhsType, RhsType>
+operator*(const LhsType& lhs_, const RhsType& rhs_);
+
+template<typename LhsType, typename RhsType>
+    requires expression_operands<LhsType, RhsType>
+[[nodiscard]] binary_expression_t<std::divides<>, LhsType, RhsType>
+operator/(const LhsType& lhs_, const RhsType& rhs_);
+
+template<expression_operand OperandType>
+[[nodiscard]] expression_unary<std::negate<>, expression_node_t<OperandType>>
+operator-(const OperandType& operand_);
+
+
+/*************************************************************************************************/
+/* Evaluation ---------------------------------------------------------------------------------- */
+template<vector_expression ExpressionType, typename ItemType>
+void evaluate_expression(const ExpressionType& expression_, ItemType* destination_);
+
+/**
+ **************************************************************************************************
+ * \brief       Type in which the elements of an expression are summed.
+ *************************************************************************************************/
+template<expression_operand OperandType>
+using expression_sum_t =
+  std::conditional_t<simd::arithmetic<typename expression_node_t<OperandType>::ValueType>,
+                     simd::sum_type_t<typename expression_node_t<OperandType>::ValueType>,
+                     typename expression_node_t<OperandType>::ValueType>;
+
+template<expression_operand OperandType>
+[[nodiscard]] expression_sum_t<OperandType> sum(const OperandType& operand_);
+
+}        // namespace pel
+
+
+#include "./vector_expression.inl"
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
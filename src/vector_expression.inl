@@ -0,0 +1,390 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./vector_expression.hpp"
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* EXPRESSION NODES ---------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Build a binary expression node.
+ *
+ * \param       lhs_: Left-hand operand of the operation.
+ * \param       rhs_: Right-hand operand of the operation.
+ *************************************************************************************************/
+template<typename OperationType, typename LhsType, typename RhsType>
+constexpr expression_binary<OperationType, LhsType, RhsType>::expression_binary(const LhsType& lhs_,
+                                                                                const RhsType& rhs_)
+: m_lhs{lhs_}, m_rhs{rhs_}
+{
+    if constexpr(vector_expression<LhsType> && vector_expression<RhsType>)
+    {
+        if(m_lhs.length() != m_rhs.length())
+        {
+            throw std::length_error("Operands of a vector expression must have the same length");
+        }
+    }
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Get the number of elements produced by a binary expression.
+ *              Scalars are broadcast, so the length is the one of the expression operand.
+ *************************************************************************************************/
+template<typename OperationType, typename LhsType, typename RhsType>
+constexpr std::size_t
+expression_binary<OperationType, LhsType, RhsType>::length() const noexcept
+{
+    if constexpr(vector_expression<LhsType>)
+    {
+        return m_lhs.length();
+    }
+    else
+    {
+        return m_rhs.length();
+    }
+}
+
+
+/*************************************************************************************************/
+/* OPERANDS ------------------------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Get the expression leaf reading the elements of a vector.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+inline expression_leaf<ItemType>
+make_expression(
+  const vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>& vector_) noexcept
+{
+    return expression_leaf<ItemType>{vector_.data(), vector_.length()};
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Expressions are their own expression node.
+ *************************************************************************************************/
+template<vector_expression ExpressionType>
+constexpr const ExpressionType&
+make_expression(const ExpressionType& expression_) noexcept
+{
+    return expression_;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Convert an operand, vector, expression or scalar, to its expression node.
+ *************************************************************************************************/
+template<typename OperandType>
+constexpr expression_node_t<OperandType>
+make_expression_node(const OperandType& operand_)
+{
+    if constexpr(expression_scalar_operand<OperandType>)
+    {
+        return expression_scalar<OperandType>{operand_};
+    }
+    else
+    {
+        return make_expression(operand_);
+    }
+}
+
+
+/*************************************************************************************************/
+/* OPERATORS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Lazy element-wise addition.
+ *************************************************************************************************/
+template<typename LhsType, typename RhsType>
+    requires expression_operands<LhsType, RhsType>
+inline binary_expression_t<std::plus<>, LhsType, RhsType>
+operator+(const LhsType& lhs_, const RhsType& rhs_)
+{
+    return {make_expression_node(lhs_), make_expression_node(rhs_)};
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Lazy element-wise subtraction.
+ *************************************************************************************************/
+template<typename LhsType, typename RhsType>
+    requires expression_operands<LhsType, RhsType>
+inline binary_expression_t<std::minus<>, LhsType, RhsType>
+operator-(const LhsType& lhs_, const RhsType& rhs_)
+{
+    return {make_expression_node(lhs_), make_expression_node(rhs_)};
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Lazy element-wise multiplication.
+ *************************************************************************************************/
+template<typename LhsType, typename RhsType>
+    requires expression_operands<LhsType, RhsType>
+inline binary_expression_t<std::multiplies<>, LhsType, RhsType>
+operator*(const LhsType& lhs_, const RhsType& rhs_)
+{
+    return {make_expression_node(lhs_), make_expression_node(rhs_)};
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Lazy element-wise division.
+ *************************************************************************************************/
+template<typename LhsType, typename RhsType>
+    requires expression_operands<LhsType, RhsType>
+inline binary_expression_t<std::divides<>, LhsType, RhsType>
+operator/(const LhsType& lhs_, const RhsType& rhs_)
+{
+    return {make_expression_node(lhs_), make_expression_node(rhs_)};
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Lazy element-wise negation.
+ *************************************************************************************************/
+template<expression_operand OperandType>
+inline expression_unary<std::negate<>, expression_node_t<OperandType>>
+operator-(const OperandType& operand_)
+{
+    return expression_unary<std::negate<>, expression_node_t<OperandType>>{
+      make_expression_node(operand_)};
+}
+
+
+/*************************************************************************************************/
+/* EVALUATION ---------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Evaluate every element of an expression into already constructed elements.
+ *              The whole expression is computed in a single pass over contiguous memory, which
+ *              the compiler is free to vectorize.
+ *
+ * \param       expression_:  Expression to evaluate.
+ * \param       destination_: First of the `expression_.length()` elements to overwrite.
+ *
+ * \note        Every element of the result only depends on the elements at the same index in the
+ *              operands, so `destination_` may be one of the vectors read by the expression.
+ *************************************************************************************************/
+template<vector_expression ExpressionType, typename ItemType>
+inline void
+evaluate_expression(const ExpressionType& expression_, ItemType* destination_)
+{
+    const std::size_t length = expression_.length();
+    for(std::size_t i = 0; i < length; i++)
+    {
+        destination_[i] = static_cast<ItemType>(expression_[i]);
+    }
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Evaluate an element of an expression in `SumType` instead of the value types of its
+ *              nodes: the elements of the vectors and the scalars are widened before any
+ *              operation, so that integer expressions summed in 64 bits cannot overflow in 32.
+ *************************************************************************************************/
+template<typename SumType, typename ItemType>
+constexpr SumType
+widened_element(const expression_leaf<ItemType>& node_, std::size_t index_) noexcept
+{
+    return static_cast<SumType>(node_[index_]);
+}
+
+template<typename SumType, typename ItemType>
+constexpr SumType
+widened_element(const expression_scalar<ItemType>& node_, std::size_t index_) noexcept
+{
+    return static_cast<SumType>(node_[index_]);
+}
+
+template<typename SumType, typename OperationType, typename OperandType>
+constexpr SumType
+widened_element(const expression_unary<OperationType, OperandType>& node_, std::size_t index_)
+{
+    return static_cast<SumType>(OperationType{}(widened_element<SumType>(node_.operand(), index_)));
+}
+
+template<typename SumType, typename OperationType, typename LhsType, typename RhsType>
+constexpr SumType
+widened_element(const expression_binary<OperationType, LhsType, RhsType>& node_,
+                std::size_t                                             index_)
+{
+    return static_cast<SumType>(OperationType{}(widened_element<SumType>(node_.lhs(), index_),
+                                                widened_element<SumType>(node_.rhs(), index_)));
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Sum the elements of a vector or an expression, without materializing it.
+ *              Plain vectors and products of two vectors of the same type are forwarded to the
+ *              `pel::simd` kernels. Other expressions are evaluated and summed in a single pass,
+ *              using independent accumulators.
+ *
+ * \note        Arithmetic expressions are evaluated in the sum type, like the `pel::simd` kernels
+ *              do, so the result does not depend on the shape of the expression: with `int`
+ *              vectors, `sum(a * b)` and `sum(a * b + 0)` both compute the products in 64 bits.
+ *************************************************************************************************/
+template<expression_operand OperandType>
+inline expression_sum_t<OperandType>
+sum(const OperandType& operand_)
+{
+    using NodeType = expression_node_t<OperandType>;
+    using ItemType = typename NodeType::ValueType;
+    using LeafType = expression_leaf<ItemType>;
+    using DotType  = expression_binary<std::multiplies<>, LeafType, LeafType>;
+    using SumType  = expression_sum_t<OperandType>;
+
+    const NodeType& node = make_expression(operand_);
+
+    if constexpr(std::is_same_v<NodeType, LeafType> && simd::arithmetic<ItemType>)
+    {
+        return simd::sum(node.data(), node.data() + node.length());
+    }
+    else if constexpr(std::is_same_v<NodeType, DotType> && simd::arithmetic<ItemType>)
+    {
+        return simd::dot(node.lhs().data(), node.lhs().data() + node.length(), node.rhs().data());
+    }
+    else
+    {
+        const std::size_t length  = node.length();
+        auto              element = [&node](std::size_t index_)
+        {
+            if constexpr(simd::arithmetic<ItemType>)
+            {
+                return widened_element<SumType>(node, index_);
+            }
+            else
+            {
+                return static_cast<SumType>(node[index_]);
+            }
+        };
+
+        SumType     accumulators[4] = {SumType{}, SumType{}, SumType{}, SumType{}};
+        std::size_t i               = 0;
+        for(; i + 4 <= length; i += 4)
+        {
+            accumulators[0] += element(i + 0);
+            accumulators[1] += element(i + 1);
+            accumulators[2] += element(i + 2);
+            accumulators[3] += element(i + 3);
+        }
+        for(; i < length; i++)
+        {
+            accumulators[0] += element(i);
+        }
+
+        return (accumulators[0] + accumulators[1]) + (accumulators[2] + accumulators[3]);
+    }
+}
+
+
+/*************************************************************************************************/
+/* VECTOR MEMBERS ------------------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Expression constructor for the vector class.
+ *              Evaluates a lazy element-wise expression directly into the new vector's storage.
+ *
+ * \param       expression_: Expression to evaluate, such as `a + b * c`.
+ * \param       alloc_:      Allocator to use for all memory allocations
+ *              [defaults : AllocatorType{}]
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+template<vector_expression ExpressionType>
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::vector(
+  const ExpressionType& expression_,
+  const AllocatorType&  alloc_)
+: container_base{alloc_}
+{
+    const SizeType count = expression_.length();
+    vector_constructor(count);
+
+    ItemType* destination = data();
+    SizeType  constructed = 0;
+    try
+    {
+        for(; constructed < count; constructed++)
+        {
+            AllocatorTraits::construct(m_allocator,
+                                       destination + constructed,
+                                       static_cast<ItemType>(expression_[constructed]));
+        }
+    }
+    catch(...)
+    {
+        add_size(constructed);
+        vector_constructor(0);
+        throw;
+    }
+
+    add_size(count);
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Expression assignment operator for the vector class.
+ *              Evaluates a lazy element-wise expression in a single pass, without temporaries.
+ *
+ * \param       expression_: Expression to evaluate, such as `a + b * c`.
+ *
+ * \note        The expression may read this vector. When the length does not change, the elements
+ *              are overwritten in place; otherwise, the expression is evaluated into new storage
+ *              before the current one is released.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+template<vector_expression ExpressionType>
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>&
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::operator=(
+  const ExpressionType& expression_)
+{
+    if(expression_.length() == length())
+    {
+        evaluate_expression(expression_, data());
+    }
+    else
+    {
+        *this = vector{expression_, get_allocator()};
+    }
+    return *this;
+}
+
+}        // namespace pel
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,130 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./vector.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+
+namespace pel
+{
+/**
+ **************************************************************************************************
+ * \brief       Layout used when formatting the elements of a container as text.
+ *
+ *              The default options give the layout of `operator<<`: a capacity and length header,
+ *              then every element on its own line. For example, a comma-separated list between
+ *              brackets is obtained with:
+ *              `{.m_open = "[", .m_separator = ", ", .m_close = "]", .m_trailingSeparator = false,
+ *              .m_header = false}`
+ *
+ * \note        The member `vector::to_string()` and `operator<<` still go through a
+ *              `std::ostringstream`: only `pel::to_string` and `pel::format_to` avoid it.
+ *************************************************************************************************/
+struct format_options
+{
+    std::string_view m_open      = "";          //!< Written before the first element.
+    std::string_view m_separator = "\n";        //!< Written between two elements.
+    std::string_view m_close     = "";          //!< Written after the last element.
+
+    bool m_trailingSeparator = true;        //!< Also write the separator after the last element.
+    bool m_header            = true;        //!< Start with the capacity and length.
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Types formatted with `std::to_chars`, without going through a stream.
+ *************************************************************************************************/
+template<typename ItemType>
+concept to_chars_formattable = std::is_arithmetic_v<ItemType>;
+
+/**
+ **************************************************************************************************
+ * \brief       Maximum number of characters written when formatting a `to_chars_formattable`
+ *              value.
+ *************************************************************************************************/
+template<to_chars_formattable ItemType>
+inline constexpr std::size_t formatted_size_v =
+  std::is_floating_point_v<ItemType> ? 64 : std::numeric_limits<ItemType>::digits10 + 3;
+
+/** Size of the buffer in which elements are formatted before being handed to the output. */
+inline constexpr std::size_t format_buffer_size = 4096;
+
+
+/*************************************************************************************************/
+/* Formatting ---------------------------------------------------------------------------------- */
+template<to_chars_formattable ItemType>
+[[nodiscard]] char*
+format_element(char* first_, char* last_, const ItemType& value_) noexcept;
+
+template<typename ItemType>
+[[nodiscard]] std::size_t
+formatted_size_hint(std::size_t length_, const format_options& options_) noexcept;
+
+template<typename ItemType, typename SinkFunction>
+void
+format_range(const ItemType*       first_,
+             const ItemType*       last_,
+             std::size_t           capacity_,
+             const format_options& options_,
+             SinkFunction&&        sink_);
+
+
+/*************************************************************************************************/
+/* Vectors ------------------------------------------------------------------------------------- */
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+[[nodiscard]] std::string
+to_string(const vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>& vector_,
+          const format_options&                                                 options_ = {});
+
+template<typename OutputIterator,
+         typename ItemType,
+         typename AllocatorType,
+         typename GrowthPolicy,
+         typename Instrumentation>
+OutputIterator
+format_to(OutputIterator                                                        out_,
+          const vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>& vector_,
+          const format_options&                                                 options_ = {});
+
+}        // namespace pel
+
+
+#include "./vector_format.inl"
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
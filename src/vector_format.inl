@@ -0,0 +1,289 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./vector_format.hpp"
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* FORMATTING ---------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Format an arithmetic value in a character buffer.
+ *              Character types are written as characters and booleans as `0` or `1`, like
+ *              `operator<<` does. Other values use `std::to_chars`, which does not depend on the
+ *              locale; floating point values are written with their shortest exact representation.
+ *
+ * \param       first_: Start of the buffer.
+ * \param       last_:  End of the buffer, at least `formatted_size_v<ItemType>` after `first_`.
+ * \param       value_: Value to format.
+ *
+ * \retval      char*: End of the formatted value.
+ *************************************************************************************************/
+template<to_chars_formattable ItemType>
+[[nodiscard]] inline char*
+format_element(char* first_, char* last_, const ItemType& value_) noexcept
+{
+    if constexpr(std::is_same_v<ItemType, char> || std::is_same_v<ItemType, signed char>
+                 || std::is_same_v<ItemType, unsigned char>)
+    {
+        *first_ = static_cast<char>(value_);
+        return first_ + 1;
+    }
+    else if constexpr(std::is_same_v<ItemType, bool>)
+    {
+        *first_ = value_ ? '1' : '0';
+        return first_ + 1;
+    }
+    else
+    {
+        return std::to_chars(first_, last_, value_).ptr;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Estimate the number of characters needed to format `length_` elements.
+ *              Exact upper bound for `to_chars_formattable` types, rough guess for the others.
+ *************************************************************************************************/
+template<typename ItemType>
+[[nodiscard]] inline std::size_t
+formatted_size_hint(std::size_t length_, const format_options& options_) noexcept
+{
+    std::size_t elementSize = 16;
+    if constexpr(to_chars_formattable<ItemType>)
+    {
+        elementSize = formatted_size_v<ItemType>;
+    }
+
+    const std::size_t headerSize = options_.m_header ? 64 : 0;
+    return headerSize + options_.m_open.size() + options_.m_close.size()
+           + length_ * (elementSize + options_.m_separator.size());
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Format a range of elements as text.
+ *
+ *              Elements are formatted in a fixed-size buffer, which is handed to `sink_` as a
+ *              `std::string_view` every time it is full. The whole text is never materialized.
+ *
+ * \param       first_:    First element to format.
+ * \param       last_:     End of the elements to format.
+ * \param       capacity_: Capacity of the container, written in the header.
+ * \param       options_:  Layout of the text.
+ * \param       sink_:     Function called with consecutive parts of the text.
+ *
+ * \note        Arithmetic types are formatted with `std::to_chars`. Types convertible to
+ *              `std::string_view` are copied as-is. Other types go through `operator<<`.
+ *************************************************************************************************/
+template<typename ItemType, typename SinkFunction>
+void
+format_range(const ItemType*       first_,
+             const ItemType*       last_,
+             std::size_t           capacity_,
+             const format_options& options_,
+             SinkFunction&&        sink_)
+{
+    constexpr bool needsStream = !to_chars_formattable<ItemType>
+                                 && !std::is_convertible_v<const ItemType&, std::string_view>;
+    using StreamType = std::conditional_t<needsStream, std::ostringstream, std::nullptr_t>;
+
+    std::array<char, format_buffer_size> buffer;
+    char*                                position  = buffer.data();
+    char* const                          bufferEnd = buffer.data() + buffer.size();
+
+    auto flush = [&]()
+    {
+        if(position != buffer.data())
+        {
+            sink_(std::string_view(buffer.data(), position));
+            position = buffer.data();
+        }
+    };
+    auto write = [&](std::string_view text_)
+    {
+        if(text_.size() > static_cast<std::size_t>(bufferEnd - position))
+        {
+            flush();
+            if(text_.size() > buffer.size())
+            {
+                sink_(text_);
+                return;
+            }
+        }
+        position = std::copy(text_.begin(), text_.end(), position);
+    };
+
+    if(options_.m_header)
+    {
+        constexpr std::size_t headerSize = 2 * formatted_size_v<std::size_t> + 32;
+        if(static_cast<std::size_t>(bufferEnd - position) < headerSize)
+        {
+            flush();
+        }
+        write("Capacity : [");
+        position = format_element(position, bufferEnd, capacity_);
+        write("]   |   Length: [");
+        position = format_element(position, bufferEnd, static_cast<std::size_t>(last_ - first_));
+        write("]\n");
+    }
+
+    write(options_.m_open);
+
+    [[maybe_unused]] StreamType stream{};
+    for(const ItemType* element = first_; element != last_; ++element)
+    {
+        if constexpr(to_chars_formattable<ItemType>)
+        {
+            /* Fast path: a single check makes room for both the separator and the element */
+            const std::size_t separatorSize = (element != first_) ? options_.m_separator.size() : 0;
+            const std::size_t requiredSize  = separatorSize + formatted_size_v<ItemType>;
+            if(requiredSize <= buffer.size())
+            {
+                if(static_cast<std::size_t>(bufferEnd - position) < requiredSize)
+                {
+                    flush();
+                }
+                position = std::copy_n(options_.m_separator.data(), separatorSize, position);
+                position = format_element(position, bufferEnd, *element);
+                continue;
+            }
+        }
+
+        if(element != first_)
+        {
+            write(options_.m_separator);
+        }
+
+        if constexpr(to_chars_formattable<ItemType>)
+        {
+            if(static_cast<std::size_t>(bufferEnd - position) < formatted_size_v<ItemType>)
+            {
+                flush();
+            }
+            position = format_element(position, bufferEnd, *element);
+        }
+        else if constexpr(std::is_convertible_v<const ItemType&, std::string_view>)
+        {
+            write(std::string_view(*element));
+        }
+        else
+        {
+            stream.str(std::string{});
+            stream << *element;
+            write(stream.view());
+        }
+    }
+
+    if(options_.m_trailingSeparator && first_ != last_)
+    {
+        write(options_.m_separator);
+    }
+    write(options_.m_close);
+
+    flush();
+}
+
+
+/*************************************************************************************************/
+/* VECTORS ------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Convert the content of a vector to a string, with a custom layout.
+ *
+ * \param       vector_:  Vector to format.
+ * \param       options_: Layout of the text (separators, brackets, header).
+ *              [defaults : format_options{}, the layout of `operator<<`]
+ *
+ * \retval      A string containing all the elements converted to a string.
+ *
+ * \note        The string is allocated once, from an estimate of its final size.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+[[nodiscard]] std::string
+to_string(const vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>& vector_,
+          const format_options&                                                 options_)
+{
+    std::string result;
+    result.reserve(formatted_size_hint<ItemType>(vector_.length(), options_));
+
+    format_range(vector_.data(),
+                 vector_.data() + vector_.length(),
+                 vector_.capacity(),
+                 options_,
+                 [&](std::string_view text_)
+                 {
+                     result.append(text_);
+                 });
+    return result;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Write the content of a vector as text to an output iterator.
+ *              The text is produced in small blocks, and is never stored as a whole.
+ *
+ * \param       out_:     Output iterator receiving the characters.
+ * \param       vector_:  Vector to format.
+ * \param       options_: Layout of the text (separators, brackets, header).
+ *              [defaults : format_options{}, the layout of `operator<<`]
+ *
+ * \retval      OutputIterator: Iterator past the last character written.
+ *************************************************************************************************/
+template<typename OutputIterator,
+         typename ItemType,
+         typename AllocatorType,
+         typename GrowthPolicy,
+         typename Instrumentation>
+OutputIterator
+format_to(OutputIterator                                                        out_,
+          const vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>& vector_,
+          const format_options&                                                 options_)
+{
+    format_range(vector_.data(),
+                 vector_.data() + vector_.length(),
+                 vector_.capacity(),
+                 options_,
+                 [&](std::string_view text_)
+                 {
+                     out_ = std::copy(text_.begin(), text_.end(), out_);
+                 });
+
+    return out_;
+}
+
+}        // namespace pel
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
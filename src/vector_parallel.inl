@@ -0,0 +1,135 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./vector_parallel.hpp"
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS -------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Parallel generator-taking constructor for the vector class.
+ *              Splits the `length_` items in chunks of at least `vector_parallel_grain`
+ *              elements, each generated on its own thread.
+ *
+ * \param       parallel_t: Tag selecting this overload (`pel::parallel`).
+ * \param       length_ :    Number of elements to create
+ * \param       generator_ : Callable returning a value convertible to `ItemType` from the index of
+ *                           the element to create. Called concurrently from several threads.
+ * \param       alloc_:      Allocator to use for all memory allocations
+ *              [defaults : AllocatorType{}]
+ *
+ * \throws      Rethrows the first exception thrown by the generator, once all threads are done.
+ *              All the elements already created are then destroyed.
+ *
+ * \note        The allocator's `construct` is also called concurrently.
+ *************************************************************************************************/
+template<typename ItemType, typename AllocatorType, typename GrowthPolicy, typename Instrumentation>
+template<typename GeneratorType>
+    requires indexed_generator<const GeneratorType, ItemType>
+vector<ItemType, AllocatorType, GrowthPolicy, Instrumentation>::vector(
+  parallel_t,
+  SizeType             length_,
+  const GeneratorType& generator_,
+  const AllocatorType& alloc_)
+: container_base{alloc_}
+{
+    struct chunk_state
+    {
+        SizeType           m_constructed = 0;
+        std::exception_ptr m_error;
+    };
+
+    vector_constructor(length_);
+
+    const SizeType hardwareThreads = std::max<SizeType>(std::thread::hardware_concurrency(), 1);
+    const SizeType chunkCount =
+      std::clamp<SizeType>(length_ / vector_parallel_grain, 1, hardwareThreads);
+    const SizeType chunkLength = (length_ + chunkCount - 1) / chunkCount;
+    ItemType*      first       = begin().ptr();
+
+    auto chunks        = std::make_unique<chunk_state[]>(chunkCount);
+    auto generateChunk = [&](SizeType chunk_) noexcept
+    {
+        const SizeType chunkBegin = std::min(length_, chunk_ * chunkLength);
+        const SizeType chunkEnd   = std::min(length_, chunkBegin + chunkLength);
+
+        SizeType i = chunkBegin;
+        try
+        {
+            for(; i < chunkEnd; ++i)
+            {
+                AllocatorTraits::construct(m_allocator, first + i, std::invoke(generator_, i));
+            }
+        }
+        catch(...)
+        {
+            chunks[chunk_].m_error = std::current_exception();
+        }
+        chunks[chunk_].m_constructed = i - chunkBegin;
+    };
+
+    {
+        auto workers = std::make_unique<std::jthread[]>(chunkCount - 1);
+        for(SizeType chunk = 1; chunk < chunkCount; ++chunk)
+        {
+            try
+            {
+                workers[chunk - 1] = std::jthread(generateChunk, chunk);
+            }
+            catch(const std::system_error&)
+            {
+                /* Could not start a thread: generate its chunk here instead */
+                generateChunk(chunk);
+            }
+        }
+        generateChunk(0);
+    }        // Workers are joined here
+
+    for(SizeType chunk = 0; chunk < chunkCount; ++chunk)
+    {
+        if(chunks[chunk].m_error != nullptr)
+        {
+            for(SizeType other = 0; other < chunkCount; ++other)
+            {
+                ItemType* chunkBegin = first + std::min(length_, other * chunkLength);
+                destroy_range(m_allocator, chunkBegin, chunkBegin + chunks[other].m_constructed);
+            }
+            vector_constructor(0);
+            std::rethrow_exception(chunks[chunk].m_error);
+        }
+    }
+
+    add_size(length_);
+}
+
+}        // namespace pel
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
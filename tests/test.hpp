@@ -0,0 +1,282 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <initializer_list>
+#include <iostream>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+
+namespace pel::test
+{
+/**
+ **************************************************************************************************
+ * \brief       Number of checks that failed since the start of the program.
+ *************************************************************************************************/
+inline std::size_t&
+failure_count() noexcept
+{
+    static std::size_t failures = 0;
+    return failures;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Report a failed check when its condition does not hold.
+ *
+ * \param       condition_:  Result of the checked expression.
+ * \param       expression_: Text of the checked expression.
+ * \param       file_:       File containing the check.
+ * \param       line_:       Line of the check.
+ *************************************************************************************************/
+inline void
+check(bool condition_, const char* expression_, const char* file_, int line_)
+{
+    if(!condition_)
+    {
+        std::cerr << file_ << ':' << line_ << ": check failed: " << expression_ << '\n';
+        failure_count()++;
+    }
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Run a test case, reporting any exception escaping it as a failure.
+ *
+ * \param       name_:     Name of the test case.
+ * \param       testCase_: Callable running the checks of the test case.
+ *************************************************************************************************/
+template<typename TestCaseType>
+inline void
+run(const char* name_, TestCaseType&& testCase_)
+{
+    const std::size_t failuresBefore = failure_count();
+    try
+    {
+        testCase_();
+    }
+    catch(const std::exception& exception_)
+    {
+        std::cerr << name_ << ": unexpected exception: " << exception_.what() << '\n';
+        failure_count()++;
+    }
+    catch(...)
+    {
+        std::cerr << name_ << ": unexpected exception\n";
+        failure_count()++;
+    }
+    std::cout << (failure_count() == failuresBefore ? "[ pass ] " : "[ FAIL ] ") << name_ << '\n';
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Check that a container holds exactly the given elements, in order.
+ *************************************************************************************************/
+template<typename ContainerType, typename ItemType>
+[[nodiscard]] inline bool
+holds(const ContainerType& container_, std::initializer_list<ItemType> expected_)
+{
+    return container_.length() == expected_.size()
+           && std::equal(expected_.begin(), expected_.end(), container_.begin());
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Element type counting its live instances, and whose copies and moves keep its
+ *              value, so that tests can detect leaked, doubly destroyed or moved-from elements.
+ *              Its string member makes it non trivially relocatable.
+ *************************************************************************************************/
+struct counted
+{
+    static inline std::ptrdiff_t s_live = 0;
+
+    int         m_value = 0;
+    std::string m_text  = "counted element";
+
+    counted() noexcept { s_live++; }
+    counted(int value_) : m_value{value_} { s_live++; }
+    counted(const counted& other_) : m_value{other_.m_value}, m_text{other_.m_text} { s_live++; }
+    counted(counted&& other_) noexcept
+    : m_value{other_.m_value}, m_text{std::move(other_.m_text)}
+    {
+        s_live++;
+    }
+    counted& operator=(const counted&) = default;
+    counted& operator=(counted&&) noexcept = default;
+    ~counted() { s_live--; }
+
+    friend bool operator==(const counted& lhs_, int rhs_) noexcept { return lhs_.m_value == rhs_; }
+    friend bool operator==(const counted& lhs_, const counted& rhs_) noexcept
+    {
+        return lhs_.m_value == rhs_.m_value;
+    }
+    friend std::ostream& operator<<(std::ostream& os_, const counted& item_)
+    {
+        return os_ << item_.m_value;
+    }
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Element type whose construction throws for negative values, or once a given number
+ *              of constructions succeeded, so that tests can check what a container is left with
+ *              when an element can't be built. Copies are constructions too.
+ *************************************************************************************************/
+struct throwing_item
+{
+    /** Constructions that succeed before the next one throws, or -1 for no limit. */
+    static inline int s_successes = -1;
+
+    int m_value = 0;
+
+    throwing_item(int value_ = 0) : m_value{value_}
+    {
+        if(value_ < 0 || (s_successes >= 0 && s_successes-- == 0))
+        {
+            throw std::runtime_error{"construction failure"};
+        }
+    }
+    throwing_item(const throwing_item& other_) : throwing_item{other_.m_value} {}
+    throwing_item& operator=(const throwing_item&) = default;
+
+    friend bool operator==(const throwing_item& lhs_, int rhs_) noexcept
+    {
+        return lhs_.m_value == rhs_;
+    }
+    friend std::ostream& operator<<(std::ostream& os_, const throwing_item& item_)
+    {
+        return os_ << item_.m_value;
+    }
+};
+
+/** Long enough to never fit in the small string buffer, so that its characters are allocated. */
+inline const std::string longText =
+  "an element long enough to never fit in the small string buffer";
+
+
+/**
+ **************************************************************************************************
+ * \brief       Memory resource counting the bytes it handed out and did not get back yet.
+ *              Releasing memory it did not hand out is reported as a failed check.
+ *************************************************************************************************/
+class tracking_resource final : public std::pmr::memory_resource
+{
+public:
+    [[nodiscard]] std::ptrdiff_t outstanding() const noexcept { return m_outstanding; }
+
+private:
+    void* do_allocate(std::size_t bytes_, std::size_t alignment_) override
+    {
+        m_outstanding += static_cast<std::ptrdiff_t>(bytes_);
+        return std::pmr::new_delete_resource()->allocate(bytes_, alignment_);
+    }
+
+    void do_deallocate(void* ptr_, std::size_t bytes_, std::size_t alignment_) override
+    {
+        m_outstanding -= static_cast<std::ptrdiff_t>(bytes_);
+        check(m_outstanding >= 0, "memory was released by its own resource", __FILE__, __LINE__);
+        std::pmr::new_delete_resource()->deallocate(ptr_, bytes_, alignment_);
+    }
+
+    [[nodiscard]] bool do_is_equal(const memory_resource& other_) const noexcept override
+    {
+        return this == &other_;
+    }
+
+    std::ptrdiff_t m_outstanding = 0;
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Evaluate an expression wrapped in a callable, discarding its result, if any.
+ *************************************************************************************************/
+template<typename ExpressionType>
+inline void
+evaluate(ExpressionType&& expression_)
+{
+    if constexpr(std::is_void_v<decltype(expression_())>)
+    {
+        expression_();
+    }
+    else
+    {
+        static_cast<void>(expression_());
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Exit code of a test program: 0 when every check passed.
+ *************************************************************************************************/
+[[nodiscard]] inline int
+exit_code() noexcept
+{
+    return failure_count() == 0 ? 0 : 1;
+}
+
+}        // namespace pel::test
+
+
+/**
+ **************************************************************************************************
+ * \brief       Check that an expression is true.
+ *************************************************************************************************/
+#define PEL_CHECK(expression_)                                                                    \
+    ::pel::test::check(!!(expression_), #expression_, __FILE__, __LINE__)
+
+/**
+ **************************************************************************************************
+ * \brief       Check that evaluating an expression throws an exception of a given type.
+ *************************************************************************************************/
+#define PEL_CHECK_THROWS(expression_, ExceptionType_)                                             \
+    do                                                                                            \
+    {                                                                                             \
+        bool pelThrown = false;                                                                   \
+        try                                                                                       \
+        {                                                                                         \
+            ::pel::test::evaluate([&] { return expression_; });                                   \
+        }                                                                                         \
+        catch(const ExceptionType_&)                                                              \
+        {                                                                                         \
+            pelThrown = true;                                                                     \
+        }                                                                                         \
+        ::pel::test::check(                                                                       \
+          pelThrown, #expression_ " throws " #ExceptionType_, __FILE__, __LINE__);                \
+    } while(false)
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
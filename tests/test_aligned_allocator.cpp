@@ -0,0 +1,155 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./test.hpp"
+#include "../src/aligned_allocator.hpp"
+#include "../src/vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+
+namespace
+{
+static_assert(std::is_same_v<pel::default_allocator_t<float>, pel::aligned_allocator<float>>);
+static_assert(std::is_same_v<pel::default_allocator_t<std::uint8_t>,
+                             pel::aligned_allocator<std::uint8_t>>);
+static_assert(std::is_same_v<pel::default_allocator_t<bool>, std::allocator<bool>>);
+static_assert(
+  std::is_same_v<pel::default_allocator_t<std::string>, std::allocator<std::string>>);
+
+static_assert(pel::aligned_allocator<float>::capacity_granularity == 16);
+static_assert(pel::aligned_allocator<double>::capacity_granularity == 8);
+static_assert(pel::aligned_allocator<char>::capacity_granularity == 64);
+
+template<typename ItemType>
+bool
+is_aligned(const pel::vector<ItemType>& vec_)
+{
+    return reinterpret_cast<std::uintptr_t>(vec_.data()) % pel::simd_alignment == 0;
+}
+
+template<typename ItemType>
+bool
+is_whole_registers(const pel::vector<ItemType>& vec_)
+{
+    return vec_.capacity() % pel::aligned_allocator<ItemType>::capacity_granularity == 0;
+}
+
+
+/*------------------------------------*/
+/* Alignment */
+
+template<typename ItemType>
+void
+testDataIsAligned()
+{
+    pel::vector<ItemType> vec{ItemType{1}, ItemType{2}, ItemType{3}};
+    PEL_CHECK(is_aligned(vec));
+
+    vec.reserve(100);
+    PEL_CHECK(is_aligned(vec));
+
+    for(std::size_t i = 0; i < 1000; ++i)
+    {
+        vec.push_back(ItemType{4});
+        PEL_CHECK(is_aligned(vec));
+    }
+
+    vec.resize(7);
+    vec.shrink_to_fit();
+    PEL_CHECK(is_aligned(vec));
+
+    const pel::vector<ItemType> copy{vec};
+    PEL_CHECK(is_aligned(copy));
+}
+
+
+/*------------------------------------*/
+/* Capacity granularity */
+
+template<typename ItemType>
+void
+testCapacityIsRoundedToWholeRegisters()
+{
+    constexpr std::size_t granularity = pel::aligned_allocator<ItemType>::capacity_granularity;
+
+    pel::vector<ItemType> vec;
+    vec.reserve(1);
+    PEL_CHECK(vec.capacity() == granularity);
+
+    vec.reserve(granularity + 1);
+    PEL_CHECK(vec.capacity() == 2 * granularity);
+    PEL_CHECK(vec.is_empty());
+
+    /* Asking for the capacity already held keeps the allocation */
+    const ItemType* const data = vec.data();
+    vec.reserve(2 * granularity - 1);
+    PEL_CHECK(vec.capacity() == 2 * granularity);
+    PEL_CHECK(vec.data() == data);
+
+    std::size_t oldCapacity = vec.capacity();
+    for(std::size_t i = 0; i < 10 * granularity; ++i)
+    {
+        vec.push_back(ItemType{1});
+        if(vec.capacity() != oldCapacity)
+        {
+            PEL_CHECK(is_whole_registers(vec));
+            oldCapacity = vec.capacity();
+        }
+    }
+
+    vec.resize(3);
+    vec.shrink_to_fit();
+    PEL_CHECK(vec.capacity() == granularity);
+    PEL_CHECK(vec.length() == 3);
+}
+
+}        // namespace
+
+
+int
+main()
+{
+    pel::test::run("data is aligned (float)", testDataIsAligned<float>);
+    pel::test::run("data is aligned (double)", testDataIsAligned<double>);
+    pel::test::run("data is aligned (int)", testDataIsAligned<int>);
+    pel::test::run("data is aligned (char)", testDataIsAligned<char>);
+    pel::test::run("capacity is rounded to whole registers (float)",
+                   testCapacityIsRoundedToWholeRegisters<float>);
+    pel::test::run("capacity is rounded to whole registers (double)",
+                   testCapacityIsRoundedToWholeRegisters<double>);
+    pel::test::run("capacity is rounded to whole registers (char)",
+                   testCapacityIsRoundedToWholeRegisters<char>);
+    return pel::test::exit_code();
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,261 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./test.hpp"
+#include "../src/caching_allocator.hpp"
+#include "../src/vector.hpp"
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+constexpr std::size_t maxBlock = pel::buffer_cache::max_block_size;
+
+using CachedVector = pel::vector<int, pel::caching_allocator<int>>;
+
+/** Built before the thread cache and the depot, and destroyed after them at exit. */
+CachedVector staticVector;
+
+/** Run a function on a new thread, whose cache is flushed to the depot when it exits. */
+template<typename FunctionType>
+void
+runOnOtherThread(FunctionType function_)
+{
+    std::thread thread{function_};
+    thread.join();
+}
+
+
+/*------------------------------------*/
+/* Counters */
+
+void
+testThreadCacheCounters()
+{
+    pel::buffer_cache::reset_statistics();
+
+    void* const first = pel::buffer_cache::allocate(100);
+    PEL_CHECK(pel::buffer_cache::statistics().m_misses == 1);
+
+    /* Released buffers are served again to the same size class */
+    pel::buffer_cache::deallocate(first, 100);
+    PEL_CHECK(pel::buffer_cache::thread_cache_bytes() == 128);
+    void* const second = pel::buffer_cache::allocate(120);
+    PEL_CHECK(second == first);
+    PEL_CHECK(pel::buffer_cache::statistics().m_hits == 1);
+    PEL_CHECK(pel::buffer_cache::thread_cache_bytes() == 0);
+
+    /* Buffers bigger than the largest size class bypass the cache */
+    void* const big = pel::buffer_cache::allocate(maxBlock + 1);
+    PEL_CHECK(pel::buffer_cache::statistics().m_uncached == 1);
+    pel::buffer_cache::deallocate(big, maxBlock + 1);
+    PEL_CHECK(pel::buffer_cache::thread_cache_bytes() == 0);
+
+    pel::buffer_cache::deallocate(second, 120);
+
+    const pel::cache_statistics statistics = pel::buffer_cache::statistics();
+    PEL_CHECK(statistics.m_hits == 1);
+    PEL_CHECK(statistics.m_misses == 1);
+    PEL_CHECK(statistics.m_depotHits == 0);
+    PEL_CHECK(statistics.m_depotPushes == 0);
+    PEL_CHECK(statistics.m_frees == 0);
+}
+
+void
+testVectorsReuseCachedBuffers()
+{
+    const int* released = nullptr;
+    {
+        CachedVector vec(1'000, 1);
+        released = vec.data();
+    }
+
+    pel::buffer_cache::reset_statistics();
+    const CachedVector vec(1'000, 2);
+    PEL_CHECK(vec.data() == released);
+    PEL_CHECK(pel::buffer_cache::statistics().m_hits == 1);
+    PEL_CHECK(pel::buffer_cache::statistics().m_misses == 0);
+}
+
+
+/*------------------------------------*/
+/* Sharing buffers between threads */
+
+void
+testBuffersReleasedByAnotherThreadComeBack()
+{
+    constexpr std::size_t bytes = 4096;
+
+    pel::buffer_cache::flush_thread_cache();
+    void* const block = pel::buffer_cache::allocate(bytes);
+
+    /* The other thread keeps the buffer in its own cache, then flushes it to the depot */
+    runOnOtherThread([block] { pel::buffer_cache::deallocate(block, bytes); });
+    PEL_CHECK(pel::buffer_cache::depot_bytes() >= bytes);
+
+    pel::buffer_cache::reset_statistics();
+    void* const reused = pel::buffer_cache::allocate(bytes);
+    PEL_CHECK(reused == block);
+    PEL_CHECK(pel::buffer_cache::statistics().m_depotHits == 1);
+    PEL_CHECK(pel::buffer_cache::statistics().m_misses == 0);
+    pel::buffer_cache::deallocate(reused, bytes);
+}
+
+
+/** Vector built before its thread's cache, so that it is destroyed after it. */
+struct late_release
+{
+    CachedVector m_vector;
+
+    ~late_release()
+    {
+        /* The cache of the thread is gone: buffers go to the depot, or to operator delete */
+        m_vector.push_back(1);
+        m_vector.shrink_to_fit();
+
+        PEL_CHECK(pel::buffer_cache::thread_cache_bytes() == 0);
+        PEL_CHECK(pel::buffer_cache::statistics().m_hits == 0);
+        PEL_CHECK(pel::buffer_cache::statistics().m_frees == 0);
+        pel::buffer_cache::reset_statistics();
+        pel::buffer_cache::flush_thread_cache();
+    }
+};
+
+void
+testBuffersOutliveTheThreadCache()
+{
+    staticVector.resize(1'000, 1);
+
+    pel::buffer_cache::flush_thread_cache();
+    const std::size_t depotBytes = pel::buffer_cache::depot_bytes();
+    runOnOtherThread(
+      []
+      {
+          thread_local late_release holder;
+          holder.m_vector.resize(100'000, 1);
+
+          /* Leave a hit in the statistics of the cache, which must not be read once it is gone */
+          pel::buffer_cache::deallocate(pel::buffer_cache::allocate(64), 64);
+          pel::buffer_cache::deallocate(pel::buffer_cache::allocate(64), 64);
+          PEL_CHECK(pel::buffer_cache::statistics().m_hits == 1);
+      });
+    PEL_CHECK(pel::buffer_cache::depot_bytes() > depotBytes);
+}
+
+
+/*------------------------------------*/
+/* Memory bounds */
+
+void
+testCachedMemoryIsBounded()
+{
+    runOnOtherThread(
+      []
+      {
+          constexpr std::size_t cacheBlocks = pel::buffer_cache::thread_cache_limit / maxBlock;
+          constexpr std::size_t depotBlocks = pel::buffer_cache::depot_limit / maxBlock;
+          constexpr std::size_t blockCount  = cacheBlocks + depotBlocks + 8;
+
+          std::vector<void*> blocks;
+          for(std::size_t i = 0; i < blockCount; i++)
+          {
+              blocks.push_back(pel::buffer_cache::allocate(maxBlock));
+          }
+
+          pel::buffer_cache::reset_statistics();
+          for(void* block : blocks)
+          {
+              pel::buffer_cache::deallocate(block, maxBlock);
+          }
+
+          /* The thread cache fills up first, then the depot, then buffers are freed */
+          const pel::cache_statistics statistics = pel::buffer_cache::statistics();
+          PEL_CHECK(pel::buffer_cache::thread_cache_bytes() == cacheBlocks * maxBlock);
+          PEL_CHECK(statistics.m_depotPushes <= depotBlocks);
+          PEL_CHECK(statistics.m_depotPushes + statistics.m_frees == blockCount - cacheBlocks);
+          PEL_CHECK(statistics.m_frees >= 8);
+          PEL_CHECK(pel::buffer_cache::depot_bytes() <= pel::buffer_cache::depot_limit);
+      });
+    PEL_CHECK(pel::buffer_cache::depot_bytes() <= pel::buffer_cache::depot_limit);
+}
+
+void
+testDepotLimitHoldsAcrossSizeClasses()
+{
+    /* Every thread releases buffers of its own size class to the depot at the same time */
+    std::vector<std::thread> threads;
+    for(std::size_t t = 0; t < 8; t++)
+    {
+        threads.emplace_back(
+          [t]
+          {
+              /* Together, the threads release twice as much memory as the depot can hold */
+              const std::size_t bytes = maxBlock >> (t % 4);
+              const std::size_t count =
+                (pel::buffer_cache::thread_cache_limit + pel::buffer_cache::depot_limit / 4)
+                / bytes;
+
+              std::vector<void*> blocks;
+              for(std::size_t i = 0; i < count; i++)
+              {
+                  blocks.push_back(pel::buffer_cache::allocate(bytes));
+              }
+              for(void* block : blocks)
+              {
+                  pel::buffer_cache::deallocate(block, bytes);
+              }
+          });
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    PEL_CHECK(pel::buffer_cache::depot_bytes() <= pel::buffer_cache::depot_limit);
+}
+
+}        // namespace
+
+
+int
+main()
+{
+    pel::test::run("thread cache counters", testThreadCacheCounters);
+    pel::test::run("vectors reuse cached buffers", testVectorsReuseCachedBuffers);
+    pel::test::run("buffers released by another thread come back",
+                   testBuffersReleasedByAnotherThreadComeBack);
+    pel::test::run("buffers outlive the thread cache", testBuffersOutliveTheThreadCache);
+    pel::test::run("cached memory is bounded", testCachedMemoryIsBounded);
+    pel::test::run("depot limit holds across size classes", testDepotLimitHoldsAcrossSizeClasses);
+    return pel::test::exit_code();
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,320 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./test.hpp"
+#include "../src/chunked_vector.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+using pel::test::counted;
+using pel::test::tracking_resource;
+
+/** Small blocks, so that a few elements already span several blocks. */
+constexpr std::size_t blockSize = 8;
+
+template<typename ItemType>
+using SmallBlocks = pel::chunked_vector<ItemType, std::allocator<ItemType>, blockSize>;
+
+template<typename ItemType>
+using PmrBlocks =
+  pel::chunked_vector<ItemType, std::pmr::polymorphic_allocator<ItemType>, blockSize>;
+
+
+/*------------------------------------*/
+/* Stability and random access */
+
+void
+testReferencesStayValidWhileGrowing()
+{
+    SmallBlocks<int>        vec;
+    std::vector<const int*> addresses;
+
+    const int& first = vec.push_back(0);
+    const auto begin = vec.begin();
+    for(int i = 1; i < 1'000; i++)
+    {
+        addresses.push_back(&vec.emplace_back(i));
+    }
+
+    /* Nothing was moved: every reference, pointer and iterator still designates its element */
+    PEL_CHECK(&first == &vec[0]);
+    PEL_CHECK(first == 0);
+    PEL_CHECK(begin == vec.begin());
+    PEL_CHECK(*begin == 0);
+    for(std::size_t i = 0; i < addresses.size(); i++)
+    {
+        PEL_CHECK(addresses[i] == &vec[i + 1]);
+        PEL_CHECK(*addresses[i] == static_cast<int>(i + 1));
+    }
+}
+
+void
+testRandomAccessAcrossBlocks()
+{
+    SmallBlocks<int> vec;
+    for(int i = 0; i < 100; i++)
+    {
+        vec.push_back(i * 2);
+    }
+
+    /* Elements on both sides of every block boundary */
+    for(std::size_t i = blockSize - 1; i < vec.length(); i += blockSize)
+    {
+        PEL_CHECK(vec[i] == static_cast<int>(i * 2));
+        if(i + 1 < vec.length())
+        {
+            PEL_CHECK(vec[i + 1] == static_cast<int>((i + 1) * 2));
+        }
+    }
+    PEL_CHECK(vec.at(99) == 198);
+    PEL_CHECK_THROWS(vec.at(100), std::out_of_range);
+    PEL_CHECK(vec.front() == 0);
+    PEL_CHECK(vec.back() == 198);
+
+    /* Iterators jump across blocks in constant time too */
+    const auto it = vec.begin() + 37;
+    PEL_CHECK(*it == 74);
+    PEL_CHECK(it - vec.begin() == 37);
+    PEL_CHECK(std::distance(vec.begin(), vec.end()) == 100);
+
+    vec[blockSize] = -1;
+    PEL_CHECK(vec.at(blockSize) == -1);
+}
+
+void
+testBlocksAreSpans()
+{
+    SmallBlocks<int> vec;
+    for(int i = 0; i < 20; i++)
+    {
+        vec.push_back(i);
+    }
+
+    PEL_CHECK(vec.block_count() == 3);
+    PEL_CHECK(vec.block(0).size() == blockSize);
+    PEL_CHECK(vec.block(1).size() == blockSize);
+    PEL_CHECK(vec.block(2).size() == 4);
+    PEL_CHECK(vec.block(1).data() == &vec[blockSize]);
+    PEL_CHECK(vec.block(2)[3] == 19);
+
+    int expected = 0;
+    for(std::size_t b = 0; b < vec.block_count(); b++)
+    {
+        for(const int item : vec.block(b))
+        {
+            PEL_CHECK(item == expected++);
+        }
+    }
+    PEL_CHECK(expected == 20);
+
+    const SmallBlocks<int>& constVec = vec;
+    PEL_CHECK(constVec.block(2).size() == 4);
+}
+
+
+/*------------------------------------*/
+/* Removal and memory */
+
+void
+testPopClearAndShrink()
+{
+    {
+        SmallBlocks<counted> vec;
+        for(int i = 0; i < 20; i++)
+        {
+            vec.emplace_back(i);
+        }
+        PEL_CHECK(vec.capacity() == 3 * blockSize);
+
+        vec.pop_back();
+        PEL_CHECK(vec.length() == 19);
+        PEL_CHECK(vec.back() == 18);
+        PEL_CHECK(counted::s_live == 19);
+
+        for(int i = 0; i < 10; i++)
+        {
+            vec.pop_back();
+        }
+        PEL_CHECK(vec.block_count() == 2);
+        PEL_CHECK(vec.capacity() == 3 * blockSize);
+
+        /* Only the blocks holding elements are kept */
+        const counted* const kept = &vec[0];
+        vec.shrink_to_fit();
+        PEL_CHECK(vec.capacity() == 2 * blockSize);
+        PEL_CHECK(&vec[0] == kept);
+        PEL_CHECK(vec[8] == 8);
+
+        vec.clear();
+        PEL_CHECK(vec.is_empty());
+        PEL_CHECK(counted::s_live == 0);
+        PEL_CHECK(vec.capacity() == 2 * blockSize);
+        PEL_CHECK_THROWS(vec.pop_back(), std::length_error);
+
+        vec.shrink_to_fit();
+        PEL_CHECK(vec.capacity() == 0);
+
+        vec.reserve(20);
+        PEL_CHECK(vec.capacity() == 3 * blockSize);
+        vec.emplace_back(1);
+    }
+    PEL_CHECK(counted::s_live == 0);
+}
+
+
+/*------------------------------------*/
+/* Copies and moves */
+
+void
+testCopyAndMove()
+{
+    {
+        SmallBlocks<counted> source;
+        for(int i = 0; i < 20; i++)
+        {
+            source.emplace_back(i);
+        }
+
+        SmallBlocks<counted> copy{source};
+        PEL_CHECK(copy.length() == 20);
+        PEL_CHECK(&copy[0] != &source[0]);
+        PEL_CHECK(copy[19] == 19);
+        PEL_CHECK(counted::s_live == 40);
+
+        /* Moving takes the blocks: the elements keep their address */
+        const counted* const block = &source[10];
+        SmallBlocks<counted> moved{std::move(source)};
+        PEL_CHECK(&moved[10] == block);
+        PEL_CHECK(source.is_empty());
+        PEL_CHECK(counted::s_live == 40);
+
+        SmallBlocks<counted> assigned{1, 2};
+        assigned = copy;
+        PEL_CHECK(assigned.length() == 20);
+        PEL_CHECK(assigned[15] == 15);
+        assigned = std::move(moved);
+        PEL_CHECK(&assigned[10] == block);
+        PEL_CHECK(counted::s_live == 40);
+
+        const SmallBlocks<counted> filled(10, counted{7});
+        PEL_CHECK(filled.length() == 10 && filled[9] == 7);
+    }
+    PEL_CHECK(counted::s_live == 0);
+}
+
+void
+testMoveAssignmentFollowsTheAllocatorRules()
+{
+    static_assert(std::is_nothrow_move_assignable_v<SmallBlocks<counted>>);
+    static_assert(!std::is_nothrow_move_assignable_v<PmrBlocks<counted>>);
+
+    tracking_resource first;
+    tracking_resource second;
+    {
+        PmrBlocks<counted> source{{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}, &first};
+        const counted* const block = &source[9];
+
+        /* Equal allocators: the blocks are taken */
+        PmrBlocks<counted> same{&first};
+        same = std::move(source);
+        PEL_CHECK(&same[9] == block);
+        PEL_CHECK(source.is_empty() && source.capacity() == 0);
+
+        /* Unequal allocators: the elements are moved into blocks of the target's resource */
+        PmrBlocks<counted> other{{42}, &second};
+        other = std::move(same);
+        PEL_CHECK(other.length() == 10 && other[0] == 0 && other[9] == 9);
+        PEL_CHECK(&other[9] != block);
+        PEL_CHECK(other.get_allocator().resource() == &second);
+        PEL_CHECK(same.is_empty() && same.capacity() != 0);
+        PEL_CHECK(counted::s_live == 10);
+    }
+    PEL_CHECK(first.outstanding() == 0);
+    PEL_CHECK(second.outstanding() == 0);
+    PEL_CHECK(counted::s_live == 0);
+}
+
+void
+testCopyAssignmentAndSwapFollowTheAllocatorRules()
+{
+    tracking_resource first;
+    tracking_resource second;
+    {
+        PmrBlocks<counted> source{{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}, &first};
+
+        /* Copies are built in blocks of the target's resource */
+        PmrBlocks<counted> copy{{42}, &second};
+        copy = source;
+        PEL_CHECK(copy.length() == 10 && copy[0] == 0 && copy[9] == 9);
+        PEL_CHECK(copy.get_allocator().resource() == &second);
+        PEL_CHECK(source.length() == 10);
+        PEL_CHECK(counted::s_live == 20);
+
+        /* Equal allocators: the blocks are exchanged */
+        PmrBlocks<counted> other{{42}, &first};
+        const counted* const block = &source[9];
+        other.swap(source);
+        PEL_CHECK(other.length() == 10 && &other[9] == block);
+        PEL_CHECK(source.length() == 1 && source[0] == 42);
+        PEL_CHECK(other.get_allocator().resource() == &first);
+    }
+    PEL_CHECK(first.outstanding() == 0);
+    PEL_CHECK(second.outstanding() == 0);
+    PEL_CHECK(counted::s_live == 0);
+}
+
+}        // namespace
+
+
+int
+main()
+{
+    pel::test::run("references stay valid while growing", testReferencesStayValidWhileGrowing);
+    pel::test::run("random access across blocks", testRandomAccessAcrossBlocks);
+    pel::test::run("blocks are spans", testBlocksAreSpans);
+    pel::test::run("pop_back, clear and shrink_to_fit", testPopClearAndShrink);
+    pel::test::run("copy and move", testCopyAndMove);
+    pel::test::run("move assignment follows the allocator rules",
+                   testMoveAssignmentFollowsTheAllocatorRules);
+    pel::test::run("copy assignment and swap follow the allocator rules",
+                   testCopyAssignmentAndSwapFollowTheAllocatorRules);
+    pel::test::run("counted elements are all destroyed", [] { PEL_CHECK(counted::s_live == 0); });
+    return pel::test::exit_code();
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
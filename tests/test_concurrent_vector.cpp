@@ -0,0 +1,345 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./test.hpp"
+#include "../src/concurrent_vector.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+using pel::test::counted;
+using pel::test::longText;
+using pel::test::throwing_item;
+using pel::test::tracking_resource;
+
+/** Distinct text of each element appended by the writers. */
+std::string
+textOf(std::size_t value_)
+{
+    return "element #" + std::to_string(value_) + " of a concurrent vector";
+}
+
+
+/*------------------------------------*/
+/* Single thread */
+
+void
+testAppendsAreIterated()
+{
+    pel::concurrent_vector<counted, std::allocator<counted>, 4> vec;
+    for(int i = 0; i < 100; i++)
+    {
+        PEL_CHECK(vec.push_back(i) == i);
+    }
+
+    PEL_CHECK(vec.length() == 100);
+    PEL_CHECK(vec.published_length() == 100);
+    PEL_CHECK(vec.end() - vec.begin() == 100);
+
+    int expected = 0;
+    for(const counted& item : vec)
+    {
+        PEL_CHECK(item == expected++);
+    }
+    PEL_CHECK(expected == 100);
+
+    vec.clear();
+    PEL_CHECK(vec.published_length() == 0);
+    PEL_CHECK(vec.begin() == vec.end());
+    PEL_CHECK(counted::s_live == 0);
+}
+
+void
+testIterationStopsBeforeAFailedSlot()
+{
+    pel::concurrent_vector<throwing_item> vec;
+    throwing_item::s_successes = 2;
+
+    vec.emplace_back(0);
+    vec.emplace_back(1);
+    PEL_CHECK_THROWS(vec.emplace_back(2), std::runtime_error);
+    vec.emplace_back(3);
+
+    PEL_CHECK(vec.length() == 4);
+    PEL_CHECK(vec.published_length() == 2);
+    PEL_CHECK(!vec.is_published(2));
+    PEL_CHECK(vec.is_published(3));
+    PEL_CHECK_THROWS(vec.at(2), std::out_of_range);
+    PEL_CHECK(vec.at(3).m_value == 3);
+
+    int visited = 0;
+    for(const throwing_item& item : vec)
+    {
+        PEL_CHECK(item.m_value == visited++);
+    }
+    PEL_CHECK(visited == 2);
+}
+
+void
+testFailedGrowthIsNeverPublished()
+{
+    pel::concurrent_vector<throwing_item> vec;
+    vec.emplace_back(0);
+
+    throwing_item::s_successes = 1;
+    PEL_CHECK_THROWS(vec.grow_by(3), std::runtime_error);
+
+    PEL_CHECK(vec.length() == 4);
+    PEL_CHECK(vec.published_length() == 2);
+    PEL_CHECK(vec.is_published(1));
+    PEL_CHECK(!vec.is_published(2));
+    PEL_CHECK(!vec.is_published(3));
+
+    const throwing_item value{5};
+    throwing_item::s_successes = 0;
+    PEL_CHECK_THROWS(vec.grow_by(2, value), std::runtime_error);
+    PEL_CHECK(vec.length() == 6);
+    PEL_CHECK(!vec.is_published(4));
+    PEL_CHECK(!vec.is_published(5));
+}
+
+
+/** Memory resource failing every allocation past a budget. */
+class failing_resource final : public std::pmr::memory_resource
+{
+public:
+    /** Allocations that succeed before the next ones throw, or -1 for no limit. */
+    int m_allowed = -1;
+
+    [[nodiscard]] std::ptrdiff_t outstanding() const noexcept { return m_upstream.outstanding(); }
+
+private:
+    void* do_allocate(std::size_t bytes_, std::size_t alignment_) override
+    {
+        if(m_allowed == 0)
+        {
+            throw std::bad_alloc{};
+        }
+        if(m_allowed > 0)
+        {
+            m_allowed--;
+        }
+        return m_upstream.allocate(bytes_, alignment_);
+    }
+
+    void do_deallocate(void* ptr_, std::size_t bytes_, std::size_t alignment_) override
+    {
+        m_upstream.deallocate(ptr_, bytes_, alignment_);
+    }
+
+    [[nodiscard]] bool do_is_equal(const memory_resource& other_) const noexcept override
+    {
+        return this == &other_;
+    }
+
+    tracking_resource m_upstream;
+};
+
+void
+testFailedSegmentAllocationsAreNeverPublished()
+{
+    failing_resource resource;
+    {
+        pel::concurrent_vector<int, std::pmr::polymorphic_allocator<int>, 4> vec{&resource};
+        resource.m_allowed = 1;
+
+        /* Only the first segment can be allocated: creating the next one ahead of time fails
+         * silently, and the append needing it throws */
+        vec.push_back(0);
+        vec.push_back(1);
+        vec.push_back(2);
+        vec.push_back(3);
+        PEL_CHECK(vec.published_length() == 4);
+        PEL_CHECK_THROWS(vec.push_back(4), std::bad_alloc);
+        PEL_CHECK_THROWS(vec.grow_by(2), std::bad_alloc);
+
+        resource.m_allowed = -1;
+        vec.push_back(7);
+        PEL_CHECK(vec.length() == 8);
+        PEL_CHECK(vec.published_length() == 4);
+        for(std::size_t index = 4; index < 7; index++)
+        {
+            PEL_CHECK(!vec.is_published(index));
+        }
+        PEL_CHECK(vec.at(7) == 7);
+
+        /* Failing to create the next segment ahead of time does not fail the append */
+        resource.m_allowed = 0;
+        PEL_CHECK(vec.grow_by(2, 8) == 8);
+        PEL_CHECK(vec.at(8) == 8);
+        PEL_CHECK(vec.at(9) == 8);
+        PEL_CHECK(vec.capacity() == 12);
+    }
+    PEL_CHECK(resource.outstanding() == 0);
+}
+
+
+/*------------------------------------*/
+/* Concurrency */
+
+void
+testConcurrentAppendsAreAllPublished()
+{
+    constexpr std::size_t threadCount     = 4;
+    constexpr std::size_t appendsByThread = 10'000;
+
+    pel::concurrent_vector<std::size_t> vec;
+    std::vector<std::thread>            threads;
+    for(std::size_t thread = 0; thread < threadCount; thread++)
+    {
+        threads.emplace_back(
+          [&vec, thread]
+          {
+              for(std::size_t i = 0; i < appendsByThread; i++)
+              {
+                  vec.push_back(thread * appendsByThread + i);
+              }
+          });
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    constexpr std::size_t total = threadCount * appendsByThread;
+    PEL_CHECK(vec.length() == total);
+    PEL_CHECK(vec.published_length() == total);
+
+    std::vector<bool> seen(total, false);
+    for(const std::size_t value : vec)
+    {
+        PEL_CHECK(value < total && !seen[value]);
+        seen[value] = true;
+    }
+}
+
+void
+testIterationDuringAppendsOnlyVisitsPublishedElements()
+{
+    constexpr std::size_t writerCount     = 3;
+    constexpr std::size_t appendsByWriter = 5'000;
+
+    pel::concurrent_vector<std::string> vec;
+    std::atomic<std::size_t>            writersDone{0};
+    std::atomic<bool>                   corrupted{false};
+
+    std::thread reader{[&]
+                       {
+                           while(writersDone.load() != writerCount)
+                           {
+                               for(const std::string& item : vec)
+                               {
+                                   if(item.rfind("element #", 0) != 0)
+                                   {
+                                       corrupted = true;
+                                   }
+                               }
+                           }
+                       }};
+
+    std::vector<std::thread> writers;
+    for(std::size_t writer = 0; writer < writerCount; writer++)
+    {
+        writers.emplace_back(
+          [&vec, &writersDone, writer]
+          {
+              for(std::size_t i = 0; i < appendsByWriter; i++)
+              {
+                  vec.emplace_back(textOf(writer * appendsByWriter + i));
+              }
+              writersDone++;
+          });
+    }
+    for(std::thread& writer : writers)
+    {
+        writer.join();
+    }
+    reader.join();
+
+    PEL_CHECK(!corrupted);
+    PEL_CHECK(vec.published_length() == writerCount * appendsByWriter);
+}
+
+
+/*------------------------------------*/
+/* Allocators */
+
+void
+testElementsAreBuiltThroughTheAllocator()
+{
+    tracking_resource resource;
+    {
+        pel::concurrent_vector<std::pmr::string, std::pmr::polymorphic_allocator<std::pmr::string>>
+          vec{&resource};
+        vec.emplace_back(longText.c_str());
+        vec.push_back(std::pmr::string{longText.c_str()});
+
+        /* Uses-allocator construction hands the resource of the vector to its elements */
+        for(const std::pmr::string& item : vec)
+        {
+            PEL_CHECK(item.get_allocator().resource() == &resource);
+            PEL_CHECK(item == longText.c_str());
+        }
+
+        vec.clear();
+        PEL_CHECK(vec.is_empty());
+        vec.emplace_back(longText.c_str());
+        PEL_CHECK(vec[0].get_allocator().resource() == &resource);
+    }
+    PEL_CHECK(resource.outstanding() == 0);
+}
+
+}        // namespace
+
+
+int
+main()
+{
+    pel::test::run("appends are iterated", testAppendsAreIterated);
+    pel::test::run("iteration stops before a failed slot", testIterationStopsBeforeAFailedSlot);
+    pel::test::run("failed growth is never published", testFailedGrowthIsNeverPublished);
+    pel::test::run("failed segment allocations are never published",
+                   testFailedSegmentAllocationsAreNeverPublished);
+    pel::test::run("concurrent appends are all published", testConcurrentAppendsAreAllPublished);
+    pel::test::run("iteration during appends only visits published elements",
+                   testIterationDuringAppendsOnlyVisitsPublishedElements);
+    pel::test::run("elements are built through the allocator",
+                   testElementsAreBuiltThroughTheAllocator);
+    return pel::test::exit_code();
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,233 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./test.hpp"
+#include "../src/small_vector.hpp"
+#include "../src/vector.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+
+namespace
+{
+using pel::test::counted;
+using pel::test::holds;
+
+/**
+ **************************************************************************************************
+ * \brief       Allocator carrying an identifier, whose instances only compare equal when their
+ *              identifiers do, and which propagates on copy assignment.
+ *************************************************************************************************/
+template<typename ItemType>
+struct tagged_allocator
+{
+    using value_type                             = ItemType;
+    using propagate_on_container_copy_assignment = std::true_type;
+
+    int m_tag = 0;
+
+    tagged_allocator() noexcept = default;
+    explicit tagged_allocator(int tag_) noexcept : m_tag{tag_} {}
+    template<typename OtherType>
+    tagged_allocator(const tagged_allocator<OtherType>& other_) noexcept : m_tag{other_.m_tag}
+    {
+    }
+
+    [[nodiscard]] ItemType* allocate(std::size_t count_)
+    {
+        return std::allocator<ItemType>{}.allocate(count_);
+    }
+    void deallocate(ItemType* ptr_, std::size_t count_) noexcept
+    {
+        std::allocator<ItemType>{}.deallocate(ptr_, count_);
+    }
+
+    template<typename OtherType>
+    friend bool operator==(const tagged_allocator&            lhs_,
+                           const tagged_allocator<OtherType>& rhs_) noexcept
+    {
+        return lhs_.m_tag == rhs_.m_tag;
+    }
+};
+
+
+/*------------------------------------*/
+/* Copy construction */
+
+template<typename ItemType>
+void
+testCopyConstructorCopiesEveryElement()
+{
+    const pel::vector<ItemType> source{0, 1, 2, 3, 4};
+    const pel::vector<ItemType> copy{source};
+    PEL_CHECK(holds(copy, {0, 1, 2, 3, 4}));
+    PEL_CHECK(holds(source, {0, 1, 2, 3, 4}));
+    PEL_CHECK(copy.data() != source.data());
+    PEL_CHECK(copy.capacity() >= copy.length());
+
+    const pel::vector<ItemType> empty;
+    const pel::vector<ItemType> emptyCopy{empty};
+    PEL_CHECK(emptyCopy.length() == 0);
+}
+
+void
+testCopyConstructorAllocatesExactly()
+{
+    pel::vector<counted> source{0, 1, 2};
+    source.reserve(64);
+
+    const pel::vector<counted> copy{source};
+    PEL_CHECK(copy.capacity() == 3);
+    PEL_CHECK(counted::s_live == 6);
+}
+
+void
+testCopyConstructorAcceptsOtherAllocators()
+{
+    const pel::vector<int, tagged_allocator<int>> source(3, 7, tagged_allocator<int>{1});
+    const pel::vector<int>                        copy{source};
+    PEL_CHECK(holds(copy, {7, 7, 7}));
+}
+
+
+/*------------------------------------*/
+/* Copy assignment */
+
+template<typename ItemType>
+void
+testCopyAssignmentReplacesTheElements()
+{
+    const pel::vector<ItemType> longer{0, 1, 2, 3, 4, 5};
+    const pel::vector<ItemType> shorter{7, 8};
+
+    pel::vector<ItemType> vec{9};
+    vec = longer;
+    PEL_CHECK(holds(vec, {0, 1, 2, 3, 4, 5}));
+
+    const ItemType* const memory = vec.data();
+    vec                          = shorter;
+    PEL_CHECK(holds(vec, {7, 8}));
+    PEL_CHECK(vec.data() == memory);
+
+    vec = longer;
+    PEL_CHECK(holds(vec, {0, 1, 2, 3, 4, 5}));
+    PEL_CHECK(vec.data() == memory);
+
+    const pel::vector<ItemType>& self = vec;
+    vec                               = self;
+    PEL_CHECK(holds(vec, {0, 1, 2, 3, 4, 5}));
+
+    vec = pel::vector<ItemType>{};
+    PEL_CHECK(vec.length() == 0);
+}
+
+void
+testCopyAssignmentDestroysTheReplacedElements()
+{
+    {
+        const pel::vector<counted> shorter{7, 8};
+        pel::vector<counted>       vec{0, 1, 2, 3, 4, 5};
+        vec = shorter;
+        PEL_CHECK(counted::s_live == 4);
+    }
+    PEL_CHECK(counted::s_live == 0);
+}
+
+void
+testCopyAssignmentPropagatesTheAllocator()
+{
+    using TaggedVector = pel::vector<counted, tagged_allocator<counted>>;
+
+    const TaggedVector source({0, 1, 2}, tagged_allocator<counted>{1});
+    TaggedVector       vec({5, 6, 7, 8}, tagged_allocator<counted>{2});
+
+    vec = source;
+    PEL_CHECK(holds(vec, {0, 1, 2}));
+    PEL_CHECK(vec.get_allocator().m_tag == 1);
+
+    const pel::vector<counted> other{3, 4};
+    vec = other;
+    PEL_CHECK(holds(vec, {3, 4}));
+    PEL_CHECK(vec.get_allocator().m_tag == 1);
+}
+
+
+/*------------------------------------*/
+/* small_vector */
+
+void
+testSmallVectorCopiesKeepTheirOwnStorage()
+{
+    const pel::small_vector<counted, 4> inlineSource{0, 1};
+    const pel::small_vector<counted, 4> heapSource{0, 1, 2, 3, 4, 5};
+
+    pel::small_vector<counted, 4> inlineCopy{inlineSource};
+    pel::small_vector<counted, 4> heapCopy{heapSource};
+    PEL_CHECK(inlineCopy.is_inline());
+    PEL_CHECK(!heapCopy.is_inline());
+    PEL_CHECK(holds(inlineCopy, {0, 1}));
+    PEL_CHECK(holds(heapCopy, {0, 1, 2, 3, 4, 5}));
+    PEL_CHECK(inlineCopy.data() != inlineSource.data());
+
+    inlineCopy = heapSource;
+    heapCopy   = inlineSource;
+    PEL_CHECK(holds(inlineCopy, {0, 1, 2, 3, 4, 5}));
+    PEL_CHECK(holds(heapCopy, {0, 1}));
+}
+
+}        // namespace
+
+
+int
+main()
+{
+    pel::test::run("copy constructor copies every element (int)",
+                   testCopyConstructorCopiesEveryElement<int>);
+    pel::test::run("copy constructor copies every element (counted)",
+                   testCopyConstructorCopiesEveryElement<counted>);
+    pel::test::run("copy constructor allocates exactly", testCopyConstructorAllocatesExactly);
+    pel::test::run("copy constructor accepts other allocators",
+                   testCopyConstructorAcceptsOtherAllocators);
+    pel::test::run("copy assignment replaces the elements (int)",
+                   testCopyAssignmentReplacesTheElements<int>);
+    pel::test::run("copy assignment replaces the elements (counted)",
+                   testCopyAssignmentReplacesTheElements<counted>);
+    pel::test::run("copy assignment destroys the replaced elements",
+                   testCopyAssignmentDestroysTheReplacedElements);
+    pel::test::run("copy assignment propagates the allocator",
+                   testCopyAssignmentPropagatesTheAllocator);
+    pel::test::run("small_vector copies keep their own storage",
+                   testSmallVectorCopiesKeepTheirOwnStorage);
+    pel::test::run("counted elements are all destroyed", [] { PEL_CHECK(counted::s_live == 0); });
+    return pel::test::exit_code();
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,183 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./test.hpp"
+#include "../src/vector.hpp"
+
+#include <stdexcept>
+#include <string>
+
+
+namespace
+{
+using pel::test::counted;
+using pel::test::holds;
+
+/*------------------------------------*/
+/* erase */
+
+template<typename ItemType>
+void
+testEraseKeepsTheOrder()
+{
+    pel::vector<ItemType> vec{0, 1, 2, 3, 4, 5};
+
+    auto next = vec.erase(vec.begin() + 2);
+    PEL_CHECK(holds(vec, {0, 1, 3, 4, 5}));
+    PEL_CHECK(next == vec.begin() + 2);
+    PEL_CHECK(*next == 3);
+
+    next = vec.erase(vec.begin() + 1, vec.begin() + 3);
+    PEL_CHECK(holds(vec, {0, 4, 5}));
+    PEL_CHECK(next == vec.begin() + 1);
+
+    next = vec.erase(vec.end() - 1);
+    PEL_CHECK(holds(vec, {0, 4}));
+    PEL_CHECK(next == vec.end());
+
+    next = vec.erase(vec.begin() + 1, vec.begin() + 1);
+    PEL_CHECK(holds(vec, {0, 4}));
+    PEL_CHECK(next == vec.begin() + 1);
+
+    vec.erase(vec.begin(), vec.end());
+    PEL_CHECK(vec.length() == 0);
+}
+
+void
+testEraseRejectsInvalidPositions()
+{
+    pel::vector<int> vec{0, 1, 2};
+    PEL_CHECK_THROWS(vec.erase(vec.end()), std::invalid_argument);
+    PEL_CHECK_THROWS(vec.erase(vec.begin() + 2, vec.begin() + 1), std::invalid_argument);
+    PEL_CHECK_THROWS(vec.unordered_erase(vec.end()), std::invalid_argument);
+    PEL_CHECK(holds(vec, {0, 1, 2}));
+}
+
+void
+testEraseDestroysTheRemovedElements()
+{
+    {
+        pel::vector<counted> vec{0, 1, 2, 3, 4, 5, 6, 7};
+        vec.erase(vec.begin() + 1, vec.begin() + 4);
+        PEL_CHECK(counted::s_live == 5);
+        vec.unordered_erase(vec.begin());
+        PEL_CHECK(counted::s_live == 4);
+        vec.erase_if([](const counted& item_) { return item_.m_value % 2 == 0; });
+        PEL_CHECK(counted::s_live == static_cast<std::ptrdiff_t>(vec.length()));
+    }
+    PEL_CHECK(counted::s_live == 0);
+}
+
+
+/*------------------------------------*/
+/* unordered_erase */
+
+template<typename ItemType>
+void
+testUnorderedEraseMovesTheLastElement()
+{
+    pel::vector<ItemType> vec{0, 1, 2, 3, 4};
+
+    auto next = vec.unordered_erase(vec.begin() + 1);
+    PEL_CHECK(holds(vec, {0, 4, 2, 3}));
+    PEL_CHECK(next == vec.begin() + 1);
+    PEL_CHECK(*next == 4);
+
+    next = vec.unordered_erase(vec.end() - 1);
+    PEL_CHECK(holds(vec, {0, 4, 2}));
+    PEL_CHECK(next == vec.end());
+}
+
+
+/*------------------------------------*/
+/* erase_if */
+
+template<typename ItemType>
+void
+testEraseIfKeepsTheOrder()
+{
+    pel::vector<ItemType> vec{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    const std::size_t removed = vec.erase_if(
+      [](const ItemType& item_) { return item_ == 0 || item_ == 4 || item_ == 5 || item_ == 9; });
+    PEL_CHECK(removed == 4);
+    PEL_CHECK(holds(vec, {1, 2, 3, 6, 7, 8}));
+
+    PEL_CHECK(pel::erase_if(vec, [](const ItemType&) { return false; }) == 0);
+    PEL_CHECK(holds(vec, {1, 2, 3, 6, 7, 8}));
+
+    PEL_CHECK(pel::erase(vec, 7) == 1);
+    PEL_CHECK(holds(vec, {1, 2, 3, 6, 8}));
+
+    PEL_CHECK(pel::erase_if(vec, [](const ItemType&) { return true; }) == 5);
+    PEL_CHECK(vec.length() == 0);
+}
+
+void
+testEraseIfLeavesAContiguousVectorWhenThePredicateThrows()
+{
+    pel::vector<int> vec{0, 1, 2, 3, 4, 5, 6, 7};
+
+    int examined = 0;
+    PEL_CHECK_THROWS(vec.erase_if(
+                       [&](int item_)
+                       {
+                           if(++examined == 5)
+                           {
+                               throw std::runtime_error{"predicate failure"};
+                           }
+                           return item_ % 2 == 0;
+                       }),
+                     std::runtime_error);
+
+    /* 0 and 2 were removed, the elements from 4 on were not examined yet */
+    PEL_CHECK(holds(vec, {1, 3, 4, 5, 6, 7}));
+}
+
+}        // namespace
+
+
+int
+main()
+{
+    pel::test::run("erase keeps the order (int)", testEraseKeepsTheOrder<int>);
+    pel::test::run("erase keeps the order (counted)", testEraseKeepsTheOrder<counted>);
+    pel::test::run("erase rejects invalid positions", testEraseRejectsInvalidPositions);
+    pel::test::run("erase destroys the removed elements", testEraseDestroysTheRemovedElements);
+    pel::test::run("unordered_erase moves the last element (int)",
+                   testUnorderedEraseMovesTheLastElement<int>);
+    pel::test::run("unordered_erase moves the last element (counted)",
+                   testUnorderedEraseMovesTheLastElement<counted>);
+    pel::test::run("erase_if keeps the order (int)", testEraseIfKeepsTheOrder<int>);
+    pel::test::run("erase_if keeps the order (counted)", testEraseIfKeepsTheOrder<counted>);
+    pel::test::run("erase_if leaves a contiguous vector when the predicate throws",
+                   testEraseIfLeavesAContiguousVectorWhenThePredicateThrows);
+    return pel::test::exit_code();
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
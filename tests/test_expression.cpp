@@ -0,0 +1,130 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./test.hpp"
+#include "../src/vector.hpp"
+#include "../src/vector_expression.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+
+
+namespace
+{
+using pel::test::holds;
+
+void
+testExpressionConstructsAVector()
+{
+    const pel::vector<int> a{1, 2, 3, 4};
+    const pel::vector<int> b{10, 20, 30, 40};
+    const pel::vector<int> c{2, 2, 2, 2};
+
+    const pel::vector<int> result = a + b * c - 1;
+    PEL_CHECK(holds(result, {20, 41, 62, 83}));
+
+    const pel::vector<int> negated = -(a - b) / 3;
+    PEL_CHECK(holds(negated, {3, 6, 9, 12}));
+
+    const pel::vector<int> scaled = 2 * a;
+    PEL_CHECK(holds(scaled, {2, 4, 6, 8}));
+}
+
+void
+testExpressionAssignment()
+{
+    pel::vector<int>       a{1, 2, 3};
+    const pel::vector<int> b{4, 5, 6};
+
+    /* Same length: evaluated in place, reading the vector being written */
+    const int* const memory = a.data();
+    a                       = a * 2 + a;
+    PEL_CHECK(holds(a, {3, 6, 9}));
+    PEL_CHECK(a.data() == memory);
+
+    /* Different length: evaluated into new storage */
+    pel::vector<int> c{7};
+    c = a + b;
+    PEL_CHECK(holds(c, {7, 11, 15}));
+
+    pel::vector<int> empty;
+    empty = b - b;
+    PEL_CHECK(holds(empty, {0, 0, 0}));
+}
+
+void
+testMismatchedLengthsThrow()
+{
+    const pel::vector<int> a{1, 2, 3};
+    const pel::vector<int> b{1, 2};
+    PEL_CHECK_THROWS(a + b, std::length_error);
+}
+
+void
+testReductions()
+{
+    const pel::vector<double> a{0.5, 1.5, 2.0};
+    const pel::vector<double> b{2.0, 2.0, 4.0};
+    PEL_CHECK(pel::sum(a * b) == 12.0);
+    PEL_CHECK(pel::sum(a) == 4.0);
+
+    const pel::vector<int> ints{1, 2, 3};
+    PEL_CHECK(pel::sum(ints * ints) == 14);
+}
+
+void
+testSumDoesNotDependOnTheShapeOfTheExpression()
+{
+    /* Every product is above INT_MAX */
+    const pel::vector<int> a{100'000, -100'000, 70'000};
+    const pel::vector<int> b{100'000, 100'000, 40'000};
+    const std::int64_t     expected = 2'800'000'000;
+
+    PEL_CHECK(pel::sum(a * b) == expected);
+    PEL_CHECK(pel::sum(a * b + 0) == expected);
+    PEL_CHECK(pel::sum(-(a * b)) == -expected);
+    PEL_CHECK(pel::sum(a * b * 2) == 2 * expected);
+    PEL_CHECK(pel::sum((a + 0) * b) == expected);
+}
+
+}        // namespace
+
+
+int
+main()
+{
+    pel::test::run("expression constructs a vector", testExpressionConstructsAVector);
+    pel::test::run("expression assignment", testExpressionAssignment);
+    pel::test::run("mismatched lengths throw", testMismatchedLengthsThrow);
+    pel::test::run("reductions", testReductions);
+    pel::test::run("sum does not depend on the shape of the expression",
+                   testSumDoesNotDependOnTheShapeOfTheExpression);
+    return pel::test::exit_code();
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,109 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./test.hpp"
+#include "../src/vector.hpp"
+#include "../src/vector_format.hpp"
+
+#include <iterator>
+#include <sstream>
+#include <string>
+
+
+namespace
+{
+/*------------------------------------*/
+/* Layout */
+
+void
+testDefaultLayoutMatchesTheStream()
+{
+    pel::vector<int> ints{-3, 0, 42, 1000000};
+    ints.reserve(16);
+    PEL_CHECK(pel::to_string(ints) == ints.to_string());
+    PEL_CHECK(pel::to_string(ints) == "Capacity : [16]   |   Length: [4]\n-3\n0\n42\n1000000\n");
+
+    const pel::vector<std::string> strings{"first", "second"};
+    PEL_CHECK(pel::to_string(strings) == strings.to_string());
+
+    const pel::vector<int> empty;
+    PEL_CHECK(pel::to_string(empty) == empty.to_string());
+
+    std::ostringstream os;
+    os << ints;
+    PEL_CHECK(os.str() == ints.to_string());
+}
+
+void
+testCustomLayout()
+{
+    const pel::format_options list{.m_open              = "[",
+                                   .m_separator         = ", ",
+                                   .m_close             = "]",
+                                   .m_trailingSeparator = false,
+                                   .m_header            = false};
+
+    const pel::vector<int> ints{1, 2, 3};
+    PEL_CHECK(pel::to_string(ints, list) == "[1, 2, 3]");
+    PEL_CHECK(pel::to_string(pel::vector<int>{}, list) == "[]");
+
+    const pel::vector<double> doubles{0.5, -1.25, 0.1};
+    PEL_CHECK(pel::to_string(doubles, list) == "[0.5, -1.25, 0.1]");
+
+    const pel::vector<std::string> strings{"a", "b"};
+    PEL_CHECK(pel::to_string(strings, list) == "[a, b]");
+}
+
+void
+testFormatToMatchesToString()
+{
+    pel::vector<int> ints;
+    for(int i = 0; i < 5000; i++)
+    {
+        ints.push_back(i * 1000);
+    }
+
+    std::string text;
+    pel::format_to(std::back_inserter(text), ints);
+    PEL_CHECK(text == pel::to_string(ints));
+    PEL_CHECK(text == ints.to_string());
+}
+
+}        // namespace
+
+
+int
+main()
+{
+    pel::test::run("default layout matches the stream", testDefaultLayoutMatchesTheStream);
+    pel::test::run("custom layout", testCustomLayout);
+    pel::test::run("format_to matches to_string", testFormatToMatchesToString);
+    return pel::test::exit_code();
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,152 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./test.hpp"
+#include "../src/growth_policy.hpp"
+#include "../src/instrumentation_policy.hpp"
+#include "../src/vector.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+
+
+namespace
+{
+constexpr std::size_t maxSize = std::numeric_limits<std::size_t>::max();
+
+
+/*------------------------------------*/
+/* Growth policies */
+
+void
+testGeometricGrowth()
+{
+    /* Grows by the factor, with a minimum capacity */
+    PEL_CHECK(pel::growth_1_5x::next_capacity(0, 1) == 4);
+    PEL_CHECK(pel::growth_1_5x::next_capacity(4, 5) == 6);
+    PEL_CHECK(pel::growth_1_5x::next_capacity(10, 11) == 15);
+    PEL_CHECK(pel::growth_2x::next_capacity(10, 11) == 20);
+    PEL_CHECK((pel::geometric_growth<2, 1, 16>::next_capacity(0, 1) == 16));
+
+    /* Jumps to the required capacity in one step when the factor is not enough */
+    PEL_CHECK(pel::growth_1_5x::next_capacity(10, 1'000) == 1'000);
+    PEL_CHECK(pel::growth_2x::next_capacity(0, 1'000'000) == 1'000'000);
+
+    /* Stops growing geometrically instead of overflowing */
+    PEL_CHECK(pel::growth_1_5x::next_capacity(maxSize / 2, maxSize / 2 + 1) == maxSize / 2 + 1);
+    PEL_CHECK(pel::growth_2x::next_capacity(maxSize - 1, maxSize) == maxSize);
+}
+
+void
+testPowerOfTwoGrowth()
+{
+    PEL_CHECK(pel::power_of_two_growth<>::next_capacity(0, 1) == 4);
+    PEL_CHECK(pel::power_of_two_growth<>::next_capacity(4, 5) == 8);
+    PEL_CHECK(pel::power_of_two_growth<>::next_capacity(8, 9) == 16);
+    PEL_CHECK(pel::power_of_two_growth<>::next_capacity(16, 32) == 32);
+    PEL_CHECK(pel::power_of_two_growth<>::next_capacity(4, 1'000) == 1'024);
+    PEL_CHECK(pel::power_of_two_growth<64>::next_capacity(0, 3) == 64);
+
+    /* The required capacity is returned as is once no power of two can hold it */
+    PEL_CHECK(pel::power_of_two_growth<>::next_capacity(0, maxSize) == maxSize);
+}
+
+void
+testExactFitGrowth()
+{
+    PEL_CHECK(pel::exact_fit_growth::next_capacity(0, 1) == 1);
+    PEL_CHECK(pel::exact_fit_growth::next_capacity(4, 5) == 5);
+    PEL_CHECK(pel::exact_fit_growth::next_capacity(4, 1'000) == 1'000);
+}
+
+
+/*------------------------------------*/
+/* Growth of the vector */
+
+template<typename GrowthPolicy>
+using TrackedVector =
+  pel::vector<int, std::allocator<int>, GrowthPolicy, pel::allocation_tracker<>>;
+
+template<typename GrowthPolicy>
+void
+testBulkAppendGrowsOnce()
+{
+    TrackedVector<GrowthPolicy> vec{1, 2, 3};
+    vec.shrink_to_fit();
+
+    const TrackedVector<GrowthPolicy> appended(1'000, 7);
+    vec.push_back(appended);
+    PEL_CHECK(vec.length() == 1'003);
+    PEL_CHECK(vec.capacity() == GrowthPolicy::next_capacity(3, 1'003));
+    PEL_CHECK(vec.instrumentation().statistics().m_growths == 1);
+}
+
+template<typename GrowthPolicy>
+void
+testAppendsFollowThePolicy()
+{
+    TrackedVector<GrowthPolicy> vec;
+    std::size_t                 expectedCapacity = 0;
+    std::size_t                 expectedGrowths  = 0;
+    for(int i = 0; i < 1'000; i++)
+    {
+        if(vec.length() == expectedCapacity)
+        {
+            expectedCapacity = GrowthPolicy::next_capacity(expectedCapacity, vec.length() + 1);
+            expectedGrowths++;
+        }
+        vec.push_back(i);
+        PEL_CHECK(vec.capacity() == expectedCapacity);
+    }
+    PEL_CHECK(vec.instrumentation().statistics().m_growths == expectedGrowths);
+}
+
+}        // namespace
+
+
+int
+main()
+{
+    pel::test::run("geometric growth", testGeometricGrowth);
+    pel::test::run("power of two growth", testPowerOfTwoGrowth);
+    pel::test::run("exact fit growth", testExactFitGrowth);
+    pel::test::run("bulk append grows once (1.5x)", testBulkAppendGrowsOnce<pel::growth_1_5x>);
+    pel::test::run("bulk append grows once (pow2)",
+                   testBulkAppendGrowsOnce<pel::power_of_two_growth<>>);
+    pel::test::run("bulk append grows once (exact)", testBulkAppendGrowsOnce<pel::exact_fit_growth>);
+    pel::test::run("appends follow the policy (1.5x)", testAppendsFollowThePolicy<pel::growth_1_5x>);
+    pel::test::run("appends follow the policy (2x)", testAppendsFollowThePolicy<pel::growth_2x>);
+    pel::test::run("appends follow the policy (pow2)",
+                   testAppendsFollowThePolicy<pel::power_of_two_growth<>>);
+    pel::test::run("appends follow the policy (exact)",
+                   testAppendsFollowThePolicy<pel::exact_fit_growth>);
+    return pel::test::exit_code();
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
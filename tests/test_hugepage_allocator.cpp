@@ -0,0 +1,249 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./test.hpp"
+#include "../src/hugepage_allocator.hpp"
+#include "../src/instrumentation_policy.hpp"
+#include "../src/vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <numeric>
+#include <string>
+
+
+namespace
+{
+/* Blocks of 64 KiB and more are mapped, to keep the tests small */
+constexpr std::size_t threshold  = std::size_t{64} * 1024;
+constexpr std::size_t mappedInts = threshold / sizeof(int);
+
+using Allocator        = pel::hugepage_allocator<int, threshold>;
+using HugeTLBAllocator = pel::hugepage_allocator<int, threshold, true>;
+
+template<typename AllocatorType>
+using TrackedVector = pel::vector<int, AllocatorType, pel::growth_2x, pel::allocation_tracker<>>;
+
+bool
+is_huge_page_aligned(const void* ptr_)
+{
+    return reinterpret_cast<std::uintptr_t>(ptr_) % pel::huge_page_size == 0;
+}
+
+bool
+holds_iota(const int* data_, std::size_t length_)
+{
+    for(std::size_t i = 0; i < length_; i++)
+    {
+        if(data_[i] != static_cast<int>(i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** Explicit huge pages still free on the system, read from /proc/meminfo. */
+std::size_t
+free_huge_pages()
+{
+    std::ifstream meminfo{"/proc/meminfo"};
+    std::string   key;
+    std::size_t   value = 0;
+    while(meminfo >> key >> value)
+    {
+        if(key == "HugePages_Free:")
+        {
+            return value;
+        }
+        meminfo.ignore(256, '\n');
+    }
+    return 0;
+}
+
+
+/*------------------------------------*/
+/* Allocation */
+
+void
+testBigBlocksAreMapped()
+{
+    Allocator alloc;
+
+    /* Below the threshold, the block comes from the C heap and can be used as is */
+    int* small = alloc.allocate(mappedInts - 1);
+    std::iota(small, small + mappedInts - 1, 0);
+    PEL_CHECK(holds_iota(small, mappedInts - 1));
+    alloc.deallocate(small, mappedInts - 1);
+
+#if defined(__linux__)
+    /* From the threshold, the block is mapped on a huge page boundary */
+    int* big = alloc.allocate(mappedInts);
+    PEL_CHECK(is_huge_page_aligned(big));
+    std::iota(big, big + mappedInts, 0);
+    PEL_CHECK(holds_iota(big, mappedInts));
+    alloc.deallocate(big, mappedInts);
+
+    /* Blocks spanning several huge pages are rounded as a whole */
+    const std::size_t count = pel::huge_page_size / sizeof(int) + 1;
+    int*              huge  = alloc.allocate(count);
+    PEL_CHECK(is_huge_page_aligned(huge));
+    std::iota(huge, huge + count, 0);
+    PEL_CHECK(holds_iota(huge, count));
+    alloc.deallocate(huge, count);
+#endif
+
+    PEL_CHECK(alloc.allocate(0) == nullptr);
+    alloc.deallocate(nullptr, 0);
+}
+
+void
+testReallocateKeepsTheElements()
+{
+    Allocator alloc;
+
+    /* Heap to heap */
+    int* ptr = alloc.allocate(16);
+    std::iota(ptr, ptr + 16, 0);
+    ptr = alloc.reallocate(ptr, 16, 64);
+    PEL_CHECK(holds_iota(ptr, 16));
+
+    /* Heap to mapping, crossing the threshold */
+    std::iota(ptr, ptr + 64, 0);
+    ptr = alloc.reallocate(ptr, 64, mappedInts);
+    PEL_CHECK(holds_iota(ptr, 64));
+
+    /* Mapping to mapping, across several huge pages */
+    const std::size_t bigCount = 2 * pel::huge_page_size / sizeof(int) + 1;
+    std::iota(ptr, ptr + mappedInts, 0);
+    ptr = alloc.reallocate(ptr, mappedInts, bigCount);
+    PEL_CHECK(holds_iota(ptr, mappedInts));
+
+    /* Back under the threshold */
+    std::iota(ptr, ptr + bigCount, 0);
+    ptr = alloc.reallocate(ptr, bigCount, 32);
+    PEL_CHECK(holds_iota(ptr, 32));
+
+    PEL_CHECK(alloc.reallocate(ptr, 32, 0) == nullptr);
+}
+
+
+/*------------------------------------*/
+/* pel::vector */
+
+template<typename AllocatorType>
+void
+testVectorGrowsWithoutRelocating()
+{
+    TrackedVector<AllocatorType> vec;
+    for(std::size_t i = 0; i < 4 * pel::huge_page_size / sizeof(int); i++)
+    {
+        vec.push_back(static_cast<int>(i));
+    }
+    PEL_CHECK(holds_iota(vec.data(), vec.length()));
+#if defined(__linux__)
+    PEL_CHECK(is_huge_page_aligned(vec.data()));
+#endif
+
+    /* The block is grown by the allocator (realloc/mremap), the elements are never relocated */
+    const pel::allocation_tracker<>& tracker = vec.instrumentation();
+    PEL_CHECK(tracker.history(0).m_kind == pel::reallocation_kind::allocate);
+    for(std::size_t i = 1; i < tracker.history_length(); i++)
+    {
+        const pel::reallocation_kind kind = tracker.history(i).m_kind;
+        PEL_CHECK(kind == pel::reallocation_kind::bitwise
+                  || kind == pel::reallocation_kind::in_place);
+    }
+
+    /* Shrinking back under the threshold returns the block to the heap */
+    vec.resize(100);
+    vec.shrink_to_fit();
+    PEL_CHECK(vec.capacity() == 100);
+    PEL_CHECK(holds_iota(vec.data(), vec.length()));
+    PEL_CHECK(tracker.history(tracker.history_length() - 1).m_kind
+              == pel::reallocation_kind::bitwise);
+
+#if defined(__linux__)
+    /* Reserving within the same huge page resizes the mapping in place */
+    vec.reserve(mappedInts);
+    vec.reserve(mappedInts + 1);
+    PEL_CHECK(tracker.history(tracker.history_length() - 1).m_kind
+              == pel::reallocation_kind::in_place);
+    PEL_CHECK(holds_iota(vec.data(), vec.length()));
+#endif
+}
+
+
+/*------------------------------------*/
+/* Explicit huge pages */
+
+void
+testHugeTLBFallsBackToTransparentHugePages()
+{
+#if defined(__linux__)
+    /* Ask for more explicit huge pages than the system has left, so that MAP_HUGETLB fails */
+    const std::size_t freePages = free_huge_pages();
+    if(freePages > 16)
+    {
+        return;
+    }
+
+    HugeTLBAllocator  alloc;
+    const std::size_t count = (freePages + 1) * pel::huge_page_size / sizeof(int);
+
+    int* ptr = alloc.allocate(count);
+    PEL_CHECK(ptr != nullptr);
+    PEL_CHECK(is_huge_page_aligned(ptr));
+    std::iota(ptr, ptr + count, 0);
+    PEL_CHECK(holds_iota(ptr, count));
+
+    ptr = alloc.reallocate(ptr, count, 2 * count);
+    PEL_CHECK(is_huge_page_aligned(ptr));
+    PEL_CHECK(holds_iota(ptr, count));
+    alloc.deallocate(ptr, 2 * count);
+#endif
+}
+
+}        // namespace
+
+
+int
+main()
+{
+    pel::test::run("big blocks are mapped", testBigBlocksAreMapped);
+    pel::test::run("reallocate keeps the elements", testReallocateKeepsTheElements);
+    pel::test::run("vector grows without relocating", testVectorGrowsWithoutRelocating<Allocator>);
+    pel::test::run("vector grows without relocating (hugetlb)",
+                   testVectorGrowsWithoutRelocating<HugeTLBAllocator>);
+    pel::test::run("hugetlb falls back to transparent huge pages",
+                   testHugeTLBFallsBackToTransparentHugePages);
+    return pel::test::exit_code();
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,265 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./test.hpp"
+#include "../src/realloc_allocator.hpp"
+#include "../src/vector.hpp"
+
+#include <stdexcept>
+#include <string>
+
+
+namespace
+{
+using pel::test::counted;
+using pel::test::holds;
+using pel::test::throwing_item;
+
+/*------------------------------------*/
+/* Returned iterators */
+
+template<typename ItemType>
+void
+testInsertReturnsTheLastInsertedElement()
+{
+    pel::vector<ItemType> vec{0, 1, 2, 3};
+
+    auto last = vec.insert(ItemType{9}, 1, 3);
+    PEL_CHECK(holds(vec, {0, 9, 9, 9, 1, 2, 3}));
+    PEL_CHECK(last == vec.begin() + 3);
+
+    last = vec.insert(ItemType{8}, vec.begin());
+    PEL_CHECK(holds(vec, {8, 0, 9, 9, 9, 1, 2, 3}));
+    PEL_CHECK(last == vec.begin());
+
+    last = vec.insert(ItemType{7}, static_cast<std::ptrdiff_t>(vec.length()), 2);
+    PEL_CHECK(holds(vec, {8, 0, 9, 9, 9, 1, 2, 3, 7, 7}));
+    PEL_CHECK(last == vec.end() - 1);
+
+    last = vec.insert(ItemType{6}, 2, 0);
+    PEL_CHECK(vec.length() == 10);
+    PEL_CHECK(last == vec.begin() + 2);
+}
+
+template<typename ItemType>
+void
+testEmplaceReturnsTheLastInsertedElement()
+{
+    pel::vector<ItemType> vec{0, 1, 2};
+
+    auto last = vec.emplace(std::ptrdiff_t{1}, 2, 5);
+    PEL_CHECK(holds(vec, {0, 5, 5, 1, 2}));
+    PEL_CHECK(last == vec.begin() + 2);
+
+    last = vec.emplace(vec.end(), 1, 6);
+    PEL_CHECK(holds(vec, {0, 5, 5, 1, 2, 6}));
+    PEL_CHECK(last == vec.end() - 1);
+}
+
+template<typename ItemType>
+void
+testRangeInsertReturnsTheLastInsertedElement()
+{
+    pel::vector<ItemType>       vec{0, 1, 2};
+    const pel::vector<ItemType> source{7, 8, 9};
+    pel::vector<ItemType>       moved{4, 5};
+
+    auto last = vec.insert(source.begin(), source.end(), 1);
+    PEL_CHECK(holds(vec, {0, 7, 8, 9, 1, 2}));
+    PEL_CHECK(last == vec.begin() + 3);
+
+    last = vec.insert(std::make_move_iterator(moved.begin()),
+                      std::make_move_iterator(moved.end()),
+                      vec.end());
+    PEL_CHECK(holds(vec, {0, 7, 8, 9, 1, 2, 4, 5}));
+    PEL_CHECK(last == vec.end() - 1);
+
+    last = vec.insert({3, 3}, 0);
+    PEL_CHECK(holds(vec, {3, 3, 0, 7, 8, 9, 1, 2, 4, 5}));
+    PEL_CHECK(last == vec.begin() + 1);
+}
+
+/** Element remembering whether it was built from its arguments or moved from another element. */
+struct tracked_item
+{
+    static inline int s_built = 0;
+
+    int  m_value     = 0;
+    bool m_movedInto = false;
+
+    explicit tracked_item(int value_) noexcept : m_value{value_} { s_built++; }
+    tracked_item(const tracked_item& other_) noexcept : m_value{other_.m_value} {}
+    tracked_item(tracked_item&& other_) noexcept : m_value{other_.m_value}, m_movedInto{true} {}
+    tracked_item& operator=(const tracked_item&) noexcept = default;
+    tracked_item& operator=(tracked_item&&) noexcept      = default;
+    ~tracked_item()                                       = default;
+
+    friend std::ostream& operator<<(std::ostream& os_, const tracked_item& item_)
+    {
+        return os_ << item_.m_value;
+    }
+};
+
+void
+testEmplaceBuildsASingleElementInPlace()
+{
+    pel::vector<tracked_item> vec;
+    vec.reserve(4);
+    vec.emplace_back(0);
+
+    /* At the end, with room to spare */
+    auto last = vec.emplace(std::ptrdiff_t{1}, 1, 1);
+    PEL_CHECK(last->m_value == 1 && !last->m_movedInto);
+
+    /* In the new block, when growing */
+    vec.shrink_to_fit();
+    last = vec.emplace(std::ptrdiff_t{1}, 1, 2);
+    PEL_CHECK(last->m_value == 2 && !last->m_movedInto);
+    PEL_CHECK(vec.length() == 3);
+
+    /* Inserting nothing builds nothing */
+    tracked_item::s_built = 0;
+    last                  = vec.emplace(std::ptrdiff_t{1}, 0, 3);
+    PEL_CHECK(tracked_item::s_built == 0);
+    PEL_CHECK(last == vec.begin() + 1);
+    PEL_CHECK(vec.length() == 3);
+    PEL_CHECK_THROWS(vec.emplace(std::ptrdiff_t{4}, 0, 3), std::invalid_argument);
+}
+
+void
+testInsertRejectsInvalidOffsets()
+{
+    pel::vector<int> vec{0, 1, 2};
+    PEL_CHECK_THROWS(vec.insert(5, std::ptrdiff_t{4}), std::invalid_argument);
+    PEL_CHECK_THROWS(vec.emplace(std::ptrdiff_t{4}, 1, 5), std::invalid_argument);
+    PEL_CHECK_THROWS(vec.insert({5, 6}, 4), std::invalid_argument);
+    PEL_CHECK(holds(vec, {0, 1, 2}));
+}
+
+
+/*------------------------------------*/
+/* Aliasing */
+
+/**
+ **************************************************************************************************
+ * \brief       Insert and emplace elements of the vector into itself, both when the elements are
+ *              shifted in place and when the vector has to grow.
+ *************************************************************************************************/
+template<typename VectorType>
+void
+testInsertCopiesElementsOfTheVector(bool full_)
+{
+    VectorType vec{"first element, too long to be stored inline",
+                   "second element, too long to be stored inline"};
+    vec.reserve(full_ ? vec.length() : vec.length() + 8);
+
+    vec.insert(vec.data()[0], 0, 2);
+    PEL_CHECK(vec.length() == 4);
+    PEL_CHECK(vec.data()[0] == "first element, too long to be stored inline");
+    PEL_CHECK(vec.data()[1] == "first element, too long to be stored inline");
+    PEL_CHECK(vec.data()[2] == "first element, too long to be stored inline");
+    PEL_CHECK(vec.data()[3] == "second element, too long to be stored inline");
+
+    vec.shrink_to_fit();
+    vec.emplace(std::ptrdiff_t{1}, 2, vec.data()[3]);
+    PEL_CHECK(vec.length() == 6);
+    PEL_CHECK(vec.data()[1] == "second element, too long to be stored inline");
+    PEL_CHECK(vec.data()[2] == "second element, too long to be stored inline");
+    PEL_CHECK(vec.data()[5] == "second element, too long to be stored inline");
+}
+
+template<typename AllocatorType>
+void
+testInsertCopiesElementsOfTheVectorWhileGrowing()
+{
+    pel::vector<int, AllocatorType> vec{1, 2, 3};
+    vec.shrink_to_fit();
+
+    for(int i = 0; i < 64; i++)
+    {
+        vec.insert(vec.data()[vec.length() - 1], 1);
+        vec.emplace(std::ptrdiff_t{0}, 1, vec.data()[1]);
+    }
+    PEL_CHECK(vec.length() == 131);
+    PEL_CHECK(vec.data()[0] == 3);
+    PEL_CHECK(vec.data()[130] == 3);
+}
+
+
+/*------------------------------------*/
+/* Exception safety */
+
+void
+testFailedInsertLeavesTheVectorUnchanged()
+{
+    pel::vector<throwing_item> vec{0, 1, 2};
+
+    PEL_CHECK_THROWS(vec.emplace(std::ptrdiff_t{1}, 2, -1), std::runtime_error);
+    PEL_CHECK(holds(vec, {0, 1, 2}));
+
+    vec.reserve(8);
+    PEL_CHECK_THROWS(vec.emplace(std::ptrdiff_t{0}, 1, -1), std::runtime_error);
+    PEL_CHECK(holds(vec, {0, 1, 2}));
+}
+
+}        // namespace
+
+
+int
+main()
+{
+    pel::test::run("insert returns the last inserted element (int)",
+                   testInsertReturnsTheLastInsertedElement<int>);
+    pel::test::run("insert returns the last inserted element (counted)",
+                   testInsertReturnsTheLastInsertedElement<counted>);
+    pel::test::run("emplace returns the last inserted element (int)",
+                   testEmplaceReturnsTheLastInsertedElement<int>);
+    pel::test::run("emplace returns the last inserted element (counted)",
+                   testEmplaceReturnsTheLastInsertedElement<counted>);
+    pel::test::run("range insert returns the last inserted element (int)",
+                   testRangeInsertReturnsTheLastInsertedElement<int>);
+    pel::test::run("range insert returns the last inserted element (counted)",
+                   testRangeInsertReturnsTheLastInsertedElement<counted>);
+    pel::test::run("emplace builds a single element in place",
+                   testEmplaceBuildsASingleElementInPlace);
+    pel::test::run("insert rejects invalid offsets", testInsertRejectsInvalidOffsets);
+    pel::test::run("insert copies elements of the vector in place",
+                   [] { testInsertCopiesElementsOfTheVector<pel::vector<std::string>>(false); });
+    pel::test::run("insert copies elements of the vector while growing",
+                   [] { testInsertCopiesElementsOfTheVector<pel::vector<std::string>>(true); });
+    pel::test::run("insert copies elements of the vector while growing (std::allocator)",
+                   testInsertCopiesElementsOfTheVectorWhileGrowing<std::allocator<int>>);
+    pel::test::run("insert copies elements of the vector while growing (realloc_allocator)",
+                   testInsertCopiesElementsOfTheVectorWhileGrowing<pel::realloc_allocator<int>>);
+    pel::test::run("failed insert leaves the vector unchanged",
+                   testFailedInsertLeavesTheVectorUnchanged);
+    pel::test::run("counted elements are all destroyed", [] { PEL_CHECK(counted::s_live == 0); });
+    return pel::test::exit_code();
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,179 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./test.hpp"
+#include "../src/instrumentation_policy.hpp"
+#include "../src/vector.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <string>
+
+
+namespace
+{
+template<pel::instrumentation_scope Scope = pel::instrumentation_scope::instance>
+using TrackedVector =
+  pel::vector<int, std::allocator<int>, pel::growth_2x, pel::allocation_tracker<Scope>>;
+
+/** Built before the registry, and merged in it when destroyed after `main` returns. */
+TrackedVector<pel::instrumentation_scope::by_type> staticVector;
+
+void
+testRecordsEveryReallocation()
+{
+    TrackedVector<> vec;
+
+    std::size_t changes      = 0;
+    std::size_t lastCapacity = vec.capacity();
+    for(int i = 0; i < 100; i++)
+    {
+        vec.push_back(i);
+        if(vec.capacity() != lastCapacity)
+        {
+            lastCapacity = vec.capacity();
+            changes++;
+        }
+    }
+
+    const pel::allocation_tracker<>&  tracker = vec.instrumentation();
+    const pel::allocation_statistics& stats   = tracker.statistics();
+    PEL_CHECK(tracker.history_length() == changes);
+    PEL_CHECK(stats.m_allocations == changes);
+    PEL_CHECK(stats.m_deallocations == changes - 1);
+    PEL_CHECK(stats.m_reallocations == changes - 1);
+    PEL_CHECK(stats.m_growths == changes);
+    PEL_CHECK(stats.m_peakCapacity == vec.capacity());
+    PEL_CHECK(stats.m_peakBytes == vec.capacity() * sizeof(int));
+
+    /* The first block is allocated empty, every other one receives the previous elements */
+    PEL_CHECK(tracker.history(0).m_kind == pel::reallocation_kind::allocate);
+    PEL_CHECK(tracker.history(0).m_oldCapacity == 0);
+
+    std::size_t bytesMoved = 0;
+    for(std::size_t i = 1; i < tracker.history_length(); i++)
+    {
+        const pel::reallocation_event& event = tracker.history(i);
+        PEL_CHECK(event.m_kind == pel::reallocation_kind::relocate);
+        PEL_CHECK(event.m_oldCapacity == tracker.history(i - 1).m_newCapacity);
+        PEL_CHECK(event.m_length == event.m_oldCapacity);
+        PEL_CHECK(event.m_itemSize == sizeof(int));
+        bytesMoved += event.m_length * event.m_itemSize;
+    }
+    PEL_CHECK(stats.m_bytesMoved == bytesMoved);
+    PEL_CHECK(tracker.history(tracker.history_length() - 1).m_newCapacity == vec.capacity());
+}
+
+void
+testHistoryKeepsTheLatestEvents()
+{
+    pel::vector<int, std::allocator<int>, pel::exact_fit_growth, pel::allocation_tracker<>> vec;
+    for(int i = 0; i < 100; i++)
+    {
+        vec.push_back(i);
+    }
+
+    const auto& tracker = vec.instrumentation();
+    PEL_CHECK(tracker.statistics().m_growths == 100);
+    PEL_CHECK(tracker.history_length() == 64);
+    PEL_CHECK(tracker.history(63).m_newCapacity == 100);
+    PEL_CHECK(tracker.history(0).m_newCapacity == 37);
+}
+
+void
+testCopiesStartTheirOwnStatistics()
+{
+    TrackedVector<> vec;
+    for(int i = 0; i < 100; i++)
+    {
+        vec.push_back(i);
+    }
+
+    const TrackedVector<> copy{vec};
+    PEL_CHECK(copy.instrumentation().statistics().m_allocations == 1);
+    PEL_CHECK(copy.instrumentation().statistics().m_reallocations == 0);
+    PEL_CHECK(copy.instrumentation().statistics().m_peakCapacity == copy.capacity());
+}
+
+void
+testDestroyedVectorsAreMergedByType()
+{
+    pel::instrumentation_registry::instance().reset();
+
+    std::size_t allocations = 0;
+    for(int round = 0; round < 3; round++)
+    {
+        TrackedVector<pel::instrumentation_scope::by_type> vec;
+        for(int i = 0; i < 100; i++)
+        {
+            vec.push_back(i);
+        }
+        allocations += vec.instrumentation().statistics().m_allocations;
+    }
+
+    const auto snapshot = pel::instrumentation_registry::instance().snapshot();
+    const auto found    = snapshot.find("int");
+    PEL_CHECK(found != snapshot.end());
+    if(found != snapshot.end())
+    {
+        PEL_CHECK(found->second.m_allocations == allocations);
+        PEL_CHECK(found->second.m_deallocations == allocations);
+    }
+
+    std::ostringstream json;
+    pel::instrumentation_registry::instance().write_json(json);
+    PEL_CHECK(json.str().find("\"int\"") != std::string::npos);
+}
+
+void
+testStaticVectorsRecordIntoTheRegistry()
+{
+    for(int i = 0; i < 100; i++)
+    {
+        staticVector.push_back(i);
+    }
+    PEL_CHECK(staticVector.instrumentation().statistics().m_allocations != 0);
+}
+
+}        // namespace
+
+
+int
+main()
+{
+    pel::test::run("records every reallocation", testRecordsEveryReallocation);
+    pel::test::run("history keeps the latest events", testHistoryKeepsTheLatestEvents);
+    pel::test::run("copies start their own statistics", testCopiesStartTheirOwnStatistics);
+    pel::test::run("destroyed vectors are merged by type", testDestroyedVectorsAreMergedByType);
+    pel::test::run("static vectors record into the registry",
+                   testStaticVectorsRecordIntoTheRegistry);
+    return pel::test::exit_code();
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
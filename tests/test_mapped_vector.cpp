@@ -0,0 +1,231 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./test.hpp"
+#include "../src/mapped_vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+
+namespace
+{
+/**
+ **************************************************************************************************
+ * \brief       Path of a temporary file, removed when the object is destroyed.
+ *************************************************************************************************/
+struct temporary_file
+{
+    std::filesystem::path m_path;
+
+    explicit temporary_file(const std::string& name_)
+    : m_path{std::filesystem::temp_directory_path() / ("pel_test_mapped_vector_" + name_)}
+    {
+        std::filesystem::remove(m_path);
+    }
+    temporary_file(const temporary_file&) = delete;
+    temporary_file& operator=(const temporary_file&) = delete;
+    ~temporary_file() { std::filesystem::remove(m_path); }
+
+    [[nodiscard]] std::size_t
+    size() const
+    {
+        return std::filesystem::file_size(m_path);
+    }
+};
+
+void
+writeIntegers(const std::filesystem::path& path_, const std::vector<std::int32_t>& values_)
+{
+    std::ofstream os{path_, std::ios::binary | std::ios::trunc};
+    os.write(reinterpret_cast<const char*>(values_.data()),
+             static_cast<std::streamsize>(values_.size() * sizeof(std::int32_t)));
+}
+
+std::vector<std::int32_t>
+readIntegers(const std::filesystem::path& path_)
+{
+    std::ifstream             is{path_, std::ios::binary};
+    std::vector<std::int32_t> values(std::filesystem::file_size(path_) / sizeof(std::int32_t));
+    is.read(reinterpret_cast<char*>(values.data()),
+            static_cast<std::streamsize>(values.size() * sizeof(std::int32_t)));
+    return values;
+}
+
+using MappedIntegers = pel::mapped_vector<std::int32_t>;
+
+
+/*------------------------------------*/
+/* Opening files */
+
+void
+testExistingFileIsAdopted()
+{
+    const temporary_file file{"adopted"};
+    writeIntegers(file.m_path, {1, 2, 3, 4, 5});
+
+    MappedIntegers vec{file.m_path, pel::mapped_file_mode::open_existing};
+    PEL_CHECK(pel::test::holds(vec, {1, 2, 3, 4, 5}));
+    PEL_CHECK(vec.capacity() == 5);
+    PEL_CHECK(vec.path() == file.m_path);
+}
+
+void
+testLargeFileIsMappedWithoutBeingRead()
+{
+    /* A sparse file far larger than what the test could read in its time budget */
+    constexpr std::size_t length = std::size_t{1} << 28;
+    const temporary_file  file{"sparse"};
+    {
+        std::ofstream create{file.m_path, std::ios::binary};
+    }
+    std::filesystem::resize_file(file.m_path, length * sizeof(std::int32_t));
+
+    MappedIntegers vec{file.m_path};
+    PEL_CHECK(vec.length() == length);
+    PEL_CHECK(vec[length / 2] == 0);
+
+    vec[length - 1] = 42;
+    PEL_CHECK(vec.back() == 42);
+}
+
+void
+testInvalidFilesAreRejected()
+{
+    const temporary_file file{"invalid"};
+    {
+        std::ofstream os{file.m_path, std::ios::binary};
+        os << "abcdef";
+    }
+
+    PEL_CHECK_THROWS(MappedIntegers(file.m_path), std::invalid_argument);
+
+    /* Elements are written through the mapping, which a read-only file cannot provide */
+    writeIntegers(file.m_path, {1, 2});
+    PEL_CHECK_THROWS(MappedIntegers(file.m_path, pel::mapped_file_mode::read_only),
+                     std::invalid_argument);
+    PEL_CHECK(readIntegers(file.m_path) == (std::vector<std::int32_t>{1, 2}));
+
+    const temporary_file missing{"missing"};
+    PEL_CHECK_THROWS(MappedIntegers(missing.m_path, pel::mapped_file_mode::open_existing),
+                     std::system_error);
+    PEL_CHECK(!std::filesystem::exists(missing.m_path));
+}
+
+
+/*------------------------------------*/
+/* Writing files */
+
+void
+testReserveGrowsTheFile()
+{
+    const temporary_file file{"reserve"};
+    MappedIntegers       vec{file.m_path, pel::mapped_file_mode::truncate};
+    PEL_CHECK(file.size() == 0);
+
+    vec.reserve(1'000);
+    PEL_CHECK(vec.capacity() >= 1'000);
+    PEL_CHECK(file.size() == vec.capacity() * sizeof(std::int32_t));
+
+    for(std::int32_t i = 0; i < 5'000; i++)
+    {
+        vec.push_back(i);
+    }
+    PEL_CHECK(file.size() == vec.capacity() * sizeof(std::int32_t));
+    PEL_CHECK(vec[4'999] == 4'999);
+}
+
+void
+testFlushWritesTheElements()
+{
+    const temporary_file file{"flush"};
+    MappedIntegers       vec{file.m_path, pel::mapped_file_mode::truncate};
+    vec.push_back({10, 20, 30});
+    vec[1] = 25;
+
+    vec.flush();
+    const std::vector<std::int32_t> content = readIntegers(file.m_path);
+    PEL_CHECK(content.size() == vec.capacity());
+    PEL_CHECK(content[0] == 10 && content[1] == 25 && content[2] == 30);
+
+    vec.push_back(40);
+    vec.flush(true);
+    PEL_CHECK(readIntegers(file.m_path)[3] == 40);
+}
+
+void
+testDestructorTruncatesTheFile()
+{
+    const temporary_file file{"truncate"};
+    {
+        MappedIntegers vec{file.m_path};
+        vec.reserve(100);
+        vec.push_back({1, 2, 3});
+        PEL_CHECK(file.size() == vec.capacity() * sizeof(std::int32_t));
+    }
+    PEL_CHECK(file.size() == 3 * sizeof(std::int32_t));
+    PEL_CHECK(readIntegers(file.m_path) == (std::vector<std::int32_t>{1, 2, 3}));
+
+    /* Reopening adopts the truncated content */
+    {
+        MappedIntegers vec{file.m_path};
+        PEL_CHECK(pel::test::holds(vec, {1, 2, 3}));
+        vec.pop_back();
+    }
+    PEL_CHECK(readIntegers(file.m_path) == (std::vector<std::int32_t>{1, 2}));
+}
+
+/* The mapping cannot be moved out through a reference to the underlying vector */
+static_assert(!std::is_convertible_v<MappedIntegers&, MappedIntegers::VectorType&>);
+
+}        // namespace
+
+
+int
+main()
+{
+#if PEL_MAPPED_FILE_POSIX
+    pel::test::run("existing file is adopted", testExistingFileIsAdopted);
+    pel::test::run("large file is mapped without being read",
+                   testLargeFileIsMappedWithoutBeingRead);
+    pel::test::run("invalid files are rejected", testInvalidFilesAreRejected);
+    pel::test::run("reserve grows the file", testReserveGrowsTheFile);
+    pel::test::run("flush writes the elements", testFlushWritesTheElements);
+    pel::test::run("destructor truncates the file", testDestructorTruncatesTheFile);
+#endif
+    return pel::test::exit_code();
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,367 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./test.hpp"
+#include "../src/arena.hpp"
+#include "../src/realloc_allocator.hpp"
+#include "../src/small_vector.hpp"
+#include "../src/vector.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+
+namespace
+{
+using pel::test::counted;
+using pel::test::holds;
+using pel::test::longText;
+using pel::test::tracking_resource;
+
+template<typename ItemType>
+using PmrVector = pel::vector<ItemType, std::pmr::polymorphic_allocator<ItemType>>;
+
+template<typename ItemType, std::size_t InlineCapacity>
+using PmrSmallVector =
+  pel::small_vector<ItemType, InlineCapacity, std::pmr::polymorphic_allocator<ItemType>>;
+
+/**
+ **************************************************************************************************
+ * \brief       Stateful allocator propagating on move assignment, whose tag tells which instance
+ *              allocated a vector's memory.
+ *************************************************************************************************/
+template<typename ItemType>
+struct propagating_allocator
+{
+    using value_type                             = ItemType;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal                        = std::false_type;
+
+    int m_tag = 0;
+
+    propagating_allocator() noexcept = default;
+    explicit propagating_allocator(int tag_) noexcept : m_tag{tag_} {}
+    template<typename OtherType>
+    propagating_allocator(const propagating_allocator<OtherType>& other_) noexcept
+    : m_tag{other_.m_tag}
+    {
+    }
+
+    [[nodiscard]] ItemType* allocate(std::size_t count_)
+    {
+        return std::allocator<ItemType>{}.allocate(count_);
+    }
+    void deallocate(ItemType* ptr_, std::size_t count_) noexcept
+    {
+        std::allocator<ItemType>{}.deallocate(ptr_, count_);
+    }
+
+    template<typename OtherType>
+    friend bool operator==(const propagating_allocator&            lhs_,
+                           const propagating_allocator<OtherType>& rhs_) noexcept
+    {
+        return lhs_.m_tag == rhs_.m_tag;
+    }
+};
+
+pel::vector<counted>
+makeVector(int length_)
+{
+    pel::vector<counted> vec;
+    for(int i = 0; i < length_; i++)
+    {
+        vec.push_back(i);
+    }
+    return vec;
+}
+
+
+/*------------------------------------*/
+/* Move construction */
+
+void
+testMoveConstructorStealsTheMemory()
+{
+    pel::vector<counted> source{0, 1, 2};
+    const counted* const memory = source.data();
+
+    pel::vector<counted> moved(std::move(source));
+    PEL_CHECK(holds(moved, {0, 1, 2}));
+    PEL_CHECK(moved.data() == memory);
+    PEL_CHECK(source.length() == 0);
+    PEL_CHECK(source.capacity() == 0);
+    PEL_CHECK(counted::s_live == 3);
+
+    source.push_back(3);
+    PEL_CHECK(holds(source, {3}));
+
+    const pel::vector<counted> returned = makeVector(4);
+    PEL_CHECK(holds(returned, {0, 1, 2, 3}));
+}
+
+void
+testMoveConstructorKeepsThePmrResource()
+{
+    tracking_resource resource;
+    {
+        PmrVector<std::string> source(0, &resource);
+        source.push_back(longText);
+
+        PmrVector<std::string> moved(std::move(source));
+        PEL_CHECK(moved.get_allocator().resource() == &resource);
+        for(int i = 0; i < 16; i++)
+        {
+            moved.push_back(longText);
+        }
+        PEL_CHECK(moved.length() == 17);
+    }
+    PEL_CHECK(resource.outstanding() == 0);
+
+    {
+        std::byte                           buffer[4096];
+        std::pmr::monotonic_buffer_resource bufferArena{buffer, sizeof(buffer), &resource};
+
+        PmrVector<int> source(0, &bufferArena);
+        source.push_back({0, 1, 2, 3});
+        PmrVector<int> moved(std::move(source));
+        moved.push_back(4);
+        PEL_CHECK(holds(moved, {0, 1, 2, 3, 4}));
+        PEL_CHECK(moved.get_allocator().resource() == &bufferArena);
+    }
+}
+
+void
+testMoveConstructorWithAnotherAllocatorMovesTheElements()
+{
+    tracking_resource first;
+    tracking_resource second;
+    {
+        PmrVector<counted> source({0, 1, 2}, &first);
+        const counted* const memory = source.data();
+
+        PmrVector<counted> same(std::move(source), &first);
+        PEL_CHECK(same.data() == memory);
+        PEL_CHECK(source.capacity() == 0);
+
+        PmrVector<counted> other(std::move(same), &second);
+        PEL_CHECK(holds(other, {0, 1, 2}));
+        PEL_CHECK(other.get_allocator().resource() == &second);
+        PEL_CHECK(same.length() == 0);
+        PEL_CHECK(same.data() == memory);
+        PEL_CHECK(counted::s_live == 3);
+        PEL_CHECK(second.outstanding() > 0);
+    }
+    PEL_CHECK(first.outstanding() == 0);
+    PEL_CHECK(second.outstanding() == 0);
+    PEL_CHECK(counted::s_live == 0);
+}
+
+void
+testMoveConstructorFromAnotherAllocatorTypeMovesTheElements()
+{
+    pel::vector<counted, pel::realloc_allocator<counted>> source{0, 1, 2};
+
+    pel::vector<counted> moved(std::move(source));
+    PEL_CHECK(holds(moved, {0, 1, 2}));
+    PEL_CHECK(source.length() == 0);
+    PEL_CHECK(counted::s_live == 3);
+}
+
+void
+testArenaVectorsAreMovable()
+{
+    using ArenaVector = pel::vector<std::string, pel::arena_allocator<std::string>>;
+
+    pel::arena  arena;
+    ArenaVector source(0, pel::arena_allocator<std::string>{arena});
+    source.push_back(longText);
+
+    ArenaVector moved(std::move(source));
+    moved.push_back(longText);
+    PEL_CHECK(moved.length() == 2);
+    PEL_CHECK(moved.get_allocator().get_arena() == &arena);
+}
+
+
+
+/*------------------------------------*/
+/* Move assignment */
+
+void
+testMoveAssignmentStealsTheMemory()
+{
+    pel::vector<counted> source{0, 1, 2};
+    pel::vector<counted> target{7, 7};
+    const counted* const memory = source.data();
+
+    target = std::move(source);
+    PEL_CHECK(holds(target, {0, 1, 2}));
+    PEL_CHECK(target.data() == memory);
+    PEL_CHECK(source.capacity() == 0);
+    PEL_CHECK(counted::s_live == 3);
+
+    target = std::move(target);
+    PEL_CHECK(holds(target, {0, 1, 2}));
+
+    static_assert(std::is_nothrow_move_assignable_v<pel::vector<counted>>);
+}
+
+void
+testMoveAssignmentPropagatesTheAllocator()
+{
+    using Allocator = propagating_allocator<counted>;
+
+    pel::vector<counted, Allocator> source({0, 1, 2}, Allocator{1});
+    pel::vector<counted, Allocator> target({7, 7}, Allocator{2});
+    const counted* const memory = source.data();
+
+    target = std::move(source);
+    PEL_CHECK(holds(target, {0, 1, 2}));
+    PEL_CHECK(target.data() == memory);
+    PEL_CHECK(target.get_allocator().m_tag == 1);
+    PEL_CHECK(counted::s_live == 3);
+
+    static_assert(std::is_nothrow_move_assignable_v<pel::vector<counted, Allocator>>);
+}
+
+void
+testMoveAssignmentWithAnotherAllocatorMovesTheElements()
+{
+    tracking_resource first;
+    tracking_resource second;
+    {
+        PmrVector<counted> source({0, 1, 2}, &first);
+        PmrVector<counted> same({7}, &first);
+        PmrVector<counted> other({7, 7, 7, 7, 7, 7}, &second);
+        const counted* const memory = source.data();
+
+        same = std::move(source);
+        PEL_CHECK(same.data() == memory);
+        PEL_CHECK(source.capacity() == 0);
+
+        other = std::move(same);
+        PEL_CHECK(holds(other, {0, 1, 2}));
+        PEL_CHECK(other.get_allocator().resource() == &second);
+        PEL_CHECK(same.length() == 0);
+        PEL_CHECK(same.data() == memory);
+        PEL_CHECK(counted::s_live == 3);
+
+        pel::vector<counted> otherType{7};
+        otherType = std::move(other);
+        PEL_CHECK(holds(otherType, {0, 1, 2}));
+        PEL_CHECK(other.length() == 0);
+        PEL_CHECK(counted::s_live == 3);
+    }
+    PEL_CHECK(first.outstanding() == 0);
+    PEL_CHECK(second.outstanding() == 0);
+}
+
+
+/*------------------------------------*/
+/* small_vector */
+
+void
+testSmallVectorMovesBetweenStorages()
+{
+    tracking_resource first;
+    tracking_resource second;
+    {
+        PmrSmallVector<counted, 4> inlineSource({0, 1}, &first);
+        PmrSmallVector<counted, 4> heapSource({0, 1, 2, 3, 4, 5}, &first);
+        PmrSmallVector<counted, 4> stolenSource({0, 1, 2, 3, 4}, &first);
+        const counted* const       stolenMemory = stolenSource.data();
+
+        /* Inline elements into a heap small_vector using another upstream */
+        PmrSmallVector<counted, 4> heapTarget({7, 7, 7, 7, 7, 7}, &second);
+        heapTarget = std::move(inlineSource);
+        PEL_CHECK(holds(heapTarget, {0, 1}));
+        PEL_CHECK(heapTarget.get_allocator().upstream().resource() == &second);
+        PEL_CHECK(inlineSource.length() == 0);
+
+        /* Heap elements into an inline small_vector using another upstream */
+        PmrSmallVector<counted, 4> inlineTarget({7}, &second);
+        inlineTarget = std::move(heapSource);
+        PEL_CHECK(holds(inlineTarget, {0, 1, 2, 3, 4, 5}));
+        PEL_CHECK(inlineTarget.get_allocator().upstream().resource() == &second);
+        PEL_CHECK(heapSource.length() == 0);
+
+        /* Heap memory is stolen when the upstreams are equal */
+        PmrSmallVector<counted, 4> sameTarget({7}, &first);
+        sameTarget = std::move(stolenSource);
+        PEL_CHECK(holds(sameTarget, {0, 1, 2, 3, 4}));
+        PEL_CHECK(sameTarget.data() == stolenMemory);
+        PEL_CHECK(stolenSource.is_inline());
+        PEL_CHECK(stolenSource.length() == 0);
+
+        /* Heap memory back into a small_vector which then fits inline */
+        PmrSmallVector<counted, 4> moved{std::move(sameTarget)};
+        PEL_CHECK(moved.data() == stolenMemory);
+        sameTarget.push_back(9);
+        PEL_CHECK(holds(sameTarget, {9}));
+        PEL_CHECK(sameTarget.is_inline());
+
+        PEL_CHECK(counted::s_live == 2 + 6 + 5 + 1);
+    }
+    PEL_CHECK(first.outstanding() == 0);
+    PEL_CHECK(second.outstanding() == 0);
+    PEL_CHECK(counted::s_live == 0);
+}
+
+/* The inline buffer cannot be moved out through a reference to the underlying vector */
+static_assert(!std::is_convertible_v<pel::small_vector<counted, 4>&,
+                                     pel::small_vector<counted, 4>::VectorType&>);
+
+}        // namespace
+
+
+int
+main()
+{
+    pel::test::run("move constructor steals the memory", testMoveConstructorStealsTheMemory);
+    pel::test::run("move constructor keeps the pmr resource",
+                   testMoveConstructorKeepsThePmrResource);
+    pel::test::run("move constructor with another allocator moves the elements",
+                   testMoveConstructorWithAnotherAllocatorMovesTheElements);
+    pel::test::run("move constructor from another allocator type moves the elements",
+                   testMoveConstructorFromAnotherAllocatorTypeMovesTheElements);
+    pel::test::run("arena vectors are movable", testArenaVectorsAreMovable);
+    pel::test::run("move assignment steals the memory", testMoveAssignmentStealsTheMemory);
+    pel::test::run("move assignment propagates the allocator",
+                   testMoveAssignmentPropagatesTheAllocator);
+    pel::test::run("move assignment with another allocator moves the elements",
+                   testMoveAssignmentWithAnotherAllocatorMovesTheElements);
+    pel::test::run("small_vector moves between inline and heap storage",
+                   testSmallVectorMovesBetweenStorages);
+    pel::test::run("counted elements are all destroyed", [] { PEL_CHECK(counted::s_live == 0); });
+    return pel::test::exit_code();
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
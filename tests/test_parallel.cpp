@@ -0,0 +1,91 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./test.hpp"
+#include "../src/vector.hpp"
+#include "../src/vector_parallel.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+
+
+namespace
+{
+using pel::test::counted;
+
+void
+testEveryElementIsGenerated()
+{
+    for(const std::size_t length : {std::size_t{0},
+                                    std::size_t{1},
+                                    pel::vector_parallel_grain - 1,
+                                    3 * pel::vector_parallel_grain + 5})
+    {
+        const pel::vector<std::size_t> vec(pel::parallel,
+                                           length,
+                                           [](std::size_t index_) { return index_ * 3; });
+        PEL_CHECK(vec.length() == length);
+
+        bool matches = true;
+        for(std::size_t i = 0; i < vec.length(); i++)
+        {
+            matches = matches && vec[i] == i * 3;
+        }
+        PEL_CHECK(matches);
+    }
+}
+
+void
+testGeneratorExceptionIsRethrown()
+{
+    const std::size_t length   = 4 * pel::vector_parallel_grain;
+    const auto        generate = [](std::size_t index_)
+    {
+        if(index_ == 2 * pel::vector_parallel_grain + 1)
+        {
+            throw std::runtime_error("generator failure");
+        }
+        return counted{static_cast<int>(index_)};
+    };
+
+    PEL_CHECK_THROWS((pel::vector<counted>(pel::parallel, length, generate)), std::runtime_error);
+    PEL_CHECK(counted::s_live == 0);
+}
+
+}        // namespace
+
+
+int
+main()
+{
+    pel::test::run("every element is generated", testEveryElementIsGenerated);
+    pel::test::run("generator exception is rethrown", testGeneratorExceptionIsRethrown);
+    return pel::test::exit_code();
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,223 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./test.hpp"
+#include "../src/arena.hpp"
+#include "../src/realloc_allocator.hpp"
+#include "../src/small_vector.hpp"
+#include "../src/vector.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+
+namespace
+{
+using pel::test::counted;
+using pel::test::holds;
+using pel::test::longText;
+using pel::test::throwing_item;
+
+
+/*------------------------------------*/
+/* push_back and emplace_back */
+
+void
+testPushBackCopiesAndMoves()
+{
+    pel::vector<counted> vec;
+    const counted        copied{1};
+    counted              moved{2};
+
+    vec.push_back(copied);
+    vec.push_back(std::move(moved));
+    vec.emplace_back(3);
+    PEL_CHECK(holds(vec, {1, 2, 3}));
+    PEL_CHECK(copied.m_text == "counted element");
+    PEL_CHECK(moved.m_text.empty());
+}
+
+void
+testPushBackAppendsVectors()
+{
+    pel::vector<counted>       vec{0, 1};
+    const pel::vector<counted> copied{2, 3};
+    pel::vector<counted>       moved{4, 5};
+
+    vec.push_back(copied);
+    vec.push_back(std::move(moved));
+    vec.push_back({6, 7});
+    PEL_CHECK(holds(vec, {0, 1, 2, 3, 4, 5, 6, 7}));
+    PEL_CHECK(holds(copied, {2, 3}));
+    PEL_CHECK(moved.length() == 0);
+}
+
+void
+testFailedEmplaceBackLeavesTheVectorUnchanged()
+{
+    pel::vector<throwing_item> vec{0, 1, 2};
+    vec.shrink_to_fit();
+    PEL_CHECK_THROWS(vec.emplace_back(-1), std::runtime_error);
+    PEL_CHECK(holds(vec, {0, 1, 2}));
+
+    vec.reserve(8);
+    PEL_CHECK_THROWS(vec.emplace_back(-1), std::runtime_error);
+    PEL_CHECK(holds(vec, {0, 1, 2}));
+}
+
+
+/*------------------------------------*/
+/* Self-referencing arguments */
+
+/**
+ **************************************************************************************************
+ * \brief       Append copies of elements of the vector to itself, through every growth, so that
+ *              the arguments refer to elements that are moved by the growth.
+ *************************************************************************************************/
+template<typename VectorType>
+void
+appendElementsOfItself(VectorType& vec_, std::size_t count_)
+{
+    for(std::size_t i = 0; i < count_; i++)
+    {
+        if(i % 2 == 0)
+        {
+            vec_.emplace_back(vec_.data()[0]);
+        }
+        else
+        {
+            vec_.push_back(vec_.data()[vec_.length() - 1]);
+        }
+    }
+}
+
+template<typename VectorType>
+bool
+holdsOnly(const VectorType& vec_, const std::string& value_, std::size_t length_)
+{
+    return vec_.length() == length_
+           && std::all_of(vec_.begin(), vec_.end(), [&](const std::string& item_)
+                          { return item_ == value_; });
+}
+
+template<typename AllocatorType>
+void
+testEmplaceBackCopiesElementsOfItself()
+{
+    pel::vector<std::string, AllocatorType> vec{longText};
+    appendElementsOfItself(vec, 100);
+    PEL_CHECK(holdsOnly(vec, longText, 101));
+}
+
+void
+testEmplaceBackCopiesElementsOfItselfInAnArena()
+{
+    /* Both vectors allocate from the same arena, so neither can always grow in place */
+    using ArenaVector = pel::vector<std::string, pel::arena_allocator<std::string>>;
+
+    pel::arena                              arena{std::size_t{256}};
+    const pel::arena_allocator<std::string> alloc{arena};
+    ArenaVector                             first(0, alloc);
+    ArenaVector                             second(0, alloc);
+    first.push_back(longText);
+    second.push_back(longText);
+
+    for(int i = 0; i < 50; i++)
+    {
+        appendElementsOfItself(first, 1);
+        appendElementsOfItself(second, 2);
+    }
+    PEL_CHECK(holdsOnly(first, longText, 51));
+    PEL_CHECK(holdsOnly(second, longText, 101));
+}
+
+void
+testEmplaceBackCopiesElementsOfItselfInASmallVector()
+{
+    pel::small_vector<std::string, 2> vec{longText, longText};
+    PEL_CHECK(vec.is_inline());
+
+    /* The first growth leaves the inline buffer */
+    appendElementsOfItself(vec, 40);
+    PEL_CHECK(!vec.is_inline());
+    PEL_CHECK(holdsOnly(vec, longText, 42));
+}
+
+template<typename AllocatorType>
+void
+testPushBackAppendsItself()
+{
+    pel::vector<int, AllocatorType> numbers{1, 2, 3};
+    numbers.shrink_to_fit();
+    numbers.push_back(numbers);
+    PEL_CHECK(holds(numbers, {1, 2, 3, 1, 2, 3}));
+
+    /* Moving a vector at its own end copies its elements */
+    numbers.shrink_to_fit();
+    numbers.push_back(std::move(numbers));
+    PEL_CHECK(holds(numbers, {1, 2, 3, 1, 2, 3, 1, 2, 3, 1, 2, 3}));
+
+    using StringAllocatorType =
+      typename std::allocator_traits<AllocatorType>::template rebind_alloc<std::string>;
+    pel::vector<std::string, StringAllocatorType> texts{longText};
+    texts.shrink_to_fit();
+    texts.push_back(texts);
+    texts.push_back(std::move(texts));
+    PEL_CHECK(holdsOnly(texts, longText, 4));
+}
+
+}        // namespace
+
+
+int
+main()
+{
+    pel::test::run("push_back copies and moves", testPushBackCopiesAndMoves);
+    pel::test::run("push_back appends vectors", testPushBackAppendsVectors);
+    pel::test::run("failed emplace_back leaves the vector unchanged",
+                   testFailedEmplaceBackLeavesTheVectorUnchanged);
+    pel::test::run("emplace_back copies elements of itself (std::allocator)",
+                   testEmplaceBackCopiesElementsOfItself<std::allocator<std::string>>);
+    pel::test::run("emplace_back copies elements of itself (realloc_allocator)",
+                   testEmplaceBackCopiesElementsOfItself<pel::realloc_allocator<std::string>>);
+    pel::test::run("emplace_back copies elements of itself (arena_allocator)",
+                   testEmplaceBackCopiesElementsOfItselfInAnArena);
+    pel::test::run("emplace_back copies elements of itself (small_vector)",
+                   testEmplaceBackCopiesElementsOfItselfInASmallVector);
+    pel::test::run("push_back appends the vector itself (std::allocator)",
+                   testPushBackAppendsItself<std::allocator<int>>);
+    pel::test::run("push_back appends the vector itself (realloc_allocator)",
+                   testPushBackAppendsItself<pel::realloc_allocator<int>>);
+    pel::test::run("counted elements are all destroyed", [] { PEL_CHECK(counted::s_live == 0); });
+    return pel::test::exit_code();
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,165 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./test.hpp"
+#include "../src/instrumentation_policy.hpp"
+#include "../src/realloc_allocator.hpp"
+#include "../src/vector.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <numeric>
+
+
+namespace
+{
+/* Blocks of 64 KiB and more are mapped, to keep the tests small */
+constexpr std::size_t threshold  = std::size_t{64} * 1024;
+constexpr std::size_t mappedInts = threshold / sizeof(int);
+
+using Allocator = pel::realloc_allocator<int, threshold>;
+
+using TrackedVector = pel::vector<int, Allocator, pel::growth_2x, pel::allocation_tracker<>>;
+
+bool
+holds_iota(const int* data_, std::size_t length_)
+{
+    for(std::size_t i = 0; i < length_; i++)
+    {
+        if(data_[i] != static_cast<int>(i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/*------------------------------------*/
+/* Allocation */
+
+void
+testOversizedCountsAreRejected()
+{
+    Allocator         alloc;
+    const std::size_t tooMany = std::numeric_limits<std::size_t>::max() / sizeof(int);
+
+    PEL_CHECK_THROWS(alloc.allocate(tooMany), std::bad_array_new_length);
+    PEL_CHECK_THROWS(alloc.allocate(std::numeric_limits<std::size_t>::max()),
+                     std::bad_array_new_length);
+
+    int* ptr = alloc.allocate(mappedInts);
+    PEL_CHECK(!alloc.expand_in_place(ptr, mappedInts, tooMany));
+    PEL_CHECK_THROWS(alloc.reallocate(ptr, mappedInts, tooMany), std::bad_array_new_length);
+    alloc.deallocate(ptr, mappedInts);
+}
+
+void
+testReallocateKeepsTheElements()
+{
+    Allocator alloc;
+
+    /* Heap to heap */
+    int* ptr = alloc.allocate(16);
+    std::iota(ptr, ptr + 16, 0);
+    ptr = alloc.reallocate(ptr, 16, 64);
+    PEL_CHECK(holds_iota(ptr, 16));
+
+    /* Heap to mapping, crossing the threshold */
+    std::iota(ptr, ptr + 64, 0);
+    ptr = alloc.reallocate(ptr, 64, mappedInts);
+    PEL_CHECK(holds_iota(ptr, 64));
+
+    /* Mapping to mapping, with mremap */
+    std::iota(ptr, ptr + mappedInts, 0);
+    ptr = alloc.reallocate(ptr, mappedInts, 16 * mappedInts);
+    PEL_CHECK(holds_iota(ptr, mappedInts));
+
+    /* Mappings resized in place keep their address */
+    std::iota(ptr, ptr + 16 * mappedInts, 0);
+    if(alloc.expand_in_place(ptr, 16 * mappedInts, 32 * mappedInts))
+    {
+        PEL_CHECK(holds_iota(ptr, 16 * mappedInts));
+        std::iota(ptr, ptr + 32 * mappedInts, 0);
+        PEL_CHECK(holds_iota(ptr, 32 * mappedInts));
+        PEL_CHECK(alloc.expand_in_place(ptr, 32 * mappedInts, 16 * mappedInts));
+    }
+
+    /* Back under the threshold */
+    ptr = alloc.reallocate(ptr, 16 * mappedInts, 32);
+    PEL_CHECK(holds_iota(ptr, 32));
+
+    PEL_CHECK(alloc.reallocate(ptr, 32, 0) == nullptr);
+}
+
+
+/*------------------------------------*/
+/* pel::vector */
+
+void
+testVectorGrowsAcrossTheThreshold()
+{
+    TrackedVector vec;
+    for(std::size_t i = 0; i < 64 * mappedInts; i++)
+    {
+        vec.push_back(static_cast<int>(i));
+    }
+    PEL_CHECK(vec.capacity() >= 64 * mappedInts);
+    PEL_CHECK(holds_iota(vec.data(), vec.length()));
+
+    /* The block is grown by the allocator (realloc/mremap), the elements are never relocated */
+    const pel::allocation_tracker<>& tracker = vec.instrumentation();
+    PEL_CHECK(tracker.history(0).m_kind == pel::reallocation_kind::allocate);
+    for(std::size_t i = 1; i < tracker.history_length(); i++)
+    {
+        const pel::reallocation_kind kind = tracker.history(i).m_kind;
+        PEL_CHECK(kind == pel::reallocation_kind::bitwise
+                  || kind == pel::reallocation_kind::in_place);
+    }
+
+    /* Shrinking back under the threshold returns the block to the heap */
+    vec.resize(100);
+    vec.shrink_to_fit();
+    PEL_CHECK(vec.capacity() == 100);
+    PEL_CHECK(holds_iota(vec.data(), vec.length()));
+}
+
+}        // namespace
+
+
+int
+main()
+{
+    pel::test::run("oversized counts are rejected", testOversizedCountsAreRejected);
+    pel::test::run("reallocate keeps the elements", testReallocateKeepsTheElements);
+    pel::test::run("vector grows across the threshold", testVectorGrowsAcrossTheThreshold);
+    return pel::test::exit_code();
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
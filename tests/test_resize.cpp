@@ -0,0 +1,204 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./test.hpp"
+#include "../src/vector.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+
+namespace
+{
+using pel::test::counted;
+using pel::test::holds;
+
+
+/*------------------------------------*/
+/* resize */
+
+void
+testResizeValueInitializes()
+{
+    pel::vector<int, std::allocator<int>> vec{1, 2};
+    vec.resize(5);
+    PEL_CHECK(holds(vec, {1, 2, 0, 0, 0}));
+
+    vec.resize(1);
+    PEL_CHECK(holds(vec, {1}));
+    PEL_CHECK(vec.capacity() >= 5);
+}
+
+void
+testResizeCopiesTheValue()
+{
+    {
+        pel::vector<counted> vec{1};
+        vec.resize(4, counted{7});
+        PEL_CHECK(holds(vec, {1, 7, 7, 7}));
+        PEL_CHECK(counted::s_live == 4);
+
+        vec.resize(2, counted{9});
+        PEL_CHECK(holds(vec, {1, 7}));
+        PEL_CHECK(counted::s_live == 2);
+
+        vec.resize(0, counted{9});
+        PEL_CHECK(vec.length() == 0);
+        PEL_CHECK(counted::s_live == 0);
+    }
+
+    pel::vector<std::string> texts;
+    texts.resize(3, "text");
+    PEL_CHECK(holds(texts, {std::string{"text"}, std::string{"text"}, std::string{"text"}}));
+}
+
+void
+testResizeDefaultInit()
+{
+    pel::vector<int, std::allocator<int>> numbers{1, 2};
+    numbers.resize_default_init(4);
+    PEL_CHECK(numbers.length() == 4);
+    PEL_CHECK(numbers[0] == 1 && numbers[1] == 2);
+    numbers.resize_default_init(1);
+    PEL_CHECK(holds(numbers, {1}));
+
+    /* Types with a default constructor are still value-initialized */
+    {
+        pel::vector<counted> vec{5};
+        vec.resize_default_init(3);
+        PEL_CHECK(holds(vec, {5, 0, 0}));
+        PEL_CHECK(counted::s_live == 3);
+    }
+    PEL_CHECK(counted::s_live == 0);
+}
+
+
+/*------------------------------------*/
+/* resize_for_overwrite */
+
+void
+testResizeForOverwriteWritesInPlace()
+{
+    pel::vector<char, std::allocator<char>> buffer{'a', 'b'};
+    const char*                             written = nullptr;
+
+    buffer.resize_for_overwrite(6,
+                                [&](char* data_, std::size_t length_)
+                                {
+                                    written = data_;
+                                    std::fill_n(data_ + 2, length_ - 2, 'x');
+                                    return length_;
+                                });
+    PEL_CHECK(written == buffer.data());
+    PEL_CHECK(holds(buffer, {'a', 'b', 'x', 'x', 'x', 'x'}));
+}
+
+void
+testResizeForOverwriteKeepsTheReturnedLength()
+{
+    pel::vector<char, std::allocator<char>> buffer{'a'};
+    buffer.resize_for_overwrite(64,
+                                [](char* data_, std::size_t)
+                                {
+                                    data_[1] = 'b';
+                                    data_[2] = 'c';
+                                    return std::size_t{3};
+                                });
+    PEL_CHECK(holds(buffer, {'a', 'b', 'c'}));
+    PEL_CHECK(buffer.capacity() >= 64);
+
+    /* Shrinking through the operation */
+    buffer.resize_for_overwrite(2, [](char*, std::size_t) { return std::size_t{1}; });
+    PEL_CHECK(holds(buffer, {'a'}));
+
+    {
+        pel::vector<counted> vec{1, 2};
+        vec.resize_for_overwrite(8,
+                                 [](counted* data_, std::size_t)
+                                 {
+                                     data_[2] = counted{3};
+                                     return std::size_t{3};
+                                 });
+        PEL_CHECK(holds(vec, {1, 2, 3}));
+        PEL_CHECK(counted::s_live == 3);
+    }
+    PEL_CHECK(counted::s_live == 0);
+}
+
+void
+testResizeForOverwriteRestoresTheLengthOnFailure()
+{
+    pel::vector<char, std::allocator<char>> buffer{'a', 'b'};
+
+    PEL_CHECK_THROWS(buffer.resize_for_overwrite(16,
+                                                 [](char* data_, std::size_t) -> std::size_t
+                                                 {
+                                                     data_[2] = 'c';
+                                                     throw std::runtime_error{"read failure"};
+                                                 }),
+                     std::runtime_error);
+    PEL_CHECK(holds(buffer, {'a', 'b'}));
+
+    /* An operation claiming more elements than it was given is rejected */
+    PEL_CHECK_THROWS(buffer.resize_for_overwrite(
+                       4, [](char*, std::size_t length_) { return length_ + 1; }),
+                     std::length_error);
+    PEL_CHECK(holds(buffer, {'a', 'b'}));
+
+    {
+        pel::vector<counted> vec{1, 2};
+        PEL_CHECK_THROWS(vec.resize_for_overwrite(
+                           6, [](counted*, std::size_t) { return std::size_t{7}; }),
+                         std::length_error);
+        PEL_CHECK(holds(vec, {1, 2}));
+        PEL_CHECK(counted::s_live == 2);
+    }
+    PEL_CHECK(counted::s_live == 0);
+}
+
+}        // namespace
+
+
+int
+main()
+{
+    pel::test::run("resize value-initializes", testResizeValueInitializes);
+    pel::test::run("resize copies the value", testResizeCopiesTheValue);
+    pel::test::run("resize_default_init", testResizeDefaultInit);
+    pel::test::run("resize_for_overwrite writes in place", testResizeForOverwriteWritesInPlace);
+    pel::test::run("resize_for_overwrite keeps the returned length",
+                   testResizeForOverwriteKeepsTheReturnedLength);
+    pel::test::run("resize_for_overwrite restores the length on failure",
+                   testResizeForOverwriteRestoresTheLengthOnFailure);
+    return pel::test::exit_code();
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,261 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./test.hpp"
+#include "../src/serialization.hpp"
+#include "../src/vector.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+
+namespace
+{
+using pel::test::holds;
+using pel::test::longText;
+
+template<typename VectorType>
+[[nodiscard]] std::string
+serialize(const VectorType& vector_)
+{
+    std::ostringstream os{std::ios::binary};
+    pel::save(vector_, os);
+    return os.str();
+}
+
+template<typename VectorType>
+void
+deserialize(VectorType& vector_, const std::string& bytes_)
+{
+    std::istringstream is{bytes_, std::ios::binary};
+    pel::load(vector_, is);
+}
+
+/** Stream buffer that can't be seeked, like a pipe or a socket. */
+class unseekable_buffer : public std::stringbuf
+{
+public:
+    using std::stringbuf::stringbuf;
+
+protected:
+    pos_type
+    seekoff(off_type, std::ios::seekdir, std::ios::openmode) override
+    {
+        return pos_type(off_type(-1));
+    }
+    pos_type
+    seekpos(pos_type, std::ios::openmode) override
+    {
+        return pos_type(off_type(-1));
+    }
+};
+
+template<typename VectorType>
+void
+deserializeUnseekable(VectorType& vector_, const std::string& bytes_)
+{
+    unseekable_buffer buffer{bytes_, std::ios::in | std::ios::binary};
+    std::istream      is{&buffer};
+    pel::load(vector_, is);
+}
+
+/** Change the length and payload size claimed by the header of serialized bytes. */
+[[nodiscard]] std::string
+withClaimedSize(std::string bytes_, std::uint64_t length_, std::uint64_t payloadSize_)
+{
+    pel::serialization_header header;
+    std::memcpy(&header, bytes_.data(), sizeof(header));
+    header.m_length      = length_;
+    header.m_payloadSize = payloadSize_;
+    std::memcpy(bytes_.data(), &header, sizeof(header));
+    return bytes_;
+}
+
+
+/*------------------------------------*/
+/* Round trips */
+
+void
+testTriviallyCopyableRoundTrip()
+{
+    pel::vector<int> source;
+    for(int i = 0; i < 10000; i++)
+    {
+        source.push_back(i * 7 - 3);
+    }
+
+    pel::vector<int> loaded{1, 2, 3};
+    deserialize(loaded, serialize(source));
+    PEL_CHECK(loaded.length() == source.length());
+    PEL_CHECK(std::equal(source.begin(), source.end(), loaded.begin()));
+
+    const pel::vector<double> doubles{0.5, -1.25, 1e300};
+    pel::vector<double>       loadedDoubles;
+    deserialize(loadedDoubles, serialize(doubles));
+    PEL_CHECK(holds(loadedDoubles, {0.5, -1.25, 1e300}));
+
+    const pel::vector<int> empty;
+    deserialize(loaded, serialize(empty));
+    PEL_CHECK(loaded.length() == 0);
+}
+
+void
+testUnseekableStreamRoundTrip()
+{
+    /* More than one step of elements, so the payload is read in several blocks */
+    pel::vector<int> source;
+    for(int i = 0; i < 300000; i++)
+    {
+        source.push_back(i * 7 - 3);
+    }
+
+    pel::vector<int> loaded{1, 2, 3};
+    deserializeUnseekable(loaded, serialize(source));
+    PEL_CHECK(loaded.length() == source.length());
+    PEL_CHECK(std::equal(source.begin(), source.end(), loaded.begin()));
+
+    pel::vector<std::string> strings;
+    deserializeUnseekable(strings, serialize(pel::vector<std::string>{"short", longText}));
+    PEL_CHECK(holds(strings, {std::string{"short"}, longText}));
+}
+
+void
+testSerializerRoundTrip()
+{
+    const pel::vector<std::string> source{"", "short", longText, longText + longText};
+
+    pel::vector<std::string> loaded{"previous"};
+    deserialize(loaded, serialize(source));
+    PEL_CHECK(holds(loaded, {std::string{}, std::string{"short"}, longText, longText + longText}));
+}
+
+void
+testSerializedViewReadsTheFile()
+{
+    const std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "pel_test_serialization.bin";
+
+    const pel::vector<int> source{4, 8, 15, 16, 23, 42};
+    {
+        std::ofstream file{path, std::ios::binary};
+        pel::save(source, file);
+    }
+
+    {
+        const pel::serialized_view<int> view{path};
+        PEL_CHECK(view.length() == source.length());
+        PEL_CHECK(std::equal(view.begin(), view.end(), source.begin()));
+        PEL_CHECK(view.verify());
+        PEL_CHECK_THROWS(view.at(6), std::out_of_range);
+    }
+    std::filesystem::remove(path);
+}
+
+
+/*------------------------------------*/
+/* Invalid data */
+
+void
+testCorruptedDataIsRejected()
+{
+    const pel::vector<int> source{0, 1, 2, 3};
+    const std::string      bytes = serialize(source);
+
+    pel::vector<int> loaded{7, 7};
+
+    std::string corrupted = bytes;
+    corrupted.back()      = static_cast<char>(corrupted.back() ^ 0x5A);
+    PEL_CHECK_THROWS(deserialize(loaded, corrupted), pel::serialization_error);
+    PEL_CHECK(loaded.length() == 0);
+
+    PEL_CHECK_THROWS(deserialize(loaded, bytes.substr(0, bytes.size() - 1)),
+                     pel::serialization_error);
+    PEL_CHECK_THROWS(deserialize(loaded, std::string{"not a serialized vector"}),
+                     pel::serialization_error);
+
+    pel::vector<float> otherType;
+    PEL_CHECK_THROWS(deserialize(otherType, bytes), pel::serialization_error);
+
+    pel::vector<std::string> strings{"previous"};
+    std::string              stringBytes = serialize(pel::vector<std::string>{longText, longText});
+    stringBytes.back() = static_cast<char>(stringBytes.back() ^ 0x5A);
+    PEL_CHECK_THROWS(deserialize(strings, stringBytes), pel::serialization_error);
+    PEL_CHECK(strings.length() == 0);
+}
+
+void
+testHugeClaimedLengthIsRejected()
+{
+    /* The headers are consistent, but claim far more data than the streams hold */
+    constexpr std::uint64_t hugeLength = std::uint64_t{1} << 40;
+
+    const std::string ints = withClaimedSize(
+      serialize(pel::vector<int>{0, 1, 2, 3}), hugeLength, hugeLength * sizeof(int));
+
+    pel::vector<int> loaded{7, 7};
+    PEL_CHECK_THROWS(deserialize(loaded, ints), pel::serialization_error);
+    PEL_CHECK(loaded.length() == 0);
+    PEL_CHECK_THROWS(deserializeUnseekable(loaded, ints), pel::serialization_error);
+    PEL_CHECK(loaded.length() == 0);
+
+    /* The first chunk also claims to be huge */
+    std::string strings = withClaimedSize(
+      serialize(pel::vector<std::string>{longText}), hugeLength, hugeLength);
+    const std::uint64_t hugeChunk[2] = {hugeLength - 16, 1};
+    std::memcpy(strings.data() + sizeof(pel::serialization_header), hugeChunk, sizeof(hugeChunk));
+
+    pel::vector<std::string> loadedStrings{"previous"};
+    PEL_CHECK_THROWS(deserialize(loadedStrings, strings), pel::serialization_error);
+    PEL_CHECK(loadedStrings.length() == 0);
+    PEL_CHECK_THROWS(deserializeUnseekable(loadedStrings, strings), pel::serialization_error);
+    PEL_CHECK(loadedStrings.length() == 0);
+}
+
+}        // namespace
+
+
+int
+main()
+{
+    pel::test::run("trivially copyable elements round trip", testTriviallyCopyableRoundTrip);
+    pel::test::run("unseekable streams round trip", testUnseekableStreamRoundTrip);
+    pel::test::run("elements with a serializer round trip", testSerializerRoundTrip);
+    pel::test::run("serialized view reads the file", testSerializedViewReadsTheFile);
+    pel::test::run("corrupted data is rejected", testCorruptedDataIsRejected);
+    pel::test::run("huge claimed length is rejected", testHugeClaimedLengthIsRejected);
+    return pel::test::exit_code();
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
@@ -0,0 +1,148 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./test.hpp"
+#include "../src/simd.hpp"
+#include "../src/vector.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+
+
+namespace
+{
+/** Lengths covering empty ranges, ranges shorter than a register, and partial tails. */
+constexpr std::size_t testedLengths[] = {0, 1, 3, 7, 8, 15, 16, 17, 33, 64, 100, 1000};
+
+/**
+ **************************************************************************************************
+ * \brief       Compare every kernel against the standard algorithms, on every instruction set
+ *              supported by this machine, starting at aligned and unaligned addresses.
+ *              Values are small integers, so that floating-point sums are exact in any order.
+ *************************************************************************************************/
+template<typename ItemType>
+void
+testKernelsMatchTheStandardAlgorithms()
+{
+    using SumType = pel::simd::sum_type_t<ItemType>;
+
+    for(pel::simd::isa isa = pel::simd::isa::scalar; isa <= pel::simd::detect_isa();
+        isa                = static_cast<pel::simd::isa>(static_cast<int>(isa) + 1))
+    {
+        pel::simd::set_active_isa(isa);
+
+        for(const std::size_t length : testedLengths)
+        {
+            for(std::size_t offset = 0; offset < 2; offset++)
+            {
+                pel::vector<ItemType> storage(length + offset, ItemType{});
+                for(std::size_t i = 0; i < storage.length(); i++)
+                {
+                    storage[i] = static_cast<ItemType>(static_cast<int>(i * 7 % 23) - 11);
+                }
+                const ItemType* first = storage.data() + offset;
+                const ItemType* last  = first + length;
+
+                PEL_CHECK(pel::simd::find(first, last, ItemType{5}) == std::find(first, last, 5));
+                PEL_CHECK(pel::simd::find(first, last, ItemType{100}) == last);
+                PEL_CHECK(pel::simd::count(first, last, ItemType{-4})
+                          == static_cast<std::size_t>(std::count(first, last, ItemType{-4})));
+                PEL_CHECK(pel::simd::sum(first, last)
+                          == std::accumulate(first, last, SumType{}));
+                PEL_CHECK(pel::simd::dot(first, last, first)
+                          == std::inner_product(first, last, first, SumType{}));
+                if(length != 0)
+                {
+                    PEL_CHECK(pel::simd::minimum(first, last) == *std::min_element(first, last));
+                    PEL_CHECK(pel::simd::maximum(first, last) == *std::max_element(first, last));
+                }
+
+                ItemType* writable = storage.data() + offset;
+                pel::simd::fill(writable, writable + length, ItemType{9});
+                PEL_CHECK(std::count(writable, writable + length, ItemType{9})
+                          == static_cast<std::ptrdiff_t>(length));
+                if(offset != 0)
+                {
+                    PEL_CHECK(storage[0] == ItemType{-11});
+                }
+            }
+        }
+    }
+    pel::simd::set_active_isa(pel::simd::detect_isa());
+}
+
+void
+testContainerOverloads()
+{
+    pel::vector<int> vec{4, -2, 7, 7, 0};
+    PEL_CHECK(pel::simd::find(vec, 7) == vec.data() + 2);
+    PEL_CHECK(pel::simd::count(vec, 7) == 2);
+    PEL_CHECK(pel::simd::minimum(vec) == -2);
+    PEL_CHECK(pel::simd::maximum(vec) == 7);
+    PEL_CHECK(pel::simd::sum(vec) == 16);
+    PEL_CHECK(pel::simd::dot(vec, vec) == 118);
+
+    pel::simd::fill(vec, 3);
+    PEL_CHECK(pel::test::holds(vec, {3, 3, 3, 3, 3}));
+}
+
+void
+testContainerOverloadsOnAnEmptyContainer()
+{
+    const pel::vector<int> vec;
+    PEL_CHECK(pel::simd::find(vec, 7) == vec.data());
+    PEL_CHECK(pel::simd::count(vec, 7) == 0);
+    PEL_CHECK(pel::simd::sum(vec) == 0);
+    PEL_CHECK_THROWS(pel::simd::minimum(vec), std::out_of_range);
+    PEL_CHECK_THROWS(pel::simd::maximum(vec), std::out_of_range);
+}
+
+}        // namespace
+
+
+int
+main()
+{
+    pel::test::run("int32 kernels match the standard algorithms",
+                   testKernelsMatchTheStandardAlgorithms<std::int32_t>);
+    pel::test::run("float kernels match the standard algorithms",
+                   testKernelsMatchTheStandardAlgorithms<float>);
+    pel::test::run("double kernels match the standard algorithms",
+                   testKernelsMatchTheStandardAlgorithms<double>);
+    pel::test::run("int16 kernels match the standard algorithms",
+                   testKernelsMatchTheStandardAlgorithms<std::int16_t>);
+    pel::test::run("container overloads", testContainerOverloads);
+    pel::test::run("container overloads on an empty container",
+                   testContainerOverloadsOnAnEmptyContainer);
+    return pel::test::exit_code();
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
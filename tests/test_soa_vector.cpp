@@ -0,0 +1,362 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./test.hpp"
+#include "../src/aligned_allocator.hpp"
+#include "../src/soa_vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+
+
+namespace
+{
+using pel::test::counted;
+
+using Particles = pel::soa_vector<float, double, int>;
+using Records   = pel::soa_vector<counted, std::string>;
+
+template<typename SoaType>
+void
+fillParticles(SoaType& vec_, int count_)
+{
+    for(int i = 0; i < count_; i++)
+    {
+        vec_.emplace_back(static_cast<float>(i), i * 0.5, i * 3);
+    }
+}
+
+template<typename SoaType>
+bool
+holdsParticles(const SoaType& vec_, int count_)
+{
+    if(vec_.length() != static_cast<std::size_t>(count_))
+    {
+        return false;
+    }
+    for(int i = 0; i < count_; i++)
+    {
+        const auto [x, y, z] = vec_[static_cast<std::size_t>(i)];
+        if(x != static_cast<float>(i) || y != i * 0.5 || z != i * 3)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename ItemType>
+bool
+isSimdAligned(const ItemType* ptr_)
+{
+    return reinterpret_cast<std::uintptr_t>(ptr_) % pel::simd_alignment == 0;
+}
+
+
+/*------------------------------------*/
+/* Elements and columns */
+
+void
+testPushAndEmplace()
+{
+    Particles vec;
+    PEL_CHECK(vec.is_empty());
+
+    vec.push_back({1.0F, 2.0, 3});
+    vec.push_back(std::tuple<float, double, int>{4.0F, 5.0, 6});
+    vec.emplace_back(7.0F, 8.0, 9);
+    PEL_CHECK(vec.length() == 3);
+    PEL_CHECK(vec[1] == std::make_tuple(4.0F, 5.0, 6));
+    PEL_CHECK(vec.at(2) == std::make_tuple(7.0F, 8.0, 9));
+    PEL_CHECK_THROWS(vec.at(3), std::out_of_range);
+
+    /* Proxy references write through to the columns */
+    std::get<2>(vec[0]) = 30;
+    vec[1]              = std::make_tuple(40.0F, 50.0, 60);
+    PEL_CHECK(vec.data<2>()[0] == 30);
+    PEL_CHECK(vec.data<0>()[1] == 40.0F);
+
+    Records records;
+    records.emplace_back(1, "first");
+    records.push_back({counted{2}, std::string{"second"}});
+    PEL_CHECK(std::get<0>(records[1]) == 2);
+    PEL_CHECK(std::get<1>(records[0]) == "first");
+}
+
+void
+testColumnsAreContiguousSpans()
+{
+    Particles vec;
+    fillParticles(vec, 100);
+
+    const auto xs = vec.column<0>();
+    const auto ys = vec.column<1>();
+    const auto zs = vec.column<2>();
+    PEL_CHECK(xs.size() == 100 && ys.size() == 100 && zs.size() == 100);
+    PEL_CHECK(xs.data() == vec.data<0>());
+    for(std::size_t i = 0; i < 100; i++)
+    {
+        PEL_CHECK(xs[i] == static_cast<float>(i));
+        PEL_CHECK(ys[i] == static_cast<double>(i) * 0.5);
+        PEL_CHECK(zs[i] == static_cast<int>(i) * 3);
+    }
+
+    /* Writing through a span changes the elements */
+    vec.column<2>()[10] = -1;
+    PEL_CHECK(std::get<2>(vec[10]) == -1);
+
+    const Particles& constVec = vec;
+    PEL_CHECK(constVec.column<1>().data() == vec.data<1>());
+}
+
+void
+testColumnsAreSimdAligned()
+{
+    Particles vec;
+    for(int i = 0; i < 200; i++)
+    {
+        vec.emplace_back(0.0F, 0.0, i);
+        PEL_CHECK(isSimdAligned(vec.data<0>()));
+        PEL_CHECK(isSimdAligned(vec.data<1>()));
+        PEL_CHECK(isSimdAligned(vec.data<2>()));
+    }
+
+    pel::soa_vector<char, double> mixed(3);
+    PEL_CHECK(isSimdAligned(mixed.data<0>()));
+    PEL_CHECK(isSimdAligned(mixed.data<1>()));
+}
+
+
+void
+testEmplaceFromOwnElementsWhenFull()
+{
+    Records records;
+    records.emplace_back(1, "a string long enough to be allocated on the heap");
+    while(records.length() < records.capacity())
+    {
+        records.emplace_back(2, "filler");
+    }
+
+    const std::size_t length   = records.length();
+    const std::size_t capacity = records.capacity();
+    records.emplace_back(records.column<0>()[0], records.column<1>()[0]);
+    PEL_CHECK(records.capacity() > capacity);
+    PEL_CHECK(records.length() == length + 1);
+    PEL_CHECK(std::get<0>(records[length]) == 1);
+    PEL_CHECK(std::get<1>(records[length]) == std::get<1>(records[0]));
+
+    Particles vec;
+    fillParticles(vec, static_cast<int>(pel::simd_alignment));
+    while(vec.length() < vec.capacity())
+    {
+        vec.push_back(vec[0]);
+    }
+    vec.push_back(vec[vec.length() - 1]);
+    PEL_CHECK(vec[vec.length() - 1] == vec[0]);
+}
+
+
+/*------------------------------------*/
+/* Memory */
+
+void
+testGrowthKeepsTheElements()
+{
+    Particles   vec;
+    std::size_t growths     = 0;
+    std::size_t oldCapacity = vec.capacity();
+    for(int i = 0; i < 1'000; i++)
+    {
+        vec.emplace_back(static_cast<float>(i), i * 0.5, i * 3);
+        PEL_CHECK(vec.capacity() >= vec.length());
+        if(vec.capacity() != oldCapacity)
+        {
+            oldCapacity = vec.capacity();
+            growths++;
+        }
+    }
+    PEL_CHECK(holdsParticles(vec, 1'000));
+
+    /* Geometric growth: far fewer reallocations than appends */
+    PEL_CHECK(growths < 20);
+
+    vec.reserve(5'000);
+    PEL_CHECK(vec.capacity() >= 5'000);
+    PEL_CHECK(holdsParticles(vec, 1'000));
+
+    Particles sized(10);
+    PEL_CHECK(sized.length() == 10);
+    PEL_CHECK(sized[9] == std::make_tuple(0.0F, 0.0, 0));
+    sized.resize(4);
+    PEL_CHECK(sized.length() == 4);
+}
+
+void
+testPopClearAndShrink()
+{
+    {
+        Records records;
+        for(int i = 0; i < 50; i++)
+        {
+            records.emplace_back(i, std::to_string(i));
+        }
+        PEL_CHECK(counted::s_live == 50);
+
+        records.pop_back();
+        PEL_CHECK(records.length() == 49);
+        PEL_CHECK(counted::s_live == 49);
+
+        records.resize(10);
+        PEL_CHECK(counted::s_live == 10);
+
+        records.shrink_to_fit();
+        PEL_CHECK(records.capacity() >= 10 && records.capacity() < 50);
+        PEL_CHECK(std::get<0>(records[9]) == 9);
+        PEL_CHECK(std::get<1>(records[9]) == "9");
+
+        const std::size_t capacity = records.capacity();
+        records.clear();
+        PEL_CHECK(records.is_empty());
+        PEL_CHECK(records.capacity() == capacity);
+        PEL_CHECK(counted::s_live == 0);
+        PEL_CHECK_THROWS(records.pop_back(), std::length_error);
+
+        records.emplace_back(1, "one");
+        records.clear();
+        records.shrink_to_fit();
+        PEL_CHECK(records.capacity() == 0);
+        PEL_CHECK(records.data<0>() == nullptr);
+    }
+    PEL_CHECK(counted::s_live == 0);
+}
+
+
+/*------------------------------------*/
+/* Copies and moves */
+
+void
+testCopyAndMove()
+{
+    Particles source;
+    fillParticles(source, 40);
+
+    Particles copy{source};
+    PEL_CHECK(holdsParticles(copy, 40));
+    PEL_CHECK(copy.data<0>() != source.data<0>());
+    PEL_CHECK(isSimdAligned(copy.data<1>()));
+
+    const float* const storage = source.data<0>();
+    Particles          moved{std::move(source)};
+    PEL_CHECK(holdsParticles(moved, 40));
+    PEL_CHECK(moved.data<0>() == storage);
+    PEL_CHECK(source.is_empty());
+    PEL_CHECK(source.capacity() == 0);
+
+    Particles assigned;
+    assigned = copy;
+    PEL_CHECK(holdsParticles(assigned, 40));
+    assigned = std::move(moved);
+    PEL_CHECK(assigned.data<0>() == storage);
+
+    {
+        Records records;
+        records.emplace_back(1, "one");
+        records.emplace_back(2, "two");
+
+        Records recordsCopy{records};
+        PEL_CHECK(std::get<1>(recordsCopy[1]) == "two");
+        PEL_CHECK(counted::s_live == 4);
+
+        Records recordsMoved{std::move(records)};
+        PEL_CHECK(std::get<0>(recordsMoved[0]) == 1);
+        PEL_CHECK(counted::s_live == 4);
+    }
+    PEL_CHECK(counted::s_live == 0);
+}
+
+/** Field whose copy constructor throws once a countdown reaches zero. */
+struct throwing_copy
+{
+    static inline int s_copiesLeft = -1;
+
+    int m_value = 0;
+
+    throwing_copy(int value_) noexcept : m_value{value_} {}
+    throwing_copy(const throwing_copy& other_) : m_value{other_.m_value}
+    {
+        if(s_copiesLeft-- == 0)
+        {
+            throw std::runtime_error{"copy failure"};
+        }
+    }
+    throwing_copy(throwing_copy&&) noexcept = default;
+};
+
+void
+testFailedCopyReleasesTheCopiedElements()
+{
+    {
+        pel::soa_vector<counted, throwing_copy> source;
+        for(int i = 0; i < 20; i++)
+        {
+            source.emplace_back(i, i);
+        }
+
+        throwing_copy::s_copiesLeft = 10;
+        using SoaType = pel::soa_vector<counted, throwing_copy>;
+        PEL_CHECK_THROWS(SoaType{source}, std::runtime_error);
+        throwing_copy::s_copiesLeft = -1;
+        PEL_CHECK(counted::s_live == 20);
+    }
+    PEL_CHECK(counted::s_live == 0);
+}
+
+}        // namespace
+
+
+int
+main()
+{
+    pel::test::run("push_back and emplace_back", testPushAndEmplace);
+    pel::test::run("columns are contiguous spans", testColumnsAreContiguousSpans);
+    pel::test::run("columns are simd aligned", testColumnsAreSimdAligned);
+    pel::test::run("emplace_back from its own elements when full",
+                   testEmplaceFromOwnElementsWhenFull);
+    pel::test::run("growth keeps the elements", testGrowthKeepsTheElements);
+    pel::test::run("pop_back, clear and shrink_to_fit", testPopClearAndShrink);
+    pel::test::run("copy and move", testCopyAndMove);
+    pel::test::run("failed copy releases the copied elements",
+                   testFailedCopyReleasesTheCopiedElements);
+    return pel::test::exit_code();
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */
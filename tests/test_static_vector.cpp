@@ -0,0 +1,272 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./test.hpp"
+#include "../src/static_vector.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+
+namespace
+{
+using pel::test::counted;
+using pel::test::holds;
+
+/** Long enough to never fit in the small string buffer. */
+const std::string firstText  = "first element, long enough to never fit in the small buffer";
+const std::string secondText = "second element, long enough to never fit in the small buffer";
+
+template<typename ItemType, std::size_t Capacity>
+using ThrowingVector = pel::static_vector<ItemType, Capacity, pel::overflow_throw>;
+
+template<typename ItemType, std::size_t Capacity>
+using ReportingVector = pel::static_vector<ItemType, Capacity, pel::overflow_return_false>;
+
+
+/*------------------------------------*/
+/* Insertions */
+
+template<typename ItemType>
+void
+testInsertShiftsTheElements()
+{
+    ReportingVector<ItemType, 8> vec{0, 1, 2};
+
+    PEL_CHECK(vec.insert(ItemType{9}, 1, 2));
+    PEL_CHECK(holds(vec, {0, 9, 9, 1, 2}));
+    PEL_CHECK(vec.emplace(0, 1, 7));
+    PEL_CHECK(holds(vec, {7, 0, 9, 9, 1, 2}));
+    PEL_CHECK(vec.insert({5, 6}, 6));
+    PEL_CHECK(holds(vec, {7, 0, 9, 9, 1, 2, 5, 6}));
+}
+
+void
+testInsertCopiesElementsOfItself()
+{
+    pel::static_vector<std::string, 8> vec{firstText, secondText};
+
+    PEL_CHECK(vec.insert(vec[0], 0, 2));
+    PEL_CHECK(holds(vec, {firstText, firstText, firstText, secondText}));
+
+    PEL_CHECK(vec.emplace(1, 2, vec[3]));
+    PEL_CHECK(holds(vec, {firstText, secondText, secondText, firstText, firstText, secondText}));
+
+    PEL_CHECK(vec.emplace(0, 1, vec[5]));
+    PEL_CHECK(vec[0] == secondText);
+    PEL_CHECK(vec[6] == secondText);
+    PEL_CHECK(vec.length() == 7);
+}
+
+constexpr bool
+insertsElementsOfItselfInConstantExpressions()
+{
+    pel::static_vector<int, 8> vec{1, 2, 3};
+    vec.insert(vec[2], 0, 2);
+    vec.emplace(1, 1, vec[4]);
+    return vec.length() == 6 && vec[0] == 3 && vec[1] == 3 && vec[2] == 3 && vec[5] == 3;
+}
+static_assert(insertsElementsOfItselfInConstantExpressions());
+
+/** Literal type with a non-trivial default constructor, stored in the union storage. */
+struct point
+{
+    int m_x = 0;
+    int m_y = 0;
+
+    constexpr bool operator==(const point&) const = default;
+};
+
+constexpr bool
+buildsNonTrivialElementsInConstantExpressions()
+{
+    pel::static_vector<point, 4> vec{{1, 2}, {3, 4}};
+    vec.emplace_back(5, 6);
+    vec.insert(point{7, 8}, 0);
+    vec.pop_back();
+    return vec.length() == 3 && vec[0] == point{7, 8} && vec[2] == point{3, 4};
+}
+static_assert(buildsNonTrivialElementsInConstantExpressions());
+
+/** The slots past the length must be initialized for the static_vector to be a constant. */
+constexpr pel::static_vector<int, 4> constantVector{1, 2};
+static_assert(constantVector.length() == 2);
+static_assert(constantVector[0] == 1 && constantVector[1] == 2);
+
+constexpr pel::static_vector<char, 8> constantCopy = pel::static_vector<char, 8>(3, 'x');
+static_assert(constantCopy.length() == 3 && constantCopy[2] == 'x');
+static_assert(pel::static_vector<int, 4>{}.is_empty());
+
+
+/*------------------------------------*/
+/* Layout */
+
+/** Size of the elements followed by the count, padded to the alignment of the elements. */
+template<typename ItemType, std::size_t Capacity>
+constexpr std::size_t expectedSize =
+  (Capacity * sizeof(ItemType) + sizeof(pel::static_vector_size_t<Capacity>) + alignof(ItemType)
+   - 1)
+  / alignof(ItemType) * alignof(ItemType);
+
+static_assert(sizeof(pel::static_vector<char, 300>) == 300 + sizeof(std::uint16_t));
+static_assert(sizeof(pel::static_vector<int, 4>) == expectedSize<int, 4>);
+static_assert(sizeof(pel::static_vector<point, 4>) == expectedSize<point, 4>);
+static_assert(sizeof(pel::static_vector<std::string, 4>) == expectedSize<std::string, 4>);
+
+static_assert(std::is_trivially_copyable_v<pel::static_vector<int, 4>>);
+static_assert(std::is_trivially_copyable_v<pel::static_vector<point, 4>>);
+static_assert(!std::is_trivially_copyable_v<pel::static_vector<std::string, 4>>);
+
+static_assert(noexcept(std::declval<pel::static_vector<int, 4>&>().push_back(1)));
+static_assert(noexcept(std::declval<ReportingVector<int, 4>&>().push_back(1)));
+static_assert(noexcept(std::declval<ReportingVector<int, 4>&>().insert(1, 0)));
+static_assert(!noexcept(std::declval<ThrowingVector<int, 4>&>().push_back(1)));
+
+
+/*------------------------------------*/
+/* Overflow */
+
+template<typename ItemType>
+void
+testOverflowReturnsFalse()
+{
+    ReportingVector<ItemType, 4> vec{0, 1, 2};
+
+    PEL_CHECK(vec.push_back(ItemType{3}));
+    PEL_CHECK(!vec.push_back(ItemType{4}));
+    PEL_CHECK(!vec.emplace_back(4));
+    PEL_CHECK(!vec.insert(ItemType{4}, 0));
+    PEL_CHECK(!vec.emplace(0, 1, 4));
+    PEL_CHECK(holds(vec, {0, 1, 2, 3}));
+
+    vec.pop_back();
+    PEL_CHECK(!vec.push_back({4, 5}));
+    PEL_CHECK(!vec.insert({4, 5}, 1));
+    PEL_CHECK(!vec.insert(ItemType{4}, 1, 2));
+    PEL_CHECK(holds(vec, {0, 1, 2}));
+    PEL_CHECK(vec.insert(ItemType{4}, 1, 1));
+    PEL_CHECK(holds(vec, {0, 4, 1, 2}));
+}
+
+template<typename ItemType>
+void
+testOverflowThrows()
+{
+    ThrowingVector<ItemType, 4> vec{0, 1, 2, 3};
+
+    PEL_CHECK_THROWS(vec.push_back(ItemType{4}), std::length_error);
+    PEL_CHECK_THROWS(vec.emplace_back(4), std::length_error);
+    PEL_CHECK_THROWS(vec.insert(ItemType{4}, 2), std::length_error);
+    PEL_CHECK_THROWS(vec.insert({4}, 0), std::length_error);
+    PEL_CHECK(holds(vec, {0, 1, 2, 3}));
+
+    PEL_CHECK_THROWS((ThrowingVector<ItemType, 2>{0, 1, 2}), std::length_error);
+}
+
+template<typename ItemType>
+void
+testInvalidOffsetIsRejected()
+{
+    ReportingVector<ItemType, 4> reporting{1, 2};
+    PEL_CHECK(!reporting.insert(ItemType{5}, 3));
+    PEL_CHECK(!reporting.insert({5}, -1));
+    PEL_CHECK(!reporting.emplace(3, 1, 5));
+    PEL_CHECK(!reporting.assign(ItemType{5}, 3));
+    PEL_CHECK(!reporting.assign({5}, 3));
+    PEL_CHECK(holds(reporting, {1, 2}));
+
+    ThrowingVector<ItemType, 4> throwing{1, 2};
+    PEL_CHECK_THROWS(throwing.insert(ItemType{5}, 3), std::invalid_argument);
+    PEL_CHECK_THROWS(throwing.insert({5}, -1), std::invalid_argument);
+    PEL_CHECK_THROWS(throwing.emplace(3, 1, 5), std::invalid_argument);
+    PEL_CHECK_THROWS(throwing.assign(ItemType{5}, 3), std::invalid_argument);
+    PEL_CHECK_THROWS(throwing.assign({5}, 3), std::invalid_argument);
+    PEL_CHECK(holds(throwing, {1, 2}));
+
+    /* The end itself is a valid offset */
+    PEL_CHECK(reporting.insert(ItemType{3}, 2));
+    PEL_CHECK(throwing.assign(ItemType{3}, 2));
+    PEL_CHECK(holds(reporting, {1, 2, 3}));
+    PEL_CHECK(holds(throwing, {1, 2, 3}));
+}
+
+void
+testTriviallyCopyableElementsAreCopiedWhole()
+{
+    pel::static_vector<point, 4> vec{{1, 2}, {3, 4}};
+
+    pel::static_vector<point, 4> copy{vec};
+    PEL_CHECK(copy.length() == 2 && copy[1] == (point{3, 4}));
+
+    pel::static_vector<point, 4> bytes;
+    std::memcpy(static_cast<void*>(&bytes), &vec, sizeof(vec));
+    PEL_CHECK(bytes.length() == 2 && bytes[0] == (point{1, 2}));
+
+    copy = pel::static_vector<point, 4>{{5, 6}};
+    PEL_CHECK(copy.length() == 1 && copy[0] == (point{5, 6}));
+}
+
+void
+testOverflowDestroysNothing()
+{
+    {
+        ReportingVector<counted, 3> vec{0, 1, 2};
+        PEL_CHECK(!vec.push_back(counted{3}));
+        PEL_CHECK(!vec.insert(vec[0], 0));
+        PEL_CHECK(counted::s_live == 3);
+    }
+    PEL_CHECK(counted::s_live == 0);
+}
+
+}        // namespace
+
+
+int
+main()
+{
+    pel::test::run("insert shifts the elements (int)", testInsertShiftsTheElements<int>);
+    pel::test::run("insert shifts the elements (counted)", testInsertShiftsTheElements<counted>);
+    pel::test::run("insert copies elements of itself", testInsertCopiesElementsOfItself);
+    pel::test::run("overflow returns false (int)", testOverflowReturnsFalse<int>);
+    pel::test::run("overflow returns false (counted)", testOverflowReturnsFalse<counted>);
+    pel::test::run("overflow throws (int)", testOverflowThrows<int>);
+    pel::test::run("overflow throws (counted)", testOverflowThrows<counted>);
+    pel::test::run("invalid offset is rejected (int)", testInvalidOffsetIsRejected<int>);
+    pel::test::run("invalid offset is rejected (counted)", testInvalidOffsetIsRejected<counted>);
+    pel::test::run("overflow destroys nothing", testOverflowDestroysNothing);
+    pel::test::run("trivially copyable elements are copied whole",
+                   testTriviallyCopyableElementsAreCopiedWhole);
+    pel::test::run("counted elements are all destroyed", [] { PEL_CHECK(counted::s_live == 0); });
+    return pel::test::exit_code();
+}
+
+
+/*************************************************************************************************/
+/* ----- END OF FILE ----- */